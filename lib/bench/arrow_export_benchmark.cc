@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/util/compression.h"
+#include "duckdb/common/arrow/arrow_converter.hpp"
+#include "duckdb/web/arrow_casts.h"
+#include "duckdb/web/arrow_ipc_encoder.h"
+#include "duckdb/web/webdb.h"
+
+using namespace duckdb::web;
+
+namespace {
+
+/// The exported result
+struct ExportFixture {
+    /// The database
+    std::shared_ptr<WebDB> db;
+    /// The chunks
+    std::vector<duckdb::unique_ptr<duckdb::DataChunk>> chunks;
+    /// The types
+    duckdb::vector<duckdb::LogicalType> types;
+    /// The client properties
+    duckdb::ClientProperties options;
+    /// The query config
+    QueryConfig config;
+    /// The Arrow schema
+    std::shared_ptr<arrow::Schema> schema;
+    /// The patched Arrow schema
+    std::shared_ptr<arrow::Schema> patched_schema;
+
+    /// Constructor
+    ExportFixture(bool casts) {
+        db = std::make_shared<WebDB>(NATIVE);
+        WebDB::Connection conn{*db};
+        auto result = conn.connection().Query(
+            "SELECT range AS id, range % 97 AS grp, (range * 7) % 1000 / 3 AS val, 'row ' || range AS txt, "
+            "TIMESTAMP '2020-01-01' + range * INTERVAL 1 SECOND AS ts FROM range(1000000)");
+        types = result->types;
+        options.arrow_offset_size = duckdb::ArrowOffsetSize::REGULAR;
+        config.cast_bigint_to_double = casts;
+        config.cast_timestamp_to_date = casts;
+        ArrowSchema raw_schema;
+        duckdb::ArrowConverter::ToArrowSchema(&raw_schema, result->types, result->names, options);
+        schema = arrow::ImportSchema(&raw_schema).ValueOrDie();
+        patched_schema = patchSchema(schema, config);
+        for (auto chunk = result->Fetch(); !!chunk && chunk->size() > 0; chunk = result->Fetch()) {
+            chunks.push_back(std::move(chunk));
+        }
+    }
+};
+
+/// Export the chunks through the C data interface, a record batch and the IPC writer
+void BM_ExportGeneric(benchmark::State& state) {
+    ExportFixture fixture{state.range(0) != 0};
+    auto ipc_options = arrow::ipc::IpcWriteOptions::Defaults();
+    ipc_options.use_threads = false;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto& chunk : fixture.chunks) {
+            ArrowArray array;
+            duckdb::ArrowConverter::ToArrowArray(*chunk, &array, fixture.options);
+            auto batch = arrow::ImportRecordBatch(&array, fixture.schema).ValueOrDie();
+            batch = patchRecordBatch(batch, fixture.patched_schema, fixture.config).ValueOrDie();
+            auto buffer = arrow::ipc::SerializeRecordBatch(*batch, ipc_options).ValueOrDie();
+            bytes += buffer->size();
+            benchmark::DoNotOptimize(buffer);
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+/// Export the chunks with the direct IPC encoder
+void BM_ExportDirect(benchmark::State& state) {
+    ExportFixture fixture{state.range(0) != 0};
+    auto encoder = ArrowIPCEncoder::Create(fixture.types, *fixture.patched_schema);
+    if (!encoder) {
+        state.SkipWithError("result is not supported by the encoder");
+        return;
+    }
+    size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto& chunk : fixture.chunks) {
+            auto message = encoder->Encode(*chunk).ValueOrDie();
+            bytes += message.GetMessage()->size();
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+/// Export the chunks with compressed IPC bodies and report the size of the result
+void BM_ExportCompressed(benchmark::State& state) {
+    std::array<arrow::Compression::type, 3> compressions{arrow::Compression::UNCOMPRESSED,
+                                                        arrow::Compression::LZ4_FRAME, arrow::Compression::ZSTD};
+    auto compression = compressions[state.range(0)];
+    ExportFixture fixture{false};
+    auto ipc_options = arrow::ipc::IpcWriteOptions::Defaults();
+    ipc_options.use_threads = false;
+    if (compression != arrow::Compression::UNCOMPRESSED) {
+        if (!arrow::util::Codec::IsAvailable(compression)) {
+            state.SkipWithError("codec is not available in this build");
+            return;
+        }
+        ipc_options.codec = arrow::util::Codec::Create(compression).ValueOrDie();
+    }
+    size_t compressed_bytes = 0;
+    for (auto _ : state) {
+        for (auto& chunk : fixture.chunks) {
+            ArrowArray array;
+            duckdb::ArrowConverter::ToArrowArray(*chunk, &array, fixture.options);
+            auto batch = arrow::ImportRecordBatch(&array, fixture.schema).ValueOrDie();
+            auto buffer = arrow::ipc::SerializeRecordBatch(*batch, ipc_options).ValueOrDie();
+            compressed_bytes += buffer->size();
+            benchmark::DoNotOptimize(buffer);
+        }
+    }
+    state.counters["ipc_bytes"] =
+        benchmark::Counter(static_cast<double>(compressed_bytes) / state.iterations(), benchmark::Counter::kDefaults,
+                           benchmark::Counter::kIs1024);
+    state.SetLabel(arrow::util::Codec::GetCodecAsString(compression));
+}
+
+}  // namespace
+
+BENCHMARK(BM_ExportGeneric)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExportDirect)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExportCompressed)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "duckdb/web/http_transport.h"
+#include "duckdb/web/io/web_filesystem.h"
+#include "duckdb/web/webdb.h"
+
+using namespace duckdb::web;
+
+namespace {
+
+/// The url of the remote file
+constexpr const char* REMOTE_URL = "http://bench/events.csv";
+
+/// Generate a csv file once.
+/// The size in MB is read from DUCKDB_WEB_BENCH_CSV_MB, set it to a few thousand to ingest a multi-GB file.
+const std::string& GetCSVData() {
+    static std::string data = []() {
+        size_t size_mb = 256;
+        if (auto env = std::getenv("DUCKDB_WEB_BENCH_CSV_MB")) size_mb = std::strtoull(env, nullptr, 10);
+        auto size = size_mb * 1000 * 1000;
+        std::string csv = "id,grp,val,txt\n";
+        csv.reserve(size + 64);
+        for (uint64_t i = 0; csv.size() < size; ++i) {
+            csv += std::to_string(i);
+            csv += ',';
+            csv += std::to_string(i % 97);
+            csv += ',';
+            csv += std::to_string((i * 7) % 1000);
+            csv += ",\"row ";
+            csv += std::to_string(i);
+            csv += "\"\n";
+        }
+        return csv;
+    }();
+    return data;
+}
+
+/// Ingest a remote csv file through the mock transport.
+/// Arguments: latency in milliseconds, bandwidth in MB/s (0 is unlimited)
+void RemoteCSVInsert(benchmark::State& state, const char* options) {
+    auto transport = std::make_shared<MockHTTPTransport>();
+    transport->AddResource(REMOTE_URL, GetCSVData());
+    transport->SetLatency(std::chrono::milliseconds{state.range(0)});
+    transport->SetBandwidth(state.range(1) * 1000 * 1000);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto db = std::make_shared<WebDB>(WEB);
+        io::WebFileSystem::Get()->SetHTTPTransport(transport);
+        db->RegisterFileURL("events.csv", REMOTE_URL, io::WebFileSystem::DataProtocol::HTTP, false);
+        WebDB::Connection conn{*db};
+        state.ResumeTiming();
+
+        auto maybe_ok = conn.InsertCSVFromPath("events.csv", options);
+        if (!maybe_ok.ok()) {
+            state.SkipWithError(maybe_ok.message().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * GetCSVData().size()));
+    state.counters["requests"] =
+        benchmark::Counter(static_cast<double>(transport->GetRequestCount()), benchmark::Counter::kAvgIterations);
+    state.counters["bytes"] =
+        benchmark::Counter(static_cast<double>(transport->GetBytesSent()), benchmark::Counter::kAvgIterations);
+}
+
+void BM_RemoteCSVInsertDirect(benchmark::State& state) {
+    RemoteCSVInsert(state, R"JSON({"name": "events", "prefetchConcurrency": 0})JSON");
+}
+void BM_RemoteCSVInsertPrefetch(benchmark::State& state) {
+    RemoteCSVInsert(state, R"JSON({"name": "events"})JSON");
+}
+void BM_RemoteCSVInsertPrefetchWide(benchmark::State& state) {
+    RemoteCSVInsert(state, R"JSON({"name": "events", "prefetchRangeSize": 8388608, "prefetchConcurrency": 5})JSON");
+}
+
+/// Local, LAN and WAN-like links
+void RemoteCSVArgs(benchmark::internal::Benchmark* b) {
+    b->Args({0, 0})->Args({2, 1000})->Args({20, 100})->Args({80, 20})->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(BM_RemoteCSVInsertDirect)->Apply(RemoteCSVArgs);
+BENCHMARK(BM_RemoteCSVInsertPrefetch)->Apply(RemoteCSVArgs);
+BENCHMARK(BM_RemoteCSVInsertPrefetchWide)->Apply(RemoteCSVArgs);
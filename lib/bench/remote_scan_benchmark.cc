@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "duckdb/web/extensions/parquet_extension.h"
+#include "duckdb/web/http_transport.h"
+#include "duckdb/web/io/web_filesystem.h"
+#include "duckdb/web/webdb.h"
+
+using namespace duckdb::web;
+
+namespace {
+
+/// The url of the remote file
+constexpr const char* REMOTE_URL = "http://bench/lineitem.parquet";
+
+/// Generate a parquet file once
+const std::string& GetParquetData() {
+    static std::string data = []() {
+        auto path = std::filesystem::temp_directory_path() / "duckdb_web_remote_scan_benchmark.parquet";
+        auto db = std::make_shared<WebDB>(NATIVE);
+        duckdb_web_parquet_init(&db->database());
+        WebDB::Connection conn{*db};
+        std::stringstream ss;
+        ss << "COPY (SELECT range AS id, range % 97 AS grp, (range * 7) % 1000 AS val, 'row ' || range AS txt "
+           << "FROM range(1000000)) TO '" << path.string() << "' (FORMAT PARQUET, ROW_GROUP_SIZE 100000)";
+        conn.connection().Query(ss.str());
+        std::ifstream in{path, std::ios::binary};
+        std::string bytes{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+        std::filesystem::remove(path);
+        return bytes;
+    }();
+    return data;
+}
+
+/// Scan a remote parquet file through the mock transport.
+/// Arguments: latency in milliseconds, bandwidth in MB/s (0 is unlimited)
+void RemoteParquetScan(benchmark::State& state, const char* query) {
+    auto transport = std::make_shared<MockHTTPTransport>();
+    transport->AddResource(REMOTE_URL, GetParquetData());
+    transport->SetLatency(std::chrono::milliseconds{state.range(0)});
+    transport->SetBandwidth(state.range(1) * 1000 * 1000);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto db = std::make_shared<WebDB>(WEB);
+        duckdb_web_parquet_init(&db->database());
+        io::WebFileSystem::Get()->SetHTTPTransport(transport);
+        db->RegisterFileURL("lineitem.parquet", REMOTE_URL, io::WebFileSystem::DataProtocol::HTTP, false);
+        WebDB::Connection conn{*db};
+        state.ResumeTiming();
+
+        auto result = conn.connection().Query(query);
+        if (result->HasError()) {
+            state.SkipWithError(result->GetError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["requests"] =
+        benchmark::Counter(static_cast<double>(transport->GetRequestCount()), benchmark::Counter::kAvgIterations);
+    state.counters["bytes"] =
+        benchmark::Counter(static_cast<double>(transport->GetBytesSent()), benchmark::Counter::kAvgIterations);
+}
+
+void BM_RemoteScanFull(benchmark::State& state) {
+    RemoteParquetScan(state, "SELECT sum(val), count(txt) FROM parquet_scan('lineitem.parquet')");
+}
+void BM_RemoteScanProjection(benchmark::State& state) {
+    RemoteParquetScan(state, "SELECT sum(val) FROM parquet_scan('lineitem.parquet')");
+}
+void BM_RemoteScanSelective(benchmark::State& state) {
+    RemoteParquetScan(state, "SELECT count(*) FROM parquet_scan('lineitem.parquet') WHERE id < 1000");
+}
+
+/// Local, LAN and WAN-like links
+void RemoteScanArgs(benchmark::internal::Benchmark* b) {
+    b->Args({0, 0})->Args({2, 1000})->Args({20, 100})->Args({80, 20})->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(BM_RemoteScanFull)->Apply(RemoteScanArgs);
+BENCHMARK(BM_RemoteScanProjection)->Apply(RemoteScanArgs);
+BENCHMARK(BM_RemoteScanSelective)->Apply(RemoteScanArgs);
+
+BENCHMARK_MAIN();
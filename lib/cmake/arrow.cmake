@@ -2,6 +2,20 @@ include(ExternalProject)
 
 set(ARROW_CXX_FLAGS "${CMAKE_CXX_FLAGS}")
 
+# IPC body compression needs the bundled LZ4 and ZSTD codecs.
+# The JavaScript Arrow reader cannot decompress record batches, compressed results are only useful to native
+# clients and to clients that forward the raw IPC bytes to such a reader.
+set(ARROW_BYPRODUCTS <INSTALL_DIR>/lib/libarrow.a)
+if(DUCKDB_WASM_IPC_COMPRESSION)
+  if(EMSCRIPTEN)
+    message(WARNING "IPC compression in a WebAssembly build: apache-arrow cannot read compressed results")
+  endif()
+  set(ARROW_WITH_IPC_COMPRESSION ON)
+  list(APPEND ARROW_BYPRODUCTS <INSTALL_DIR>/lib/libarrow_bundled_dependencies.a)
+else()
+  set(ARROW_WITH_IPC_COMPRESSION OFF)
+endif()
+
 set(ARROW_FLAGS
     -G${CMAKE_GENERATOR}
     -DCMAKE_BUILD_TYPE=Release
@@ -38,12 +52,14 @@ set(ARROW_FLAGS
     -DARROW_USE_CCACHE=OFF
     -DARROW_USE_GLOG=OFF
     -DARROW_WITH_BROTLI=OFF
-    -DARROW_WITH_LZ4=OFF
+    -DARROW_WITH_LZ4=${ARROW_WITH_IPC_COMPRESSION}
     -DARROW_WITH_PROTOBUF=OFF
     -DARROW_WITH_RAPIDJSON=OFF
     -DARROW_WITH_SNAPPY=OFF
     -DARROW_WITH_ZLIB=OFF
-    -DARROW_WITH_ZSTD=OFF
+    -DARROW_WITH_ZSTD=${ARROW_WITH_IPC_COMPRESSION}
+    -DLZ4_SOURCE=BUNDLED
+    -Dzstd_SOURCE=BUNDLED
     -DARROW_ENABLE_TIMING_TESTS=OFF
     -DBOOST_SOURCE=BUNDLED)
 
@@ -81,7 +97,7 @@ ExternalProject_Add(
     ${ARROW_FLAGS}
   DOWNLOAD_COMMAND ""
   UPDATE_COMMAND ""
-  BUILD_BYPRODUCTS <INSTALL_DIR>/lib/libarrow.a)
+  BUILD_BYPRODUCTS ${ARROW_BYPRODUCTS})
 
 ExternalProject_Get_Property(arrow_ep install_dir)
 set(ARROW_INCLUDE_DIR ${install_dir}/include)
@@ -96,3 +112,14 @@ set_property(
   PROPERTY INTERFACE_INCLUDE_DIRECTORIES ${ARROW_INCLUDE_DIR})
 
 add_dependencies(arrow arrow_ep)
+
+if(DUCKDB_WASM_IPC_COMPRESSION)
+  add_library(arrow_bundled_dependencies STATIC IMPORTED)
+  set_property(TARGET arrow_bundled_dependencies
+               PROPERTY IMPORTED_LOCATION ${install_dir}/lib/libarrow_bundled_dependencies.a)
+  add_dependencies(arrow_bundled_dependencies arrow_ep)
+  set_property(
+    TARGET arrow
+    APPEND
+    PROPERTY INTERFACE_LINK_LIBRARIES arrow_bundled_dependencies)
+endif()
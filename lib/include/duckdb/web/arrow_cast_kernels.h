@@ -0,0 +1,32 @@
+#ifndef INCLUDE_DUCKDB_WEB_ARROW_CAST_KERNELS_H_
+#define INCLUDE_DUCKDB_WEB_ARROW_CAST_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace duckdb {
+namespace web {
+
+/// Kernels for the result casts of the query config.
+///
+/// The kernels work on contiguous values and are shared by the record batch patching and the direct IPC encoder.
+/// 64-bit integer conversions use wasm SIMD128 with WEBDB_SIMD and SSE2/AVX2 in native builds. They produce the same
+/// correctly rounded doubles as a static_cast.
+namespace kernels {
+
+/// Cast int64 values to double
+void CastInt64ToDouble(const int64_t* in, double* out, size_t count);
+/// Cast uint64 values to double
+void CastUInt64ToDouble(const uint64_t* in, double* out, size_t count);
+/// Scale int64 values with a multiplier and a truncating divisor
+void ScaleInt64(const int64_t* in, int64_t* out, size_t count, int64_t multiplier, int64_t divisor);
+/// Cast decimals with 16, 32 or 64 bit values to double
+template <typename T> void CastDecimalToDouble(const T* in, double* out, size_t count, int32_t scale);
+/// Cast 128 bit decimals, stored as pairs of low and high words, to double
+void CastDecimal128ToDouble(const uint64_t* in, double* out, size_t count, int32_t scale);
+
+}  // namespace kernels
+}  // namespace web
+}  // namespace duckdb
+
+#endif
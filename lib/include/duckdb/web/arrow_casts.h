@@ -2,6 +2,8 @@
 #define INCLUDE_DUCKDB_WEB_ARROW_CASTS_H_
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "arrow/array/array_dict.h"
 #include "arrow/array/array_nested.h"
@@ -103,12 +105,44 @@ std::shared_ptr<arrow::Array> castScalarArray(const std::shared_ptr<arrow::Array
     }
 }
 
+/// The cast of a record batch column
+struct ColumnCast {
+    /// The cast kinds
+    enum class Kind { NONE, INT64_TO_DOUBLE, UINT64_TO_DOUBLE, SCALE_INT64, DECIMAL128_TO_DOUBLE };
+    /// The cast kind
+    Kind kind = Kind::NONE;
+    /// The target type
+    std::shared_ptr<arrow::DataType> type = nullptr;
+    /// The multiplier of scaled integers
+    int64_t multiplier = 1;
+    /// The divisor of scaled integers
+    int64_t divisor = 1;
+    /// The decimal scale
+    int32_t scale = 0;
+};
+
+/// The casts of all record batches of a query result, planned once for the schema
+struct RecordBatchCasts {
+    /// The patched schema
+    std::shared_ptr<arrow::Schema> schema = nullptr;
+    /// The column casts
+    std::vector<ColumnCast> columns = {};
+    /// Is any column casted?
+    bool any = false;
+};
+
 /// Helper to cast scalar types in arrow schema and return the same schema if nothing changes
 std::shared_ptr<arrow::Schema> patchSchema(const std::shared_ptr<arrow::Schema>& schema, const QueryConfig& config);
 /// Helper to cast a record batch
 arrow::Result<std::shared_ptr<arrow::RecordBatch>> patchRecordBatch(const std::shared_ptr<arrow::RecordBatch>& batch,
                                                                     const std::shared_ptr<arrow::Schema>& schema,
                                                                     const QueryConfig& config);
+/// Plan the casts of the record batches with a schema
+RecordBatchCasts planRecordBatchCasts(const arrow::Schema& schema, const std::shared_ptr<arrow::Schema>& patched_schema,
+                                      const QueryConfig& config);
+/// Helper to cast a record batch with planned casts
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> patchRecordBatch(const std::shared_ptr<arrow::RecordBatch>& batch,
+                                                                    const RecordBatchCasts& casts);
 
 }  // namespace web
 }  // namespace duckdb
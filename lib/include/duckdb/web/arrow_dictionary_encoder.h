@@ -0,0 +1,134 @@
+#ifndef INCLUDE_DUCKDB_WEB_ARROW_DICTIONARY_ENCODER_H_
+#define INCLUDE_DUCKDB_WEB_ARROW_DICTIONARY_ENCODER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/options.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/record_batch.h"
+#include "arrow/result.h"
+#include "arrow/type.h"
+#include "duckdb/common/string_map_set.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/types/string_heap.hpp"
+
+namespace duckdb {
+namespace web {
+
+/// Dictionary-encodes the string columns of a query result.
+///
+/// Every VARCHAR column keeps a dictionary that only grows across the record batches of a result. The IPC writers
+/// therefore emit dictionary deltas with the new values instead of repeating the values in every batch. The indices
+/// are computed from the DuckDB vectors, entries of dictionary and constant vectors are looked up once per chunk.
+///
+/// A column whose dictionary grows too large or holds mostly distinct values falls back to plain strings. Before the
+/// schema is written, the column is exported as utf8. Afterwards, streams write the strings of every batch as a
+/// dictionary of its own, IPC files cannot replace dictionaries and keep growing it.
+class ArrowDictionaryEncoder {
+   public:
+    /// The dictionary size after which a column falls back to plain strings
+    static constexpr size_t MAX_DICTIONARY_BYTES = 16 << 20;  // 16 MB
+    /// The number of rows after which the distinct ratio of a column is checked
+    static constexpr uint64_t MIN_RATIO_ROWS = 2048;
+    /// The ratio of distinct values to rows above which a column falls back to plain strings
+    static constexpr double MAX_DISTINCT_RATIO = 0.5;
+
+   protected:
+    /// The dictionary of a column
+    struct Dictionary {
+        /// The column index
+        size_t column;
+        /// The indices of the values
+        duckdb::string_map_t<int32_t> indices = {};
+        /// The owned values
+        duckdb::StringHeap heap;
+        /// The value offsets
+        std::vector<int32_t> offsets = {0};
+        /// The value data
+        std::string data = {};
+        /// The number of encoded rows
+        uint64_t rows = 0;
+        /// The column fell back to plain strings?
+        bool plain = false;
+        /// The last finished array, reused while no value is added
+        std::shared_ptr<arrow::Array> finished = nullptr;
+
+        /// Constructor
+        explicit Dictionary(size_t column) : column(column) {}
+        /// Get the index of a value, adds the value if it is new
+        arrow::Result<int32_t> GetIndex(const duckdb::string_t& value);
+        /// Get the dictionary as Arrow array, copies the values only if the dictionary grew
+        arrow::Result<std::shared_ptr<arrow::Array>> Finish();
+        /// Should the column fall back to plain strings?
+        bool ExceedsThresholds() const;
+        /// Fall back to plain strings and drop the values
+        void FallBack();
+    };
+
+    /// The dictionaries
+    std::vector<std::unique_ptr<Dictionary>> dictionaries_;
+    /// The schema with dictionary fields
+    std::shared_ptr<arrow::Schema> schema_;
+    /// Was the schema written?
+    bool schema_fixed_ = false;
+    /// May the dictionaries be replaced once the schema was written?
+    bool allow_replacements_ = false;
+
+    /// Encode the indices of a string vector
+    arrow::Result<std::shared_ptr<arrow::Array>> EncodeIndices(Dictionary& dictionary, duckdb::Vector& vector,
+                                                               size_t count);
+
+   public:
+    /// Constructor
+    ArrowDictionaryEncoder(std::vector<std::unique_ptr<Dictionary>> dictionaries, std::shared_ptr<arrow::Schema> schema)
+        : dictionaries_(std::move(dictionaries)), schema_(std::move(schema)) {}
+
+    /// Create an encoder for DuckDB types and the patched Arrow schema, returns nullptr without string columns
+    static std::unique_ptr<ArrowDictionaryEncoder> Create(const duckdb::vector<duckdb::LogicalType>& types,
+                                                          const arrow::Schema& schema);
+    /// Get the schema with dictionary fields
+    auto& GetSchema() const { return schema_; }
+    /// Fix the schema once it is written, IPC files do not allow dictionary replacements
+    void FixSchema(bool allow_replacements) {
+        schema_fixed_ = true;
+        allow_replacements_ = allow_replacements;
+    }
+    /// Replace the string columns of a record batch that was exported from a data chunk
+    arrow::Result<std::shared_ptr<arrow::RecordBatch>> Encode(duckdb::DataChunk& chunk,
+                                                              const std::shared_ptr<arrow::RecordBatch>& batch);
+};
+
+/// Writes record batches as IPC stream messages without the schema.
+///
+/// Each write returns the messages of a single record batch, preceded by the dictionary batches and deltas that the
+/// batch needs. Concatenated after the serialized schema, the buffers form a valid IPC stream.
+class ArrowIPCMessageWriter {
+   protected:
+    /// The buffered output
+    std::shared_ptr<arrow::io::BufferOutputStream> out_;
+    /// The record batch writer
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer_;
+
+   public:
+    /// Constructor
+    ArrowIPCMessageWriter(std::shared_ptr<arrow::io::BufferOutputStream> out,
+                          std::shared_ptr<arrow::ipc::RecordBatchWriter> writer)
+        : out_(std::move(out)), writer_(std::move(writer)) {}
+
+    /// Create a writer for a schema
+    static arrow::Result<std::unique_ptr<ArrowIPCMessageWriter>> Create(const std::shared_ptr<arrow::Schema>& schema,
+                                                                        const arrow::ipc::IpcWriteOptions& options);
+    /// Write a record batch and return its messages
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Write(const arrow::RecordBatch& batch);
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef INCLUDE_DUCKDB_WEB_ARROW_EXPORT_CONTEXT_H_
+#define INCLUDE_DUCKDB_WEB_ARROW_EXPORT_CONTEXT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/ipc/options.h"
+#include "arrow/record_batch.h"
+#include "arrow/result.h"
+#include "arrow/type.h"
+#include "duckdb/common/arrow/arrow_converter.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_properties.hpp"
+#include "duckdb/main/query_result.hpp"
+#include "duckdb/web/arrow_casts.h"
+#include "duckdb/web/arrow_dictionary_encoder.h"
+#include "duckdb/web/arrow_ipc_encoder.h"
+#include "duckdb/web/config.h"
+
+namespace duckdb {
+namespace web {
+
+/// The export state of a query result.
+///
+/// Everything the chunks of a result share is set up once: the client properties and extension casts of the Arrow
+/// converter, the imported and patched schemas with their cast plan, the IPC write options and the encoders. The
+/// chunks are then exported without any per-chunk setup.
+class ArrowExportContext {
+   public:
+    /// The extension type casts of the Arrow converter
+    using ExtensionTypeCasts =
+        duckdb::unordered_map<duckdb::idx_t, const duckdb::shared_ptr<duckdb::ArrowTypeExtensionData>>;
+
+   protected:
+    /// The client properties
+    duckdb::ClientProperties options_;
+    /// The extension type casts
+    ExtensionTypeCasts extension_type_cast_;
+    /// The imported schema
+    std::shared_ptr<arrow::Schema> schema_ = nullptr;
+    /// The casts to the patched schema
+    RecordBatchCasts casts_ = {};
+    /// The IPC write options
+    arrow::ipc::IpcWriteOptions ipc_options_ = arrow::ipc::IpcWriteOptions::Defaults();
+    /// The direct IPC encoder (if supported)
+    std::unique_ptr<ArrowIPCEncoder> encoder_ = nullptr;
+    /// The dictionary encoder (if enabled)
+    std::unique_ptr<ArrowDictionaryEncoder> dictionary_encoder_ = nullptr;
+    /// The IPC message writer of dictionary-encoded streams
+    std::unique_ptr<ArrowIPCMessageWriter> message_writer_ = nullptr;
+
+   public:
+    /// Constructor
+    ArrowExportContext(duckdb::ClientProperties options, ExtensionTypeCasts extension_type_cast)
+        : options_(std::move(options)), extension_type_cast_(std::move(extension_type_cast)) {}
+
+    /// Create the export context of a query result
+    static arrow::Result<std::unique_ptr<ArrowExportContext>> Create(duckdb::ClientContext& context,
+                                                                     const duckdb::vector<duckdb::LogicalType>& types,
+                                                                     const duckdb::vector<std::string>& names,
+                                                                     const WebDBConfig& config);
+
+    /// Get the schema of the written record batches
+    const std::shared_ptr<arrow::Schema>& GetSchema() const {
+        return dictionary_encoder_ ? dictionary_encoder_->GetSchema() : casts_.schema;
+    }
+    /// Get the IPC write options
+    auto& GetIPCOptions() const { return ipc_options_; }
+    /// Fix the schema once it is written, IPC files do not allow dictionary replacements
+    void FixSchema(bool allow_replacements) {
+        if (dictionary_encoder_) dictionary_encoder_->FixSchema(allow_replacements);
+    }
+
+    /// Export a data chunk as record batch with the generic export
+    arrow::Result<std::shared_ptr<arrow::RecordBatch>> ExportChunk(duckdb::DataChunk& chunk);
+
+    /// Serialize the schema of a streamed result
+    arrow::Result<std::shared_ptr<arrow::Buffer>> SerializeSchema();
+    /// Encode chunks of a streamed result as a single record batch message
+    arrow::Result<std::shared_ptr<arrow::Buffer>> EncodeChunks(std::vector<duckdb::unique_ptr<duckdb::DataChunk>>& chunks);
+    /// Write all chunks of a materialized result as IPC file
+    arrow::Result<std::shared_ptr<arrow::Buffer>> WriteFile(duckdb::QueryResult& result);
+    /// Write all chunks of materialized results with the same types as a single IPC file
+    arrow::Result<std::shared_ptr<arrow::Buffer>> WriteFile(const std::vector<duckdb::QueryResult*>& results);
+};
+
+/// Reads the chunks of a query result as record batches.
+///
+/// The chunks are exported without IPC serialization, the batches reference buffers of the Arrow converter that stay
+/// alive until the last reference is released. Exported through the C stream interface, in-process consumers read
+/// the result without copying it.
+class ArrowQueryResultReader : public arrow::RecordBatchReader {
+   protected:
+    /// The query result
+    duckdb::unique_ptr<duckdb::QueryResult> result_;
+    /// The export context
+    std::unique_ptr<ArrowExportContext> export_context_;
+
+   public:
+    /// Constructor
+    ArrowQueryResultReader(duckdb::unique_ptr<duckdb::QueryResult> result,
+                           std::unique_ptr<ArrowExportContext> export_context)
+        : result_(std::move(result)), export_context_(std::move(export_context)) {
+        export_context_->FixSchema(true);
+    }
+
+    /// Get the schema
+    std::shared_ptr<arrow::Schema> schema() const override { return export_context_->GetSchema(); }
+    /// Read the next record batch in the stream. Return null for batch when reaching end of stream
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
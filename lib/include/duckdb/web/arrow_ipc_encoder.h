@@ -0,0 +1,77 @@
+#ifndef INCLUDE_DUCKDB_WEB_ARROW_IPC_ENCODER_H_
+#define INCLUDE_DUCKDB_WEB_ARROW_IPC_ENCODER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/result.h"
+#include "arrow/type.h"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/web/arrow_ipc_message.h"
+
+namespace duckdb {
+namespace web {
+
+/// Encodes DuckDB data chunks directly as Arrow IPC record batch messages.
+///
+/// The generic export converts a chunk with the Arrow C data interface, imports it as record batch, patches the
+/// configured casts and serializes it. The encoder writes the vectors straight into the message buffer instead and
+/// applies the casts on the way, flat vectors use the cast kernels. It only supports flat columns, other results use the generic export.
+class ArrowIPCEncoder {
+   public:
+    /// The encoding of a column
+    enum class ColumnEncoding : uint8_t {
+        /// Bit-pack booleans
+        BOOLEAN,
+        /// Copy fixed-width values
+        FIXED_WIDTH,
+        /// Cast BIGINT values to double
+        BIGINT_TO_DOUBLE,
+        /// Cast UBIGINT values to double
+        UBIGINT_TO_DOUBLE,
+        /// Cast timestamps to milliseconds
+        TIMESTAMP_TO_DATE64,
+        /// Cast decimals to double
+        DECIMAL_TO_DOUBLE,
+        /// Write offsets and string data
+        STRING,
+    };
+
+   protected:
+    /// A column
+    struct Column {
+        /// The encoding
+        ColumnEncoding encoding;
+        /// The width of the values
+        size_t width = 0;
+        /// The factor that converts timestamps to milliseconds
+        int64_t multiplier = 1;
+        /// The divisor that converts timestamps to milliseconds
+        int64_t divisor = 1;
+        /// The width of the DuckDB decimal values
+        size_t decimal_width = 0;
+        /// The scale of decimals
+        int32_t scale = 0;
+    };
+    /// The columns
+    std::vector<Column> columns_;
+
+   public:
+    /// Constructor
+    explicit ArrowIPCEncoder(std::vector<Column> columns) : columns_(std::move(columns)) {}
+
+    /// Create an encoder for DuckDB types and the patched Arrow schema, returns nullptr if not supported
+    static std::unique_ptr<ArrowIPCEncoder> Create(const duckdb::vector<duckdb::LogicalType>& types,
+                                                   const arrow::Schema& schema);
+    /// Encode a data chunk
+    arrow::Result<ArrowIPCRecordBatchMessage> Encode(duckdb::DataChunk& chunk) const;
+    /// Encode data chunks as a single record batch
+    arrow::Result<ArrowIPCRecordBatchMessage> Encode(const std::vector<duckdb::DataChunk*>& chunks) const;
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
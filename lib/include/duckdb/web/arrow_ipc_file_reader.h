@@ -0,0 +1,72 @@
+#ifndef INCLUDE_DUCKDB_WEB_ARROW_IPC_FILE_READER_H_
+#define INCLUDE_DUCKDB_WEB_ARROW_IPC_FILE_READER_H_
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "arrow/ipc/reader.h"
+#include "arrow/record_batch.h"
+#include "arrow/result.h"
+#include "arrow/status.h"
+#include "arrow/type_fwd.h"
+#include "duckdb/common/arrow/arrow.hpp"
+#include "duckdb/common/arrow/arrow_wrapper.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/web/io/file_page_buffer.h"
+
+namespace duckdb {
+struct ArrowStreamParameters;
+
+namespace web {
+
+/// Reads the record batches of an Arrow IPC file in partitions of at most PARTITION_ROWS rows.
+/// The batches are decoded in windows of one batch per decode thread, positioned reads on the file are thread-safe.
+class ArrowIPCFileReader : public arrow::RecordBatchReader {
+   protected:
+    /// The file reader, shared by all clones
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> file_;
+    /// The number of batches that are decoded at once
+    int decode_threads_;
+    /// The index of the next batch to decode
+    int next_batch_id_;
+    /// The decoded batches
+    std::vector<std::shared_ptr<arrow::RecordBatch>> window_;
+    /// The current batch in the window
+    size_t window_pos_;
+    /// The first row of the next partition in the current batch
+    int64_t next_batch_offset_;
+
+    /// Decode the next window of batches
+    arrow::Status DecodeWindow();
+
+   public:
+    /// Constructor
+    ArrowIPCFileReader(std::shared_ptr<arrow::ipc::RecordBatchFileReader> file, int decode_threads);
+    /// Destructor
+    ~ArrowIPCFileReader() = default;
+
+    /// Open an ipc file of the file page buffer
+    static arrow::Result<std::shared_ptr<ArrowIPCFileReader>> Open(std::shared_ptr<io::FilePageBuffer> file_page_buffer,
+                                                                   std::string_view path, int decode_threads = 1);
+    /// Create a reader that starts at the first batch again
+    std::shared_ptr<ArrowIPCFileReader> CloneShared() const;
+
+    /// Get the number of record batches in the file
+    int num_record_batches() const { return file_->num_record_batches(); }
+    /// Get the schema
+    std::shared_ptr<arrow::Schema> schema() const override;
+    /// Read the next record batch in the file. Return null for batch when reaching end of file
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+
+    /// Create arrow array stream wrapper
+    static duckdb::unique_ptr<duckdb::ArrowArrayStreamWrapper> CreateStream(uintptr_t reader_ptr,
+                                                                            duckdb::ArrowStreamParameters& parameters);
+    /// Create arrow array stream wrapper
+    static void GetSchema(uintptr_t reader_ptr, duckdb::ArrowSchemaWrapper& schema);
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif  // INCLUDE_DUCKDB_WEB_ARROW_IPC_FILE_READER_H_
@@ -0,0 +1,83 @@
+#ifndef INCLUDE_DUCKDB_WEB_ARROW_IPC_MESSAGE_H_
+#define INCLUDE_DUCKDB_WEB_ARROW_IPC_MESSAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/result.h"
+#include "arrow/status.h"
+
+namespace duckdb {
+namespace web {
+
+/// An Arrow IPC record batch message that is written into a single allocation.
+///
+/// The caller first declares the field nodes and the body buffers, then allocates the message and fills the buffers
+/// in place. The flatbuffer metadata is written directly, the result is a complete encapsulated message as produced by
+/// arrow::ipc::SerializeRecordBatch.
+class ArrowIPCRecordBatchMessage {
+   public:
+    /// The alignment of the body buffers
+    static constexpr int64_t BUFFER_ALIGNMENT = 8;
+
+   protected:
+    /// A field node
+    struct FieldNode {
+        /// The number of values
+        int64_t length;
+        /// The number of nulls
+        int64_t null_count;
+    };
+    /// A body buffer
+    struct BodyBuffer {
+        /// The offset in the body
+        int64_t offset;
+        /// The length
+        int64_t length;
+    };
+
+    /// The number of rows
+    int64_t num_rows_ = 0;
+    /// The field nodes
+    std::vector<FieldNode> nodes_ = {};
+    /// The body buffers
+    std::vector<BodyBuffer> buffers_ = {};
+    /// The padded length of the body
+    int64_t body_length_ = 0;
+    /// The padded length of the flatbuffer metadata
+    int64_t metadata_length_ = 0;
+    /// The encapsulated message
+    std::shared_ptr<arrow::Buffer> message_ = nullptr;
+
+    /// Write the flatbuffer metadata
+    void WriteMetadata(uint8_t* out) const;
+
+   public:
+    /// Constructor
+    explicit ArrowIPCRecordBatchMessage(int64_t num_rows) : num_rows_(num_rows) {}
+
+    /// Add a field node
+    void AddFieldNode(int64_t length, int64_t null_count) { nodes_.push_back({length, null_count}); }
+    /// Add a body buffer and return its index
+    size_t AddBuffer(int64_t length);
+    /// Allocate the message once all field nodes and buffers were added
+    arrow::Status Allocate(arrow::MemoryPool* pool = arrow::default_memory_pool());
+    /// Get the data of an allocated body buffer
+    uint8_t* GetBuffer(size_t index) const {
+        return message_->mutable_data() + 8 + metadata_length_ + buffers_[index].offset;
+    }
+
+    /// Get the encapsulated message
+    auto& GetMessage() const { return message_; }
+    /// Get the message as payload for an IPC payload writer
+    arrow::ipc::IpcPayload GetPayload() const;
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
@@ -46,14 +46,24 @@ struct ArrowIPCStreamBuffer : public arrow::ipc::Listener {
     auto& schema() const { return schema_; }
     /// Return the batches
     auto& batches() const { return batches_; }
+    /// Drop the batches that were consumed
+    void ClearBatches() { batches_.clear(); }
 };
 
+/// Reads the buffered batches in partitions of at most PARTITION_ROWS rows.
+/// DuckDB's arrow scan hands out one array per thread, large batches are sliced so that the scan can convert and
+/// insert them on multiple threads.
 struct ArrowIPCStreamBufferReader : public arrow::RecordBatchReader {
+    /// The maximum number of rows of a partition, a row group of DuckDB
+    static constexpr int64_t PARTITION_ROWS = 122880;
+
    protected:
     /// The buffer
     std::shared_ptr<ArrowIPCStreamBuffer> buffer_;
     /// The batch index
     size_t next_batch_id_;
+    /// The first row of the next partition in the batch
+    int64_t next_batch_offset_;
 
    public:
     /// Constructor
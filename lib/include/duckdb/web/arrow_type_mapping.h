@@ -16,6 +16,8 @@ arrow::Result<duckdb::LogicalType> mapArrowTypeToDuckDB(const arrow::DataType& t
 arrow::Result<std::shared_ptr<arrow::DataType>> mapDuckDBTypeToArrow(const duckdb::LogicalType& type);
 /// Convert an arrow array to a DuckDB vector
 arrow::Status convertArrowArrayToDuckDBVector(arrow::Array& in, duckdb::Vector& out);
+/// Convert an arrow array to DuckDB values
+arrow::Result<duckdb::vector<duckdb::Value>> convertArrowArrayToDuckDBValues(const arrow::Array& in);
 
 }  // namespace web
 }  // namespace duckdb
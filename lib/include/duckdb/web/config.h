@@ -50,12 +50,34 @@ struct QueryConfig {
     std::optional<bool> cast_duration_to_time64 = std::nullopt;
     /// Cast Decimal to Double
     std::optional<bool> cast_decimal_to_double = std::nullopt;
+    /// The number of rows that a streamed record batch should reach before it is returned
+    std::optional<uint64_t> result_batch_rows = std::nullopt;
+    /// The number of bytes that a streamed record batch should reach before it is returned
+    std::optional<uint64_t> result_batch_bytes = std::nullopt;
+    /// The compression of Arrow IPC result bodies ("none", "lz4" or "zstd").
+    /// Native builds and proxies only, the JavaScript Arrow reader cannot decompress record batches.
+    std::optional<std::string> result_compression = std::nullopt;
+    /// Export VARCHAR columns as dictionaries that persist across record batches
+    std::optional<bool> dictionary_encode_strings = std::nullopt;
+    /// The byte budget of the query result cache (0 disables the cache)
+    std::optional<uint64_t> result_cache_bytes = std::nullopt;
+    /// The number of rows that are returned together with the schema of a streamed result (0 returns the schema only)
+    std::optional<uint64_t> first_batch_rows = std::nullopt;
+    /// The directory of the files that spilled results are written to.
+    /// Native builds default to the temp directory. Spilling fails if the spill file would be a wasm memory buffer.
+    std::optional<std::string> result_spill_directory = std::nullopt;
 
     /// Has any cast?
     bool hasAnyCast() const {
         return cast_bigint_to_double.value_or(false) || cast_timestamp_to_date.value_or(false) ||
                cast_duration_to_time64.value_or(false) || cast_decimal_to_double.value_or(false);
     }
+    /// Coalesce result chunks?
+    bool hasResultBatchTarget() const {
+        return result_batch_rows.value_or(0) > 0 || result_batch_bytes.value_or(0) > 0;
+    }
+    /// Compress result bodies?
+    bool hasResultCompression() const { return result_compression.value_or("none") != "none"; }
     /// Read from a document
     static QueryConfig ReadFrom(std::string_view args_json);
 };
@@ -76,6 +98,11 @@ struct FileSystemConfig {
     /// Force full HTTP reads, suppressing use of range requests
     std::optional<bool> force_full_http_reads = std::nullopt;
     std::optional<bool> reliable_head_requests = std::nullopt;
+    /// The byte budget of the HTTP range cache (default 0 disables the cache).
+    /// Cached responses are revalidated with If-None-Match, which adds a CORS preflight for cross-origin urls.
+    std::optional<uint64_t> http_cache_bytes = std::nullopt;
+    /// The time in milliseconds in which cached HTTP responses are served without revalidation
+    std::optional<uint64_t> http_cache_max_age_ms = std::nullopt;
 };
 
 struct WebDBConfig {
@@ -99,6 +126,8 @@ struct WebDBConfig {
         .allow_full_http_reads = std::nullopt,
         .force_full_http_reads = std::nullopt,
         .reliable_head_requests = std::nullopt,
+        .http_cache_bytes = std::nullopt,
+        .http_cache_max_age_ms = std::nullopt,
     };
 
     /// These options are fetched from DuckDB
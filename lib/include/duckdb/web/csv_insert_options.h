@@ -39,6 +39,10 @@ struct CSVInsertOptions {
     std::optional<std::string> timestampformat = std::nullopt;
     /// Specified columns?
     std::optional<std::vector<std::shared_ptr<arrow::Field>>> columns = std::nullopt;
+    /// Specified range size for prefetching remote files?
+    std::optional<size_t> prefetch_range_size = std::nullopt;
+    /// Specified number of concurrent range requests for remote files? 0 disables prefetching.
+    std::optional<size_t> prefetch_concurrency = std::nullopt;
 
     /// Read from input stream
     arrow::Status ReadFrom(const rapidjson::Document& doc);
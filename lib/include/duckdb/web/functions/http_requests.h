@@ -0,0 +1,17 @@
+#ifndef INCLUDE_DUCKDB_WEB_FUNCTIONS_HTTP_REQUESTS_H_
+#define INCLUDE_DUCKDB_WEB_FUNCTIONS_HTTP_REQUESTS_H_
+
+#include "duckdb/main/database.hpp"
+
+namespace duckdb {
+namespace web {
+
+/// Register the table function http_requests([reset := false]) that lists the traced HTTP requests.
+/// With reset := true the traces are dropped after reading them which scopes the traces to a query.
+/// Also registers http_hedging() that returns the counters of hedged range requests.
+void RegisterHTTPRequestsFunction(DatabaseInstance &db);
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
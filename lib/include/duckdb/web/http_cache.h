@@ -0,0 +1,158 @@
+#ifndef INCLUDE_DUCKDB_WEB_HTTP_CACHE_H_
+#define INCLUDE_DUCKDB_WEB_HTTP_CACHE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "duckdb/web/http_transport.h"
+
+namespace duckdb {
+namespace web {
+
+/// The settings of the HTTP range cache
+struct HTTPCacheConfig {
+    /// The byte budget of cached responses (0 disables the cache).
+    /// The cache is opt-in since conditional requests add CORS preflights for cross-origin urls.
+    uint64_t max_bytes = 0;
+    /// The time in which cached responses are served without revalidation.
+    /// A longer lifetime announced by the server with "Cache-Control: max-age" takes precedence.
+    std::chrono::milliseconds max_age = std::chrono::milliseconds{0};
+};
+
+/// The statistics of the HTTP range cache
+struct HTTPCacheStatistics {
+    /// The number of responses that were served from the cache without a request
+    std::atomic<uint64_t> hits = 0;
+    /// The number of responses that were served from the cache after a 304 Not Modified
+    std::atomic<uint64_t> revalidations = 0;
+    /// The number of requests that were not cached
+    std::atomic<uint64_t> misses = 0;
+    /// The number of evicted responses
+    std::atomic<uint64_t> evictions = 0;
+};
+
+/// An LRU cache of HTTP responses keyed by (url, etag, range).
+///
+/// Only responses with an ETag are cached since they can be revalidated with If-None-Match.
+/// A response with a different ETag for the same url drops all responses of the old version.
+class HTTPRangeCache {
+   public:
+    /// A cached response
+    struct CachedResponse {
+        /// The response
+        HTTPTransportResponse response;
+        /// The entity tag of the object
+        std::string etag;
+        /// The response can be served without revalidation?
+        bool fresh;
+    };
+
+   protected:
+    /// A cache entry
+    struct Entry {
+        /// The key
+        std::string key;
+        /// The url
+        std::string url;
+        /// The response
+        HTTPTransportResponse response;
+        /// The accounted bytes
+        size_t bytes;
+    };
+    /// The version of a remote object that is cached
+    struct Object {
+        /// The entity tag
+        std::string etag;
+        /// Cached responses are fresh until
+        std::chrono::steady_clock::time_point fresh_until;
+        /// The number of cached responses
+        size_t entry_count = 0;
+    };
+
+    /// The mutex
+    mutable std::mutex mutex_ = {};
+    /// The config
+    HTTPCacheConfig config_ = {};
+    /// The entries in LRU order, most recently used first
+    std::list<Entry> lru_ = {};
+    /// The entries by key
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries_ = {};
+    /// The cached objects by url
+    std::unordered_map<std::string, Object> objects_ = {};
+    /// The accounted bytes
+    size_t bytes_ = 0;
+    /// The statistics
+    HTTPCacheStatistics stats_ = {};
+
+    /// Build an entry key
+    static std::string BuildKey(std::string_view url, std::string_view etag, std::string_view range);
+    /// Erase an entry
+    void Erase(std::list<Entry>::iterator entry);
+    /// Erase all entries of a url
+    void EraseObject(const std::string& url);
+    /// Evict entries until the cache fits its budget
+    void Evict();
+
+   public:
+    /// Get the config
+    HTTPCacheConfig GetConfig() const;
+    /// Update the config
+    void Configure(HTTPCacheConfig config);
+    /// Get the statistics
+    auto& GetStatistics() { return stats_; }
+    /// Get the accounted bytes
+    size_t GetSize() const;
+    /// Get the number of cached responses
+    size_t GetEntryCount() const;
+
+    /// Find a cached response
+    std::optional<CachedResponse> Find(const std::string& url, std::string_view range);
+    /// Insert a response
+    void Insert(const std::string& url, std::string_view range, const HTTPTransportResponse& response,
+                std::chrono::milliseconds freshness);
+    /// Mark the cached responses of a url as fresh after a 304 Not Modified
+    void Revalidate(const std::string& url, std::chrono::milliseconds freshness);
+    /// Drop all cached responses of a url
+    void Invalidate(const std::string& url);
+    /// Drop all cached responses
+    void Clear();
+};
+
+/// A transport that serves GET and HEAD requests from a range cache and forwards everything else.
+/// Requests with credentials bypass the cache since the cache key does not distinguish between callers.
+class CachingHTTPTransport : public HTTPTransport {
+   protected:
+    /// The transport
+    std::shared_ptr<HTTPTransport> inner_;
+    /// The cache
+    std::shared_ptr<HTTPRangeCache> cache_;
+
+    /// Compute the freshness lifetime of a response
+    std::chrono::milliseconds ComputeFreshness(const HTTPTransportResponse& response) const;
+
+   public:
+    /// Constructor
+    CachingHTTPTransport(std::shared_ptr<HTTPTransport> inner, std::shared_ptr<HTTPRangeCache> cache)
+        : inner_(std::move(inner)), cache_(std::move(cache)) {}
+
+    /// Get the wrapped transport
+    auto& GetInner() const { return inner_; }
+    /// Get the name of the transport
+    std::string_view GetName() const override { return inner_->GetName(); }
+    /// Send a request
+    HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                               const std::atomic<bool>* cancelled = nullptr) override;
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef INCLUDE_DUCKDB_WEB_HTTP_HEDGING_H_
+#define INCLUDE_DUCKDB_WEB_HTTP_HEDGING_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace duckdb {
+namespace web {
+
+/// The hedging settings of a request
+struct HTTPHedgingConfig {
+    /// Hedge slow range requests?
+    bool enabled = false;
+    /// The latency percentile that is used as hedging deadline
+    double percentile = 0.95;
+    /// The minimum hedging deadline in milliseconds
+    uint64_t min_delay_ms = 10;
+    /// The hedging deadline in milliseconds as long as there are too few latency samples
+    uint64_t default_delay_ms = 1000;
+};
+
+/// A tracker for recent request latencies
+class HTTPLatencyTracker {
+   public:
+    /// The number of latencies that we remember
+    static constexpr size_t CAPACITY = 256;
+    /// The number of latencies that we need before computing percentiles
+    static constexpr size_t MIN_SAMPLES = 16;
+
+   protected:
+    /// The mutex
+    mutable std::mutex mutex_ = {};
+    /// The latencies in microseconds (ring buffer)
+    std::array<uint64_t, CAPACITY> samples_ = {};
+    /// The number of recorded latencies
+    size_t sample_count_ = 0;
+
+   public:
+    /// Record a latency
+    void Record(std::chrono::microseconds latency);
+    /// Get the number of latencies that are currently remembered
+    size_t GetSampleCount() const;
+    /// Compute a latency percentile (if there are enough samples)
+    std::optional<std::chrono::microseconds> ComputePercentile(double percentile) const;
+};
+
+/// The hedging statistics
+struct HTTPHedgingStatistics {
+    /// The number of requests that were eligible for hedging
+    std::atomic<uint64_t> requests = 0;
+    /// The number of hedges that were issued
+    std::atomic<uint64_t> hedges_issued = 0;
+    /// The number of hedges that responded before the original request
+    std::atomic<uint64_t> hedges_won = 0;
+    /// The number of requests that were cancelled because another one won
+    std::atomic<uint64_t> requests_cancelled = 0;
+    /// The number of requests that were not hedged because all hedge workers were busy
+    std::atomic<uint64_t> hedges_skipped = 0;
+};
+
+/// A small pool of threads that run the hedges of requests.
+/// The threads are started lazily and kept alive, a task is rejected if no thread is idle.
+class HTTPHedgeWorkers {
+   public:
+    /// The default number of threads
+    static constexpr size_t DEFAULT_MAX_WORKERS = 4;
+
+   protected:
+    /// The maximum number of threads
+    const size_t max_workers_;
+    /// The mutex
+    mutable std::mutex mutex_ = {};
+    /// The condition variable that signals new tasks
+    std::condition_variable task_cv_ = {};
+    /// The threads
+    std::vector<std::thread> threads_ = {};
+    /// The pending tasks
+    std::deque<std::function<void()>> tasks_ = {};
+    /// The number of idle threads
+    size_t idle_ = 0;
+    /// Stop the threads?
+    bool stopped_ = false;
+
+    /// Run tasks until stopped
+    void Work();
+
+   public:
+    /// Constructor
+    HTTPHedgeWorkers(size_t max_workers = DEFAULT_MAX_WORKERS);
+    /// Destructor
+    ~HTTPHedgeWorkers();
+
+    /// Get the number of started threads
+    size_t GetThreadCount() const;
+    /// Run a task on an idle thread, returns false if all threads are busy
+    bool TrySubmit(std::function<void()> task);
+};
+
+/// Issues a duplicate of a request if the original one does not respond within a deadline.
+///
+/// The deadline is a latency percentile of recently observed requests.
+/// The original request and the hedge run on a few hedge workers while the calling thread waits for the first response.
+/// The loser is asked to cancel through its cancellation flag. A loser that cannot abort (e.g. a synchronous
+/// XMLHttpRequest) keeps its worker until it finishes and is discarded, the caller does not wait for it.
+/// If all workers are busy the request runs unhedged on the calling thread, which also bounds the number of losers
+/// that are still running.
+class HTTPHedging {
+   protected:
+    /// The latencies
+    HTTPLatencyTracker latencies_ = {};
+    /// The statistics
+    HTTPHedgingStatistics stats_ = {};
+
+    /// The state that is shared with the attempts
+    template <typename T>
+    struct SharedState {
+        /// The mutex
+        std::mutex mutex;
+        /// The condition variable that is notified when a request finishes
+        std::condition_variable finished_cv;
+        /// The original request finished?
+        bool original_done = false;
+        /// The hedge was launched?
+        bool hedge_launched = false;
+        /// The number of finished requests
+        size_t finished = 0;
+        /// The winning result (if any)
+        std::optional<T> result = std::nullopt;
+        /// The winning attempt
+        size_t winner = 0;
+        /// The latency of the winning attempt
+        std::chrono::microseconds winner_latency = {};
+        /// The errors of the attempts
+        std::array<std::exception_ptr, 2> errors = {};
+        /// The cancellation flags of the attempts
+        std::array<std::atomic<bool>, 2> cancelled = {};
+    };
+
+   public:
+    /// The request signature.
+    /// The request must not reference state of the caller since a cancelled hedge may outlive the hedged call.
+    template <typename T>
+    using Request = std::function<T(const std::atomic<bool>& cancelled)>;
+
+   protected:
+    /// Run an attempt and publish its result
+    template <typename T>
+    static void RunAttempt(SharedState<T>& state, Request<T>& request, size_t attempt) {
+        auto start = std::chrono::steady_clock::now();
+        std::optional<T> result;
+        std::exception_ptr error = nullptr;
+        try {
+            result.emplace(request(state.cancelled[attempt]));
+        } catch (...) {
+            error = std::current_exception();
+        }
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        std::unique_lock<std::mutex> guard{state.mutex};
+        if (result.has_value() && !state.result.has_value() && !state.cancelled[attempt]) {
+            state.result = std::move(result);
+            state.winner = attempt;
+            state.winner_latency = latency;
+            state.cancelled[1 - attempt] = true;
+        }
+        state.errors[attempt] = error;
+        state.original_done |= attempt == 0;
+        ++state.finished;
+        state.finished_cv.notify_all();
+    }
+
+    /// The hedge workers, destroyed first since their tasks use the statistics
+    HTTPHedgeWorkers workers_;
+
+   public:
+    /// Constructor
+    HTTPHedging(size_t max_workers = HTTPHedgeWorkers::DEFAULT_MAX_WORKERS) : workers_(max_workers) {}
+
+    /// Get the latencies
+    auto& GetLatencies() { return latencies_; }
+    /// Get the statistics
+    auto& GetStatistics() { return stats_; }
+    /// Get the hedge workers
+    auto& GetWorkers() { return workers_; }
+    /// Compute the current hedging deadline
+    std::chrono::microseconds ComputeDeadline(const HTTPHedgingConfig& config) const;
+
+    /// Run a request without hedging
+    template <typename T>
+    T RunUnhedged(Request<T>& request) {
+        static const std::atomic<bool> NEVER_CANCELLED{false};
+        auto start = std::chrono::steady_clock::now();
+        T result = request(NEVER_CANCELLED);
+        auto latency = std::chrono::steady_clock::now() - start;
+        latencies_.Record(std::chrono::duration_cast<std::chrono::microseconds>(latency));
+        return result;
+    }
+
+    /// Run a request with hedging
+    template <typename T>
+    T Run(const HTTPHedgingConfig& config, Request<T> request) {
+#ifndef WEBDB_THREADS
+        return RunUnhedged(request);
+#else
+        if (!config.enabled) return RunUnhedged(request);
+        stats_.requests.fetch_add(1, std::memory_order_relaxed);
+        auto deadline = ComputeDeadline(config);
+        auto state = std::make_shared<SharedState<T>>();
+
+        // Run the original request on a worker.
+        // The shared state keeps everything alive that a late loser still touches.
+        if (!workers_.TrySubmit([state, request]() mutable { RunAttempt(*state, request, 0); })) {
+            stats_.hedges_skipped.fetch_add(1, std::memory_order_relaxed);
+            return RunUnhedged(request);
+        }
+
+        // Send the hedge if the original request did not finish before the deadline
+        std::unique_lock<std::mutex> guard{state->mutex};
+        if (!state->finished_cv.wait_for(guard, deadline, [&]() { return state->original_done; })) {
+            guard.unlock();
+            auto launched = workers_.TrySubmit([state, request]() mutable { RunAttempt(*state, request, 1); });
+            guard.lock();
+            state->hedge_launched = launched;
+            if (launched) {
+                stats_.hedges_issued.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                stats_.hedges_skipped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Wait for the first response, or for all attempts if they fail
+        state->finished_cv.wait(guard, [&]() {
+            return state->result.has_value() || state->finished == (state->hedge_launched ? 2 : 1);
+        });
+
+        // All attempts failed?
+        if (!state->result.has_value()) {
+            std::rethrow_exception(state->errors[0] ? state->errors[0] : state->errors[1]);
+        }
+        if (state->hedge_launched) {
+            // The loser was cancelled unless it failed on its own
+            if (!state->errors[1 - state->winner]) {
+                stats_.requests_cancelled.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (state->winner == 1) {
+                stats_.hedges_won.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        latencies_.Record(state->winner_latency);
+        return std::move(*state->result);
+#endif
+    }
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
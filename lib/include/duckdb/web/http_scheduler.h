@@ -0,0 +1,176 @@
+#ifndef INCLUDE_DUCKDB_WEB_HTTP_SCHEDULER_H_
+#define INCLUDE_DUCKDB_WEB_HTTP_SCHEDULER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "duckdb/web/http_transport.h"
+
+namespace duckdb {
+namespace web {
+
+/// The statistics of the HTTP request scheduler
+struct HTTPSchedulerStatistics {
+    /// The number of requests that were sent without waiting
+    std::atomic<uint64_t> immediate = 0;
+    /// The number of requests that had to wait for a connection
+    std::atomic<uint64_t> queued = 0;
+    /// The number of requests that were cancelled while waiting
+    std::atomic<uint64_t> cancelled = 0;
+};
+
+/// A scheduler that limits the concurrent requests per host.
+///
+/// Browsers allow only a few connections per origin and queue the remaining requests invisibly.
+/// Requests therefore wait here instead where demand reads are served before queued readahead and prefetch
+/// requests. Speculative requests never occupy the last connection of a host so that a demand read
+/// can always start immediately once a demand request finishes.
+class HTTPRequestScheduler {
+   public:
+    /// The default limit of concurrent requests per host
+    static constexpr size_t DEFAULT_MAX_CONNECTIONS_PER_HOST = 6;
+    /// The interval in which waiting requests check for cancellation
+    static constexpr std::chrono::milliseconds CANCELLATION_POLL_INTERVAL = std::chrono::milliseconds{10};
+
+    /// A granted connection that is released on destruction
+    class Slot {
+        friend class HTTPRequestScheduler;
+
+       protected:
+        /// The scheduler
+        HTTPRequestScheduler* scheduler_ = nullptr;
+        /// The host
+        std::string host_ = {};
+        /// The priority
+        HTTPRequestPriority priority_ = HTTPRequestPriority::DEMAND;
+
+        /// Constructor
+        Slot(HTTPRequestScheduler& scheduler, std::string host, HTTPRequestPriority priority)
+            : scheduler_(&scheduler), host_(std::move(host)), priority_(priority) {}
+
+       public:
+        /// Move constructor
+        Slot(Slot&& other) : scheduler_(other.scheduler_), host_(std::move(other.host_)), priority_(other.priority_) {
+            other.scheduler_ = nullptr;
+        }
+        /// Destructor
+        ~Slot() {
+            if (scheduler_) scheduler_->Release(host_, priority_);
+        }
+        Slot(const Slot& other) = delete;
+        Slot& operator=(const Slot& other) = delete;
+        Slot& operator=(Slot&& other) = delete;
+    };
+
+   protected:
+    /// The number of priorities
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    /// A waiting request
+    struct Waiter {
+        /// The priority
+        HTTPRequestPriority priority;
+        /// Was the connection granted?
+        bool granted = false;
+    };
+    /// The connections of a host
+    struct Host {
+        /// The active requests
+        size_t active = 0;
+        /// The active readahead and prefetch requests
+        size_t active_speculative = 0;
+        /// The waiting requests by priority
+        std::array<std::deque<Waiter*>, PRIORITY_COUNT> queues = {};
+    };
+
+    /// The mutex
+    std::mutex mutex_ = {};
+    /// The condition variable that signals granted connections
+    std::condition_variable granted_ = {};
+    /// The limit of concurrent requests per host (0 disables the limit)
+    size_t max_connections_ = DEFAULT_MAX_CONNECTIONS_PER_HOST;
+    /// The hosts
+    std::unordered_map<std::string, Host> hosts_ = {};
+    /// The statistics
+    HTTPSchedulerStatistics stats_ = {};
+
+    /// Can a request start without considering the queued requests?
+    bool HasCapacity(const Host& host, HTTPRequestPriority priority) const;
+    /// Grant connections to queued requests
+    void Dispatch(Host& host);
+    /// Release a connection
+    void Release(const std::string& host, HTTPRequestPriority priority);
+
+   public:
+    /// Get the host of a url
+    static std::string_view GetHost(std::string_view url);
+
+    /// Get the limit of concurrent requests per host
+    size_t GetMaxConnectionsPerHost();
+    /// Set the limit of concurrent requests per host (0 disables the limit)
+    void SetMaxConnectionsPerHost(size_t limit);
+    /// Get the statistics
+    auto& GetStatistics() { return stats_; }
+    /// Get the number of active requests of a host
+    size_t GetActiveCount(std::string_view url);
+    /// Get the number of waiting requests of a host
+    size_t GetQueuedCount(std::string_view url);
+
+    /// Wait for a connection to the host of a url.
+    /// Returns nullopt if the request was cancelled while waiting.
+    std::optional<Slot> Acquire(std::string_view url, HTTPRequestPriority priority,
+                                const std::atomic<bool>* cancelled = nullptr);
+};
+
+/// A transport that sends requests once the scheduler grants a connection
+class SchedulingHTTPTransport : public HTTPTransport {
+   protected:
+    /// The transport
+    std::shared_ptr<HTTPTransport> inner_;
+    /// The scheduler
+    std::shared_ptr<HTTPRequestScheduler> scheduler_;
+
+   public:
+    /// Constructor
+    SchedulingHTTPTransport(std::shared_ptr<HTTPTransport> inner, std::shared_ptr<HTTPRequestScheduler> scheduler)
+        : inner_(std::move(inner)), scheduler_(std::move(scheduler)) {}
+
+    /// Get the wrapped transport
+    auto& GetInner() const { return inner_; }
+    /// Get the name of the transport
+    std::string_view GetName() const override { return inner_->GetName(); }
+    /// Send a request
+    HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                               const std::atomic<bool>* cancelled = nullptr) override;
+};
+
+/// Sets the priority of the requests that the current thread sends through the web filesystem
+class HTTPRequestPriorityScope {
+   protected:
+    /// The previous priority
+    HTTPRequestPriority previous_;
+
+   public:
+    /// Constructor
+    HTTPRequestPriorityScope(HTTPRequestPriority priority);
+    /// Destructor
+    ~HTTPRequestPriorityScope();
+
+    /// Get the priority of the current thread
+    static HTTPRequestPriority Get();
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
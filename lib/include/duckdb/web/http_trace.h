@@ -0,0 +1,111 @@
+#ifndef INCLUDE_DUCKDB_WEB_HTTP_TRACE_H_
+#define INCLUDE_DUCKDB_WEB_HTTP_TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "duckdb/web/http_transport.h"
+
+namespace duckdb {
+namespace web {
+
+/// The trace of a single HTTP request
+struct HTTPRequestTrace {
+    /// The sequence number of the request
+    uint64_t id = 0;
+    /// The method
+    std::string method;
+    /// The url
+    std::string url;
+    /// The requested range (if any)
+    std::string range;
+    /// The status code (0 for network failures)
+    uint16_t status = 0;
+    /// The number of received body bytes
+    uint64_t bytes = 0;
+    /// The start time in microseconds since the tracer was created
+    uint64_t start_us = 0;
+    /// The duration in microseconds
+    uint64_t duration_us = 0;
+    /// The number of failed attempts of the same request that directly preceded this one
+    uint32_t retries = 0;
+    /// The request was cancelled (e.g. a hedged request that lost)
+    bool cancelled = false;
+};
+
+/// A bounded ring buffer of HTTP request traces
+class HTTPRequestTracer {
+   public:
+    /// The default number of retained traces
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+   protected:
+    /// The mutex
+    mutable std::mutex mutex_ = {};
+    /// The epoch of the start times
+    const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+    /// The number of retained traces (0 disables tracing)
+    size_t capacity_ = DEFAULT_CAPACITY;
+    /// The traces
+    std::vector<HTTPRequestTrace> traces_ = {};
+    /// The slot of the next trace once the ring is full
+    size_t next_slot_ = 0;
+    /// The next sequence number
+    uint64_t next_id_ = 0;
+    /// The failed attempts of requests that did not succeed yet
+    std::unordered_map<std::string, uint32_t> failed_attempts_ = {};
+
+   public:
+    /// Get the capacity
+    size_t GetCapacity() const;
+    /// Set the capacity, drops all traces
+    void SetCapacity(size_t capacity);
+    /// Get the time since the epoch
+    std::chrono::microseconds Now() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch_);
+    }
+
+    /// Record a request
+    void Record(const HTTPTransportRequest& request, const HTTPTransportResponse& response,
+                std::chrono::microseconds start, std::chrono::microseconds duration, bool cancelled);
+    /// Record a request that was sent outside of a transport.
+    /// The sequence number and the retries are assigned by the tracer.
+    void Record(HTTPRequestTrace trace);
+    /// Get the retained traces, oldest first
+    std::vector<HTTPRequestTrace> Collect(bool reset = false);
+    /// Drop all traces
+    void Reset();
+};
+
+/// A transport that records every request in a tracer
+class TracingHTTPTransport : public HTTPTransport {
+   protected:
+    /// The transport
+    std::shared_ptr<HTTPTransport> inner_;
+    /// The tracer
+    std::shared_ptr<HTTPRequestTracer> tracer_;
+
+   public:
+    /// Constructor
+    TracingHTTPTransport(std::shared_ptr<HTTPTransport> inner, std::shared_ptr<HTTPRequestTracer> tracer)
+        : inner_(std::move(inner)), tracer_(std::move(tracer)) {}
+
+    /// Get the wrapped transport
+    auto& GetInner() const { return inner_; }
+    /// Get the name of the transport
+    std::string_view GetName() const override { return inner_->GetName(); }
+    /// Send a request
+    HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                               const std::atomic<bool>* cancelled = nullptr) override;
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
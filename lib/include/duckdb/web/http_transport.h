@@ -0,0 +1,220 @@
+#ifndef INCLUDE_DUCKDB_WEB_HTTP_TRANSPORT_H_
+#define INCLUDE_DUCKDB_WEB_HTTP_TRANSPORT_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace duckdb {
+namespace web {
+
+/// A list of HTTP headers
+using HTTPHeaderList = std::vector<std::pair<std::string, std::string>>;
+
+/// The priority of a request
+enum class HTTPRequestPriority : uint8_t {
+    /// A read that a query is waiting for
+    DEMAND = 0,
+    /// A read that fetches more than what was requested
+    READAHEAD = 1,
+    /// A speculative read that nobody is waiting for yet
+    PREFETCH = 2,
+};
+
+/// A request that is sent through an HTTP transport
+struct HTTPTransportRequest {
+    /// The method
+    std::string method = "GET";
+    /// The absolute url
+    std::string url = "";
+    /// The headers
+    HTTPHeaderList headers = {};
+    /// The body (if any)
+    std::string_view body = {};
+    /// The priority
+    HTTPRequestPriority priority = HTTPRequestPriority::DEMAND;
+
+    /// Find a header (case-insensitive)
+    std::optional<std::string_view> FindHeader(std::string_view name) const;
+};
+
+/// Visit the header lines of the form "Key: Value" separated by CRLF without splitting them upfront
+template <typename Fn> void ForEachHeaderLine(std::string_view text, Fn fn) {
+    auto trim = [](std::string_view v) {
+        while (!v.empty() && (v.front() == ' ' || v.front() == '\t')) v.remove_prefix(1);
+        while (!v.empty() && (v.back() == ' ' || v.back() == '\t' || v.back() == '\r')) v.remove_suffix(1);
+        return v;
+    };
+    while (!text.empty()) {
+        auto eol = text.find('\n');
+        auto line = text.substr(0, eol);
+        text = (eol == std::string_view::npos) ? std::string_view{} : text.substr(eol + 1);
+        auto colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        fn(trim(line.substr(0, colon)), trim(line.substr(colon + 1)));
+    }
+}
+
+/// A response that was received through an HTTP transport
+struct HTTPTransportResponse {
+    /// The status code, 0 if the request failed without a response
+    uint16_t status = 0;
+    /// The headers
+    HTTPHeaderList headers = {};
+    /// Additional header lines as received from the server.
+    /// Transports store the header block as is, it is only scanned when a header is accessed.
+    std::string raw_headers = "";
+    /// The body
+    std::string body = "";
+    /// The error message if the request failed without a response
+    std::string error = "";
+
+    /// Find a header (case-insensitive)
+    std::optional<std::string_view> FindHeader(std::string_view name) const;
+    /// Visit all headers
+    template <typename Fn> void ForEachHeader(Fn fn) const {
+        for (auto& [key, value] : headers) fn(std::string_view{key}, std::string_view{value});
+        ForEachHeaderLine(raw_headers, fn);
+    }
+};
+
+/// The fixed-size head of a response that JavaScript writes into memory owned by the transport.
+/// The header block and the body are then copied straight into the response, without an intermediate buffer.
+struct HTTPResponseEnvelope {
+    /// The status code, 0 if the request failed without a response
+    uint32_t status;
+    /// The length of the header block
+    uint32_t headers_length;
+    /// The length of the body
+    uint32_t body_length;
+    /// Padding
+    uint32_t reserved;
+};
+static_assert(sizeof(HTTPResponseEnvelope) == 16, "the envelope layout is shared with JavaScript");
+
+/// An HTTP transport.
+/// The HTTP client and the native runtime of the web filesystem send all requests through a transport.
+class HTTPTransport {
+   public:
+    /// Destructor
+    virtual ~HTTPTransport() = default;
+    /// Get the name of the transport
+    virtual std::string_view GetName() const = 0;
+    /// Send a request.
+    /// Transports that can abort a request in flight check the cancellation flag while waiting.
+    virtual HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                                       const std::atomic<bool>* cancelled = nullptr) = 0;
+};
+
+#ifdef EMSCRIPTEN
+/// A transport that uses synchronous XMLHttpRequests
+class XMLHttpRequestTransport : public HTTPTransport {
+   public:
+    /// Get the name of the transport
+    std::string_view GetName() const override { return "xhr"; }
+    /// Send a request
+    HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                               const std::atomic<bool>* cancelled = nullptr) override;
+};
+#else
+/// A transport that speaks HTTP/1.1 over plain TCP sockets.
+/// This is meant for native tests and benchmarks against local servers and does not support TLS.
+class SocketHTTPTransport : public HTTPTransport {
+   public:
+    /// The interval in which a waiting request checks its cancellation flag
+    static constexpr int POLL_INTERVAL_MS = 10;
+
+    /// Get the name of the transport
+    std::string_view GetName() const override { return "socket"; }
+    /// Send a request
+    HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                               const std::atomic<bool>* cancelled = nullptr) override;
+};
+#endif
+
+/// A programmable in-process transport for tests and benchmarks.
+/// Serves static resources or a custom handler and can inject latency, bandwidth limits and errors.
+class MockHTTPTransport : public HTTPTransport {
+   public:
+    /// A handler that produces responses
+    using Handler = std::function<HTTPTransportResponse(const HTTPTransportRequest&)>;
+
+   protected:
+    /// A static resource
+    struct Resource {
+        /// The data
+        std::string data;
+        /// The entity tag
+        std::string etag;
+    };
+
+    /// The mutex
+    std::mutex mutex_ = {};
+    /// The static resources by url
+    std::unordered_map<std::string, std::shared_ptr<const Resource>> resources_ = {};
+    /// The custom handler (if any)
+    Handler handler_ = nullptr;
+    /// The latency of every request
+    std::chrono::microseconds latency_ = std::chrono::microseconds{0};
+    /// The bandwidth in bytes per second (0 is unlimited)
+    uint64_t bandwidth_ = 0;
+    /// The probability that a request fails
+    double error_rate_ = 0.0;
+    /// The number of upcoming requests that fail
+    size_t failing_requests_ = 0;
+    /// The status code of failing requests (0 is a network error)
+    uint16_t error_status_ = 503;
+    /// The random engine for injected errors
+    std::mt19937_64 rng_ = std::mt19937_64{0};
+    /// The number of requests
+    std::atomic<uint64_t> request_count_ = 0;
+    /// The number of body bytes that were sent to the client
+    std::atomic<uint64_t> bytes_sent_ = 0;
+
+   public:
+    /// Get the name of the transport
+    std::string_view GetName() const override { return "mock"; }
+    /// Add a static resource.
+    /// Without explicit entity tag, the tag is derived from the data.
+    void AddResource(std::string url, std::string data, std::optional<std::string> etag = std::nullopt);
+    /// Set a custom handler for requests that don't target a static resource
+    void SetHandler(Handler handler);
+    /// Set the latency of every request
+    void SetLatency(std::chrono::microseconds latency);
+    /// Set the bandwidth in bytes per second (0 is unlimited)
+    void SetBandwidth(uint64_t bytes_per_second);
+    /// Fail requests randomly
+    void SetErrorRate(double rate, uint16_t status = 503);
+    /// Fail the next n requests
+    void FailNextRequests(size_t n, uint16_t status = 503);
+    /// Get the number of requests
+    auto GetRequestCount() const { return request_count_.load(); }
+    /// Get the number of body bytes that were sent to the client
+    auto GetBytesSent() const { return bytes_sent_.load(); }
+    /// Send a request
+    HTTPTransportResponse Send(const HTTPTransportRequest& request,
+                               const std::atomic<bool>* cancelled = nullptr) override;
+
+    /// Serve a static resource.
+    /// Supports HEAD and GET requests with a single byte range and conditional requests with If-None-Match.
+    static HTTPTransportResponse ServeResource(const HTTPTransportRequest& request, std::string_view data,
+                                               std::string_view etag = {});
+};
+
+/// Create the default transport of the platform
+std::shared_ptr<HTTPTransport> CreateDefaultHTTPTransport();
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
@@ -1,6 +1,8 @@
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/common/http_util.hpp"
 #include "duckdb/main/secret/secret.hpp"
+#include "duckdb/web/http_hedging.h"
+#include "duckdb/web/http_transport.h"
 
 namespace duckdb {
 
@@ -35,6 +37,21 @@ struct HTTPFSParams : public HTTPParams {
     // TODO: make this unnecessary
 };
 
+/// The parameters of the wasm HTTP client.
+/// Settings of our own live here to keep HTTPFSParams in sync with duckdb-httpfs.
+struct HTTPWasmParams : public HTTPFSParams {
+    HTTPWasmParams(HTTPUtil &http_util) : HTTPFSParams(http_util) {}
+
+    /// The hedging settings for range requests
+    web::HTTPHedgingConfig hedging;
+
+    /// Get the hedging settings of parameters, hedging is disabled for parameters that were not created by us
+    static web::HTTPHedgingConfig GetHedging(const HTTPParams &params) {
+        auto wasm_params = dynamic_cast<const HTTPWasmParams *>(&params);
+        return wasm_params ? wasm_params->hedging : web::HTTPHedgingConfig{};
+    }
+};
+
 static string TryGetPrefix(const string &url) {
     const string prefixes[] = {"s3://", "s3a://", "s3n://", "gcs://", "gs://", "r2://"};
     for (auto &prefix : prefixes) {
@@ -49,7 +66,7 @@ class HTTPWasmUtil : public HTTPUtil {
    public:
     unique_ptr<HTTPParams> InitializeParameters(optional_ptr<FileOpener> opener,
                                                 optional_ptr<FileOpenerInfo> info) override {
-        auto result = make_uniq<HTTPFSParams>(*this);
+        auto result = make_uniq<HTTPWasmParams>(*this);
         result->Initialize(opener);
         // result->state = HTTPState::TryGetState(opener);
 
@@ -79,6 +96,9 @@ class HTTPWasmUtil : public HTTPUtil {
         FileOpener::TryGetCurrentSetting(opener, "unsafe_disable_etag_checks", result->unsafe_disable_etag_checks,
                                          info);
         FileOpener::TryGetCurrentSetting(opener, "s3_version_id_pinning", result->s3_version_id_pinning, info);
+        FileOpener::TryGetCurrentSetting(opener, "http_hedged_requests", result->hedging.enabled, info);
+        FileOpener::TryGetCurrentSetting(opener, "http_hedge_percentile", result->hedging.percentile, info);
+        FileOpener::TryGetCurrentSetting(opener, "http_hedge_min_delay_ms", result->hedging.min_delay_ms, info);
 
         unique_ptr<KeyValueSecretReader> settings_reader;
 
@@ -132,6 +152,19 @@ class HTTPWasmUtil : public HTTPUtil {
     // static unordered_map<string, string> ParseGetParameters(const string &text);
 
     string GetName() const override;
+
+    /// Get the hedging of range requests
+    auto &GetHedging() { return *hedging_; }
+    /// Get the transport override (if any)
+    auto GetTransport() const { return transport_; }
+    /// Override the transport of the web filesystem
+    void SetTransport(std::shared_ptr<web::HTTPTransport> transport) { transport_ = std::move(transport); }
+
+   protected:
+    /// The transport override (if any)
+    std::shared_ptr<web::HTTPTransport> transport_ = nullptr;
+    /// The hedging of range requests, shared by all clients
+    shared_ptr<web::HTTPHedging> hedging_ = make_shared_ptr<web::HTTPHedging>();
 };
 
 }  // namespace duckdb
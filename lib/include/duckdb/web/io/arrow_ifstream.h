@@ -11,7 +11,9 @@ namespace duckdb {
 namespace web {
 namespace io {
 
-class ArrowInputFileStream : virtual public arrow::io::InputStream {
+/// An arrow file that reads through the file page buffer.
+/// Streaming reads return views of fixed pages, positioned reads copy and are thread-safe.
+class ArrowInputFileStream : public arrow::io::RandomAccessFile {
    protected:
     /// An arrow buffer for a view into a fixed page
     struct PageView : public arrow::Buffer {
@@ -42,8 +44,8 @@ class ArrowInputFileStream : virtual public arrow::io::InputStream {
     /// The temporarily fixed page
     std::optional<PageView> tmp_page_ = std::nullopt;
 
-    /// Read data from current file position without advancing the position
-    arrow::Result<PageView> PeekView(int64_t nbytes);
+    /// Read data at a position without touching the file position
+    arrow::Result<PageView> PeekView(int64_t position, int64_t nbytes);
 
    public:
     /// Constructor
@@ -92,6 +94,28 @@ class ArrowInputFileStream : virtual public arrow::io::InputStream {
     /// memory copy.
     arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override;
 
+    /// Random access file
+
+    /// Return the size of the file
+    arrow::Result<int64_t> GetSize() override;
+
+    /// Move the file position
+    arrow::Status Seek(int64_t position) override;
+
+    /// Read data from a position.
+    ///
+    /// Read at most `nbytes` from `position` into `out` without changing the file position.
+    /// The number of bytes read is returned. Safe to call from multiple threads.
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override;
+
+    /// Read data from a position.
+    ///
+    /// Read at most `nbytes` from `position` without changing the file position.
+    /// Less bytes are only returned at the end of the file. The data is copied out of the page buffer since the
+    /// buffers may be released on other threads than the one that fixed the pages. Safe to call from multiple
+    /// threads.
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override;
+
     /// Input stream
 
     /// \brief Advance or skip stream indicated number of bytes
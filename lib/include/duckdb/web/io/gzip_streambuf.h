@@ -0,0 +1,88 @@
+#ifndef INCLUDE_DUCKDB_WEB_IO_GZIP_STREAMBUF_H_
+#define INCLUDE_DUCKDB_WEB_IO_GZIP_STREAMBUF_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <streambuf>
+
+#include "miniz.hpp"
+
+namespace duckdb {
+namespace web {
+namespace io {
+
+/// A stream buffer that inflates a gzip stream incrementally.
+///
+/// The compressed source is pulled in fixed chunks and inflated into a fixed output window,
+/// so a reader never holds more than one window of the uncompressed data.
+/// Positions, slices and copies refer to uncompressed offsets.
+/// Seeking backwards restarts the inflater at the beginning of the source.
+class GzipInputStreamBuffer : public std::streambuf {
+   public:
+    /// The size of the compressed input chunks
+    static constexpr size_t INPUT_BUFFER_SIZE = 16 * 1024;
+    /// The size of the uncompressed output window
+    static constexpr size_t OUTPUT_BUFFER_SIZE = 32 * 1024;
+
+   protected:
+    /// The compressed source
+    std::streambuf* source_;
+    /// The inflater
+    duckdb_miniz::mz_stream stream_ = {};
+    /// The compressed input
+    std::unique_ptr<char[]> input_;
+    /// The uncompressed output
+    std::unique_ptr<char[]> output_;
+    /// The uncompressed offset of the output window
+    uint64_t window_offset_ = 0;
+    /// The uncompressed end of the slice
+    uint64_t slice_end_ = std::numeric_limits<uint64_t>::max();
+    /// Reached the end of the current gzip member?
+    bool member_end_ = false;
+    /// Reached the end of the gzip stream?
+    bool stream_end_ = false;
+
+    /// Refill the compressed input
+    bool ReadInput();
+    /// Consume compressed input bytes that are not passed to the inflater
+    bool SkipInput(size_t n, unsigned char* out = nullptr);
+    /// Read the header of the next gzip member
+    bool ReadMemberHeader(bool first);
+    /// Restart the inflater at the beginning of the source
+    void Restart();
+    /// Truncate the output window at the end of the slice
+    void TruncateWindow();
+    /// Skip uncompressed bytes
+    void Skip(uint64_t n);
+    /// Get the uncompressed position
+    uint64_t GetPosition() const { return window_offset_ + (gptr() - eback()); }
+
+    /// Inflate the next window
+    int_type underflow() override;
+    /// Set internal position pointer to relative position
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override;
+    /// Set internal position pointer to absolute position
+    pos_type seekpos(pos_type pos, std::ios_base::openmode) override;
+
+   public:
+    /// Constructor
+    GzipInputStreamBuffer(std::streambuf& source);
+    /// Constructor that continues at the position of another buffer over a copy of its source
+    GzipInputStreamBuffer(std::streambuf& source, const GzipInputStreamBuffer& other);
+    /// Destructor
+    ~GzipInputStreamBuffer();
+
+    /// Does a buffer start with the gzip magic bytes?
+    static bool HasGzipMagic(const char* data, size_t size) {
+        return size >= 2 && static_cast<unsigned char>(data[0]) == 0x1F && static_cast<unsigned char>(data[1]) == 0x8B;
+    }
+    /// Scan a slice of the uncompressed data
+    void Slice(uint64_t offset, uint64_t size);
+};
+
+}  // namespace io
+}  // namespace web
+}  // namespace duckdb
+
+#endif
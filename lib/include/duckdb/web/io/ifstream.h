@@ -1,9 +1,11 @@
 #ifndef INCLUDE_DUCKDB_WEB_IO_STREAMBUF_H_
 #define INCLUDE_DUCKDB_WEB_IO_STREAMBUF_H_
 
+#include <memory>
 #include <streambuf>
 
 #include "duckdb/web/io/file_page_buffer.h"
+#include "duckdb/web/io/gzip_streambuf.h"
 
 namespace duckdb {
 namespace web {
@@ -89,21 +91,47 @@ class InputFileStreamBuffer : public std::streambuf {
     void Slice(uint64_t offset, uint64_t size);
 };
 
+/// An input stream over a file that inflates gzip files transparently.
+/// Offsets of slices refer to the uncompressed data.
 class InputFileStream : public std::istream {
    protected:
     /// The buffer
     InputFileStreamBuffer buffer_;
+    /// The inflating buffer if the file is gzip compressed
+    std::unique_ptr<GzipInputStreamBuffer> gzip_buffer_;
 
    public:
     /// Constructor
     InputFileStream(std::shared_ptr<FilePageBuffer> file_page_buffer, std::string_view path)
-        : buffer_(std::move(file_page_buffer), path), std::istream(&buffer_) {}
+        : buffer_(std::move(file_page_buffer), path), std::istream(&buffer_) {
+        char magic[2];
+        auto n = buffer_.sgetn(magic, 2);
+        buffer_.Slice(0, 0);
+        if (GzipInputStreamBuffer::HasGzipMagic(magic, n)) {
+            gzip_buffer_ = std::make_unique<GzipInputStreamBuffer>(buffer_);
+            rdbuf(gzip_buffer_.get());
+        }
+    }
     /// Copy constructor
-    InputFileStream(const InputFileStream& other) : buffer_(other.buffer_), std::istream(&buffer_){};
+    InputFileStream(const InputFileStream& other)
+        : buffer_(other.buffer_),
+          std::istream(&buffer_),
+          gzip_buffer_(other.gzip_buffer_ ? std::make_unique<GzipInputStreamBuffer>(buffer_, *other.gzip_buffer_)
+                                          : nullptr) {
+        if (gzip_buffer_) rdbuf(gzip_buffer_.get());
+    };
+    /// Is the file gzip compressed?
+    bool IsCompressed() const { return !!gzip_buffer_; }
     /// Scan a slice of the file
-    void Rewind() { buffer_.Slice(0, 0); }
+    void Rewind() { Slice(0, 0); }
     /// Scan a slice of the file
-    void Slice(uint64_t offset, uint64_t size = 0) { buffer_.Slice(offset, size); }
+    void Slice(uint64_t offset, uint64_t size = 0) {
+        if (gzip_buffer_) {
+            gzip_buffer_->Slice(offset, size);
+        } else {
+            buffer_.Slice(offset, size);
+        }
+    }
 };
 
 }  // namespace io
@@ -0,0 +1,126 @@
+#ifndef INCLUDE_DUCKDB_WEB_IO_RANGE_PREFETCHER_H_
+#define INCLUDE_DUCKDB_WEB_IO_RANGE_PREFETCHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+namespace web {
+namespace io {
+
+/// Fetches the byte ranges of a remote file concurrently ahead of a sequential reader.
+///
+/// The file is split into ranges of a fixed size that are fetched by a few worker threads in file order.
+/// At most two ranges per worker are held in memory, a worker waits for the reader to consume a range before it
+/// fetches the next one. Reads of a range that is still in flight wait for it. Reads outside of the prefetched
+/// ranges are not served and fall back to the regular read path, a read ahead of the prefetched ranges moves the
+/// prefetching forward.
+class RangePrefetcher {
+   public:
+    /// Reads up to n bytes at an offset and returns the number of bytes read
+    using RangeReader = std::function<size_t(void* out, size_t n, duckdb::idx_t offset)>;
+
+    /// The default range size
+    static constexpr size_t DEFAULT_RANGE_SIZE = 4 << 20;  // 4 MB
+    /// The default number of concurrent range requests
+    static constexpr size_t DEFAULT_CONCURRENCY = 4;
+
+   protected:
+    /// A prefetched range
+    struct Range {
+        /// The offset
+        uint64_t offset = 0;
+        /// The size
+        size_t size = 0;
+        /// The data
+        std::unique_ptr<char[]> data = nullptr;
+        /// The fetch finished?
+        bool done = false;
+        /// The fetch failed or returned less than size bytes?
+        bool failed = false;
+        /// The number of readers that copy from the range
+        size_t readers = 0;
+        /// The end of the consumed bytes relative to the offset
+        size_t consumed = 0;
+
+        /// Constructor
+        Range(uint64_t offset, size_t size) : offset(offset), size(size) {}
+    };
+
+    /// The file size
+    const uint64_t file_size_;
+    /// The range size
+    const size_t range_size_;
+    /// The maximum number of ranges in memory
+    const size_t max_ranges_;
+    /// The range reader
+    RangeReader reader_;
+
+    /// The mutex
+    std::mutex mutex_ = {};
+    /// The condition variable that signals fetched and consumed ranges
+    std::condition_variable changed_ = {};
+    /// The ranges in memory by offset
+    std::map<uint64_t, Range> ranges_ = {};
+    /// The offset of the next range to fetch
+    uint64_t next_offset_ = 0;
+    /// Stop the workers?
+    bool stopped_ = false;
+    /// The workers
+    std::vector<std::thread> workers_ = {};
+
+    /// The number of fetched bytes
+    std::atomic<uint64_t> fetched_bytes_ = 0;
+    /// The number of bytes that were served from prefetched ranges
+    std::atomic<uint64_t> served_bytes_ = 0;
+    /// The number of reads that fell back to the regular read path
+    std::atomic<uint64_t> missed_reads_ = 0;
+
+    /// Fetch ranges until stopped
+    void Work();
+    /// Drop a range if it was consumed
+    void DropIfConsumed(std::map<uint64_t, Range>::iterator iter);
+
+   public:
+    /// Constructor
+    RangePrefetcher(uint64_t file_size, RangeReader reader, size_t range_size = DEFAULT_RANGE_SIZE,
+                    size_t concurrency = DEFAULT_CONCURRENCY);
+    /// Destructor
+    ~RangePrefetcher();
+    /// Delete copy constructor
+    RangePrefetcher(const RangePrefetcher& other) = delete;
+    /// Delete copy assignment
+    RangePrefetcher& operator=(const RangePrefetcher& other) = delete;
+
+    /// Get the range size
+    auto GetRangeSize() const { return range_size_; }
+    /// Get the number of fetched bytes
+    auto GetFetchedBytes() const { return fetched_bytes_.load(std::memory_order_relaxed); }
+    /// Get the number of bytes that were served from prefetched ranges
+    auto GetServedBytes() const { return served_bytes_.load(std::memory_order_relaxed); }
+    /// Get the number of reads that fell back to the regular read path
+    auto GetMissedReads() const { return missed_reads_.load(std::memory_order_relaxed); }
+
+    /// Read up to n bytes at an offset from the prefetched ranges.
+    /// Returns the number of bytes read, which is limited to the end of the range, or nullopt if the offset is not
+    /// prefetched.
+    std::optional<size_t> Read(void* out, size_t n, duckdb::idx_t offset);
+    /// Stop the workers and drop the ranges
+    void Stop();
+};
+
+}  // namespace io
+}  // namespace web
+}  // namespace duckdb
+
+#endif  // INCLUDE_DUCKDB_WEB_IO_RANGE_PREFETCHER_H_
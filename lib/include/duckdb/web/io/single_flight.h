@@ -0,0 +1,211 @@
+#ifndef INCLUDE_DUCKDB_WEB_IO_SINGLE_FLIGHT_H_
+#define INCLUDE_DUCKDB_WEB_IO_SINGLE_FLIGHT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+namespace web {
+namespace io {
+
+/// Deduplicates concurrent reads of the same byte range of a remote file.
+///
+/// The first reader of a range becomes the leader and performs the actual read into its own buffer.
+/// Readers that arrive while the leader is in flight and start within the in-flight range join the flight instead
+/// of issuing a request of their own. Once the leader finishes, the fetched bytes are fanned out to all waiters.
+/// A joined reader that extends beyond the in-flight range receives a short read and continues with the next range.
+/// If the leader fails, one waiter retries the range and the others wait for the retry. A failed retry fails all of
+/// its waiters.
+class SingleFlightReader {
+   protected:
+    /// A read in flight
+    struct Flight {
+        /// The offset of the range
+        uint64_t offset = 0;
+        /// The size of the range
+        uint64_t size = 0;
+        /// The number of readers that wait for the flight
+        size_t waiters = 0;
+        /// The flight finished?
+        bool done = false;
+        /// The leader failed?
+        bool failed = false;
+        /// The flight retries a failed flight?
+        bool retry = false;
+        /// The error of the leader
+        std::exception_ptr error = nullptr;
+        /// The retry of the failed flight (if any)
+        std::shared_ptr<Flight> retry_flight = nullptr;
+        /// A waiter claimed the leadership of the retry?
+        bool claimed = false;
+        /// The number of bytes read by the leader
+        size_t bytes_read = 0;
+        /// The data shared with the waiters (only allocated if there are any)
+        std::unique_ptr<char[]> data = nullptr;
+
+        /// Constructor
+        Flight(uint64_t offset, uint64_t size) : offset(offset), size(size) {}
+    };
+
+    /// The mutex protecting the flights
+    std::mutex mutex_ = {};
+    /// The condition variable to wake up waiters
+    std::condition_variable flight_landed_ = {};
+    /// The flights by file id
+    std::unordered_map<uint32_t, std::vector<std::shared_ptr<Flight>>> flights_ = {};
+    /// The number of reads that were issued
+    std::atomic<uint64_t> issued_reads_ = 0;
+    /// The number of reads that were served by another flight
+    std::atomic<uint64_t> shared_reads_ = 0;
+
+   public:
+    /// Constructor
+    SingleFlightReader() = default;
+
+    /// Get the number of issued reads
+    auto GetIssuedReads() const { return issued_reads_.load(std::memory_order_relaxed); }
+    /// Get the number of shared reads
+    auto GetSharedReads() const { return shared_reads_.load(std::memory_order_relaxed); }
+
+    /// Read up to nr_bytes bytes into the buffer.
+    /// Returns the number of bytes read which might be less than nr_bytes.
+    template <typename Fn>
+    size_t Read(uint32_t file_id, void* buffer, size_t nr_bytes, duckdb::idx_t offset, Fn read_fn) {
+        if (nr_bytes == 0) return read_fn(buffer, nr_bytes, offset);
+
+        // Join an in-flight read or start a new one
+        std::shared_ptr<Flight> flight;
+        bool leader = false;
+        {
+            std::unique_lock<std::mutex> guard{mutex_};
+            auto& flights = flights_[file_id];
+            for (auto& f : flights) {
+                if (f->offset <= offset && offset < (f->offset + f->size)) {
+                    flight = f;
+                    ++flight->waiters;
+                    break;
+                }
+            }
+            if (!flight) {
+                flight = std::make_shared<Flight>(offset, nr_bytes);
+                flights.push_back(flight);
+                leader = true;
+            }
+        }
+
+        // Wait for the leader
+        while (!leader) {
+            std::unique_lock<std::mutex> guard{mutex_};
+            flight_landed_.wait(guard, [&]() { return flight->done; });
+
+            // Copy the shared bytes
+            if (!flight->failed) {
+                guard.unlock();
+                shared_reads_.fetch_add(1, std::memory_order_relaxed);
+                return CopyShared(*flight, buffer, nr_bytes, offset);
+            }
+            // The retry failed as well?
+            if (flight->retry) {
+                std::rethrow_exception(flight->error);
+            }
+            // The leader failed, the first waiter leads the retry and the others wait for it
+            auto retry = flight->retry_flight;
+            if (!retry->claimed) {
+                retry->claimed = true;
+                leader = true;
+            }
+            flight = std::move(retry);
+        }
+        return Lead(file_id, std::move(flight), buffer, nr_bytes, offset, read_fn);
+    }
+
+   protected:
+    /// Copy the bytes of a landed flight
+    static size_t CopyShared(const Flight& flight, void* buffer, size_t nr_bytes, duckdb::idx_t offset) {
+        auto skip = offset - flight.offset;
+        auto n = flight.bytes_read > skip ? std::min<size_t>(nr_bytes, flight.bytes_read - skip) : 0;
+        if (n > 0) std::memcpy(buffer, flight.data.get() + skip, n);
+        return n;
+    }
+
+    /// Perform the read of a flight as leader
+    template <typename Fn>
+    size_t Lead(uint32_t file_id, std::shared_ptr<Flight> flight, void* buffer, size_t nr_bytes, duckdb::idx_t offset,
+                Fn read_fn) {
+        // A retry reads the range of the failed flight which might differ from the own range
+        bool own_range = flight->offset == offset && flight->size == nr_bytes;
+        std::unique_ptr<char[]> scratch = own_range ? nullptr : std::unique_ptr<char[]>(new char[flight->size]);
+        auto target = own_range ? static_cast<char*>(buffer) : scratch.get();
+
+        // Perform the read
+        issued_reads_.fetch_add(1, std::memory_order_relaxed);
+        size_t bytes_read = 0;
+        std::exception_ptr error = nullptr;
+        try {
+            bytes_read = read_fn(target, flight->size, flight->offset);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // Unregister the flight so that no further readers can join.
+        // Then copy the data for the waiters without holding the lock.
+        size_t waiters = 0;
+        {
+            std::unique_lock<std::mutex> guard{mutex_};
+            auto iter = flights_.find(file_id);
+            auto& flights = iter->second;
+            for (auto f = flights.begin(); f != flights.end(); ++f) {
+                if (*f == flight) {
+                    flights.erase(f);
+                    break;
+                }
+            }
+            waiters = flight->waiters;
+            // Register the retry of a failed flight before waking up the waiters
+            if (error && !flight->retry && waiters > 0) {
+                flight->retry_flight = std::make_shared<Flight>(flight->offset, flight->size);
+                flight->retry_flight->retry = true;
+                flight->retry_flight->waiters = waiters - 1;
+                flights.push_back(flight->retry_flight);
+            }
+            if (flights.empty()) flights_.erase(iter);
+        }
+        if (!error) {
+            if (scratch) {
+                flight->data = std::move(scratch);
+            } else if (waiters > 0) {
+                flight->data = std::unique_ptr<char[]>(new char[bytes_read]);
+                std::memcpy(flight->data.get(), buffer, bytes_read);
+            }
+        }
+        {
+            std::unique_lock<std::mutex> guard{mutex_};
+            flight->bytes_read = bytes_read;
+            flight->failed = !!error;
+            flight->error = error;
+            flight->done = true;
+        }
+        if (waiters > 0) {
+            flight_landed_.notify_all();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return own_range ? bytes_read : CopyShared(*flight, buffer, nr_bytes, offset);
+    }
+};
+
+}  // namespace io
+}  // namespace web
+}  // namespace duckdb
+
+#endif
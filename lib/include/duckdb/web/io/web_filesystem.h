@@ -14,8 +14,14 @@
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/vector.hpp"
 #include "duckdb/web/config.h"
+#include "duckdb/web/http_cache.h"
+#include "duckdb/web/http_scheduler.h"
+#include "duckdb/web/http_trace.h"
+#include "duckdb/web/http_transport.h"
 #include "duckdb/web/io/file_stats.h"
+#include "duckdb/web/io/range_prefetcher.h"
 #include "duckdb/web/io/readahead_buffer.h"
+#include "duckdb/web/io/single_flight.h"
 #include "duckdb/web/utils/parallel.h"
 #include "duckdb/web/utils/wasm_response.h"
 #include "nonstd/span.h"
@@ -93,6 +99,8 @@ class WebFileSystem : public duckdb::FileSystem {
 
         /// The file stats
         std::shared_ptr<io::FileStatisticsCollector> file_stats_ = nullptr;
+        /// The concurrent range prefetching (if any)
+        std::shared_ptr<RangePrefetcher> range_prefetcher_ = nullptr;
 
        public:
         /// Constructor
@@ -173,6 +181,18 @@ class WebFileSystem : public duckdb::FileSystem {
     uint32_t next_file_id_ = 0;
     /// The thread-local readahead buffers
     std::unordered_map<uint32_t, std::unique_ptr<ReadAheadBuffer>> readahead_buffers_ = {};
+    /// The deduplication of concurrent remote reads
+    SingleFlightReader remote_reads_ = {};
+    /// The HTTP range cache
+    std::shared_ptr<HTTPRangeCache> http_cache_ = std::make_shared<HTTPRangeCache>();
+    /// The HTTP request traces
+    std::shared_ptr<HTTPRequestTracer> http_tracer_ = std::make_shared<HTTPRequestTracer>();
+    /// The HTTP request scheduler
+    std::shared_ptr<HTTPRequestScheduler> http_scheduler_ = std::make_shared<HTTPRequestScheduler>();
+    /// The HTTP transport
+    std::shared_ptr<HTTPTransport> http_transport_ = WrapHTTPTransport(CreateDefaultHTTPTransport());
+    /// The HTTP transport is the default transport of the runtime?
+    bool default_http_transport_ = true;
     /// The file statistics
     std::shared_ptr<io::FileStatisticsRegistry> file_statistics_;
     /// Cache epoch for synchronization of JS caches
@@ -186,6 +206,18 @@ class WebFileSystem : public duckdb::FileSystem {
     inline uint32_t AllocateFileID() { return ++next_file_id_; }
     /// Invalidate readaheads
     void InvalidateReadAheads(size_t file_id, std::unique_lock<SharedMutex> &file_guard);
+    /// Read a range of a remote file.
+    /// HTTP ranges are sent through the HTTP transport and are cached, scheduled and traced like the requests of the
+    /// HTTP client. In the browser they are read by the runtime while the range cache is disabled, which keeps its
+    /// error reporting and avoids the CORS preflights of conditional requests.
+    /// Ranges read by the runtime (including signed S3 requests) wait for the scheduler and are traced.
+    size_t ReadRemoteRange(const WebFile &file, void *out, size_t n, duckdb::idx_t offset);
+    /// Put the range cache, the scheduler and the tracer in front of a transport
+    std::shared_ptr<HTTPTransport> WrapHTTPTransport(std::shared_ptr<HTTPTransport> transport) {
+        auto traced = std::make_shared<TracingHTTPTransport>(std::move(transport), http_tracer_);
+        auto scheduled = std::make_shared<SchedulingHTTPTransport>(std::move(traced), http_scheduler_);
+        return std::make_shared<CachingHTTPTransport>(std::move(scheduled), http_cache_);
+    }
 
    public:
     /// Constructor
@@ -197,6 +229,22 @@ class WebFileSystem : public duckdb::FileSystem {
 
     /// Get the config
     auto Config() const { return config_; }
+    /// Get the deduplication of concurrent remote reads
+    auto &GetRemoteReads() { return remote_reads_; }
+    /// Get the HTTP transport
+    auto GetHTTPTransport() const { return http_transport_; }
+    /// Set the HTTP transport.
+    /// Must be called before any remote file is opened.
+    void SetHTTPTransport(std::shared_ptr<HTTPTransport> transport) {
+        http_transport_ = WrapHTTPTransport(std::move(transport));
+        default_http_transport_ = false;
+    }
+    /// Get the HTTP range cache
+    auto &GetHTTPCache() { return *http_cache_; }
+    /// Get the HTTP request traces
+    auto &GetHTTPTracer() { return *http_tracer_; }
+    /// Get the HTTP request scheduler
+    auto &GetHTTPScheduler() { return *http_scheduler_; }
     /// Load the current cache epoch
     auto LoadCacheEpoch() const { return cache_epoch_.load(std::memory_order_relaxed); }
     /// Get a file info as JSON string
@@ -215,6 +263,8 @@ class WebFileSystem : public duckdb::FileSystem {
     /// Register a file buffer
     arrow::Result<std::unique_ptr<WebFileHandle>> RegisterFileBuffer(std::string_view file_name,
                                                                      DataBuffer file_buffer);
+    /// Get the data protocol of a file (if known)
+    std::optional<DataProtocol> FindDataProtocol(std::string_view file_name);
     /// Try to drop a specific file
     bool TryDropFile(std::string_view file_name);
     /// drop a specific file
@@ -225,6 +275,13 @@ class WebFileSystem : public duckdb::FileSystem {
     void ConfigureFileStatistics(std::shared_ptr<FileStatisticsRegistry> registry);
     /// Collect file statistics
     void CollectFileStatistics(std::string_view path, std::shared_ptr<FileStatisticsCollector> collector);
+    /// Prefetch the ranges of a remote file concurrently ahead of sequential reads.
+    /// Returns the prefetcher or null if the file is not remote or the build has no threads.
+    std::shared_ptr<RangePrefetcher> PrefetchRanges(duckdb::FileHandle &handle,
+                                                    size_t range_size = RangePrefetcher::DEFAULT_RANGE_SIZE,
+                                                    size_t concurrency = RangePrefetcher::DEFAULT_CONCURRENCY);
+    /// Stop prefetching the ranges of a file
+    void StopRangePrefetch(duckdb::FileHandle &handle);
 
     // Increment the Cache epoch, this allows detecting stale fileInfoCaches from JS
     void IncrementCacheEpoch();
@@ -0,0 +1,123 @@
+#ifndef INCLUDE_DUCKDB_WEB_QUERY_RESULT_CACHE_H_
+#define INCLUDE_DUCKDB_WEB_QUERY_RESULT_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "duckdb/common/enums/statement_type.hpp"
+#include "duckdb/parser/sql_statement.hpp"
+
+namespace duckdb {
+namespace web {
+
+/// The statistics of the query result cache
+struct QueryResultCacheStatistics {
+    /// The number of results that were served from the cache
+    std::atomic<uint64_t> hits = 0;
+    /// The number of cacheable queries that were executed
+    std::atomic<uint64_t> misses = 0;
+    /// The number of evicted results
+    std::atomic<uint64_t> evictions = 0;
+    /// The number of invalidations
+    std::atomic<uint64_t> invalidations = 0;
+};
+
+/// An LRU cache of serialized query results.
+///
+/// Results are keyed by the normalized statement text, the bound parameter values, the result format and the session
+/// epoch of the connection. Fresh connections share the epoch 0, a connection that changes its session state (e.g. with
+/// SET, USE or CREATE TEMP) moves to an epoch of its own. The cache keeps a data version that is bumped by every
+/// statement that may write and by file registrations. Bumping the version drops all results, and results that were
+/// computed under an older version are not inserted.
+class QueryResultCache {
+   public:
+    /// The format of a cached result
+    enum class ResultFormat : uint8_t { IPC_FILE = 0, IPC_STREAM = 1 };
+    /// A cached result
+    struct Result {
+        /// The IPC file, or the schema and the record batch messages of an IPC stream
+        std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+    };
+
+   protected:
+    /// A cache entry
+    struct Entry {
+        /// The key
+        std::string key;
+        /// The result
+        std::shared_ptr<const Result> result;
+        /// The accounted bytes
+        size_t bytes;
+    };
+
+    /// The mutex
+    mutable std::mutex mutex_ = {};
+    /// The byte budget (0 disables the cache)
+    uint64_t max_bytes_ = 0;
+    /// The data version
+    uint64_t version_ = 0;
+    /// The next session epoch
+    std::atomic<uint64_t> next_session_epoch_ = 1;
+    /// The entries in LRU order, most recently used first
+    std::list<Entry> lru_ = {};
+    /// The entries by key
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries_ = {};
+    /// The accounted bytes
+    size_t bytes_ = 0;
+    /// The statistics
+    QueryResultCacheStatistics stats_ = {};
+
+    /// Erase an entry
+    void Erase(std::list<Entry>::iterator entry);
+    /// Evict entries until the cache fits its budget
+    void Evict();
+
+   public:
+    /// Is the cache enabled?
+    bool IsEnabled() const;
+    /// Get the byte budget
+    uint64_t GetMaxBytes() const;
+    /// Update the byte budget and drop all results
+    void Configure(uint64_t max_bytes);
+    /// Get the statistics
+    auto& GetStatistics() { return stats_; }
+    /// Get the accounted bytes
+    size_t GetSize() const;
+    /// Get the number of cached results
+    size_t GetEntryCount() const;
+    /// Get the data version
+    uint64_t GetVersion() const;
+    /// Allocate a session epoch for a connection that changed its session state
+    uint64_t NextSessionEpoch() { return next_session_epoch_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// May a statement type write data or change the results of other statements?
+    static bool MayWrite(duckdb::StatementType type);
+    /// Does a statement change the session state of its connection?
+    static bool ChangesSessionState(const duckdb::SQLStatement& statement);
+    /// Normalize a statement, returns nullopt if its results cannot be cached
+    static std::optional<std::string> Normalize(const duckdb::SQLStatement& statement);
+    /// Build the key of a normalized statement
+    static std::string BuildKey(uint64_t session_epoch, std::string_view normalized, ResultFormat format,
+                                std::string_view parameters = {});
+
+    /// Find a cached result
+    std::shared_ptr<const Result> Find(const std::string& key);
+    /// Insert a result that was computed under a data version
+    void Insert(const std::string& key, uint64_t version, std::shared_ptr<const Result> result);
+    /// Bump the data version and drop all results
+    void Invalidate();
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
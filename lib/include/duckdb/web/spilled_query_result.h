@@ -0,0 +1,94 @@
+#ifndef INCLUDE_DUCKDB_WEB_SPILLED_QUERY_RESULT_H_
+#define INCLUDE_DUCKDB_WEB_SPILLED_QUERY_RESULT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/ipc/options.h"
+#include "arrow/result.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "duckdb/main/query_result.hpp"
+#include "duckdb/web/arrow_export_context.h"
+#include "duckdb/web/io/file_page_buffer.h"
+
+namespace duckdb {
+namespace web {
+
+/// A materialized query result that is spilled to a file.
+///
+/// The record batch messages of the result are appended to a file of the file page buffer while the result is
+/// fetched, only the schema and the row offsets of the batches stay in memory. Row ranges are then fetched without
+/// executing the query again, batches that are covered completely are returned without decoding them.
+class SpilledQueryResult {
+   protected:
+    /// A spilled record batch
+    struct Batch {
+        /// The offset of the message in the file
+        uint64_t file_offset;
+        /// The length of the message
+        uint64_t byte_length;
+        /// The first row
+        uint64_t first_row;
+        /// The number of rows
+        uint64_t row_count;
+    };
+
+    /// The file page buffer
+    io::FilePageBuffer& file_page_buffer_;
+    /// The spill file path
+    std::string path_;
+    /// The spill file
+    std::unique_ptr<io::FilePageBuffer::FileRef> file_ = nullptr;
+    /// The schema
+    std::shared_ptr<arrow::Schema> schema_ = nullptr;
+    /// The serialized schema
+    std::shared_ptr<arrow::Buffer> schema_message_ = nullptr;
+    /// The IPC write options
+    arrow::ipc::IpcWriteOptions ipc_options_ = arrow::ipc::IpcWriteOptions::Defaults();
+    /// The spilled batches
+    std::vector<Batch> batches_ = {};
+    /// The number of rows
+    uint64_t row_count_ = 0;
+
+    /// Append a record batch message to the spill file
+    void Append(const arrow::Buffer& message, uint64_t rows);
+    /// Read a record batch message from the spill file
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadMessage(const Batch& batch);
+
+   public:
+    /// Constructor
+    SpilledQueryResult(io::FilePageBuffer& file_page_buffer, std::string path);
+    /// Destructor, drops the spill file
+    ~SpilledQueryResult();
+
+    /// Fetch all chunks of a query result and spill them as record batches of at least batch_rows rows
+    static arrow::Result<std::unique_ptr<SpilledQueryResult>> Create(io::FilePageBuffer& file_page_buffer,
+                                                                     std::string_view directory,
+                                                                     duckdb::QueryResult& result,
+                                                                     ArrowExportContext& export_context,
+                                                                     uint64_t batch_rows);
+
+    /// Get the spill file path
+    auto& GetPath() const { return path_; }
+    /// Get the schema
+    auto& GetSchema() const { return schema_; }
+    /// Get the number of rows
+    auto GetRowCount() const { return row_count_; }
+    /// Get the number of spilled batches
+    auto GetBatchCount() const { return batches_.size(); }
+    /// Get the number of spilled bytes
+    uint64_t GetSpilledBytes() const;
+
+    /// Fetch up to limit rows starting at offset as IPC stream
+    arrow::Result<std::shared_ptr<arrow::Buffer>> FetchRange(uint64_t offset, uint64_t limit);
+};
+
+}  // namespace web
+}  // namespace duckdb
+
+#endif
@@ -4,7 +4,10 @@
 #include <cstring>
 #include <duckdb/main/pending_query_result.hpp>
 #include <duckdb/main/prepared_statement.hpp>
+#include <functional>
 #include <initializer_list>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -14,6 +17,7 @@
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/main/query_result.hpp"
 #include "duckdb/parser/parser.hpp"
+#include "duckdb/web/arrow_export_context.h"
 #include "duckdb/web/arrow_insert_options.h"
 #include "duckdb/web/config.h"
 #include "duckdb/web/environment.h"
@@ -21,6 +25,8 @@
 #include "duckdb/web/io/file_page_buffer.h"
 #include "duckdb/web/io/file_stats.h"
 #include "duckdb/web/io/web_filesystem.h"
+#include "duckdb/web/query_result_cache.h"
+#include "duckdb/web/spilled_query_result.h"
 #include "duckdb/web/udf.h"
 #include "nonstd/span.h"
 
@@ -52,42 +58,129 @@ class WebDB {
         friend WebDB;
 
        protected:
+        /// A streamed result that is recorded for the result cache
+        struct ResultCacheRecording {
+            /// The cache key
+            std::string key;
+            /// The data version when the query started
+            uint64_t version;
+            /// The recorded buffers
+            std::shared_ptr<QueryResultCache::Result> result = std::make_shared<QueryResultCache::Result>();
+            /// The recorded bytes
+            size_t bytes = 0;
+        };
+
+        /// The state of a pending query and its streamed result
+        struct QueryHandle {
+            /// The statements extracted from the query text
+            std::vector<duckdb::unique_ptr<duckdb::SQLStatement>> pending_statements = {};
+            /// The index of the currently-running statement (in the above list)
+            size_t pending_statement_index = 0;
+            /// The value of allow_stream_result passed to PendingQuery
+            bool allow_stream_result = false;
+            /// The pending query result (if any)
+            duckdb::unique_ptr<duckdb::PendingQueryResult> pending_query_result = nullptr;
+            /// The pending query was canceled
+            bool pending_query_was_canceled = false;
+            /// The pending statements may write?
+            bool pending_may_write = false;
+            /// The schema of a query that finished while it was suspended, until it is polled
+            std::shared_ptr<arrow::Buffer> ready_schema = nullptr;
+            /// The error of a query that failed while it was suspended
+            arrow::Status suspended_error = arrow::Status::OK();
+            /// The query result (if any)
+            duckdb::unique_ptr<duckdb::QueryResult> query_result = nullptr;
+            /// The export context of the query result (if any)
+            std::unique_ptr<ArrowExportContext> export_context = nullptr;
+            /// The cached result that is served (if any)
+            std::shared_ptr<const QueryResultCache::Result> cached_result = nullptr;
+            /// The next buffer of the cached result
+            size_t cached_result_index = 0;
+            /// The streamed result that is recorded for the result cache (if cacheable)
+            std::optional<ResultCacheRecording> cache_recording = std::nullopt;
+        };
+
         /// The webdb
         WebDB& webdb_;
         /// The connection
         duckdb::Connection connection_;
 
-        /// The statements extracted from the text passed to PendingQuery
-        std::vector<duckdb::unique_ptr<duckdb::SQLStatement>> current_pending_statements_;
-        /// The index of the currently-running statement (in the above list)
-        size_t current_pending_statement_index_ = 0;
-        /// The value of allow_stream_result passed to PendingQuery
-        bool current_allow_stream_result_ = false;
-        /// The current pending query result (if any)
-        duckdb::unique_ptr<duckdb::PendingQueryResult> current_pending_query_result_ = nullptr;
-        /// The current pending query was canceled
-        bool current_pending_query_was_canceled_ = false;
-        /// The current query result (if any)
-        duckdb::unique_ptr<duckdb::QueryResult> current_query_result_ = nullptr;
-        /// The current arrow schema (if any)
-        std::shared_ptr<arrow::Schema> current_schema_ = nullptr;
-        /// The current patched arrow schema (if any)
-        std::shared_ptr<arrow::Schema> current_schema_patched_ = nullptr;
+        /// The query of PendingQuery, PollPendingQuery, CancelPendingQuery and FetchQueryResults without identifier
+        QueryHandle current_query_ = {};
+        /// The queries that were started with StartPendingQuery
+        std::unordered_map<size_t, std::unique_ptr<QueryHandle>> query_handles_ = {};
+        /// The next query handle id
+        size_t next_query_handle_id_ = 0;
+        /// The query that owns the running query of the client context (if any)
+        QueryHandle* active_query_ = nullptr;
 
         /// The currently active prepared statements
         std::unordered_map<size_t, duckdb::unique_ptr<duckdb::PreparedStatement>> prepared_statements_ = {};
         /// The next prepared statement id
         size_t next_prepared_statement_id_ = 0;
+        /// The spilled query results
+        std::unordered_map<size_t, std::unique_ptr<SpilledQueryResult>> spilled_results_ = {};
+        /// The next spilled query result id
+        size_t next_spilled_result_id_ = 0;
         /// The current arrow ipc input stream
         std::optional<ArrowInsertOptions> arrow_insert_options_ = std::nullopt;
         /// The current arrow ipc input stream
         std::unique_ptr<BufferingArrowIPCStreamDecoder> arrow_ipc_stream_;
+        /// The arrow ipc input stream is inserted in its own transaction?
+        bool arrow_insert_transaction_ = false;
+        /// The session epoch that scopes the cached results of the connection
+        uint64_t session_epoch_ = 0;
 
         // Fully materialize a given result set and return it as an Arrow Buffer
         arrow::Result<std::shared_ptr<arrow::Buffer>> MaterializeQueryResult(
             duckdb::unique_ptr<duckdb::QueryResult> result);
         // Setup streaming of a result set and return the schema as an Arrow Buffer
-        arrow::Result<std::shared_ptr<arrow::Buffer>> StreamQueryResult(duckdb::unique_ptr<duckdb::QueryResult> result);
+        arrow::Result<std::shared_ptr<arrow::Buffer>> StreamQueryResult(QueryHandle& query,
+                                                                        duckdb::unique_ptr<duckdb::QueryResult> result);
+        // Reset the query result of a query
+        void ResetQueryResult(QueryHandle& query);
+        // Move the connection to a session epoch of its own if a statement changes its session state
+        void TrackSessionState(const duckdb::SQLStatement& statement);
+        // Look up a single statement in the result cache, returns the cache key on a miss if the result is cacheable
+        std::optional<std::string> LookupCachedResult(const duckdb::SQLStatement& statement,
+                                                      QueryResultCache::ResultFormat format,
+                                                      std::shared_ptr<const QueryResultCache::Result>& hit,
+                                                      std::string_view parameters = {});
+        // Look up a prepared statement in the result cache, returns the cache key on a miss if the result is cacheable
+        std::optional<std::string> LookupCachedPreparedResult(size_t statement_id, std::string_view args_json,
+                                                              QueryResultCache::ResultFormat format,
+                                                              std::shared_ptr<const QueryResultCache::Result>& hit);
+        // Serve a cached streamed result and return its schema
+        std::shared_ptr<arrow::Buffer> StreamCachedResult(QueryHandle& query,
+                                                          std::shared_ptr<const QueryResultCache::Result> result);
+        // Record a buffer of a streamed result for the result cache
+        void RecordResultBuffer(QueryHandle& query, const std::shared_ptr<arrow::Buffer>& buffer);
+        // Insert the recorded streamed result into the result cache
+        void FinishResultRecording(QueryHandle& query);
+        // Fetch and encode at least the first rows of a streamed result, returns nullptr for empty results
+        arrow::Result<std::shared_ptr<arrow::Buffer>> FetchFirstBatch(QueryHandle& query, uint64_t rows);
+        // Start a pending query and return the stream schema when finished
+        arrow::Result<std::shared_ptr<arrow::Buffer>> PendingQuery(QueryHandle& query, std::string_view text,
+                                                                   bool allow_stream_result);
+        // Poll a pending query and return the schema when finished
+        arrow::Result<std::shared_ptr<arrow::Buffer>> PollPendingQuery(QueryHandle& query);
+        // Continue a pending query with a finished statement, returns the schema after the last statement
+        arrow::Result<std::shared_ptr<arrow::Buffer>> FinishPendingStatement(
+            QueryHandle& query, duckdb::unique_ptr<duckdb::QueryResult> result);
+        // Cancel a pending query
+        bool CancelPendingQuery(QueryHandle& query);
+        // Fetch a record batch from a streamed result
+        DuckDBWasmResultsWrapper FetchQueryResults(QueryHandle& query);
+        // Finish the query that owns the client context before another query runs.
+        // Query handles keep their results, pending statements are executed and streamed results are materialized.
+        // Fails while an arrow ipc stream insert is pending.
+        arrow::Status SuspendActiveQuery();
+        // Find a query handle
+        arrow::Result<std::reference_wrapper<QueryHandle>> FindQueryHandle(size_t query_id);
+        // Consume a buffer of an arrow ipc stream and insert the decoded batches
+        arrow::Status ConsumeArrowIPCBuffer(std::shared_ptr<arrow::Buffer> data, std::string_view options_json);
+        // Export a query result as Arrow C stream
+        arrow::Status ExportQueryResult(duckdb::unique_ptr<duckdb::QueryResult> result, ArrowArrayStream* out);
         // Execute a prepared statement by setting up all arguments and returning the query result
         arrow::Result<duckdb::unique_ptr<duckdb::QueryResult>> ExecutePreparedStatement(size_t statement_id,
                                                                                         std::string_view args_json);
@@ -114,8 +207,20 @@ class WebDB {
         arrow::Result<std::shared_ptr<arrow::Buffer>> PollPendingQuery();
         /// Cancel a pending query
         bool CancelPendingQuery();
-        /// Fetch a data chunk from a pending query
+        /// Fetch a record batch from a pending query, coalescing data chunks if configured
         DuckDBWasmResultsWrapper FetchQueryResults();
+        /// Start a pending query with its own query handle and return the handle identifier.
+        /// Several query handles can be polled and fetched interleaved. DuckDB runs one query per connection at a time,
+        /// a running query is therefore finished and its streamed result materialized when another query starts.
+        arrow::Result<size_t> StartPendingQuery(std::string_view text, bool allow_stream_result);
+        /// Poll the pending query of a query handle and return the schema when finished
+        arrow::Result<std::shared_ptr<arrow::Buffer>> PollPendingQuery(size_t query_id);
+        /// Cancel the pending query of a query handle
+        bool CancelPendingQuery(size_t query_id);
+        /// Fetch a record batch of a query handle, the handle is closed at the end of the result
+        DuckDBWasmResultsWrapper FetchQueryResults(size_t query_id);
+        /// Close a query handle
+        arrow::Status CloseQueryHandle(size_t query_id);
         /// Get table names
         arrow::Result<std::string> GetTableNames(std::string_view text);
 
@@ -127,14 +232,45 @@ class WebDB {
         /// Execute a prepared statement with the given parameters in stringifed json format and stream result
         arrow::Result<std::shared_ptr<arrow::Buffer>> SendPreparedStatement(size_t statement_id,
                                                                             std::string_view args_json);
+        /// Execute a prepared statement once per row of parameters given as Arrow IPC stream and return the
+        /// concatenated result
+        arrow::Result<std::shared_ptr<arrow::Buffer>> RunPreparedStatementBatch(size_t statement_id,
+                                                                                nonstd::span<const uint8_t> params);
         /// Close a prepared statement by its identifier
         arrow::Status ClosePreparedStatement(size_t statement_id);
 
+        /// Run a query and export the result as Arrow C stream without IPC serialization.
+        /// The buffers stay in our memory until the consumer releases the stream and its arrays.
+        arrow::Status ExportQuery(std::string_view text, ArrowArrayStream* out);
+        /// Execute a prepared statement and export the result as Arrow C stream
+        arrow::Status ExportPreparedStatement(size_t statement_id, std::string_view args_json, ArrowArrayStream* out);
+
+        /// Run a query and spill the materialized result to a file, returns the result identifier
+        arrow::Result<size_t> SpillQuery(std::string_view text);
+        /// Get the number of rows of a spilled result
+        arrow::Result<uint64_t> GetSpilledResultRowCount(size_t result_id);
+        /// Fetch up to limit rows of a spilled result starting at offset as IPC stream
+        arrow::Result<std::shared_ptr<arrow::Buffer>> FetchSpilledResultRange(size_t result_id, uint64_t offset,
+                                                                              uint64_t limit);
+        /// Close a spilled result and drop its file
+        arrow::Status CloseSpilledResult(size_t result_id);
+
         /// Create a scalar function
         arrow::Status CreateScalarFunction(std::string_view args_json);
 
         /// Insert an arrow record batch from an IPC stream
         arrow::Status InsertArrowFromIPCStream(nonstd::span<const uint8_t> stream, std::string_view options);
+        /// Insert an arrow record batch from an IPC stream buffer that is owned by the connection from now on.
+        /// The batches are decoded as slices of the buffer without copying it.
+        arrow::Status InsertArrowFromIPCBuffer(std::unique_ptr<char[]> buffer, size_t buffer_length,
+                                               std::string_view options);
+        /// Abort a pending arrow ipc stream insert.
+        /// The inserted batches are rolled back unless the stream was inserted into an explicit transaction.
+        /// Other statements on the connection fail while an insert is pending.
+        arrow::Status AbortArrowIPCStream();
+        /// Insert the record batches of an arrow IPC file from a path.
+        /// The batches are decoded in parallel, the file is inserted by a single statement.
+        arrow::Status InsertArrowFromIPCFile(std::string_view path, std::string_view options);
         /// Insert csv data from a path
         arrow::Status InsertCSVFromPath(std::string_view path, std::string_view options);
         /// Insert json data from a path
@@ -153,6 +289,8 @@ class WebDB {
     /// The connections
     std::unordered_map<Connection*, duckdb::unique_ptr<Connection>> connections_;
 
+    /// The query result cache
+    QueryResultCache result_cache_ = {};
     /// The file statistics (if any)
     std::shared_ptr<io::FileStatisticsRegistry> file_stats_ = {};
     /// The pinned web files (if any)
@@ -206,6 +344,12 @@ class WebDB {
     arrow::Result<std::string> GetFileInfo(std::string_view file_name, uint32_t cache_epoch);
     /// Flush all file buffers
     void FlushFiles();
+    /// Clear the HTTP range cache
+    void ClearHTTPCache();
+    /// Get the query result cache
+    auto& result_cache() { return result_cache_; }
+    /// Clear the query result cache
+    void ClearResultCache();
     /// Flush file by path
     void FlushFile(std::string_view path);
     /// Drop all files
@@ -0,0 +1,191 @@
+#include "duckdb/web/arrow_cast_kernels.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(WEBDB_SIMD)
+#include <wasm_simd128.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace duckdb {
+namespace web {
+namespace kernels {
+
+namespace {
+
+/// 2^52 as double bits, the low word of a value becomes the mantissa
+constexpr uint64_t MAGIC_LOW = 0x4330000000000000ull;
+/// 2^84 as double bits, the high word of a value becomes the mantissa
+constexpr uint64_t MAGIC_HIGH = 0x4530000000000000ull;
+/// 2^84 + 2^52
+constexpr double MAGIC_UNSIGNED = 19342813118337666422669312.0;
+/// 2^84 + 2^63 + 2^52, compensates the flipped sign bit of signed values
+constexpr double MAGIC_SIGNED = 19342822341709703277445120.0;
+/// The sign bit
+constexpr uint64_t SIGN_BIT = 0x8000000000000000ull;
+
+/// Powers of ten
+constexpr double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11, 1e12,
+                                    1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25,
+                                    1e26, 1e27, 1e28, 1e29, 1e30, 1e31, 1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38};
+
+/// Get a power of ten
+double GetPowerOfTen(int32_t exponent) {
+    if (exponent >= 0 && exponent <= 38) return POWERS_OF_TEN[exponent];
+    return std::pow(10.0, exponent);
+}
+
+/// Convert 64-bit integers to double.
+/// The high and low words are placed in the mantissas of 2^84 and 2^52, subtracting the magic number leaves the exact
+/// high part which is rounded once when the low part is added. Signed values flip the sign bit first.
+template <bool SIGNED> size_t CastWordsToDouble(const uint64_t* in, double* out, size_t count) {
+    size_t i = 0;
+    constexpr double magic = SIGNED ? MAGIC_SIGNED : MAGIC_UNSIGNED;
+#if defined(WEBDB_SIMD)
+    const v128_t flip = wasm_i64x2_splat(SIGNED ? SIGN_BIT : 0);
+    const v128_t low_mask = wasm_i64x2_splat(0xFFFFFFFFull);
+    const v128_t magic_low = wasm_i64x2_splat(MAGIC_LOW);
+    const v128_t magic_high = wasm_i64x2_splat(MAGIC_HIGH);
+    const v128_t magic_all = wasm_f64x2_splat(magic);
+    for (; i + 2 <= count; i += 2) {
+        v128_t x = wasm_v128_xor(wasm_v128_load(in + i), flip);
+        v128_t low = wasm_v128_or(wasm_v128_and(x, low_mask), magic_low);
+        v128_t high = wasm_v128_or(wasm_u64x2_shr(x, 32), magic_high);
+        v128_t result = wasm_f64x2_add(wasm_f64x2_sub(high, magic_all), low);
+        wasm_v128_store(out + i, result);
+    }
+#elif defined(__AVX2__)
+    const __m256i flip = _mm256_set1_epi64x(SIGNED ? SIGN_BIT : 0);
+    const __m256i low_mask = _mm256_set1_epi64x(0xFFFFFFFFll);
+    const __m256i magic_low = _mm256_set1_epi64x(MAGIC_LOW);
+    const __m256i magic_high = _mm256_set1_epi64x(MAGIC_HIGH);
+    const __m256d magic_all = _mm256_set1_pd(magic);
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), flip);
+        __m256i low = _mm256_or_si256(_mm256_and_si256(x, low_mask), magic_low);
+        __m256i high = _mm256_or_si256(_mm256_srli_epi64(x, 32), magic_high);
+        __m256d result =
+            _mm256_add_pd(_mm256_sub_pd(_mm256_castsi256_pd(high), magic_all), _mm256_castsi256_pd(low));
+        _mm256_storeu_pd(out + i, result);
+    }
+#elif defined(__SSE2__)
+    const __m128i flip = _mm_set1_epi64x(SIGNED ? SIGN_BIT : 0);
+    const __m128i low_mask = _mm_set1_epi64x(0xFFFFFFFFll);
+    const __m128i magic_low = _mm_set1_epi64x(MAGIC_LOW);
+    const __m128i magic_high = _mm_set1_epi64x(MAGIC_HIGH);
+    const __m128d magic_all = _mm_set1_pd(magic);
+    for (; i + 2 <= count; i += 2) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), flip);
+        __m128i low = _mm_or_si128(_mm_and_si128(x, low_mask), magic_low);
+        __m128i high = _mm_or_si128(_mm_srli_epi64(x, 32), magic_high);
+        __m128d result = _mm_add_pd(_mm_sub_pd(_mm_castsi128_pd(high), magic_all), _mm_castsi128_pd(low));
+        _mm_storeu_pd(out + i, result);
+    }
+#endif
+    return i;
+}
+
+/// Divide int64 values by a constant, the compiler replaces the division with a multiplication
+template <int64_t DIVISOR> void DivideInt64(const int64_t* in, int64_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = in[i] / DIVISOR;
+    }
+}
+
+}  // namespace
+
+/// Cast int64 values to double
+void CastInt64ToDouble(const int64_t* in, double* out, size_t count) {
+    auto i = CastWordsToDouble<true>(reinterpret_cast<const uint64_t*>(in), out, count);
+    for (; i < count; ++i) {
+        out[i] = static_cast<double>(in[i]);
+    }
+}
+
+/// Cast uint64 values to double
+void CastUInt64ToDouble(const uint64_t* in, double* out, size_t count) {
+    auto i = CastWordsToDouble<false>(in, out, count);
+    for (; i < count; ++i) {
+        out[i] = static_cast<double>(in[i]);
+    }
+}
+
+/// Scale int64 values with a multiplier and a truncating divisor
+void ScaleInt64(const int64_t* in, int64_t* out, size_t count, int64_t multiplier, int64_t divisor) {
+    if (multiplier == 1 && divisor == 1) {
+        if (in != out) std::memmove(out, in, count * sizeof(int64_t));
+        return;
+    }
+    if (multiplier == 1) {
+        switch (divisor) {
+            case 1000:
+                DivideInt64<1000>(in, out, count);
+                return;
+            case 1000 * 1000:
+                DivideInt64<1000 * 1000>(in, out, count);
+                return;
+            default:
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = in[i] / divisor;
+                }
+                return;
+        }
+    }
+    size_t i = 0;
+#if defined(WEBDB_SIMD)
+    if (divisor == 1) {
+        const v128_t factor = wasm_i64x2_splat(multiplier);
+        for (; i + 2 <= count; i += 2) {
+            wasm_v128_store(out + i, wasm_i64x2_mul(wasm_v128_load(in + i), factor));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = in[i] * multiplier / divisor;
+    }
+}
+
+/// Cast decimals with 16, 32 or 64 bit values to double
+template <typename T> void CastDecimalToDouble(const T* in, double* out, size_t count, int32_t scale) {
+    if constexpr (sizeof(T) == sizeof(int64_t)) {
+        CastInt64ToDouble(reinterpret_cast<const int64_t*>(in), out, count);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<double>(in[i]);
+        }
+    }
+    if (scale == 0) return;
+    auto divisor = GetPowerOfTen(scale);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] /= divisor;
+    }
+}
+
+template void CastDecimalToDouble<int16_t>(const int16_t* in, double* out, size_t count, int32_t scale);
+template void CastDecimalToDouble<int32_t>(const int32_t* in, double* out, size_t count, int32_t scale);
+template void CastDecimalToDouble<int64_t>(const int64_t* in, double* out, size_t count, int32_t scale);
+
+/// Cast 128 bit decimals, stored as pairs of low and high words, to double
+void CastDecimal128ToDouble(const uint64_t* in, double* out, size_t count, int32_t scale) {
+    auto divisor = GetPowerOfTen(scale);
+    for (size_t i = 0; i < count; ++i) {
+        auto low = in[2 * i];
+        auto high = static_cast<int64_t>(in[2 * i + 1]);
+        // Values that fit into 64 bits are converted exactly like the narrower decimals
+        double value;
+        if (high == (static_cast<int64_t>(low) >> 63)) {
+            value = static_cast<double>(static_cast<int64_t>(low));
+        } else {
+            value = static_cast<double>(high) * 18446744073709551616.0 + static_cast<double>(low);
+        }
+        out[i] = scale == 0 ? value : value / divisor;
+    }
+}
+
+}  // namespace kernels
+}  // namespace web
+}  // namespace duckdb
@@ -1,6 +1,7 @@
 #include "duckdb/web/arrow_casts.h"
 
 #include <arrow/array/array_decimal.h>
+#include <arrow/array/util.h>
 #include <arrow/buffer.h>
 #include <arrow/result.h>
 #include <arrow/type_fwd.h>
@@ -8,7 +9,9 @@
 
 #include <chrono>
 #include <iomanip>
+#include <type_traits>
 
+#include "duckdb/web/arrow_cast_kernels.h"
 #include "duckdb/web/config.h"
 #include "duckdb/web/webdb.h"
 
@@ -48,160 +51,143 @@ std::shared_ptr<arrow::Schema> patchSchema(const std::shared_ptr<arrow::Schema>&
     }
 }
 
-/// Helper to cast a record batch
-arrow::Result<std::shared_ptr<arrow::RecordBatch>> patchRecordBatch(const std::shared_ptr<arrow::RecordBatch>& batch,
-                                                                    const std::shared_ptr<arrow::Schema>& schema,
-                                                                    const QueryConfig& config) {
-    // Schema the same?
-    if (batch->schema() == schema) return batch;
+namespace {
 
-    // Patch all columns
-    std::vector<std::shared_ptr<arrow::Array>> arrays;
-    for (auto& column : batch->columns()) {
-        std::shared_ptr<arrow::Array> out = column;
-        switch (out->type_id()) {
-            case arrow::Type::INT64: {
-                if (config.cast_bigint_to_double.value_or(false)) {
-                    auto array = std::dynamic_pointer_cast<arrow::Int64Array>(out);
-                    auto in = reinterpret_cast<const arrow::Int64Type::c_type*>(array->values()->data());
-                    ARROW_ASSIGN_OR_RAISE(auto buffer,
-                                          arrow::AllocateBuffer(array->length() * sizeof(arrow::DoubleType::c_type)));
-                    auto writer = reinterpret_cast<arrow::DoubleType::c_type*>(buffer->mutable_data());
-                    for (auto i = 0; i < array->length(); ++i) {
-                        writer[i] = in[i];
-                    }
-                    out = std::make_shared<arrow::DoubleArray>(
-                        array->length(), std::shared_ptr<arrow::Buffer>(buffer.release()), array->null_bitmap(),
-                        array->null_count(), array->offset());
-                }
-                break;
+/// Plan the cast of a column
+ColumnCast planColumnCast(const arrow::DataType& type, const QueryConfig& config) {
+    ColumnCast cast;
+    switch (type.id()) {
+        case arrow::Type::INT64:
+            if (config.cast_bigint_to_double.value_or(false)) {
+                cast = {.kind = ColumnCast::Kind::INT64_TO_DOUBLE, .type = arrow::float64()};
             }
-            case arrow::Type::UINT64: {
-                if (config.cast_bigint_to_double.value_or(false)) {
-                    auto array = std::dynamic_pointer_cast<arrow::UInt64Array>(out);
-                    auto in = reinterpret_cast<const arrow::UInt64Type::c_type*>(array->values()->data());
-                    ARROW_ASSIGN_OR_RAISE(auto buffer,
-                                          arrow::AllocateBuffer(array->length() * sizeof(arrow::DoubleType::c_type)));
-                    auto writer = reinterpret_cast<arrow::DoubleType::c_type*>(buffer->mutable_data());
-                    for (auto i = 0; i < array->length(); ++i) {
-                        writer[i] = in[i];
-                    }
-                    out = std::make_shared<arrow::DoubleArray>(
-                        array->length(), std::shared_ptr<arrow::Buffer>(buffer.release()), array->null_bitmap(),
-                        array->null_count(), array->offset());
-                }
-                break;
+            break;
+        case arrow::Type::UINT64:
+            if (config.cast_bigint_to_double.value_or(false)) {
+                cast = {.kind = ColumnCast::Kind::UINT64_TO_DOUBLE, .type = arrow::float64()};
             }
-            case arrow::Type::TIMESTAMP: {
-                if (config.cast_timestamp_to_date.value_or(false)) {
-                    static_assert(std::is_same<arrow::TimestampType::c_type, int64_t>::value);
-                    static_assert(std::is_same<arrow::Date64Type::c_type, int64_t>::value);
-                    auto array = std::dynamic_pointer_cast<arrow::TimestampArray>(out);
-                    auto type = reinterpret_cast<const arrow::TimestampType*>(array->type().get());
-                    auto in = reinterpret_cast<const arrow::TimestampType::c_type*>(array->values()->data());
-                    ARROW_ASSIGN_OR_RAISE(auto buffer,
-                                          arrow::AllocateBuffer(array->length() * sizeof(arrow::Date64Type::c_type)));
-                    auto writer = reinterpret_cast<arrow::Date64Type::c_type*>(buffer->mutable_data());
-                    switch (type->unit()) {
-                        case arrow::TimeUnit::SECOND:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i] * 1000;
-                            }
-                            break;
-                        case arrow::TimeUnit::MILLI:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i];
-                            }
-                            break;
-                        case arrow::TimeUnit::MICRO:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i] / 1000;
-                            }
-                            break;
-                        case arrow::TimeUnit::NANO:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i] / (1000 * 1000);
-                            }
-                            break;
-                    }
-                    out = std::make_shared<arrow::Date64Array>(
-                        array->length(), std::shared_ptr<arrow::Buffer>(buffer.release()), array->null_bitmap(),
-                        array->null_count(), array->offset());
+            break;
+        case arrow::Type::TIMESTAMP:
+            if (config.cast_timestamp_to_date.value_or(false)) {
+                static_assert(std::is_same<arrow::TimestampType::c_type, int64_t>::value);
+                static_assert(std::is_same<arrow::Date64Type::c_type, int64_t>::value);
+                cast = {.kind = ColumnCast::Kind::SCALE_INT64, .type = arrow::date64()};
+                switch (static_cast<const arrow::TimestampType&>(type).unit()) {
+                    case arrow::TimeUnit::SECOND:
+                        cast.multiplier = 1000;
+                        break;
+                    case arrow::TimeUnit::MILLI:
+                        break;
+                    case arrow::TimeUnit::MICRO:
+                        cast.divisor = 1000;
+                        break;
+                    case arrow::TimeUnit::NANO:
+                        cast.divisor = 1000 * 1000;
+                        break;
                 }
-                break;
             }
-            case arrow::Type::DURATION: {
-                if (config.cast_duration_to_time64.value_or(false)) {
-                    static_assert(std::is_same<arrow::DurationType::c_type, int64_t>::value);
-                    static_assert(std::is_same<arrow::Time64Type::c_type, int64_t>::value);
-                    auto array = std::dynamic_pointer_cast<arrow::DurationArray>(out);
-                    auto type = reinterpret_cast<const arrow::DurationType*>(array->type().get());
-                    auto in = reinterpret_cast<const arrow::Time64Type::c_type*>(array->values()->data());
-                    ARROW_ASSIGN_OR_RAISE(auto buffer,
-                                          arrow::AllocateBuffer(array->length() * sizeof(arrow::Time64Type::c_type)));
-                    auto writer = reinterpret_cast<arrow::Time64Type::c_type*>(buffer->mutable_data());
-
-                    auto cast_to_type = type->unit() == arrow::TimeUnit::NANO ? arrow::time64(arrow::TimeUnit::NANO)
-                                                                              : arrow::time64(arrow::TimeUnit::MICRO);
-                    switch (type->unit()) {
-                        case arrow::TimeUnit::SECOND:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i] * 1000 * 1000;  // Converted to Micro
-                            }
-                            break;
-                        case arrow::TimeUnit::MILLI:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i] * 1000;  // Converted to Micro
-                            }
-                            break;
-                        case arrow::TimeUnit::MICRO:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i];
-                            }
-                            break;
-                        case arrow::TimeUnit::NANO:
-                            for (auto i = 0; i < array->length(); ++i) {
-                                writer[i] = in[i];
-                            }
-                            break;
-                    }
-
-                    out = std::make_shared<arrow::Time64Array>(
-                        cast_to_type, array->length(), std::shared_ptr<arrow::Buffer>(buffer.release()),
-                        array->null_bitmap(), array->null_count(), array->offset());
+            break;
+        case arrow::Type::DURATION:
+            if (config.cast_duration_to_time64.value_or(false)) {
+                static_assert(std::is_same<arrow::DurationType::c_type, int64_t>::value);
+                static_assert(std::is_same<arrow::Time64Type::c_type, int64_t>::value);
+                auto unit = static_cast<const arrow::DurationType&>(type).unit();
+                cast = {.kind = ColumnCast::Kind::SCALE_INT64,
+                        .type = unit == arrow::TimeUnit::NANO ? arrow::time64(arrow::TimeUnit::NANO)
+                                                              : arrow::time64(arrow::TimeUnit::MICRO)};
+                switch (unit) {
+                    case arrow::TimeUnit::SECOND:
+                        cast.multiplier = 1000 * 1000;  // Converted to Micro
+                        break;
+                    case arrow::TimeUnit::MILLI:
+                        cast.multiplier = 1000;  // Converted to Micro
+                        break;
+                    case arrow::TimeUnit::MICRO:
+                    case arrow::TimeUnit::NANO:
+                        break;
                 }
-                break;
             }
-            case arrow::Type::DECIMAL128: {
-                if (config.cast_decimal_to_double.value_or(false)) {
-                    auto type = reinterpret_cast<const arrow::Decimal128Type*>(out->type().get());
-                    auto scale = type->scale();
-                    auto array = std::dynamic_pointer_cast<arrow::Decimal128Array>(out);
+            break;
+        case arrow::Type::DECIMAL128:
+            if (config.cast_decimal_to_double.value_or(false)) {
+                cast = {.kind = ColumnCast::Kind::DECIMAL128_TO_DOUBLE,
+                        .type = arrow::float64(),
+                        .scale = static_cast<const arrow::Decimal128Type&>(type).scale()};
+            }
+            break;
+        default:
+            break;
+    }
+    return cast;
+}
 
-                    ARROW_ASSIGN_OR_RAISE(auto buffer,
-                                          arrow::AllocateBuffer(array->length() * sizeof(arrow::DoubleType::c_type)));
+/// Cast a column.
+/// The kernels convert the offset values as well, the casted arrays keep the offset of the validity bitmap.
+arrow::Result<std::shared_ptr<arrow::Array>> castColumn(const std::shared_ptr<arrow::Array>& array,
+                                                        const ColumnCast& cast) {
+    if (cast.kind == ColumnCast::Kind::NONE) return array;
+    auto values = array->length() + array->offset();
+    auto in = array->data()->buffers[1]->data();
+    ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateBuffer(values * sizeof(int64_t)));
+    switch (cast.kind) {
+        case ColumnCast::Kind::INT64_TO_DOUBLE:
+            kernels::CastInt64ToDouble(reinterpret_cast<const int64_t*>(in),
+                                       reinterpret_cast<double*>(buffer->mutable_data()), values);
+            break;
+        case ColumnCast::Kind::UINT64_TO_DOUBLE:
+            kernels::CastUInt64ToDouble(reinterpret_cast<const uint64_t*>(in),
+                                        reinterpret_cast<double*>(buffer->mutable_data()), values);
+            break;
+        case ColumnCast::Kind::SCALE_INT64:
+            kernels::ScaleInt64(reinterpret_cast<const int64_t*>(in), reinterpret_cast<int64_t*>(buffer->mutable_data()),
+                                values, cast.multiplier, cast.divisor);
+            break;
+        case ColumnCast::Kind::DECIMAL128_TO_DOUBLE:
+            kernels::CastDecimal128ToDouble(reinterpret_cast<const uint64_t*>(in),
+                                            reinterpret_cast<double*>(buffer->mutable_data()), values, cast.scale);
+            break;
+        case ColumnCast::Kind::NONE:
+            break;
+    }
+    return arrow::MakeArray(arrow::ArrayData::Make(cast.type, array->length(),
+                                                   {array->null_bitmap(), std::shared_ptr<arrow::Buffer>(std::move(buffer))},
+                                                   array->null_count(), array->offset()));
+}
 
-                    auto writer = reinterpret_cast<arrow::DoubleType::c_type*>(buffer->mutable_data());
+}  // namespace
 
-                    for (auto i = 0; i < array->length(); ++i) {
-                        const arrow::Decimal128 out_value(array->GetValue(i));
-                        writer[i] = out_value.ToDouble(scale);
-                    }
+/// Plan the casts of the record batches with a schema
+RecordBatchCasts planRecordBatchCasts(const arrow::Schema& schema, const std::shared_ptr<arrow::Schema>& patched_schema,
+                                      const QueryConfig& config) {
+    RecordBatchCasts casts{.schema = patched_schema};
+    casts.columns.reserve(schema.num_fields());
+    for (auto& field : schema.fields()) {
+        casts.columns.push_back(planColumnCast(*field->type(), config));
+        casts.any |= casts.columns.back().kind != ColumnCast::Kind::NONE;
+    }
+    return casts;
+}
 
-                    out = std::make_shared<arrow::DoubleArray>(
-                        array->length(), std::shared_ptr<arrow::Buffer>(buffer.release()), array->null_bitmap(),
-                        array->null_count(), array->offset());
-                }
-                break;
-            }
-            default:
-                break;
-        }
+/// Helper to cast a record batch with planned casts
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> patchRecordBatch(const std::shared_ptr<arrow::RecordBatch>& batch,
+                                                                    const RecordBatchCasts& casts) {
+    if (!casts.any) return batch;
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    arrays.reserve(batch->num_columns());
+    for (int i = 0; i < batch->num_columns(); ++i) {
+        ARROW_ASSIGN_OR_RAISE(auto out, castColumn(batch->column(i), casts.columns[i]));
         arrays.push_back(std::move(out));
     }
+    return arrow::RecordBatch::Make(casts.schema, batch->num_rows(), std::move(arrays));
+}
 
-    // Create a record batch
-    return arrow::RecordBatch::Make(schema, batch->num_rows(), arrays);
+/// Helper to cast a record batch
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> patchRecordBatch(const std::shared_ptr<arrow::RecordBatch>& batch,
+                                                                    const std::shared_ptr<arrow::Schema>& schema,
+                                                                    const QueryConfig& config) {
+    // Schema the same?
+    if (batch->schema() == schema) return batch;
+    return patchRecordBatch(batch, planRecordBatchCasts(*batch->schema(), schema, config));
 }
 
 }  // namespace web
@@ -0,0 +1,212 @@
+#include "duckdb/web/arrow_dictionary_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "arrow/array/array_binary.h"
+#include "arrow/array/array_dict.h"
+#include "arrow/array/builder_primitive.h"
+#include "arrow/ipc/message.h"
+#include "duckdb/common/types/string_type.hpp"
+#include "duckdb/common/types/vector.hpp"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// Writes IPC payloads into a buffered output stream and drops the schema
+class MessagePayloadWriter : public arrow::ipc::internal::IpcPayloadWriter {
+   protected:
+    /// The output stream
+    arrow::io::OutputStream* out_;
+    /// The write options
+    arrow::ipc::IpcWriteOptions options_;
+
+   public:
+    /// Constructor
+    MessagePayloadWriter(arrow::io::OutputStream* out, const arrow::ipc::IpcWriteOptions& options)
+        : out_(out), options_(options) {}
+
+    /// Start writing
+    arrow::Status Start() override { return arrow::Status::OK(); }
+    /// Write a payload
+    arrow::Status WritePayload(const arrow::ipc::IpcPayload& payload) override {
+        if (payload.type == arrow::ipc::MessageType::SCHEMA) return arrow::Status::OK();
+        int32_t metadata_length = 0;
+        return arrow::ipc::WriteIpcPayload(payload, options_, out_, &metadata_length);
+    }
+    /// Close the writer
+    arrow::Status Close() override { return arrow::Status::OK(); }
+};
+
+}  // namespace
+
+/// Get the index of a value, adds the value if it is new
+arrow::Result<int32_t> ArrowDictionaryEncoder::Dictionary::GetIndex(const duckdb::string_t& value) {
+    auto iter = indices.find(value);
+    if (iter != indices.end()) return iter->second;
+    auto size = value.GetSize();
+    if (data.size() + size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        return arrow::Status::CapacityError("dictionary of column ", column, " exceeds 2GB");
+    }
+    auto index = static_cast<int32_t>(offsets.size() - 1);
+    indices.insert({heap.AddBlob(value), index});
+    data.append(value.GetData(), size);
+    offsets.push_back(static_cast<int32_t>(data.size()));
+    return index;
+}
+
+/// Get the dictionary as Arrow array, copies the values only if the dictionary grew
+arrow::Result<std::shared_ptr<arrow::Array>> ArrowDictionaryEncoder::Dictionary::Finish() {
+    auto length = static_cast<int64_t>(offsets.size() - 1);
+    // The IPC writers skip a dictionary that is the same array as before
+    if (finished && finished->length() == length) return finished;
+    ARROW_ASSIGN_OR_RAISE(auto offset_buffer, arrow::AllocateBuffer(offsets.size() * sizeof(int32_t)));
+    std::memcpy(offset_buffer->mutable_data(), offsets.data(), offsets.size() * sizeof(int32_t));
+    ARROW_ASSIGN_OR_RAISE(auto data_buffer, arrow::AllocateBuffer(data.size()));
+    std::memcpy(data_buffer->mutable_data(), data.data(), data.size());
+    finished = std::make_shared<arrow::StringArray>(length, std::move(offset_buffer), std::move(data_buffer));
+    return finished;
+}
+
+/// Should the column fall back to plain strings?
+bool ArrowDictionaryEncoder::Dictionary::ExceedsThresholds() const {
+    if (data.size() > MAX_DICTIONARY_BYTES) return true;
+    auto distinct = static_cast<double>(offsets.size() - 1);
+    return rows >= MIN_RATIO_ROWS && distinct > MAX_DISTINCT_RATIO * static_cast<double>(rows);
+}
+
+/// Fall back to plain strings and drop the values
+void ArrowDictionaryEncoder::Dictionary::FallBack() {
+    plain = true;
+    indices = {};
+    heap.Destroy();
+    offsets = {0};
+    data = {};
+    finished = nullptr;
+}
+
+/// Create an encoder for DuckDB types and the patched Arrow schema, returns nullptr without string columns
+std::unique_ptr<ArrowDictionaryEncoder> ArrowDictionaryEncoder::Create(const duckdb::vector<LogicalType>& types,
+                                                                       const arrow::Schema& schema) {
+    std::vector<std::unique_ptr<Dictionary>> dictionaries;
+    std::vector<std::shared_ptr<arrow::Field>> fields = schema.fields();
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (types[i].id() != LogicalTypeId::VARCHAR || fields[i]->type()->id() != arrow::Type::STRING) continue;
+        fields[i] = fields[i]->WithType(arrow::dictionary(arrow::int32(), arrow::utf8()));
+        dictionaries.push_back(std::make_unique<Dictionary>(i));
+    }
+    if (dictionaries.empty()) return nullptr;
+    return std::make_unique<ArrowDictionaryEncoder>(std::move(dictionaries),
+                                                    arrow::schema(std::move(fields), schema.metadata()));
+}
+
+/// Encode the indices of a string vector
+arrow::Result<std::shared_ptr<arrow::Array>> ArrowDictionaryEncoder::EncodeIndices(Dictionary& dictionary,
+                                                                                   Vector& vector, size_t count) {
+    UnifiedVectorFormat format;
+    vector.ToUnifiedFormat(count, format);
+    auto values = UnifiedVectorFormat::GetData<string_t>(format);
+
+    arrow::Int32Builder builder;
+    ARROW_RETURN_NOT_OK(builder.Reserve(count));
+
+    // Flat vectors reference every value once
+    auto vector_type = vector.GetVectorType();
+    if (vector_type != VectorType::DICTIONARY_VECTOR && vector_type != VectorType::CONSTANT_VECTOR) {
+        for (size_t i = 0; i < count; ++i) {
+            auto idx = format.sel->get_index(i);
+            if (!format.validity.RowIsValid(idx)) {
+                builder.UnsafeAppendNull();
+                continue;
+            }
+            ARROW_ASSIGN_OR_RAISE(auto index, dictionary.GetIndex(values[idx]));
+            builder.UnsafeAppend(index);
+        }
+        return builder.Finish();
+    }
+
+    // Map the entries of dictionary and constant vectors once
+    size_t entries = 0;
+    for (size_t i = 0; i < count; ++i) {
+        entries = std::max<size_t>(entries, format.sel->get_index(i) + 1);
+    }
+    std::vector<int32_t> mapped(entries, -1);
+    for (size_t i = 0; i < count; ++i) {
+        auto idx = format.sel->get_index(i);
+        if (!format.validity.RowIsValid(idx)) {
+            builder.UnsafeAppendNull();
+            continue;
+        }
+        if (mapped[idx] < 0) {
+            ARROW_ASSIGN_OR_RAISE(mapped[idx], dictionary.GetIndex(values[idx]));
+        }
+        builder.UnsafeAppend(mapped[idx]);
+    }
+    return builder.Finish();
+}
+
+/// Replace the string columns of a record batch that was exported from a data chunk
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> ArrowDictionaryEncoder::Encode(
+    DataChunk& chunk, const std::shared_ptr<arrow::RecordBatch>& batch) {
+    auto columns = batch->columns();
+    for (auto& dictionary : dictionaries_) {
+        auto& column = columns[dictionary->column];
+        auto& type = schema_->field(dictionary->column)->type();
+
+        // Plain columns keep the exported strings, either as utf8 or as a dictionary of this batch
+        if (dictionary->plain) {
+            if (type->id() != arrow::Type::DICTIONARY) continue;
+            arrow::Int32Builder builder;
+            ARROW_RETURN_NOT_OK(builder.Reserve(column->length()));
+            for (int64_t i = 0; i < column->length(); ++i) {
+                if (column->IsNull(i)) {
+                    builder.UnsafeAppendNull();
+                } else {
+                    builder.UnsafeAppend(static_cast<int32_t>(i));
+                }
+            }
+            ARROW_ASSIGN_OR_RAISE(auto indices, builder.Finish());
+            column = std::make_shared<arrow::DictionaryArray>(type, std::move(indices), column);
+            continue;
+        }
+
+        ARROW_ASSIGN_OR_RAISE(auto indices, EncodeIndices(*dictionary, chunk.data[dictionary->column], chunk.size()));
+        dictionary->rows += chunk.size();
+        auto fall_back = dictionary->ExceedsThresholds() && (!schema_fixed_ || allow_replacements_);
+        if (fall_back && !schema_fixed_) {
+            dictionary->FallBack();
+            auto fields = schema_->fields();
+            fields[dictionary->column] = fields[dictionary->column]->WithType(arrow::utf8());
+            schema_ = arrow::schema(std::move(fields), schema_->metadata());
+            continue;
+        }
+        ARROW_ASSIGN_OR_RAISE(auto values, dictionary->Finish());
+        column = std::make_shared<arrow::DictionaryArray>(type, std::move(indices), std::move(values));
+        if (fall_back) dictionary->FallBack();
+    }
+    return arrow::RecordBatch::Make(schema_, batch->num_rows(), std::move(columns));
+}
+
+/// Create a writer for a schema
+arrow::Result<std::unique_ptr<ArrowIPCMessageWriter>> ArrowIPCMessageWriter::Create(
+    const std::shared_ptr<arrow::Schema>& schema, const arrow::ipc::IpcWriteOptions& options) {
+    ARROW_ASSIGN_OR_RAISE(auto out, arrow::io::BufferOutputStream::Create());
+    auto payload_writer = std::make_unique<MessagePayloadWriter>(out.get(), options);
+    ARROW_ASSIGN_OR_RAISE(auto writer,
+                          arrow::ipc::internal::OpenRecordBatchWriter(std::move(payload_writer), schema, options));
+    return std::make_unique<ArrowIPCMessageWriter>(std::move(out), std::move(writer));
+}
+
+/// Write a record batch and return its messages
+arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowIPCMessageWriter::Write(const arrow::RecordBatch& batch) {
+    ARROW_RETURN_NOT_OK(writer_->WriteRecordBatch(batch));
+    ARROW_ASSIGN_OR_RAISE(auto buffer, out_->Finish());
+    ARROW_RETURN_NOT_OK(out_->Reset());
+    return buffer;
+}
+
+}  // namespace web
+}  // namespace duckdb
@@ -0,0 +1,194 @@
+#include "duckdb/web/arrow_export_context.h"
+
+#include "arrow/c/bridge.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/dictionary.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/util/compression.h"
+#include "duckdb/common/arrow/arrow.hpp"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// Get the IPC write options for query results
+arrow::Result<arrow::ipc::IpcWriteOptions> GetResultIPCOptions(const QueryConfig& config) {
+    auto options = arrow::ipc::IpcWriteOptions::Defaults();
+    options.use_threads = false;
+    options.emit_dictionary_deltas = config.dictionary_encode_strings.value_or(false);
+    if (!config.hasResultCompression()) {
+        return options;
+    }
+    arrow::Compression::type compression;
+    auto& name = *config.result_compression;
+    if (name == "lz4") {
+        compression = arrow::Compression::LZ4_FRAME;
+    } else if (name == "zstd") {
+        compression = arrow::Compression::ZSTD;
+    } else {
+        return arrow::Status::Invalid("unsupported result compression: ", name);
+    }
+    if (!arrow::util::Codec::IsAvailable(compression)) {
+        return arrow::Status::NotImplemented("result compression is not available in this build: ", name,
+                                             " (IPC codecs are only built with DUCKDB_WASM_IPC_COMPRESSION)");
+    }
+    ARROW_ASSIGN_OR_RAISE(options.codec, arrow::util::Codec::Create(compression));
+    return options;
+}
+
+}  // namespace
+
+/// Create the export context of a query result
+arrow::Result<std::unique_ptr<ArrowExportContext>> ArrowExportContext::Create(
+    duckdb::ClientContext& context, const duckdb::vector<duckdb::LogicalType>& types,
+    const duckdb::vector<std::string>& names, const WebDBConfig& config) {
+    ClientProperties options("UTC", ArrowOffsetSize::REGULAR, false, false, config.arrow_lossless_conversion,
+                             ArrowFormatVersion::V1_0, &context);
+    options.arrow_offset_size = ArrowOffsetSize::REGULAR;
+    auto export_context = std::make_unique<ArrowExportContext>(
+        options, ArrowTypeExtensionData::GetExtensionTypes(context, types));
+
+    // Import the schema and plan the casts
+    ArrowSchema raw_schema;
+    ArrowConverter::ToArrowSchema(&raw_schema, types, names, options);
+    ARROW_ASSIGN_OR_RAISE(export_context->schema_, arrow::ImportSchema(&raw_schema));
+    auto patched_schema = patchSchema(export_context->schema_, config.query);
+    export_context->casts_ = planRecordBatchCasts(*export_context->schema_, patched_schema, config.query);
+
+    // Set up the encoders
+    ARROW_ASSIGN_OR_RAISE(export_context->ipc_options_, GetResultIPCOptions(config.query));
+    if (config.query.dictionary_encode_strings.value_or(false)) {
+        export_context->dictionary_encoder_ = ArrowDictionaryEncoder::Create(types, *patched_schema);
+    }
+    // Encode the chunks directly as IPC messages if all columns are supported and the bodies are plain
+    if (!export_context->ipc_options_.codec && !export_context->dictionary_encoder_) {
+        export_context->encoder_ = ArrowIPCEncoder::Create(types, *patched_schema);
+    }
+    return export_context;
+}
+
+/// Export a data chunk as record batch with the generic export
+arrow::Result<std::shared_ptr<arrow::RecordBatch>> ArrowExportContext::ExportChunk(duckdb::DataChunk& chunk) {
+    // Import the data chunk as record batch
+    ArrowArray array;
+    ArrowConverter::ToArrowArray(chunk, &array, options_, extension_type_cast_);
+    ARROW_ASSIGN_OR_RAISE(auto batch, arrow::ImportRecordBatch(&array, schema_));
+    // Patch the record batch
+    ARROW_ASSIGN_OR_RAISE(batch, patchRecordBatch(batch, casts_));
+    // Dictionary-encode the strings
+    if (dictionary_encoder_) {
+        ARROW_ASSIGN_OR_RAISE(batch, dictionary_encoder_->Encode(chunk, batch));
+    }
+    return batch;
+}
+
+/// Serialize the schema of a streamed result
+arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowExportContext::SerializeSchema() {
+    FixSchema(true);
+    if (dictionary_encoder_) {
+        ARROW_ASSIGN_OR_RAISE(message_writer_, ArrowIPCMessageWriter::Create(GetSchema(), ipc_options_));
+    }
+    return arrow::ipc::SerializeSchema(*GetSchema());
+}
+
+/// Encode chunks of a streamed result as a single record batch message
+arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowExportContext::EncodeChunks(
+    std::vector<duckdb::unique_ptr<duckdb::DataChunk>>& chunks) {
+    // Encode the chunks directly if possible
+    if (encoder_) {
+        std::vector<duckdb::DataChunk*> chunk_ptrs;
+        for (auto& chunk : chunks) chunk_ptrs.push_back(chunk.get());
+        ARROW_ASSIGN_OR_RAISE(auto message, encoder_->Encode(chunk_ptrs));
+        return message.GetMessage();
+    }
+
+    // Concatenate the chunks
+    if (chunks.size() > 1) {
+        idx_t rows = 0;
+        for (auto& chunk : chunks) rows += chunk->size();
+        auto combined = duckdb::make_uniq<duckdb::DataChunk>();
+        combined->Initialize(Allocator::DefaultAllocator(), chunks.front()->GetTypes(), rows);
+        for (auto& chunk : chunks) combined->Append(*chunk);
+        chunks.clear();
+        chunks.push_back(std::move(combined));
+    }
+
+    // Export the record batch
+    ARROW_ASSIGN_OR_RAISE(auto batch, ExportChunk(*chunks.front()));
+    // Write dictionary-encoded record batches with their dictionary deltas
+    if (message_writer_) {
+        return message_writer_->Write(*batch);
+    }
+    // Serialize the record batch
+    return arrow::ipc::SerializeRecordBatch(*batch, ipc_options_);
+}
+
+/// Write all chunks of a materialized result as IPC file
+arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowExportContext::WriteFile(duckdb::QueryResult& result) {
+    return WriteFile(std::vector<duckdb::QueryResult*>{&result});
+}
+
+/// Write all chunks of materialized results with the same types as a single IPC file
+arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowExportContext::WriteFile(
+    const std::vector<duckdb::QueryResult*>& results) {
+    ARROW_ASSIGN_OR_RAISE(auto out, arrow::io::BufferOutputStream::Create());
+    auto& schema = GetSchema();
+
+    // Write the directly encoded IPC messages
+    if (encoder_) {
+        ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::internal::MakePayloadFileWriter(out.get(), schema, ipc_options_));
+        ARROW_RETURN_NOT_OK(writer->Start());
+        arrow::ipc::IpcPayload schema_payload;
+        arrow::ipc::DictionaryFieldMapper mapper{*schema};
+        ARROW_RETURN_NOT_OK(arrow::ipc::GetSchemaPayload(*schema, ipc_options_, mapper, &schema_payload));
+        ARROW_RETURN_NOT_OK(writer->WritePayload(schema_payload));
+        for (auto* result : results) {
+            for (auto chunk = result->Fetch(); !!chunk && chunk->size() > 0; chunk = result->Fetch()) {
+                ARROW_ASSIGN_OR_RAISE(auto message, encoder_->Encode(*chunk));
+                ARROW_RETURN_NOT_OK(writer->WritePayload(message.GetPayload()));
+            }
+        }
+        ARROW_RETURN_NOT_OK(writer->Close());
+        return out->Finish();
+    }
+
+    // Write the exported record batches.
+    // The first batch may still turn dictionary columns into plain strings, the writer is created after it.
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    auto make_writer = [&]() -> arrow::Status {
+        FixSchema(false);
+        ARROW_ASSIGN_OR_RAISE(writer, arrow::ipc::MakeFileWriter(out, GetSchema(), ipc_options_));
+        return arrow::Status::OK();
+    };
+    for (auto* result : results) {
+        for (auto chunk = result->Fetch(); !!chunk && chunk->size() > 0; chunk = result->Fetch()) {
+            ARROW_ASSIGN_OR_RAISE(auto batch, ExportChunk(*chunk));
+            if (!writer) ARROW_RETURN_NOT_OK(make_writer());
+            ARROW_RETURN_NOT_OK(writer->WriteRecordBatch(*batch));
+        }
+    }
+    if (!writer) ARROW_RETURN_NOT_OK(make_writer());
+    ARROW_RETURN_NOT_OK(writer->Close());
+    return out->Finish();
+}
+
+/// Read the next record batch in the stream. Return null for batch when reaching end of stream
+arrow::Status ArrowQueryResultReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
+    *batch = nullptr;
+    if (!result_) return arrow::Status::OK();
+    try {
+        auto chunk = result_->Fetch();
+        if (!chunk || chunk->size() == 0) {
+            result_.reset();
+            return arrow::Status::OK();
+        }
+        ARROW_ASSIGN_OR_RAISE(*batch, export_context_->ExportChunk(*chunk));
+        return arrow::Status::OK();
+    } catch (std::exception& e) {
+        return arrow::Status::ExecutionError(e.what());
+    }
+}
+
+}  // namespace web
+}  // namespace duckdb
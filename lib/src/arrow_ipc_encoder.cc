@@ -0,0 +1,391 @@
+#include "duckdb/web/arrow_ipc_encoder.h"
+
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
+#include "duckdb/common/types/string_type.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include "duckdb/web/arrow_cast_kernels.h"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// Get the number of bytes of a bitmap
+size_t GetBitmapLength(size_t count) { return (count + 7) / 8; }
+
+/// Count the nulls of a vector
+int64_t CountNulls(const UnifiedVectorFormat& format, size_t count) {
+    if (format.validity.AllValid()) return 0;
+    int64_t nulls = 0;
+    for (size_t i = 0; i < count; ++i) {
+        nulls += !format.validity.RowIsValid(format.sel->get_index(i));
+    }
+    return nulls;
+}
+
+/// Set a bit in a bitmap
+void SetBit(uint8_t* bitmap, size_t i) { bitmap[i >> 3] |= 1 << (i & 7); }
+
+/// Write the validity bits of a vector into a zeroed bitmap
+void WriteValidity(const UnifiedVectorFormat& format, size_t count, uint8_t* out, size_t offset) {
+    size_t i = 0;
+    if (format.validity.AllValid()) {
+        for (; i < count; ++i) SetBit(out, offset + i);
+        return;
+    }
+    // DuckDB validity masks share the bit order of Arrow bitmaps
+    if (!format.sel->IsSet() && (offset & 7) == 0) {
+        std::memcpy(out + (offset >> 3), format.validity.GetData(), count >> 3);
+        i = count & ~static_cast<size_t>(7);
+    }
+    for (; i < count; ++i) {
+        if (format.validity.RowIsValid(format.sel->get_index(i))) SetBit(out, offset + i);
+    }
+}
+
+/// Gather fixed-width values
+template <typename T> void GatherValues(const UnifiedVectorFormat& format, size_t count, uint8_t* out) {
+    auto* in = UnifiedVectorFormat::GetData<T>(format);
+    auto* writer = reinterpret_cast<T*>(out);
+    for (size_t i = 0; i < count; ++i) {
+        writer[i] = in[format.sel->get_index(i)];
+    }
+}
+
+/// Cast 64-bit integers to double
+template <typename T> void CastToDouble(const UnifiedVectorFormat& format, size_t count, uint8_t* out) {
+    auto* in = UnifiedVectorFormat::GetData<T>(format);
+    auto* writer = reinterpret_cast<double*>(out);
+    if (!format.sel->IsSet()) {
+        if constexpr (std::is_signed_v<T>) {
+            kernels::CastInt64ToDouble(in, writer, count);
+        } else {
+            kernels::CastUInt64ToDouble(in, writer, count);
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        writer[i] = static_cast<double>(in[format.sel->get_index(i)]);
+    }
+}
+
+/// Cast decimals to double
+template <typename T> void CastDecimalToDouble(const UnifiedVectorFormat& format, size_t count, uint8_t* out,
+                                               int32_t scale) {
+    auto* in = UnifiedVectorFormat::GetData<T>(format);
+    auto* writer = reinterpret_cast<double*>(out);
+    std::vector<T> gathered;
+    if (format.sel->IsSet()) {
+        gathered.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            gathered[i] = in[format.sel->get_index(i)];
+        }
+        in = gathered.data();
+    }
+    if constexpr (std::is_same_v<T, hugeint_t>) {
+        static_assert(sizeof(hugeint_t) == 2 * sizeof(uint64_t));
+        kernels::CastDecimal128ToDouble(reinterpret_cast<const uint64_t*>(in), writer, count, scale);
+    } else {
+        kernels::CastDecimalToDouble<T>(in, writer, count, scale);
+    }
+}
+
+/// Get the time unit of a DuckDB timestamp type
+std::optional<arrow::TimeUnit::type> GetTimestampUnit(LogicalTypeId type) {
+    switch (type) {
+        case LogicalTypeId::TIMESTAMP_SEC:
+            return arrow::TimeUnit::SECOND;
+        case LogicalTypeId::TIMESTAMP_MS:
+            return arrow::TimeUnit::MILLI;
+        case LogicalTypeId::TIMESTAMP:
+        case LogicalTypeId::TIMESTAMP_TZ:
+            return arrow::TimeUnit::MICRO;
+        case LogicalTypeId::TIMESTAMP_NS:
+            return arrow::TimeUnit::NANO;
+        default:
+            return std::nullopt;
+    }
+}
+
+}  // namespace
+
+/// Create an encoder for DuckDB types and the patched Arrow schema, returns nullptr if not supported
+std::unique_ptr<ArrowIPCEncoder> ArrowIPCEncoder::Create(const duckdb::vector<duckdb::LogicalType>& types,
+                                                         const arrow::Schema& schema) {
+    if (static_cast<size_t>(schema.num_fields()) != types.size()) return nullptr;
+    std::vector<Column> columns;
+    columns.reserve(types.size());
+    for (size_t i = 0; i < types.size(); ++i) {
+        auto& arrow_type = *schema.field(i)->type();
+        auto fixed_width = [&](arrow::Type::type expected, size_t width) -> std::optional<Column> {
+            if (arrow_type.id() != expected) return std::nullopt;
+            return Column{.encoding = ColumnEncoding::FIXED_WIDTH, .width = width};
+        };
+        std::optional<Column> column;
+        switch (types[i].id()) {
+            case LogicalTypeId::BOOLEAN:
+                if (arrow_type.id() == arrow::Type::BOOL) column = Column{.encoding = ColumnEncoding::BOOLEAN};
+                break;
+            case LogicalTypeId::TINYINT:
+                column = fixed_width(arrow::Type::INT8, 1);
+                break;
+            case LogicalTypeId::SMALLINT:
+                column = fixed_width(arrow::Type::INT16, 2);
+                break;
+            case LogicalTypeId::INTEGER:
+                column = fixed_width(arrow::Type::INT32, 4);
+                break;
+            case LogicalTypeId::BIGINT:
+                column = fixed_width(arrow::Type::INT64, 8);
+                if (arrow_type.id() == arrow::Type::DOUBLE) {
+                    column = Column{.encoding = ColumnEncoding::BIGINT_TO_DOUBLE, .width = 8};
+                }
+                break;
+            case LogicalTypeId::UTINYINT:
+                column = fixed_width(arrow::Type::UINT8, 1);
+                break;
+            case LogicalTypeId::USMALLINT:
+                column = fixed_width(arrow::Type::UINT16, 2);
+                break;
+            case LogicalTypeId::UINTEGER:
+                column = fixed_width(arrow::Type::UINT32, 4);
+                break;
+            case LogicalTypeId::UBIGINT:
+                column = fixed_width(arrow::Type::UINT64, 8);
+                if (arrow_type.id() == arrow::Type::DOUBLE) {
+                    column = Column{.encoding = ColumnEncoding::UBIGINT_TO_DOUBLE, .width = 8};
+                }
+                break;
+            case LogicalTypeId::FLOAT:
+                column = fixed_width(arrow::Type::FLOAT, 4);
+                break;
+            case LogicalTypeId::DOUBLE:
+                column = fixed_width(arrow::Type::DOUBLE, 8);
+                break;
+            case LogicalTypeId::DATE:
+                column = fixed_width(arrow::Type::DATE32, 4);
+                break;
+            case LogicalTypeId::TIME:
+                if (arrow_type.id() == arrow::Type::TIME64 &&
+                    static_cast<const arrow::Time64Type&>(arrow_type).unit() == arrow::TimeUnit::MICRO) {
+                    column = Column{.encoding = ColumnEncoding::FIXED_WIDTH, .width = 8};
+                }
+                break;
+            case LogicalTypeId::TIMESTAMP_SEC:
+            case LogicalTypeId::TIMESTAMP_MS:
+            case LogicalTypeId::TIMESTAMP:
+            case LogicalTypeId::TIMESTAMP_TZ:
+            case LogicalTypeId::TIMESTAMP_NS: {
+                auto unit = *GetTimestampUnit(types[i].id());
+                if (arrow_type.id() == arrow::Type::TIMESTAMP &&
+                    static_cast<const arrow::TimestampType&>(arrow_type).unit() == unit) {
+                    column = Column{.encoding = ColumnEncoding::FIXED_WIDTH, .width = 8};
+                } else if (arrow_type.id() == arrow::Type::DATE64) {
+                    column = Column{.encoding = ColumnEncoding::TIMESTAMP_TO_DATE64, .width = 8};
+                    switch (unit) {
+                        case arrow::TimeUnit::SECOND:
+                            column->multiplier = 1000;
+                            break;
+                        case arrow::TimeUnit::MILLI:
+                            break;
+                        case arrow::TimeUnit::MICRO:
+                            column->divisor = 1000;
+                            break;
+                        case arrow::TimeUnit::NANO:
+                            column->divisor = 1000 * 1000;
+                            break;
+                    }
+                }
+                break;
+            }
+            case LogicalTypeId::DECIMAL:
+                if (arrow_type.id() == arrow::Type::DOUBLE) {
+                    column = Column{.encoding = ColumnEncoding::DECIMAL_TO_DOUBLE,
+                                    .width = 8,
+                                    .decimal_width = GetTypeIdSize(types[i].InternalType()),
+                                    .scale = DecimalType::GetScale(types[i])};
+                }
+                break;
+            case LogicalTypeId::VARCHAR:
+                if (arrow_type.id() == arrow::Type::STRING) column = Column{.encoding = ColumnEncoding::STRING};
+                break;
+            case LogicalTypeId::BLOB:
+                if (arrow_type.id() == arrow::Type::BINARY) column = Column{.encoding = ColumnEncoding::STRING};
+                break;
+            default:
+                break;
+        }
+        if (!column) return nullptr;
+        columns.push_back(*column);
+    }
+    return std::make_unique<ArrowIPCEncoder>(std::move(columns));
+}
+
+/// Encode a data chunk
+arrow::Result<ArrowIPCRecordBatchMessage> ArrowIPCEncoder::Encode(duckdb::DataChunk& chunk) const {
+    return Encode(std::vector<duckdb::DataChunk*>{&chunk});
+}
+
+/// Encode data chunks as a single record batch
+arrow::Result<ArrowIPCRecordBatchMessage> ArrowIPCEncoder::Encode(const std::vector<duckdb::DataChunk*>& chunks) const {
+    size_t rows = 0;
+    for (auto* chunk : chunks) rows += chunk->size();
+    ArrowIPCRecordBatchMessage message{static_cast<int64_t>(rows)};
+
+    // Declare the buffers
+    std::vector<std::vector<UnifiedVectorFormat>> formats(columns_.size());
+    std::vector<int64_t> null_counts(columns_.size());
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        formats[i].resize(chunks.size());
+        for (size_t k = 0; k < chunks.size(); ++k) {
+            chunks[k]->data[i].ToUnifiedFormat(chunks[k]->size(), formats[i][k]);
+            null_counts[i] += CountNulls(formats[i][k], chunks[k]->size());
+        }
+        message.AddFieldNode(rows, null_counts[i]);
+        message.AddBuffer(null_counts[i] > 0 ? GetBitmapLength(rows) : 0);
+        switch (columns_[i].encoding) {
+            case ColumnEncoding::BOOLEAN:
+                message.AddBuffer(GetBitmapLength(rows));
+                break;
+            case ColumnEncoding::FIXED_WIDTH:
+            case ColumnEncoding::BIGINT_TO_DOUBLE:
+            case ColumnEncoding::UBIGINT_TO_DOUBLE:
+            case ColumnEncoding::TIMESTAMP_TO_DATE64:
+            case ColumnEncoding::DECIMAL_TO_DOUBLE:
+                message.AddBuffer(rows * columns_[i].width);
+                break;
+            case ColumnEncoding::STRING: {
+                int64_t length = 0;
+                for (size_t k = 0; k < chunks.size(); ++k) {
+                    auto& format = formats[i][k];
+                    auto* strings = UnifiedVectorFormat::GetData<string_t>(format);
+                    for (size_t j = 0; j < chunks[k]->size(); ++j) {
+                        auto idx = format.sel->get_index(j);
+                        if (format.validity.RowIsValid(idx)) length += strings[idx].GetSize();
+                    }
+                }
+                if (length > std::numeric_limits<int32_t>::max()) {
+                    return arrow::Status::CapacityError("string data of a batch exceeds the 32-bit offset limit");
+                }
+                message.AddBuffer((rows + 1) * sizeof(int32_t));
+                message.AddBuffer(length);
+                break;
+            }
+        }
+    }
+    ARROW_RETURN_NOT_OK(message.Allocate());
+
+    // Write the buffers
+    size_t buffer = 0;
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        auto& column = columns_[i];
+        if (null_counts[i] > 0) {
+            auto* validity = message.GetBuffer(buffer);
+            std::memset(validity, 0, GetBitmapLength(rows));
+            for (size_t k = 0, row = 0; k < chunks.size(); row += chunks[k++]->size()) {
+                WriteValidity(formats[i][k], chunks[k]->size(), validity, row);
+            }
+        }
+        ++buffer;
+        auto* values = message.GetBuffer(buffer++);
+        auto* string_data = column.encoding == ColumnEncoding::STRING ? message.GetBuffer(buffer++) : nullptr;
+        if (column.encoding == ColumnEncoding::BOOLEAN) std::memset(values, 0, GetBitmapLength(rows));
+        if (column.encoding == ColumnEncoding::STRING) reinterpret_cast<int32_t*>(values)[0] = 0;
+        int32_t string_offset = 0;
+
+        for (size_t k = 0, row = 0; k < chunks.size(); row += chunks[k++]->size()) {
+            auto& format = formats[i][k];
+            auto count = chunks[k]->size();
+            auto* out = values + row * column.width;
+            switch (column.encoding) {
+                case ColumnEncoding::BOOLEAN: {
+                    auto* in = UnifiedVectorFormat::GetData<bool>(format);
+                    for (size_t j = 0; j < count; ++j) {
+                        if (in[format.sel->get_index(j)]) SetBit(values, row + j);
+                    }
+                    break;
+                }
+                case ColumnEncoding::FIXED_WIDTH:
+                    if (!format.sel->IsSet()) {
+                        std::memcpy(out, format.data, count * column.width);
+                        break;
+                    }
+                    switch (column.width) {
+                        case 1:
+                            GatherValues<uint8_t>(format, count, out);
+                            break;
+                        case 2:
+                            GatherValues<uint16_t>(format, count, out);
+                            break;
+                        case 4:
+                            GatherValues<uint32_t>(format, count, out);
+                            break;
+                        case 8:
+                            GatherValues<uint64_t>(format, count, out);
+                            break;
+                    }
+                    break;
+                case ColumnEncoding::BIGINT_TO_DOUBLE:
+                    CastToDouble<int64_t>(format, count, out);
+                    break;
+                case ColumnEncoding::UBIGINT_TO_DOUBLE:
+                    CastToDouble<uint64_t>(format, count, out);
+                    break;
+                case ColumnEncoding::TIMESTAMP_TO_DATE64: {
+                    auto* in = UnifiedVectorFormat::GetData<int64_t>(format);
+                    auto* writer = reinterpret_cast<int64_t*>(out);
+                    if (!format.sel->IsSet()) {
+                        kernels::ScaleInt64(in, writer, count, column.multiplier, column.divisor);
+                        break;
+                    }
+                    for (size_t j = 0; j < count; ++j) {
+                        auto idx = format.sel->get_index(j);
+                        writer[j] = format.validity.RowIsValid(idx) ? in[idx] * column.multiplier / column.divisor : 0;
+                    }
+                    break;
+                }
+                case ColumnEncoding::DECIMAL_TO_DOUBLE:
+                    switch (column.decimal_width) {
+                        case 2:
+                            CastDecimalToDouble<int16_t>(format, count, out, column.scale);
+                            break;
+                        case 4:
+                            CastDecimalToDouble<int32_t>(format, count, out, column.scale);
+                            break;
+                        case 8:
+                            CastDecimalToDouble<int64_t>(format, count, out, column.scale);
+                            break;
+                        case 16:
+                            CastDecimalToDouble<hugeint_t>(format, count, out, column.scale);
+                            break;
+                    }
+                    break;
+                case ColumnEncoding::STRING: {
+                    auto* strings = UnifiedVectorFormat::GetData<string_t>(format);
+                    auto* offsets = reinterpret_cast<int32_t*>(values) + row;
+                    for (size_t j = 0; j < count; ++j) {
+                        auto idx = format.sel->get_index(j);
+                        if (format.validity.RowIsValid(idx)) {
+                            auto& value = strings[idx];
+                            std::memcpy(string_data + string_offset, value.GetData(), value.GetSize());
+                            string_offset += value.GetSize();
+                        }
+                        offsets[j + 1] = string_offset;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return message;
+}
+
+}  // namespace web
+}  // namespace duckdb
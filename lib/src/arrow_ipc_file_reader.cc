@@ -0,0 +1,132 @@
+#include "duckdb/web/arrow_ipc_file_reader.h"
+
+#include <algorithm>
+
+#include "arrow/c/bridge.h"
+#include "arrow/ipc/options.h"
+#include "arrow/util/parallel.h"
+#include "duckdb/web/arrow_stream_buffer.h"
+#include "duckdb/web/io/arrow_ifstream.h"
+
+namespace duckdb {
+namespace web {
+
+/// Constructor
+ArrowIPCFileReader::ArrowIPCFileReader(std::shared_ptr<arrow::ipc::RecordBatchFileReader> file, int decode_threads)
+    : file_(std::move(file)),
+      decode_threads_(std::max(decode_threads, 1)),
+      next_batch_id_(0),
+      window_(),
+      window_pos_(0),
+      next_batch_offset_(0) {}
+
+/// Open an ipc file of the file page buffer
+arrow::Result<std::shared_ptr<ArrowIPCFileReader>> ArrowIPCFileReader::Open(
+    std::shared_ptr<io::FilePageBuffer> file_page_buffer, std::string_view path, int decode_threads) {
+    auto input = std::make_shared<io::ArrowInputFileStream>(std::move(file_page_buffer), path);
+    // Batches are decoded in parallel, columns are decoded on the decoding thread
+    auto options = arrow::ipc::IpcReadOptions::Defaults();
+    options.use_threads = false;
+    ARROW_ASSIGN_OR_RAISE(auto file, arrow::ipc::RecordBatchFileReader::Open(std::move(input), options));
+    return std::make_shared<ArrowIPCFileReader>(std::move(file), decode_threads);
+}
+
+/// Create a reader that starts at the first batch again
+std::shared_ptr<ArrowIPCFileReader> ArrowIPCFileReader::CloneShared() const {
+    return std::make_shared<ArrowIPCFileReader>(file_, decode_threads_);
+}
+
+/// Get the schema
+std::shared_ptr<arrow::Schema> ArrowIPCFileReader::schema() const { return file_->schema(); }
+
+/// Decode the next window of batches
+arrow::Status ArrowIPCFileReader::DecodeWindow() {
+    auto first = next_batch_id_;
+    auto n = std::min(decode_threads_, file_->num_record_batches() - first);
+    window_.assign(n, nullptr);
+    window_pos_ = 0;
+
+    // The first read loads the dictionaries of the file and must not run concurrently
+    int skip = 0;
+    if (first == 0 && n > 0) {
+        ARROW_ASSIGN_OR_RAISE(window_[0], file_->ReadRecordBatch(0));
+        skip = 1;
+    }
+    ARROW_RETURN_NOT_OK(arrow::internal::OptionalParallelFor(decode_threads_ > 1, n - skip, [&](int i) {
+        ARROW_ASSIGN_OR_RAISE(window_[skip + i], file_->ReadRecordBatch(first + skip + i));
+        return arrow::Status::OK();
+    }));
+    next_batch_id_ += n;
+    return arrow::Status::OK();
+}
+
+/// Read the next record batch in the file. Return null for batch when reaching end of file
+arrow::Status ArrowIPCFileReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
+    while (true) {
+        // Hand out the decoded batches first
+        if (window_pos_ < window_.size()) {
+            auto& next = window_[window_pos_];
+            if (next_batch_offset_ >= next->num_rows()) {
+                next.reset();
+                ++window_pos_;
+                next_batch_offset_ = 0;
+                continue;
+            }
+            // Slice large batches into partitions without copying
+            auto rows = std::min(ArrowIPCStreamBufferReader::PARTITION_ROWS, next->num_rows() - next_batch_offset_);
+            *batch = rows == next->num_rows() ? next : next->Slice(next_batch_offset_, rows);
+            next_batch_offset_ += rows;
+            return arrow::Status::OK();
+        }
+        if (next_batch_id_ >= file_->num_record_batches()) {
+            *batch = nullptr;
+            return arrow::Status::OK();
+        }
+        ARROW_RETURN_NOT_OK(DecodeWindow());
+    }
+}
+
+/// Arrow array stream factory function
+duckdb::unique_ptr<duckdb::ArrowArrayStreamWrapper> ArrowIPCFileReader::CreateStream(
+    uintptr_t reader_ptr, duckdb::ArrowStreamParameters& parameters) {
+    assert(reader_ptr != 0);
+    auto reader = reinterpret_cast<std::shared_ptr<ArrowIPCFileReader>*>(reader_ptr);
+    auto reader_copy = (*reader)->CloneShared();
+
+    // Create arrow stream
+    auto stream_wrapper = duckdb::make_uniq<duckdb::ArrowArrayStreamWrapper>();
+    stream_wrapper->arrow_array_stream.release = nullptr;
+    auto maybe_ok = arrow::ExportRecordBatchReader(reader_copy, &stream_wrapper->arrow_array_stream);
+    if (!maybe_ok.ok()) {
+        if (stream_wrapper->arrow_array_stream.release) {
+            stream_wrapper->arrow_array_stream.release(&stream_wrapper->arrow_array_stream);
+        }
+        return nullptr;
+    }
+
+    // Release the stream
+    return stream_wrapper;
+}
+
+void ArrowIPCFileReader::GetSchema(uintptr_t reader_ptr, duckdb::ArrowSchemaWrapper& schema) {
+    assert(reader_ptr != 0);
+    auto reader = reinterpret_cast<std::shared_ptr<ArrowIPCFileReader>*>(reader_ptr);
+    auto reader_copy = (*reader)->CloneShared();
+
+    // Create arrow stream
+    auto stream_wrapper = std::make_unique<duckdb::ArrowArrayStreamWrapper>();
+    stream_wrapper->arrow_array_stream.release = nullptr;
+    auto maybe_ok = arrow::ExportRecordBatchReader(reader_copy, &stream_wrapper->arrow_array_stream);
+    if (!maybe_ok.ok()) {
+        if (stream_wrapper->arrow_array_stream.release) {
+            stream_wrapper->arrow_array_stream.release(&stream_wrapper->arrow_array_stream);
+        }
+        return;
+    }
+
+    // Pass ownership to caller
+    stream_wrapper->arrow_array_stream.get_schema(&stream_wrapper->arrow_array_stream, &schema.arrow_schema);
+}
+
+}  // namespace web
+}  // namespace duckdb
@@ -0,0 +1,136 @@
+#include "duckdb/web/arrow_ipc_message.h"
+
+#include <cstring>
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// The continuation marker of encapsulated messages
+constexpr uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+/// The metadata version V5
+constexpr int16_t METADATA_VERSION_V5 = 4;
+/// The message header type of record batches
+constexpr uint8_t MESSAGE_HEADER_RECORD_BATCH = 3;
+
+/// The fixed flatbuffer layout of the record batch message.
+///
+///   0  root offset
+///   4  Message vtable [version, header_type, header, bodyLength]
+///  16  Message table
+///  40  RecordBatch vtable [length, nodes, buffers]
+///  56  RecordBatch table
+///  84  nodes vector, followed by the buffers vector
+constexpr size_t MESSAGE_VTABLE = 4;
+constexpr size_t MESSAGE_TABLE = 16;
+constexpr size_t MESSAGE_TABLE_SIZE = 24;
+constexpr size_t RECORD_BATCH_VTABLE = 40;
+constexpr size_t RECORD_BATCH_TABLE = 56;
+constexpr size_t RECORD_BATCH_TABLE_SIZE = 24;
+constexpr size_t NODES_VECTOR = 84;
+/// The size of the FieldNode and Buffer structs
+constexpr size_t STRUCT_SIZE = 16;
+
+/// Align a length to the buffer alignment
+int64_t Align(int64_t length) {
+    constexpr auto alignment = ArrowIPCRecordBatchMessage::BUFFER_ALIGNMENT;
+    return (length + alignment - 1) & ~(alignment - 1);
+}
+
+/// Write a little-endian value
+template <typename T> void Store(uint8_t* out, size_t offset, T value) { std::memcpy(out + offset, &value, sizeof(T)); }
+
+/// Get the length of the flatbuffer metadata
+size_t GetMetadataLength(size_t nodes, size_t buffers) {
+    auto nodes_end = NODES_VECTOR + 4 + nodes * STRUCT_SIZE;
+    return nodes_end + 8 + buffers * STRUCT_SIZE;
+}
+
+}  // namespace
+
+/// Add a body buffer and return its index
+size_t ArrowIPCRecordBatchMessage::AddBuffer(int64_t length) {
+    buffers_.push_back({body_length_, length});
+    body_length_ += Align(length);
+    return buffers_.size() - 1;
+}
+
+/// Write the flatbuffer metadata
+void ArrowIPCRecordBatchMessage::WriteMetadata(uint8_t* out) const {
+    std::memset(out, 0, metadata_length_);
+    auto nodes_end = NODES_VECTOR + 4 + nodes_.size() * STRUCT_SIZE;
+    auto buffers_vector = nodes_end + 4;
+
+    // Root offset
+    Store<uint32_t>(out, 0, MESSAGE_TABLE);
+
+    // Message
+    Store<uint16_t>(out, MESSAGE_VTABLE + 0, 12);
+    Store<uint16_t>(out, MESSAGE_VTABLE + 2, MESSAGE_TABLE_SIZE);
+    Store<uint16_t>(out, MESSAGE_VTABLE + 4, 16);
+    Store<uint16_t>(out, MESSAGE_VTABLE + 6, 18);
+    Store<uint16_t>(out, MESSAGE_VTABLE + 8, 4);
+    Store<uint16_t>(out, MESSAGE_VTABLE + 10, 8);
+    Store<int32_t>(out, MESSAGE_TABLE + 0, MESSAGE_TABLE - MESSAGE_VTABLE);
+    Store<uint32_t>(out, MESSAGE_TABLE + 4, RECORD_BATCH_TABLE - (MESSAGE_TABLE + 4));
+    Store<int64_t>(out, MESSAGE_TABLE + 8, body_length_);
+    Store<int16_t>(out, MESSAGE_TABLE + 16, METADATA_VERSION_V5);
+    Store<uint8_t>(out, MESSAGE_TABLE + 18, MESSAGE_HEADER_RECORD_BATCH);
+
+    // RecordBatch
+    Store<uint16_t>(out, RECORD_BATCH_VTABLE + 0, 10);
+    Store<uint16_t>(out, RECORD_BATCH_VTABLE + 2, RECORD_BATCH_TABLE_SIZE);
+    Store<uint16_t>(out, RECORD_BATCH_VTABLE + 4, 8);
+    Store<uint16_t>(out, RECORD_BATCH_VTABLE + 6, 4);
+    Store<uint16_t>(out, RECORD_BATCH_VTABLE + 8, 16);
+    Store<int32_t>(out, RECORD_BATCH_TABLE + 0, RECORD_BATCH_TABLE - RECORD_BATCH_VTABLE);
+    Store<uint32_t>(out, RECORD_BATCH_TABLE + 4, NODES_VECTOR - (RECORD_BATCH_TABLE + 4));
+    Store<int64_t>(out, RECORD_BATCH_TABLE + 8, num_rows_);
+    Store<uint32_t>(out, RECORD_BATCH_TABLE + 16, buffers_vector - (RECORD_BATCH_TABLE + 16));
+
+    // Nodes and buffers
+    Store<uint32_t>(out, NODES_VECTOR, nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        Store<int64_t>(out, NODES_VECTOR + 4 + i * STRUCT_SIZE, nodes_[i].length);
+        Store<int64_t>(out, NODES_VECTOR + 4 + i * STRUCT_SIZE + 8, nodes_[i].null_count);
+    }
+    Store<uint32_t>(out, buffers_vector, buffers_.size());
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        Store<int64_t>(out, buffers_vector + 4 + i * STRUCT_SIZE, buffers_[i].offset);
+        Store<int64_t>(out, buffers_vector + 4 + i * STRUCT_SIZE + 8, buffers_[i].length);
+    }
+}
+
+/// Allocate the message once all field nodes and buffers were added
+arrow::Status ArrowIPCRecordBatchMessage::Allocate(arrow::MemoryPool* pool) {
+    metadata_length_ = GetMetadataLength(nodes_.size(), buffers_.size());
+    ARROW_ASSIGN_OR_RAISE(auto message, arrow::AllocateBuffer(8 + metadata_length_ + body_length_, pool));
+    message_ = std::move(message);
+
+    // Write the prefix and the metadata
+    auto* out = message_->mutable_data();
+    Store<uint32_t>(out, 0, CONTINUATION_MARKER);
+    Store<int32_t>(out, 4, metadata_length_);
+    WriteMetadata(out + 8);
+
+    // Clear the padding of the body buffers
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        auto padding = Align(buffers_[i].length) - buffers_[i].length;
+        std::memset(GetBuffer(i) + buffers_[i].length, 0, padding);
+    }
+    return arrow::Status::OK();
+}
+
+/// Get the message as payload for an IPC payload writer
+arrow::ipc::IpcPayload ArrowIPCRecordBatchMessage::GetPayload() const {
+    arrow::ipc::IpcPayload payload;
+    payload.type = arrow::ipc::MessageType::RECORD_BATCH;
+    payload.metadata = arrow::SliceBuffer(message_, 8, metadata_length_);
+    payload.body_buffers.push_back(arrow::SliceBuffer(message_, 8 + metadata_length_, body_length_));
+    payload.body_length = body_length_;
+    return payload;
+}
+
+}  // namespace web
+}  // namespace duckdb
@@ -1,5 +1,6 @@
 #include "duckdb/web/arrow_stream_buffer.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "duckdb/web/arrow_bridge.h"
@@ -27,17 +28,27 @@ arrow::Status ArrowIPCStreamBuffer::OnEOS() {
 
 /// Constructor
 ArrowIPCStreamBufferReader::ArrowIPCStreamBufferReader(std::shared_ptr<ArrowIPCStreamBuffer> buffer)
-    : buffer_(buffer), next_batch_id_(0) {}
+    : buffer_(buffer), next_batch_id_(0), next_batch_offset_(0) {}
 
 /// Get the schema
 std::shared_ptr<arrow::Schema> ArrowIPCStreamBufferReader::schema() const { return buffer_->schema(); }
 /// Read the next record batch in the stream. Return null for batch when reaching end of stream
 arrow::Status ArrowIPCStreamBufferReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
-    if (next_batch_id_ >= buffer_->batches().size()) {
-        *batch = nullptr;
+    auto& batches = buffer_->batches();
+    while (next_batch_id_ < batches.size()) {
+        auto& next = batches[next_batch_id_];
+        if (next_batch_offset_ >= next->num_rows()) {
+            ++next_batch_id_;
+            next_batch_offset_ = 0;
+            continue;
+        }
+        // Slice large batches into partitions without copying
+        auto rows = std::min(PARTITION_ROWS, next->num_rows() - next_batch_offset_);
+        *batch = rows == next->num_rows() ? next : next->Slice(next_batch_offset_, rows);
+        next_batch_offset_ += rows;
         return arrow::Status::OK();
     }
-    *batch = buffer_->batches()[next_batch_id_++];
+    *batch = nullptr;
     return arrow::Status::OK();
 }
 
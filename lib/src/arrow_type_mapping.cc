@@ -1,18 +1,54 @@
 #include "duckdb/web/arrow_type_mapping.h"
 
 #include "arrow/array/array_binary.h"
+#include "arrow/array/array_decimal.h"
 #include "arrow/array/array_primitive.h"
 #include "arrow/result.h"
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/type_fwd.h"
+#include "arrow/util/decimal.h"
 #include "duckdb/common/types.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/value.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/web/webdb.h"
 
 namespace duckdb {
 namespace web {
 
+namespace {
+
+/// Convert the values of a typed arrow array, nulls keep the column type
+template <typename ArrayType, typename ConvertFn>
+duckdb::vector<duckdb::Value> convertValues(const arrow::Array& in, const duckdb::LogicalType& type, ConvertFn convert) {
+    auto& array = static_cast<const ArrayType&>(in);
+    duckdb::vector<duckdb::Value> out;
+    out.reserve(array.length());
+    for (int64_t i = 0; i < array.length(); ++i) {
+        out.push_back(array.IsNull(i) ? duckdb::Value(type) : convert(array, i));
+    }
+    return out;
+}
+
+/// Get the factor that converts a time unit to microseconds, negative factors divide
+int64_t getMicrosFactor(arrow::TimeUnit::type unit) {
+    switch (unit) {
+        case arrow::TimeUnit::SECOND:
+            return 1000 * 1000;
+        case arrow::TimeUnit::MILLI:
+            return 1000;
+        case arrow::TimeUnit::MICRO:
+            return 1;
+        case arrow::TimeUnit::NANO:
+            return -1000;
+    }
+    return 1;
+}
+
+}  // namespace
+
 /// Map arrow type
 arrow::Result<duckdb::LogicalType> mapArrowTypeToDuckDB(const arrow::DataType& type) {
     switch (type.id()) {
@@ -247,5 +283,106 @@ arrow::Status convertArrowArrayToDuckDBVector(arrow::Array& in, duckdb::Vector&
     return arrow::Status::OK();
 }
 
+/// Convert an arrow array to DuckDB values
+arrow::Result<duckdb::vector<duckdb::Value>> convertArrowArrayToDuckDBValues(const arrow::Array& in) {
+    auto& in_type = *in.type();
+    ARROW_ASSIGN_OR_RAISE(auto type, mapArrowTypeToDuckDB(in_type));
+    switch (in_type.id()) {
+        case arrow::Type::type::NA:
+            return duckdb::vector<duckdb::Value>(in.length(), duckdb::Value());
+        case arrow::Type::type::BOOL:
+            return convertValues<arrow::BooleanArray>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::BOOLEAN(a.Value(i)); });
+        case arrow::Type::type::INT8:
+            return convertValues<arrow::Int8Array>(in, type,
+                                                   [](auto& a, int64_t i) { return duckdb::Value::TINYINT(a.Value(i)); });
+        case arrow::Type::type::INT16:
+            return convertValues<arrow::Int16Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::SMALLINT(a.Value(i)); });
+        case arrow::Type::type::INT32:
+            return convertValues<arrow::Int32Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::INTEGER(a.Value(i)); });
+        case arrow::Type::type::INT64:
+            return convertValues<arrow::Int64Array>(in, type,
+                                                    [](auto& a, int64_t i) { return duckdb::Value::BIGINT(a.Value(i)); });
+        case arrow::Type::type::UINT8:
+            return convertValues<arrow::UInt8Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::UTINYINT(a.Value(i)); });
+        case arrow::Type::type::UINT16:
+            return convertValues<arrow::UInt16Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::USMALLINT(a.Value(i)); });
+        case arrow::Type::type::UINT32:
+            return convertValues<arrow::UInt32Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::UINTEGER(a.Value(i)); });
+        case arrow::Type::type::UINT64:
+            return convertValues<arrow::UInt64Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::UBIGINT(a.Value(i)); });
+        case arrow::Type::type::FLOAT:
+            return convertValues<arrow::FloatArray>(in, type,
+                                                    [](auto& a, int64_t i) { return duckdb::Value::FLOAT(a.Value(i)); });
+        case arrow::Type::type::DOUBLE:
+            return convertValues<arrow::DoubleArray>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::DOUBLE(a.Value(i)); });
+        case arrow::Type::type::STRING:
+            return convertValues<arrow::StringArray>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value(std::string{a.GetView(i)}); });
+        case arrow::Type::type::LARGE_STRING:
+            return convertValues<arrow::LargeStringArray>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value(std::string{a.GetView(i)}); });
+        case arrow::Type::type::BINARY:
+        case arrow::Type::type::LARGE_BINARY:
+        case arrow::Type::type::FIXED_SIZE_BINARY: {
+            auto blob = [](auto& a, int64_t i) {
+                auto v = a.GetView(i);
+                return duckdb::Value::BLOB(reinterpret_cast<duckdb::const_data_ptr_t>(v.data()), v.size());
+            };
+            if (in_type.id() == arrow::Type::type::BINARY) return convertValues<arrow::BinaryArray>(in, type, blob);
+            if (in_type.id() == arrow::Type::type::LARGE_BINARY) {
+                return convertValues<arrow::LargeBinaryArray>(in, type, blob);
+            }
+            return convertValues<arrow::FixedSizeBinaryArray>(in, type, blob);
+        }
+        case arrow::Type::type::DATE32:
+            return convertValues<arrow::Date32Array>(
+                in, type, [](auto& a, int64_t i) { return duckdb::Value::DATE(duckdb::date_t(a.Value(i))); });
+        case arrow::Type::type::DATE64:
+            return convertValues<arrow::Date64Array>(in, type, [](auto& a, int64_t i) {
+                constexpr int64_t MS_PER_DAY = 24 * 60 * 60 * 1000;
+                auto ms = a.Value(i);
+                auto days = ms / MS_PER_DAY - (ms % MS_PER_DAY < 0);
+                return duckdb::Value::DATE(duckdb::date_t(static_cast<int32_t>(days)));
+            });
+        case arrow::Type::type::TIMESTAMP: {
+            auto& ts_type = static_cast<const arrow::TimestampType&>(in_type);
+            auto factor = getMicrosFactor(ts_type.unit());
+            bool with_tz = !ts_type.timezone().empty();
+            return convertValues<arrow::TimestampArray>(in, type, [&](auto& a, int64_t i) {
+                auto v = a.Value(i);
+                auto micros = factor >= 0 ? v * factor : v / -factor;
+                return with_tz ? duckdb::Value::TIMESTAMPTZ(duckdb::timestamp_tz_t(micros))
+                               : duckdb::Value::TIMESTAMP(duckdb::timestamp_t(micros));
+            });
+        }
+        case arrow::Type::type::DECIMAL128: {
+            auto& decimal_type = static_cast<const arrow::Decimal128Type&>(in_type);
+            auto width = static_cast<uint8_t>(decimal_type.precision());
+            auto scale = static_cast<uint8_t>(decimal_type.scale());
+            return convertValues<arrow::Decimal128Array>(in, type, [&](auto& a, int64_t i) {
+                arrow::Decimal128 v{a.GetValue(i)};
+                if (width <= duckdb::Decimal::MAX_WIDTH_INT64) {
+                    return duckdb::Value::DECIMAL(static_cast<int64_t>(v.low_bits()), width, scale);
+                }
+                duckdb::hugeint_t h;
+                h.lower = v.low_bits();
+                h.upper = v.high_bits();
+                return duckdb::Value::DECIMAL(h, width, scale);
+            });
+        }
+        default:
+            return arrow::Status::NotImplemented("value conversion not implemented for arrow type: ",
+                                                 in_type.ToString());
+    }
+}
+
 }  // namespace web
 }  // namespace duckdb
@@ -51,6 +51,8 @@ WebDBConfig WebDBConfig::ReadFrom(std::string_view args_json) {
                                       .allow_full_http_reads = std::nullopt,
                                       .force_full_http_reads = std::nullopt,
                                       .reliable_head_requests = std::nullopt,
+                                      .http_cache_bytes = std::nullopt,
+                                      .http_cache_max_age_ms = std::nullopt,
                                   },
                               .duckdb_config_options =
                                   DuckDBConfigOptions{
@@ -101,6 +103,27 @@ WebDBConfig WebDBConfig::ReadFrom(std::string_view args_json) {
             if (q.HasMember("castDecimalToDouble") && q["castDecimalToDouble"].IsBool()) {
                 config.query.cast_decimal_to_double = q["castDecimalToDouble"].GetBool();
             }
+            if (q.HasMember("resultBatchRows") && q["resultBatchRows"].IsUint64()) {
+                config.query.result_batch_rows = q["resultBatchRows"].GetUint64();
+            }
+            if (q.HasMember("resultBatchBytes") && q["resultBatchBytes"].IsUint64()) {
+                config.query.result_batch_bytes = q["resultBatchBytes"].GetUint64();
+            }
+            if (q.HasMember("resultCompression") && q["resultCompression"].IsString()) {
+                config.query.result_compression = q["resultCompression"].GetString();
+            }
+            if (q.HasMember("dictionaryEncodeStrings") && q["dictionaryEncodeStrings"].IsBool()) {
+                config.query.dictionary_encode_strings = q["dictionaryEncodeStrings"].GetBool();
+            }
+            if (q.HasMember("resultCacheBytes") && q["resultCacheBytes"].IsUint64()) {
+                config.query.result_cache_bytes = q["resultCacheBytes"].GetUint64();
+            }
+            if (q.HasMember("firstBatchRows") && q["firstBatchRows"].IsUint64()) {
+                config.query.first_batch_rows = q["firstBatchRows"].GetUint64();
+            }
+            if (q.HasMember("resultSpillDirectory") && q["resultSpillDirectory"].IsString()) {
+                config.query.result_spill_directory = q["resultSpillDirectory"].GetString();
+            }
         }
         if (doc.HasMember("filesystem") && doc["filesystem"].IsObject()) {
             auto fs = doc["filesystem"].GetObject();
@@ -113,6 +136,12 @@ WebDBConfig WebDBConfig::ReadFrom(std::string_view args_json) {
             if (fs.HasMember("reliableHeadRequests") && fs["reliableHeadRequests"].IsBool()) {
                 config.filesystem.reliable_head_requests = fs["reliableHeadRequests"].GetBool();
             }
+            if (fs.HasMember("httpCacheBytes") && fs["httpCacheBytes"].IsUint64()) {
+                config.filesystem.http_cache_bytes = fs["httpCacheBytes"].GetUint64();
+            }
+            if (fs.HasMember("httpCacheMaxAgeMs") && fs["httpCacheMaxAgeMs"].IsUint64()) {
+                config.filesystem.http_cache_max_age_ms = fs["httpCacheMaxAgeMs"].GetUint64();
+            }
         }
         if (doc.HasMember("customUserAgent") && doc["customUserAgent"].IsString()) {
             config.custom_user_agent = doc["customUserAgent"].GetString();
@@ -34,6 +34,8 @@ enum FieldTag {
     SKIP,
     DATEFORMAT,
     TIMESTAMPFORMAT,
+    PREFETCH_RANGE_SIZE,
+    PREFETCH_CONCURRENCY,
 };
 
 static std::unordered_map<std::string_view, FieldTag> FIELD_TAGS{
@@ -49,6 +51,8 @@ static std::unordered_map<std::string_view, FieldTag> FIELD_TAGS{
     {"fields", FieldTag::COLUMNS},
     {"header", FieldTag::HEADER},
     {"name", FieldTag::NAME},
+    {"prefetchConcurrency", FieldTag::PREFETCH_CONCURRENCY},
+    {"prefetchRangeSize", FieldTag::PREFETCH_RANGE_SIZE},
     {"quote", FieldTag::QUOTE},
     {"schema", FieldTag::SCHEMA},
     {"skip", FieldTag::SKIP},
@@ -129,6 +133,22 @@ arrow::Status CSVInsertOptions::ReadFrom(const rapidjson::Document& doc) {
                 ARROW_RETURN_NOT_OK(RequireFieldType(iter->value, rapidjson::Type::kStringType, name));
                 timestampformat = std::string{iter->value.GetString(), iter->value.GetStringLength()};
                 break;
+
+            case FieldTag::PREFETCH_RANGE_SIZE:
+                ARROW_RETURN_NOT_OK(RequireFieldType(iter->value, rapidjson::Type::kNumberType, name));
+                if (!iter->value.IsUint64() || iter->value.GetUint64() == 0) {
+                    return arrow::Status::Invalid("field '", name, "' must be a positive integer");
+                }
+                prefetch_range_size = iter->value.GetUint64();
+                break;
+
+            case FieldTag::PREFETCH_CONCURRENCY:
+                ARROW_RETURN_NOT_OK(RequireFieldType(iter->value, rapidjson::Type::kNumberType, name));
+                if (!iter->value.IsUint64()) {
+                    return arrow::Status::Invalid("field '", name, "' must be a non-negative integer");
+                }
+                prefetch_concurrency = iter->value.GetUint64();
+                break;
         }
     }
     return arrow::Status::OK();
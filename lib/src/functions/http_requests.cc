@@ -0,0 +1,123 @@
+#include "duckdb/web/functions/http_requests.h"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_transaction.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
+#include "duckdb/web/http_trace.h"
+#include "duckdb/web/http_wasm.h"
+#include "duckdb/web/io/web_filesystem.h"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+struct HTTPRequestsBindData : public TableFunctionData {
+    /// Drop the traces after reading them?
+    bool reset = false;
+};
+
+struct HTTPRequestsState : public GlobalTableFunctionState {
+    /// The traces
+    std::vector<HTTPRequestTrace> traces;
+    /// The next trace
+    idx_t offset = 0;
+};
+
+unique_ptr<FunctionData> HTTPRequestsBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+    auto data = make_uniq<HTTPRequestsBindData>();
+    if (auto reset = input.named_parameters.find("reset"); reset != input.named_parameters.end()) {
+        data->reset = !reset->second.IsNull() && BooleanValue::Get(reset->second);
+    }
+    names = {"id", "method", "url", "range", "status", "bytes", "start_ms", "duration_ms", "retries", "cancelled"};
+    return_types = {LogicalType::UBIGINT, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                    LogicalType::INTEGER, LogicalType::UBIGINT, LogicalType::DOUBLE,  LogicalType::DOUBLE,
+                    LogicalType::UINTEGER, LogicalType::BOOLEAN};
+    return std::move(data);
+}
+
+unique_ptr<GlobalTableFunctionState> HTTPRequestsInit(ClientContext &context, TableFunctionInitInput &input) {
+    auto &data = input.bind_data->Cast<HTTPRequestsBindData>();
+    auto state = make_uniq<HTTPRequestsState>();
+    if (auto webfs = io::WebFileSystem::Get()) {
+        state->traces = webfs->GetHTTPTracer().Collect(data.reset);
+    }
+    return std::move(state);
+}
+
+void HTTPRequestsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+    auto &state = input.global_state->Cast<HTTPRequestsState>();
+    idx_t count = 0;
+    for (; state.offset < state.traces.size() && count < STANDARD_VECTOR_SIZE; ++state.offset, ++count) {
+        auto &trace = state.traces[state.offset];
+        output.SetValue(0, count, Value::UBIGINT(trace.id));
+        output.SetValue(1, count, Value(trace.method));
+        output.SetValue(2, count, Value(trace.url));
+        output.SetValue(3, count, trace.range.empty() ? Value() : Value(trace.range));
+        output.SetValue(4, count, Value::INTEGER(trace.status));
+        output.SetValue(5, count, Value::UBIGINT(trace.bytes));
+        output.SetValue(6, count, Value::DOUBLE(trace.start_us / 1000.0));
+        output.SetValue(7, count, Value::DOUBLE(trace.duration_us / 1000.0));
+        output.SetValue(8, count, Value::UINTEGER(trace.retries));
+        output.SetValue(9, count, Value::BOOLEAN(trace.cancelled));
+    }
+    output.SetCardinality(count);
+}
+
+struct HTTPHedgingState : public GlobalTableFunctionState {
+    /// The statistics were emitted?
+    bool done = false;
+};
+
+unique_ptr<FunctionData> HTTPHedgingBind(ClientContext &context, TableFunctionBindInput &input,
+                                         vector<LogicalType> &return_types, vector<string> &names) {
+    names = {"requests", "hedges_issued", "hedges_won", "hedges_skipped", "requests_cancelled"};
+    return_types = {LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+                    LogicalType::UBIGINT};
+    return make_uniq<TableFunctionData>();
+}
+
+unique_ptr<GlobalTableFunctionState> HTTPHedgingInit(ClientContext &context, TableFunctionInitInput &input) {
+    return make_uniq<HTTPHedgingState>();
+}
+
+void HTTPHedgingFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+    auto &state = input.global_state->Cast<HTTPHedgingState>();
+    auto &http_util = DBConfig::GetConfig(context).http_util;
+    if (state.done || !http_util || http_util->GetName() != "WasmHTTPUtils") {
+        output.SetCardinality(0);
+        return;
+    }
+    auto &stats = static_cast<HTTPWasmUtil &>(*http_util).GetHedging().GetStatistics();
+    output.SetValue(0, 0, Value::UBIGINT(stats.requests.load(std::memory_order_relaxed)));
+    output.SetValue(1, 0, Value::UBIGINT(stats.hedges_issued.load(std::memory_order_relaxed)));
+    output.SetValue(2, 0, Value::UBIGINT(stats.hedges_won.load(std::memory_order_relaxed)));
+    output.SetValue(3, 0, Value::UBIGINT(stats.hedges_skipped.load(std::memory_order_relaxed)));
+    output.SetValue(4, 0, Value::UBIGINT(stats.requests_cancelled.load(std::memory_order_relaxed)));
+    output.SetCardinality(1);
+    state.done = true;
+}
+
+}  // namespace
+
+/// Register the table functions http_requests and http_hedging
+void RegisterHTTPRequestsFunction(DatabaseInstance &db) {
+    TableFunction function("http_requests", {}, HTTPRequestsFunction, HTTPRequestsBind, HTTPRequestsInit);
+    function.named_parameters["reset"] = LogicalType::BOOLEAN;
+    CreateTableFunctionInfo info(std::move(function));
+    info.on_conflict = OnCreateConflict::ALTER_ON_CONFLICT;
+    auto &catalog = Catalog::GetSystemCatalog(db);
+    catalog.CreateTableFunction(CatalogTransaction::GetSystemTransaction(db), info);
+
+    // Register http_hedging() next to it
+    TableFunction hedging("http_hedging", {}, HTTPHedgingFunction, HTTPHedgingBind, HTTPHedgingInit);
+    CreateTableFunctionInfo hedging_info(std::move(hedging));
+    hedging_info.on_conflict = OnCreateConflict::ALTER_ON_CONFLICT;
+    catalog.CreateTableFunction(CatalogTransaction::GetSystemTransaction(db), hedging_info);
+}
+
+}  // namespace web
+}  // namespace duckdb
@@ -0,0 +1,220 @@
+#include "duckdb/web/http_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace duckdb {
+namespace web {
+
+/// Build an entry key
+std::string HTTPRangeCache::BuildKey(std::string_view url, std::string_view etag, std::string_view range) {
+    std::string key;
+    key.reserve(url.size() + etag.size() + range.size() + 2);
+    key.append(url);
+    key.push_back('\n');
+    key.append(etag);
+    key.push_back('\n');
+    key.append(range);
+    return key;
+}
+
+/// Erase an entry
+void HTTPRangeCache::Erase(std::list<Entry>::iterator entry) {
+    bytes_ -= entry->bytes;
+    entries_.erase(entry->key);
+    if (auto object = objects_.find(entry->url); object != objects_.end() && --object->second.entry_count == 0) {
+        objects_.erase(object);
+    }
+    lru_.erase(entry);
+}
+
+/// Erase all entries of a url
+void HTTPRangeCache::EraseObject(const std::string& url) {
+    for (auto iter = lru_.begin(); iter != lru_.end();) {
+        auto next = std::next(iter);
+        if (iter->url == url) Erase(iter);
+        iter = next;
+    }
+    objects_.erase(url);
+}
+
+/// Evict entries until the cache fits its budget
+void HTTPRangeCache::Evict() {
+    while (bytes_ > config_.max_bytes && !lru_.empty()) {
+        Erase(std::prev(lru_.end()));
+        stats_.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/// Get the config
+HTTPCacheConfig HTTPRangeCache::GetConfig() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return config_;
+}
+
+/// Update the config
+void HTTPRangeCache::Configure(HTTPCacheConfig config) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    config_ = config;
+    Evict();
+}
+
+/// Get the accounted bytes
+size_t HTTPRangeCache::GetSize() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return bytes_;
+}
+
+/// Get the number of cached responses
+size_t HTTPRangeCache::GetEntryCount() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return entries_.size();
+}
+
+/// Find a cached response
+std::optional<HTTPRangeCache::CachedResponse> HTTPRangeCache::Find(const std::string& url, std::string_view range) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto object = objects_.find(url);
+    if (object == objects_.end()) return std::nullopt;
+    auto entry = entries_.find(BuildKey(url, object->second.etag, range));
+    if (entry == entries_.end()) return std::nullopt;
+    lru_.splice(lru_.begin(), lru_, entry->second);
+    return CachedResponse{
+        .response = entry->second->response,
+        .etag = object->second.etag,
+        .fresh = std::chrono::steady_clock::now() < object->second.fresh_until,
+    };
+}
+
+/// Insert a response
+void HTTPRangeCache::Insert(const std::string& url, std::string_view range, const HTTPTransportResponse& response,
+                            std::chrono::milliseconds freshness) {
+    auto etag = response.FindHeader("ETag");
+    std::unique_lock<std::mutex> guard{mutex_};
+    if (!etag || etag->empty()) {
+        // We cannot revalidate responses without entity tag
+        EraseObject(url);
+        return;
+    }
+
+    // Another version of the object is cached?
+    if (auto object = objects_.find(url); object != objects_.end() && object->second.etag != *etag) {
+        EraseObject(url);
+    }
+    auto key = BuildKey(url, *etag, range);
+    if (auto existing = entries_.find(key); existing != entries_.end()) {
+        Erase(existing->second);
+    }
+
+    // Account the entry
+    size_t bytes = key.size() + response.body.size() + response.raw_headers.size();
+    for (auto& [name, value] : response.headers) {
+        bytes += name.size() + value.size();
+    }
+    if (bytes > config_.max_bytes) return;
+
+    auto& object = objects_[url];
+    object.etag = std::string{*etag};
+    object.fresh_until = std::chrono::steady_clock::now() + freshness;
+    ++object.entry_count;
+    lru_.push_front(Entry{
+        .key = key,
+        .url = url,
+        .response = response,
+        .bytes = bytes,
+    });
+    entries_.insert({std::move(key), lru_.begin()});
+    bytes_ += bytes;
+    Evict();
+}
+
+/// Mark the cached responses of a url as fresh after a 304 Not Modified
+void HTTPRangeCache::Revalidate(const std::string& url, std::chrono::milliseconds freshness) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    if (auto object = objects_.find(url); object != objects_.end()) {
+        object->second.fresh_until = std::chrono::steady_clock::now() + freshness;
+    }
+}
+
+/// Drop all cached responses of a url
+void HTTPRangeCache::Invalidate(const std::string& url) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    EraseObject(url);
+}
+
+/// Drop all cached responses
+void HTTPRangeCache::Clear() {
+    std::unique_lock<std::mutex> guard{mutex_};
+    lru_.clear();
+    entries_.clear();
+    objects_.clear();
+    bytes_ = 0;
+}
+
+/// Compute the freshness lifetime of a response
+std::chrono::milliseconds CachingHTTPTransport::ComputeFreshness(const HTTPTransportResponse& response) const {
+    auto freshness = cache_->GetConfig().max_age;
+    auto cache_control = response.FindHeader("Cache-Control");
+    if (!cache_control) return freshness;
+    if (cache_control->find("no-cache") != std::string_view::npos) return std::chrono::milliseconds{0};
+    if (auto max_age = cache_control->find("max-age="); max_age != std::string_view::npos) {
+        auto seconds = std::strtoull(std::string{cache_control->substr(max_age + 8)}.c_str(), nullptr, 10);
+        freshness = std::max<std::chrono::milliseconds>(freshness, std::chrono::seconds{seconds});
+    }
+    return freshness;
+}
+
+/// Does a request carry credentials?
+static bool HasCredentials(const HTTPTransportRequest& request) {
+    return request.FindHeader("Authorization") || request.FindHeader("Cookie") ||
+           request.FindHeader("x-amz-security-token");
+}
+
+/// Send a request
+HTTPTransportResponse CachingHTTPTransport::Send(const HTTPTransportRequest& request,
+                                                 const std::atomic<bool>* cancelled) {
+    auto cacheable = (request.method == "GET" || request.method == "HEAD") && request.body.empty() &&
+                     !request.FindHeader("If-None-Match") && !request.FindHeader("If-Match") &&
+                     !HasCredentials(request) && cache_->GetConfig().max_bytes > 0;
+    if (!cacheable) {
+        // Writes invalidate the cached responses
+        if (request.method != "GET" && request.method != "HEAD") {
+            cache_->Invalidate(request.url);
+        }
+        return inner_->Send(request, cancelled);
+    }
+    std::string range{request.method == "HEAD" ? "HEAD" : request.FindHeader("Range").value_or("")};
+    auto& stats = cache_->GetStatistics();
+
+    // Serve a fresh response or revalidate a stale one
+    auto cached = cache_->Find(request.url, range);
+    if (cached && cached->fresh) {
+        stats.hits.fetch_add(1, std::memory_order_relaxed);
+        return std::move(cached->response);
+    }
+    HTTPTransportResponse response;
+    if (cached) {
+        auto conditional = request;
+        conditional.headers.emplace_back("If-None-Match", cached->etag);
+        response = inner_->Send(conditional, cancelled);
+        if (response.status == 304) {
+            cache_->Revalidate(request.url, ComputeFreshness(response));
+            stats.revalidations.fetch_add(1, std::memory_order_relaxed);
+            return std::move(cached->response);
+        }
+    } else {
+        response = inner_->Send(request, cancelled);
+    }
+    stats.misses.fetch_add(1, std::memory_order_relaxed);
+
+    // Remember successful responses
+    auto cache_control = response.FindHeader("Cache-Control");
+    if ((response.status == 200 || response.status == 206) &&
+        !(cache_control && cache_control->find("no-store") != std::string_view::npos)) {
+        cache_->Insert(request.url, range, response, ComputeFreshness(response));
+    }
+    return response;
+}
+
+}  // namespace web
+}  // namespace duckdb
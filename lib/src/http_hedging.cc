@@ -0,0 +1,104 @@
+#include "duckdb/web/http_hedging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace duckdb {
+namespace web {
+
+/// Record a latency
+void HTTPLatencyTracker::Record(std::chrono::microseconds latency) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    samples_[sample_count_ % CAPACITY] = latency.count();
+    ++sample_count_;
+}
+
+/// Get the number of latencies that are currently remembered
+size_t HTTPLatencyTracker::GetSampleCount() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return std::min(sample_count_, CAPACITY);
+}
+
+/// Compute a latency percentile
+std::optional<std::chrono::microseconds> HTTPLatencyTracker::ComputePercentile(double percentile) const {
+    std::vector<uint64_t> samples;
+    {
+        std::unique_lock<std::mutex> guard{mutex_};
+        auto n = std::min(sample_count_, CAPACITY);
+        if (n < MIN_SAMPLES) return std::nullopt;
+        samples.assign(samples_.begin(), samples_.begin() + n);
+    }
+    auto p = std::clamp(percentile, 0.0, 1.0);
+    auto rank = std::min<size_t>(static_cast<size_t>(std::ceil(p * samples.size())), samples.size());
+    rank = (rank == 0) ? 0 : (rank - 1);
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return std::chrono::microseconds{samples[rank]};
+}
+
+/// Constructor
+HTTPHedgeWorkers::HTTPHedgeWorkers(size_t max_workers) : max_workers_(std::max<size_t>(max_workers, 1)) {}
+
+/// Destructor
+HTTPHedgeWorkers::~HTTPHedgeWorkers() {
+    {
+        std::unique_lock<std::mutex> guard{mutex_};
+        stopped_ = true;
+        task_cv_.notify_all();
+    }
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+/// Get the number of started threads
+size_t HTTPHedgeWorkers::GetThreadCount() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return threads_.size();
+}
+
+/// Run tasks until stopped
+void HTTPHedgeWorkers::Work() {
+    std::unique_lock<std::mutex> guard{mutex_};
+    while (true) {
+        ++idle_;
+        task_cv_.wait(guard, [&]() { return stopped_ || !tasks_.empty(); });
+        --idle_;
+        if (stopped_) return;
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+    }
+}
+
+/// Run a task on an idle thread
+bool HTTPHedgeWorkers::TrySubmit(std::function<void()> task) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    if (stopped_) return false;
+    if (idle_ > tasks_.size()) {
+        tasks_.push_back(std::move(task));
+        task_cv_.notify_one();
+        return true;
+    }
+    if (threads_.size() < max_workers_) {
+        tasks_.push_back(std::move(task));
+        threads_.emplace_back([this]() { Work(); });
+        return true;
+    }
+    return false;
+}
+
+/// Compute the current hedging deadline
+std::chrono::microseconds HTTPHedging::ComputeDeadline(const HTTPHedgingConfig& config) const {
+    auto min_delay = std::chrono::microseconds{config.min_delay_ms * 1000};
+    auto observed = latencies_.ComputePercentile(config.percentile);
+    if (!observed.has_value()) {
+        return std::max(min_delay, std::chrono::microseconds{config.default_delay_ms * 1000});
+    }
+    return std::max(min_delay, *observed);
+}
+
+}  // namespace web
+}  // namespace duckdb
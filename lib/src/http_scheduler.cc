@@ -0,0 +1,169 @@
+#include "duckdb/web/http_scheduler.h"
+
+#include <algorithm>
+
+namespace duckdb {
+namespace web {
+
+namespace {
+/// The priority of the requests of the current thread
+thread_local HTTPRequestPriority CURRENT_PRIORITY = HTTPRequestPriority::DEMAND;
+}  // namespace
+
+/// Get the host of a url
+std::string_view HTTPRequestScheduler::GetHost(std::string_view url) {
+    auto scheme = url.find("://");
+    auto begin = scheme == std::string_view::npos ? 0 : scheme + 3;
+    auto end = url.find_first_of("/?#", begin);
+    return url.substr(0, end);
+}
+
+/// Can a request start without considering the queued requests?
+bool HTTPRequestScheduler::HasCapacity(const Host& host, HTTPRequestPriority priority) const {
+    if (max_connections_ == 0) return true;
+    if (host.active >= max_connections_) return false;
+    // Keep the last connection for demand reads
+    if (priority != HTTPRequestPriority::DEMAND && max_connections_ > 1 &&
+        host.active_speculative >= max_connections_ - 1) {
+        return false;
+    }
+    return true;
+}
+
+/// Grant connections to queued requests
+void HTTPRequestScheduler::Dispatch(Host& host) {
+    bool granted = false;
+    for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+        auto& queue = host.queues[i];
+        auto priority = static_cast<HTTPRequestPriority>(i);
+        while (!queue.empty() && HasCapacity(host, priority)) {
+            queue.front()->granted = true;
+            queue.pop_front();
+            ++host.active;
+            if (priority != HTTPRequestPriority::DEMAND) ++host.active_speculative;
+            granted = true;
+        }
+        // Lower priorities wait behind
+        if (!queue.empty()) break;
+    }
+    if (granted) granted_.notify_all();
+}
+
+/// Release a connection
+void HTTPRequestScheduler::Release(const std::string& host_name, HTTPRequestPriority priority) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto iter = hosts_.find(host_name);
+    if (iter == hosts_.end()) return;
+    auto& host = iter->second;
+    --host.active;
+    if (priority != HTTPRequestPriority::DEMAND) --host.active_speculative;
+    Dispatch(host);
+    if (host.active == 0 && std::all_of(host.queues.begin(), host.queues.end(), [](auto& q) { return q.empty(); })) {
+        hosts_.erase(iter);
+    }
+}
+
+/// Get the limit of concurrent requests per host
+size_t HTTPRequestScheduler::GetMaxConnectionsPerHost() {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return max_connections_;
+}
+
+/// Set the limit of concurrent requests per host
+void HTTPRequestScheduler::SetMaxConnectionsPerHost(size_t limit) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    max_connections_ = limit;
+    for (auto& [name, host] : hosts_) {
+        Dispatch(host);
+    }
+}
+
+/// Get the number of active requests of a host
+size_t HTTPRequestScheduler::GetActiveCount(std::string_view url) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto iter = hosts_.find(std::string{GetHost(url)});
+    return iter == hosts_.end() ? 0 : iter->second.active;
+}
+
+/// Get the number of waiting requests of a host
+size_t HTTPRequestScheduler::GetQueuedCount(std::string_view url) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto iter = hosts_.find(std::string{GetHost(url)});
+    if (iter == hosts_.end()) return 0;
+    size_t count = 0;
+    for (auto& queue : iter->second.queues) count += queue.size();
+    return count;
+}
+
+/// Wait for a connection to the host of a url
+std::optional<HTTPRequestScheduler::Slot> HTTPRequestScheduler::Acquire(std::string_view url,
+                                                                       HTTPRequestPriority priority,
+                                                                       const std::atomic<bool>* cancelled) {
+    std::string host_name{GetHost(url)};
+    auto queue_id = static_cast<size_t>(priority);
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto& host = hosts_[host_name];
+
+    // Start immediately if nobody with the same or a higher priority is waiting
+    bool waiting_ahead = false;
+    for (size_t i = 0; i <= queue_id; ++i) {
+        waiting_ahead |= !host.queues[i].empty();
+    }
+    if (!waiting_ahead && HasCapacity(host, priority)) {
+        ++host.active;
+        if (priority != HTTPRequestPriority::DEMAND) ++host.active_speculative;
+        stats_.immediate.fetch_add(1, std::memory_order_relaxed);
+        return Slot{*this, std::move(host_name), priority};
+    }
+
+    // Wait for a connection
+    Waiter waiter{.priority = priority};
+    host.queues[queue_id].push_back(&waiter);
+    stats_.queued.fetch_add(1, std::memory_order_relaxed);
+    while (!waiter.granted) {
+        if (cancelled && *cancelled) {
+            auto& queue = host.queues[queue_id];
+            queue.erase(std::find(queue.begin(), queue.end(), &waiter));
+            stats_.cancelled.fetch_add(1, std::memory_order_relaxed);
+            // Requests with a lower priority might have been waiting behind us
+            Dispatch(host);
+            if (host.active == 0 &&
+                std::all_of(host.queues.begin(), host.queues.end(), [](auto& q) { return q.empty(); })) {
+                hosts_.erase(host_name);
+            }
+            return std::nullopt;
+        }
+        if (cancelled) {
+            granted_.wait_for(guard, CANCELLATION_POLL_INTERVAL);
+        } else {
+            granted_.wait(guard);
+        }
+    }
+    return Slot{*this, std::move(host_name), priority};
+}
+
+/// Send a request
+HTTPTransportResponse SchedulingHTTPTransport::Send(const HTTPTransportRequest& request,
+                                                    const std::atomic<bool>* cancelled) {
+    auto slot = scheduler_->Acquire(request.url, request.priority, cancelled);
+    if (!slot) {
+        HTTPTransportResponse response;
+        response.error = "request was cancelled";
+        return response;
+    }
+    return inner_->Send(request, cancelled);
+}
+
+/// Constructor
+HTTPRequestPriorityScope::HTTPRequestPriorityScope(HTTPRequestPriority priority) : previous_(CURRENT_PRIORITY) {
+    CURRENT_PRIORITY = priority;
+}
+
+/// Destructor
+HTTPRequestPriorityScope::~HTTPRequestPriorityScope() { CURRENT_PRIORITY = previous_; }
+
+/// Get the priority of the current thread
+HTTPRequestPriority HTTPRequestPriorityScope::Get() { return CURRENT_PRIORITY; }
+
+}  // namespace web
+}  // namespace duckdb
@@ -0,0 +1,105 @@
+#include "duckdb/web/http_trace.h"
+
+#include <algorithm>
+
+namespace duckdb {
+namespace web {
+
+/// Get the capacity
+size_t HTTPRequestTracer::GetCapacity() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return capacity_;
+}
+
+/// Set the capacity, drops all traces
+void HTTPRequestTracer::SetCapacity(size_t capacity) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    capacity_ = capacity;
+    traces_.clear();
+    traces_.shrink_to_fit();
+    next_slot_ = 0;
+    failed_attempts_.clear();
+}
+
+/// Record a request
+void HTTPRequestTracer::Record(const HTTPTransportRequest& request, const HTTPTransportResponse& response,
+                               std::chrono::microseconds start, std::chrono::microseconds duration, bool cancelled) {
+    HTTPRequestTrace trace{
+        .method = request.method,
+        .url = request.url,
+        .range = std::string{request.FindHeader("Range").value_or("")},
+        .status = response.status,
+        .bytes = response.body.size(),
+        .start_us = static_cast<uint64_t>(start.count()),
+        .duration_us = static_cast<uint64_t>(duration.count()),
+        .cancelled = cancelled,
+    };
+    Record(std::move(trace));
+}
+
+/// Record a request that was sent outside of a transport
+void HTTPRequestTracer::Record(HTTPRequestTrace trace) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    if (capacity_ == 0) return;
+    trace.id = next_id_++;
+
+    // Count the failed attempts of the same request.
+    // Cancelled requests were abandoned on purpose and are neither failures nor retries.
+    if (!trace.cancelled) {
+        auto key = trace.method + "\n" + trace.url + "\n" + trace.range;
+        auto failed = trace.status == 0 || trace.status == 429 || trace.status >= 500;
+        auto iter = failed_attempts_.find(key);
+        trace.retries = iter != failed_attempts_.end() ? iter->second : 0;
+        if (!failed) {
+            if (iter != failed_attempts_.end()) failed_attempts_.erase(iter);
+        } else if (iter != failed_attempts_.end()) {
+            ++iter->second;
+        } else {
+            // Requests that are never retried must not pile up
+            if (failed_attempts_.size() >= capacity_) failed_attempts_.clear();
+            failed_attempts_.insert({std::move(key), 1});
+        }
+    }
+
+    // Append to the ring
+    if (traces_.size() < capacity_) {
+        traces_.push_back(std::move(trace));
+    } else {
+        traces_[next_slot_] = std::move(trace);
+        next_slot_ = (next_slot_ + 1) % capacity_;
+    }
+}
+
+/// Get the retained traces, oldest first
+std::vector<HTTPRequestTrace> HTTPRequestTracer::Collect(bool reset) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    std::vector<HTTPRequestTrace> traces;
+    if (reset) {
+        traces = std::move(traces_);
+        traces_.clear();
+    } else {
+        traces = traces_;
+    }
+    std::rotate(traces.begin(), traces.begin() + next_slot_, traces.end());
+    if (reset) next_slot_ = 0;
+    return traces;
+}
+
+/// Drop all traces
+void HTTPRequestTracer::Reset() {
+    std::unique_lock<std::mutex> guard{mutex_};
+    traces_.clear();
+    next_slot_ = 0;
+}
+
+/// Send a request
+HTTPTransportResponse TracingHTTPTransport::Send(const HTTPTransportRequest& request,
+                                                 const std::atomic<bool>* cancelled) {
+    auto start = tracer_->Now();
+    auto response = inner_->Send(request, cancelled);
+    tracer_->Record(request, response, start, tracer_->Now() - start, cancelled && *cancelled);
+    return response;
+}
+
+}  // namespace web
+}  // namespace duckdb
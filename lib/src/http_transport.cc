@@ -0,0 +1,551 @@
+#include "duckdb/web/http_transport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#ifdef EMSCRIPTEN
+#include <emscripten.h>
+#else
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include "duckdb/web/utils/scope_guard.h"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// Compare two strings case-insensitively
+static bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Find a header in a header list
+static std::optional<std::string_view> FindHeaderIn(const HTTPHeaderList& headers, std::string_view name) {
+    for (auto& [key, value] : headers) {
+        if (EqualsIgnoreCase(key, name)) return std::string_view{value};
+    }
+    return std::nullopt;
+}
+
+/// Wait for a duration unless the request is cancelled.
+/// Returns false if the request was cancelled.
+static bool WaitUnlessCancelled(std::chrono::microseconds duration, const std::atomic<bool>* cancelled) {
+    if (duration.count() <= 0) return !(cancelled && *cancelled);
+    if (!cancelled) {
+        std::this_thread::sleep_for(duration);
+        return true;
+    }
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+        if (*cancelled) return false;
+        auto remaining = until - std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(remaining, std::chrono::milliseconds{1}));
+    }
+    return !*cancelled;
+}
+
+/// Build a response for a request that failed without a response
+static HTTPTransportResponse FailedResponse(std::string error) {
+    HTTPTransportResponse response;
+    response.status = 0;
+    response.error = std::move(error);
+    return response;
+}
+
+}  // namespace
+
+/// Find a header
+std::optional<std::string_view> HTTPTransportRequest::FindHeader(std::string_view name) const {
+    return FindHeaderIn(headers, name);
+}
+/// Find a header
+std::optional<std::string_view> HTTPTransportResponse::FindHeader(std::string_view name) const {
+    if (auto value = FindHeaderIn(headers, name)) return value;
+    std::optional<std::string_view> found;
+    ForEachHeaderLine(raw_headers, [&](std::string_view key, std::string_view value) {
+        if (!found && EqualsIgnoreCase(key, name)) found = value;
+    });
+    return found;
+}
+
+#ifdef EMSCRIPTEN
+
+/// Send a request with a synchronous XMLHttpRequest
+HTTPTransportResponse XMLHttpRequestTransport::Send(const HTTPTransportRequest& request,
+                                                    const std::atomic<bool>* cancelled) {
+    if (cancelled && *cancelled) return FailedResponse("request was cancelled");
+
+    // Pass the headers as array of string pointers
+    std::vector<const char*> header_ptrs;
+    header_ptrs.reserve(request.headers.size() * 2);
+    for (auto& [key, value] : request.headers) {
+        header_ptrs.push_back(key.c_str());
+        header_ptrs.push_back(value.c_str());
+    }
+    auto has_body = request.method == "POST" || request.method == "PUT";
+
+    // The request keeps the header block and the body in JavaScript until the response is allocated
+    HTTPResponseEnvelope envelope = {};
+    // clang-format off
+    auto received = EM_ASM_INT(
+        {
+            var url = (UTF8ToString($0));
+            if (typeof XMLHttpRequest === "undefined") {
+                return 0;
+            }
+            const xhr = new XMLHttpRequest();
+            xhr.open(UTF8ToString($3), url, false);
+            xhr.responseType = "arraybuffer";
+
+            var i = 0;
+            var len = $1;
+            while (i < len*2) {
+                var ptr1 = HEAP32[($2)/4 + i ];
+                var ptr2 = HEAP32[($2)/4 + i + 1];
+
+                try {
+                    var z = encodeURI(UTF8ToString(ptr1));
+                    if (z === "Host") z = "X-Host-Override";
+                    if (z === "User-Agent") {}
+                    else if (z.toLowerCase() === "authorization") {
+                        xhr.setRequestHeader(z, UTF8ToString(ptr2));
+                    } else {
+                        xhr.setRequestHeader(z, encodeURI(UTF8ToString(ptr2)));
+                    }
+                } catch (error) {
+                    console.warn("Error while performing XMLHttpRequest.setRequestHeader()", error);
+                }
+                i += 2;
+            }
+
+            try {
+                if ($6) {
+                    xhr.send(Module.HEAPU8.slice($4, $4 + $5));
+                } else {
+                    xhr.send(null);
+                }
+            } catch {
+                return 0;
+            }
+            // Only a genuine network/CORS failure yields status 0; any real
+            // HTTP response (including 4xx/5xx) must be surfaced with its body
+            // and headers so callers (e.g. the Iceberg REST catalog) can react.
+            if (xhr.status === 0) return 0;
+            var body = new Uint8Array(xhr.response || new ArrayBuffer(0));
+            // The header block is copied as is and only parsed when a header is accessed
+            var headers = xhr.getAllResponseHeaders();
+            Module.duckdbPendingXHRResponse = {headers: headers, body: body};
+
+            // Write the envelope, see HTTPResponseEnvelope
+            Module.HEAPU32[($7 >> 2) + 0] = xhr.status;
+            Module.HEAPU32[($7 >> 2) + 1] = lengthBytesUTF8(headers);
+            Module.HEAPU32[($7 >> 2) + 2] = body.byteLength;
+            return 1;
+        },
+        request.url.c_str(), request.headers.size(), header_ptrs.data(), request.method.c_str(), request.body.data(),
+        request.body.size(), has_body, &envelope);
+    // clang-format on
+
+    if (!received) {
+        return FailedResponse("XMLHttpRequest failed");
+    }
+
+    // Copy the header block and the body straight into the response
+    HTTPTransportResponse response;
+    response.status = static_cast<uint16_t>(envelope.status);
+    response.raw_headers.resize(envelope.headers_length);
+    response.body.resize(envelope.body_length);
+    // clang-format off
+    EM_ASM(
+        {
+            var pending = Module.duckdbPendingXHRResponse;
+            Module.duckdbPendingXHRResponse = undefined;
+            stringToUTF8(pending.headers, $0, $1 + 1);
+            Module.HEAPU8.set(pending.body, $2);
+        },
+        response.raw_headers.data(), response.raw_headers.size(), response.body.data());
+    // clang-format on
+    return response;
+}
+
+/// Create the default transport
+std::shared_ptr<HTTPTransport> CreateDefaultHTTPTransport() { return std::make_shared<XMLHttpRequestTransport>(); }
+
+#else
+
+namespace {
+
+/// An url that was split for a socket connection
+struct SocketURL {
+    /// The host
+    std::string host;
+    /// The port
+    std::string port;
+    /// The request target
+    std::string target;
+    /// The value of the host header
+    std::string authority;
+};
+
+/// Split an http url
+static std::optional<SocketURL> SplitURL(std::string_view url, std::string& error) {
+    constexpr std::string_view HTTP_PREFIX = "http://";
+    if (url.compare(0, HTTP_PREFIX.size(), HTTP_PREFIX) != 0) {
+        error = "the socket transport only supports http urls: " + std::string{url};
+        return std::nullopt;
+    }
+    url.remove_prefix(HTTP_PREFIX.size());
+    auto authority_end = url.find_first_of("/?#");
+    SocketURL result;
+    result.authority = std::string{url.substr(0, authority_end)};
+    result.target = (authority_end == std::string_view::npos) ? "/" : std::string{url.substr(authority_end)};
+    if (!result.target.empty() && result.target[0] != '/') result.target = "/" + result.target;
+
+    std::string_view authority = result.authority;
+    if (!authority.empty() && authority[0] == '[') {
+        auto close = authority.find(']');
+        if (close == std::string_view::npos) {
+            error = "invalid url: " + std::string{url};
+            return std::nullopt;
+        }
+        result.host = std::string{authority.substr(1, close - 1)};
+        authority.remove_prefix(close + 1);
+        result.port = (!authority.empty() && authority[0] == ':') ? std::string{authority.substr(1)} : "80";
+    } else {
+        auto colon = authority.rfind(':');
+        result.host = std::string{authority.substr(0, colon)};
+        result.port = (colon == std::string_view::npos) ? "80" : std::string{authority.substr(colon + 1)};
+    }
+    if (result.host.empty()) {
+        error = "invalid url: " + std::string{url};
+        return std::nullopt;
+    }
+    return result;
+}
+
+/// Connect to a host
+static int Connect(const SocketURL& url, std::string& error) {
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (auto rc = ::getaddrinfo(url.host.c_str(), url.port.c_str(), &hints, &addresses); rc != 0) {
+        error = std::string{"failed to resolve host "} + url.host + ": " + ::gai_strerror(rc);
+        return -1;
+    }
+    auto free_addresses = sg::make_scope_guard([&]() { ::freeaddrinfo(addresses); });
+    for (auto* address = addresses; address; address = address->ai_next) {
+        auto fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) return fd;
+        ::close(fd);
+    }
+    error = "failed to connect to " + url.authority;
+    return -1;
+}
+
+/// Send all bytes
+static bool SendAll(int fd, std::string_view data) {
+    while (!data.empty()) {
+        auto n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data.remove_prefix(n);
+    }
+    return true;
+}
+
+/// Decode a chunked body
+static std::optional<std::string> DecodeChunked(std::string_view body) {
+    std::string out;
+    while (true) {
+        auto eol = body.find("\r\n");
+        if (eol == std::string_view::npos) return std::nullopt;
+        auto size_text = std::string{body.substr(0, eol)};
+        char* end = nullptr;
+        auto size = std::strtoull(size_text.c_str(), &end, 16);
+        body.remove_prefix(eol + 2);
+        if (size == 0) return out;
+        if (body.size() < size + 2) return std::nullopt;
+        out.append(body.data(), size);
+        body.remove_prefix(size + 2);
+    }
+}
+
+}  // namespace
+
+/// Send a request over a plain TCP socket
+HTTPTransportResponse SocketHTTPTransport::Send(const HTTPTransportRequest& request,
+                                                const std::atomic<bool>* cancelled) {
+    std::string error;
+    auto url = SplitURL(request.url, error);
+    if (!url) return FailedResponse(std::move(error));
+    if (cancelled && *cancelled) return FailedResponse("request was cancelled");
+
+    // Connect to the server
+    auto fd = Connect(*url, error);
+    if (fd < 0) return FailedResponse(std::move(error));
+    auto close_socket = sg::make_scope_guard([&]() { ::close(fd); });
+
+    // Write the request
+    std::stringstream out;
+    out << request.method << " " << url->target << " HTTP/1.1\r\n";
+    out << "Host: " << url->authority << "\r\n";
+    for (auto& [key, value] : request.headers) {
+        if (EqualsIgnoreCase(key, "Host") || EqualsIgnoreCase(key, "Connection") ||
+            EqualsIgnoreCase(key, "Content-Length")) {
+            continue;
+        }
+        out << key << ": " << value << "\r\n";
+    }
+    if (!request.body.empty() || request.method == "POST" || request.method == "PUT") {
+        out << "Content-Length: " << request.body.size() << "\r\n";
+    }
+    out << "Connection: close\r\n\r\n";
+    if (!SendAll(fd, out.str()) || !SendAll(fd, request.body)) {
+        return FailedResponse("failed to send request to " + url->authority);
+    }
+
+    // Read the response until the server closes the connection or the body is complete
+    std::string buffer;
+    std::vector<char> chunk(1 << 16);
+    size_t header_end = std::string::npos;
+    std::optional<size_t> content_length;
+    bool expects_body = true;
+    HTTPTransportResponse response;
+    while (true) {
+        if (cancelled && *cancelled) return FailedResponse("request was cancelled");
+        pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+        auto ready = ::poll(&pfd, 1, POLL_INTERVAL_MS);
+        if (ready < 0 && errno != EINTR) return FailedResponse("failed to wait for response");
+        if (ready <= 0) continue;
+        auto n = ::recv(fd, chunk.data(), chunk.size(), 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return FailedResponse("failed to receive response");
+        }
+        if (n == 0) break;
+        buffer.append(chunk.data(), n);
+
+        // Parse the status line and the headers
+        if (header_end == std::string::npos) {
+            header_end = buffer.find("\r\n\r\n");
+            if (header_end == std::string::npos) continue;
+            std::string_view head{buffer.data(), header_end};
+            auto status_end = head.find("\r\n");
+            auto status_line = head.substr(0, status_end);
+            auto sp = status_line.find(' ');
+            if (sp == std::string_view::npos) return FailedResponse("invalid status line");
+            response.status = static_cast<uint16_t>(std::atoi(std::string{status_line.substr(sp + 1, 3)}.c_str()));
+            if (status_end != std::string_view::npos) response.raw_headers = head.substr(status_end + 2);
+            expects_body = request.method != "HEAD" && response.status != 204 && response.status != 304;
+            auto chunked = response.FindHeader("Transfer-Encoding");
+            if (auto length = response.FindHeader("Content-Length"); length && !chunked) {
+                content_length = std::strtoull(std::string{*length}.c_str(), nullptr, 10);
+            }
+        }
+        // Complete?
+        if (!expects_body) break;
+        if (content_length && (buffer.size() - header_end - 4) >= *content_length) break;
+    }
+    if (header_end == std::string::npos) return FailedResponse("connection closed before receiving a response");
+
+    // Extract the body
+    if (expects_body) {
+        std::string_view body{buffer.data() + header_end + 4, buffer.size() - header_end - 4};
+        if (auto encoding = response.FindHeader("Transfer-Encoding"); encoding && EqualsIgnoreCase(*encoding, "chunked")) {
+            auto decoded = DecodeChunked(body);
+            if (!decoded) return FailedResponse("invalid chunked response body");
+            response.body = std::move(*decoded);
+        } else {
+            if (content_length) body = body.substr(0, *content_length);
+            response.body = std::string{body};
+        }
+    }
+    return response;
+}
+
+/// Create the default transport
+std::shared_ptr<HTTPTransport> CreateDefaultHTTPTransport() { return std::make_shared<SocketHTTPTransport>(); }
+
+#endif
+
+/// Add a static resource
+void MockHTTPTransport::AddResource(std::string url, std::string data, std::optional<std::string> etag) {
+    if (!etag) {
+        std::stringstream ss;
+        ss << "\"" << std::hex << std::hash<std::string>{}(data) << "\"";
+        etag = ss.str();
+    }
+    auto resource = std::make_shared<const Resource>(Resource{std::move(data), std::move(*etag)});
+    std::unique_lock<std::mutex> guard{mutex_};
+    resources_[std::move(url)] = std::move(resource);
+}
+/// Set a custom handler
+void MockHTTPTransport::SetHandler(Handler handler) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    handler_ = std::move(handler);
+}
+/// Set the latency of every request
+void MockHTTPTransport::SetLatency(std::chrono::microseconds latency) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    latency_ = latency;
+}
+/// Set the bandwidth
+void MockHTTPTransport::SetBandwidth(uint64_t bytes_per_second) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    bandwidth_ = bytes_per_second;
+}
+/// Fail requests randomly
+void MockHTTPTransport::SetErrorRate(double rate, uint16_t status) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    error_rate_ = rate;
+    error_status_ = status;
+}
+/// Fail the next n requests
+void MockHTTPTransport::FailNextRequests(size_t n, uint16_t status) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    failing_requests_ = n;
+    error_status_ = status;
+}
+
+/// Send a request
+HTTPTransportResponse MockHTTPTransport::Send(const HTTPTransportRequest& request, const std::atomic<bool>* cancelled) {
+    request_count_.fetch_add(1, std::memory_order_relaxed);
+
+    // Resolve the behavior of this request
+    std::shared_ptr<const Resource> resource;
+    Handler handler;
+    std::chrono::microseconds latency;
+    uint64_t bandwidth;
+    std::optional<uint16_t> injected_error;
+    {
+        std::unique_lock<std::mutex> guard{mutex_};
+        if (auto iter = resources_.find(request.url); iter != resources_.end()) {
+            resource = iter->second;
+        }
+        handler = handler_;
+        latency = latency_;
+        bandwidth = bandwidth_;
+        if (failing_requests_ > 0) {
+            --failing_requests_;
+            injected_error = error_status_;
+        } else if (error_rate_ > 0 && std::uniform_real_distribution<double>{0.0, 1.0}(rng_) < error_rate_) {
+            injected_error = error_status_;
+        }
+    }
+
+    // Simulate the latency
+    if (!WaitUnlessCancelled(latency, cancelled)) return FailedResponse("request was cancelled");
+    if (injected_error) {
+        if (*injected_error == 0) return FailedResponse("injected network error");
+        HTTPTransportResponse response;
+        response.status = *injected_error;
+        response.body = "injected error";
+        return response;
+    }
+
+    // Produce the response
+    HTTPTransportResponse response;
+    if (resource) {
+        response = ServeResource(request, resource->data, resource->etag);
+    } else if (handler) {
+        response = handler(request);
+    } else {
+        response.status = 404;
+    }
+
+    // Simulate the bandwidth
+    if (bandwidth > 0) {
+        auto transfer = std::chrono::microseconds{response.body.size() * 1000000 / bandwidth};
+        if (!WaitUnlessCancelled(transfer, cancelled)) return FailedResponse("request was cancelled");
+    }
+    bytes_sent_.fetch_add(response.body.size(), std::memory_order_relaxed);
+    return response;
+}
+
+/// Serve a static resource
+HTTPTransportResponse MockHTTPTransport::ServeResource(const HTTPTransportRequest& request, std::string_view data,
+                                                       std::string_view etag) {
+    HTTPTransportResponse response;
+    if (!etag.empty()) {
+        response.headers.emplace_back("ETag", std::string{etag});
+        if (request.FindHeader("If-None-Match") == etag) {
+            response.status = 304;
+            return response;
+        }
+    }
+    if (request.method == "HEAD") {
+        response.status = 200;
+        response.headers.emplace_back("Content-Length", std::to_string(data.size()));
+        response.headers.emplace_back("Accept-Ranges", "bytes");
+        return response;
+    }
+    if (request.method != "GET") {
+        response.status = 405;
+        return response;
+    }
+
+    // Serve the entire resource?
+    auto range = request.FindHeader("Range");
+    if (!range || range->compare(0, 6, "bytes=") != 0) {
+        response.status = 200;
+        response.headers.emplace_back("Content-Length", std::to_string(data.size()));
+        response.body = std::string{data};
+        return response;
+    }
+
+    // Parse the byte range
+    auto spec = std::string{range->substr(6)};
+    auto dash = spec.find('-');
+    if (dash == std::string::npos) {
+        response.status = 416;
+        return response;
+    }
+    auto first_text = spec.substr(0, dash);
+    auto last_text = spec.substr(dash + 1);
+    uint64_t first = 0;
+    uint64_t last = data.empty() ? 0 : data.size() - 1;
+    if (first_text.empty()) {
+        auto suffix = std::min<uint64_t>(std::strtoull(last_text.c_str(), nullptr, 10), data.size());
+        first = data.size() - suffix;
+    } else {
+        first = std::strtoull(first_text.c_str(), nullptr, 10);
+        if (!last_text.empty()) last = std::min<uint64_t>(last, std::strtoull(last_text.c_str(), nullptr, 10));
+    }
+    if (first >= data.size() || first > last) {
+        response.status = 416;
+        response.headers.emplace_back("Content-Range", "bytes */" + std::to_string(data.size()));
+        return response;
+    }
+    response.status = 206;
+    response.body = std::string{data.substr(first, last - first + 1)};
+    response.headers.emplace_back("Content-Length", std::to_string(response.body.size()));
+    response.headers.emplace_back("Content-Range", "bytes " + std::to_string(first) + "-" + std::to_string(last) +
+                                                       "/" + std::to_string(data.size()));
+    return response;
+}
+
+}  // namespace web
+}  // namespace duckdb
@@ -1,11 +1,13 @@
 #include "duckdb/web/http_wasm.h"
 
-#include <emscripten.h>
-
 #include <iostream>
 
 #include "duckdb/common/http_util.hpp"
 #include "duckdb/web/config.h"
+#include "duckdb/web/http_hedging.h"
+#include "duckdb/web/http_scheduler.h"
+#include "duckdb/web/http_transport.h"
+#include "duckdb/web/io/web_filesystem.h"
 
 namespace duckdb {
 class HTTPLogger;
@@ -27,27 +29,51 @@ HTTPHeaders TransformHeadersWasm(const HTTPHeaders &header_map, const HTTPParams
     return res_headers;
 }
 
+/// Translate a response of the transport
+static unique_ptr<HTTPResponse> TransformResponse(web::HTTPTransportResponse response) {
+    if (response.status == 0) {
+        auto res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
+        res->reason = "Please consult the browser console for details, might be potentially a CORS error";
+        if (!response.error.empty()) res->reason += " (" + response.error + ")";
+        return res;
+    }
+    auto res = make_uniq<HTTPResponse>(HTTPUtil::ToStatusCode(response.status));
+    res->reason = HTTPUtil::GetStatusMessage(res->status);
+    response.ForEachHeader(
+        [&](std::string_view key, std::string_view value) { res->headers.Insert(string{key}, string{value}); });
+    res->body = std::move(response.body);
+    return res;
+}
+
 class HTTPWasmClient : public HTTPClient {
    public:
-    HTTPWasmClient(HTTPFSParams &http_params, const string &proto_host_port) {
+    HTTPWasmClient(HTTPFSParams &http_params, const string &proto_host_port,
+                   std::shared_ptr<web::HTTPTransport> transport, shared_ptr<web::HTTPHedging> hedging)
+        : transport(std::move(transport)), hedging(std::move(hedging)) {
         host_port = proto_host_port;
         state = http_params.state;
+        hedging_config = HTTPWasmParams::GetHedging(http_params);
     }
     void Initialize(HTTPParams &params) override {
         auto &http_params = params.Cast<HTTPFSParams>();
         state = http_params.state;
+        hedging_config = HTTPWasmParams::GetHedging(http_params);
     }
     string host_port;
-
-    unique_ptr<HTTPResponse> Get(GetRequestInfo &info) override {
-        // clang-format off
-        unique_ptr<HTTPResponse> res;
-
-        string path = info.url;
-        if (path[0] == '/') path = host_port + info.url;
+    /// The transport
+    std::shared_ptr<web::HTTPTransport> transport;
+    /// The hedging of range requests
+    shared_ptr<web::HTTPHedging> hedging;
+    /// The hedging settings
+    web::HTTPHedgingConfig hedging_config;
+
+    /// Resolve the url of a request
+    string ResolveURL(const string &url) const {
+        string path = url;
+        if (path[0] == '/') path = host_port + url;
 
         if (!web::experimental_s3_tables_global_proxy.empty()) {
-            if (info.url.rfind(web::experimental_s3_tables_global_proxy, 0) != 0) {
+            if (url.rfind(web::experimental_s3_tables_global_proxy, 0) != 0) {
                 auto id_table = path.find("--table-s3.s3.");
                 auto id_aws = path.find(".amazonaws.com/");
                 if (id_table != std::string::npos && id_aws != std::string::npos && id_table < id_aws) {
@@ -58,1037 +84,81 @@ class HTTPWasmClient : public HTTPClient {
         if ((path.rfind("https://", 0) != 0) && (path.rfind("http://", 0) != 0)) {
             path = "https://" + path;
         }
-        auto headers = TransformHeadersWasm(info.headers, info.params);
-
-        int n = 0;
-        for (auto h : headers) {
-            n++;
-        }
-        char **z = (char **)(void *)malloc(n * 4 * 2);
-
-        int i = 0;
-        for (auto h : headers) {
-            z[i] = (char *)malloc(h.first.size() * 4 + 1);
-            memset(z[i], 0, h.first.size() * 4 + 1);
-            memcpy(z[i], h.first.c_str(), h.first.size());
-            i++;
-            z[i] = (char *)malloc(h.second.size() * 4 + 1);
-            memset(z[i], 0, h.second.size() * 4 + 1);
-            memcpy(z[i], h.second.c_str(), h.second.size());
-            i++;
-        }
-
-        char *exe = NULL;
-        exe = (char *)EM_ASM_PTR(
-            {
-                var url = (UTF8ToString($0));
-                if (typeof XMLHttpRequest === "undefined") {
-                    return 0;
-                }
-                const xhr = new XMLHttpRequest();
-		if (false && url.startsWith("http://")) {
-			url = "https://" + url.substr(7);
-		}
-                xhr.open(UTF8ToString($3), url, false);
-                xhr.responseType = "arraybuffer";
-
-                var i = 0;
-                var len = $1;
-                while (i < len*2) {
-                    var ptr1 = HEAP32[($2)/4 + i ];
-                    var ptr2 = HEAP32[($2)/4 + i + 1];
-
-                    try {
-			var z = encodeURI(UTF8ToString(ptr1));
-			if (z === "Host") z = "X-Host-Override";
-			if (z === "User-Agent") {}
-			else if (z.toLowerCase() === "authorization") {
-                        	xhr.setRequestHeader(z, UTF8ToString(ptr2));
-			} else {
-
-                        	xhr.setRequestHeader(z, encodeURI(UTF8ToString(ptr2)));
-			}
-                    } catch (error) {
-                console.warn("Error while performing XMLHttpRequest.setRequestHeader()", error);
-                    }
-                    i += 2;
-                }
-
-                try {
-                    xhr.send(null);
-                } catch {
-                    return 0;
-                }
-                // Only a genuine network/CORS failure yields status 0; any real
-                // HTTP response (including 4xx/5xx) must be surfaced with its body
-                // and headers so callers (e.g. the Iceberg REST catalog) can react.
-                if (xhr.status === 0) return 0;
-                var uInt8Array = xhr.response;
-                if (!uInt8Array) uInt8Array = new ArrayBuffer(0);
-
-                var len = uInt8Array.byteLength;
-                var fileOnWasmHeap = _malloc(len + 8);
-
-                var properArray = new Uint8Array(uInt8Array);
-
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + fileOnWasmHeap + 8] = properArray[iii];
-                }
-
-                var LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap + 4);
-
-		var headers = Uint8Array.from(Array.from(xhr.getAllResponseHeaders()).map(letter => letter.charCodeAt(0)));
-		len = headers.byteLength;
-                var headersOnWasmHeap = _malloc(len + 8);
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + headersOnWasmHeap + 8] = headers[iii];
-                }
-
-                LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, headersOnWasmHeap + 4);
-
-                // Stash the real HTTP status in the (otherwise unused) first 4
-                // bytes of the headers buffer so C++ can recover it.
-                var st123 = xhr.status;
-                var STAT123 = new Uint8Array(4);
-                STAT123[0] = st123 % 256; st123 -= STAT123[0]; st123 /= 256;
-                STAT123[1] = st123 % 256; st123 -= STAT123[1]; st123 /= 256;
-                STAT123[2] = st123 % 256; st123 -= STAT123[2]; st123 /= 256;
-                STAT123[3] = st123 % 256;
-                Module.HEAPU8.set(STAT123, headersOnWasmHeap + 0);
-
-		len = headersOnWasmHeap;
-                LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap);
-
-                return fileOnWasmHeap;
-            },
-            path.c_str(), n, z, "GET");
-        // clang-format on
-
-        i = 0;
-        for (auto h : headers) {
-            free(z[i]);
-            i++;
-            free(z[i]);
-            i++;
-        }
-        free(z);
+        return path;
+    }
+    /// Prepare a request for the transport
+    web::HTTPTransportRequest PrepareRequest(const char *method, const string &url, const HTTPHeaders &headers,
+                                             const HTTPParams &params) const {
+        web::HTTPTransportRequest request;
+        request.method = method;
+        request.url = ResolveURL(url);
+        request.priority = web::HTTPRequestPriorityScope::Get();
+        for (auto &header : TransformHeadersWasm(headers, params)) {
+            request.headers.emplace_back(header.first, header.second);
+        }
+        return request;
+    }
 
-        if (!exe) {
-            res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
-            res->reason = "Please consult the browser console for details, might be potentially a CORS error";
+    unique_ptr<HTTPResponse> Get(GetRequestInfo &info) override {
+        auto request = PrepareRequest("GET", info.url, info.headers, info.params);
+        web::HTTPTransportResponse response;
+        if (request.FindHeader("Range")) {
+            // Range requests are hedged if enabled.
+            // The request is captured by value since a cancelled loser may outlive this call.
+            web::HTTPHedging::Request<web::HTTPTransportResponse> hedged =
+                [transport = transport, request](const std::atomic<bool> &cancelled) {
+                    return transport->Send(request, &cancelled);
+                };
+            response = hedging->Run(hedging_config, std::move(hedged));
         } else {
-            res = duckdb::make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
-
-            uint64_t next = 0;
-            {
-                uint64_t LEN = 0;
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[3];
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[2];
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[1];
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[0];
-                next = LEN;
-            }
-            uint64_t len = 0;
-            {
-                uint64_t LEN = 0;
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[3 + 4];
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[2 + 4];
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[1 + 4];
-                LEN *= 256;
-                LEN += ((uint8_t *)exe)[0 + 4];
-                len = LEN;
-            }
-
-            uint64_t len_headers = 0;
-            {
-                uint64_t LEN = 0;
-                LEN *= 256;
-                LEN += ((uint8_t *)next)[3 + 4];
-                LEN *= 256;
-                LEN += ((uint8_t *)next)[2 + 4];
-                LEN *= 256;
-                LEN += ((uint8_t *)next)[1 + 4];
-                LEN *= 256;
-                LEN += ((uint8_t *)next)[0 + 4];
-                len_headers = LEN;
-            }
-
-            // Recover the real HTTP status stashed in the headers buffer prefix.
-            int32_t status_code = 0;
-            status_code |= static_cast<uint8_t>(((uint8_t *)next)[0]);
-            status_code |= static_cast<uint8_t>(((uint8_t *)next)[1]) << 8;
-            status_code |= static_cast<uint8_t>(((uint8_t *)next)[2]) << 16;
-            status_code |= static_cast<uint8_t>(((uint8_t *)next)[3]) << 24;
-            if (status_code != 0) {
-                res->status = HTTPUtil::ToStatusCode(status_code);
-                res->reason = HTTPUtil::GetStatusMessage(res->status);
-            }
-
-            char *ptr = reinterpret_cast<char *>(next);
-
-            string headers = string(ptr + 8, len_headers);
-
-            vector<string> vec_headers = StringUtil::Split(headers, "\r\n");
-
-            for (auto h : vec_headers) {
-                int j = 0;
-                while (j < h.size() && h[j] != ':') j++;
-                string head = string(h.c_str(), j);
-                while (j < h.size() && h[j] != ' ') j++;
-                string tail = string(h.c_str() + j + 1);
-                res->headers.Insert(head, tail);
-            }
-
-            res->body = string(exe + 8, len);
-
-            idx_t LEN_X_T = len;
-            if (info.content_handler) {
-                info.content_handler(((const unsigned char *)exe) + 8, LEN_X_T);
-            }
-
-            free(exe);
-            free(ptr);
+            response = transport->Send(request);
+        }
+        auto res = TransformResponse(std::move(response));
+        if (info.content_handler) {
+            info.content_handler(reinterpret_cast<const unsigned char *>(res->body.data()), res->body.size());
         }
-
         return res;
     }
     unique_ptr<HTTPResponse> Head(HeadRequestInfo &info) override {
-        unique_ptr<HTTPResponse> res;
-
-        string path = info.url;
-        if (path[0] == '/') path = host_port + info.url;
-
-        if (!web::experimental_s3_tables_global_proxy.empty()) {
-            if (info.url.rfind(web::experimental_s3_tables_global_proxy, 0) != 0) {
-                auto id_table = path.find("--table-s3.s3.");
-                auto id_aws = path.find(".amazonaws.com/");
-                if (id_table != std::string::npos && id_aws != std::string::npos && id_table < id_aws) {
-                    path = web::experimental_s3_tables_global_proxy + path.substr(8);
-                }
-            }
-        }
-        if ((path.rfind("https://", 0) != 0) && (path.rfind("http://", 0) != 0)) {
-            path = "https://" + path;
-        }
-        auto headers = TransformHeadersWasm(info.headers, info.params);
-        int n = 0;
-        for (auto h : headers) {
-            n++;
-        }
-
-        char **z = (char **)(void *)malloc(n * 4 * 2);
-
-        int i = 0;
-        for (auto h : headers) {
-            z[i] = (char *)malloc(h.first.size() * 4 + 1);
-            memset(z[i], 0, h.first.size() * 4 + 1);
-            memcpy(z[i], h.first.c_str(), h.first.size());
-            i++;
-            z[i] = (char *)malloc(h.second.size() * 4 + 1);
-            memset(z[i], 0, h.second.size() * 4 + 1);
-            memcpy(z[i], h.second.c_str(), h.second.size());
-            i++;
-        }
-
-        // clang-format off
-        char *exe = NULL;
-        exe = (char *)EM_ASM_PTR(
-            {
-                var url = (UTF8ToString($0));
-                if (typeof XMLHttpRequest === "undefined") {
-                    return 0;
-                }
-                const xhr = new XMLHttpRequest();
-		if (false && url.startsWith("http://")) {
-			url = "https://" + url.substr(7);
-		}
-                xhr.open(UTF8ToString($3), url, false);
-                xhr.responseType = "arraybuffer";
-
-                var i = 0;
-                var len = $1;
-                while (i < len*2) {
-                    var ptr1 = HEAP32[($2)/4 + i ];
-                    var ptr2 = HEAP32[($2)/4 + i + 1];
-
-console.log('HEAD', UTF8ToString(ptr1), UTF8ToString(ptr2));
-                    try {
-			var z = encodeURI(UTF8ToString(ptr1));
-			if (z === "Host") z = "X-Host-Override";
-			if (z === "User-Agent") {}
-			else if (z.toLowerCase() === "authorization") {
-                        	xhr.setRequestHeader(z, UTF8ToString(ptr2));
-			} else {
-				
-                        	xhr.setRequestHeader(z, encodeURI(UTF8ToString(ptr2)));
-			}
-                    } catch (error) {
-                console.warn("Error while performing XMLHttpRequest.setRequestHeader()", error);
-                    }
-                    i += 2;
-                }
-
-                try {
-                    xhr.send(null);
-                } catch {
-                    return 0;
-                }
-                if (xhr.status === 0) return 0;
-
-                var uInt8Array = xhr.response;
-                if (!uInt8Array) uInt8Array = new ArrayBuffer(0);
-                var len = uInt8Array.byteLength;
-                var fileOnWasmHeap = _malloc(len + 8);
-
-                var properArray = new Uint8Array(uInt8Array);
-
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + fileOnWasmHeap + 8] = properArray[iii];
-                }
-
-                var LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap + 4);
-
-		var headers = Uint8Array.from(Array.from(xhr.getAllResponseHeaders()).map(letter => letter.charCodeAt(0)));
-		len = headers.byteLength;
-                var headersOnWasmHeap = _malloc(len + 8);
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + headersOnWasmHeap + 8] = headers[iii];
-                }
-
-                LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, headersOnWasmHeap + 4);
-
-                var st123 = xhr.status;
-                var STAT123 = new Uint8Array(4);
-                STAT123[0] = st123 % 256; st123 -= STAT123[0]; st123 /= 256;
-                STAT123[1] = st123 % 256; st123 -= STAT123[1]; st123 /= 256;
-                STAT123[2] = st123 % 256; st123 -= STAT123[2]; st123 /= 256;
-                STAT123[3] = st123 % 256;
-                Module.HEAPU8.set(STAT123, headersOnWasmHeap + 0);
-
-		len = headersOnWasmHeap;
-                LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap);
-
-                return fileOnWasmHeap;
-            },
-            path.c_str(), n, z, "HEAD");
-
-        i = 0;
-
-        for (auto h : headers) {
-            free(z[i]);
-            i++;
-            free(z[i]);
-            i++;
-        }
-        free(z);
-
-        if (!exe) {
-            res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
-            res->reason = "Please consult the browser console for details, might be potentially a CORS error";
-        } else {
-            res = duckdb::make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
-
-		uint64_t next = 0;
-	{
-            uint64_t LEN = 0;	
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[3];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[2];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[1];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[0];
-		next = LEN;
-	}
-		uint64_t len = 0;
-	{
-            uint64_t LEN = 0;	
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[3 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[2 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[1 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[0 + 4];
-		len = LEN;
-	}
-
-		uint64_t len_headers = 0;
-	{
-            uint64_t LEN = 0;	
-            LEN *= 256;
-            LEN += ((uint8_t *)next)[3 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)next)[2 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)next)[1 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)next)[0 + 4];
-		len_headers = LEN;
-	}
-		
-			int32_t status_code = 0;
-		status_code |= static_cast<uint8_t>((((uint8_t *)next)[0]));
-		status_code |= static_cast<uint8_t>((((uint8_t *)next)[1])) << 8;
-		status_code |= static_cast<uint8_t>((((uint8_t *)next)[2])) << 16;
-		status_code |= static_cast<uint8_t>((((uint8_t *)next)[3])) << 24;
-		if (status_code != 0) {
-		    res->status = HTTPUtil::ToStatusCode(status_code);
-		    res->reason = HTTPUtil::GetStatusMessage(res->status);
-		}
-
-		char * ptr = reinterpret_cast<char*>(next) ;
-
-
-	string headers = string(ptr + 8, len_headers);
-
-vector<string> vec_headers = StringUtil::Split(headers, "\r\n");
-
-for (auto h : vec_headers) {
-int i = 0;
-while (i < h.size() && h[i] != ':') i++;
-
-string head = string(h.c_str(), i);
-
-while (i < h.size() && h[i] != ' ') i++;
-string tail = string(h.c_str() + i+1);
-
-res->headers.Insert(head, tail);	
-	}
-	
-
-
-
-
-            res->body = string(exe + 8, len);
-            /*
-                        if (info.content_handler) {
-                            info.content_handler((const unsigned char *)exe + 4, LEN);
-                        }
-            */
-
-            free(exe);
-            free(ptr);
-        }
-        // clang-format on
-
-        return res;
+        auto request = PrepareRequest("HEAD", info.url, info.headers, info.params);
+        return TransformResponse(transport->Send(request));
     }
     unique_ptr<HTTPResponse> Post(PostRequestInfo &info) override {
-        unique_ptr<HTTPResponse> res;
-
-        string path = info.url;
-        if (path[0] == '/') path = host_port + info.url;
-
-        if (!web::experimental_s3_tables_global_proxy.empty()) {
-            if (info.url.rfind(web::experimental_s3_tables_global_proxy, 0) != 0) {
-                auto id_table = path.find("--table-s3.s3.");
-                auto id_aws = path.find(".amazonaws.com/");
-                if (id_table != std::string::npos && id_aws != std::string::npos && id_table < id_aws) {
-                    path = web::experimental_s3_tables_global_proxy + path.substr(8);
-                }
-            }
-        }
-        if ((path.rfind("https://", 0) != 0) && (path.rfind("http://", 0) != 0)) {
-            path = "https://" + path;
-        }
-        auto headers = TransformHeadersWasm(info.headers, info.params);
-        int n = 0;
-        for (auto h : headers) {
-            n++;
-        }
-
-        char **z = (char **)(void *)malloc(n * 4 * 2);
-
-        int i = 0;
-        for (auto h : headers) {
-            z[i] = (char *)malloc(h.first.size() * 4 + 1);
-            memset(z[i], 0, h.first.size() * 4 + 1);
-            memcpy(z[i], h.first.c_str(), h.first.size());
-            i++;
-            z[i] = (char *)malloc(h.second.size() * 4 + 1);
-            memset(z[i], 0, h.second.size() * 4 + 1);
-            memcpy(z[i], h.second.c_str(), h.second.size());
-            i++;
-        }
-
-        const int buffer_length = info.buffer_in_len;
-        char *payload = (char *)malloc(buffer_length);
-        memcpy(payload, info.buffer_in, buffer_length);
-
-        // clang-format off
-        char *exe = NULL;
-        exe = (char *)EM_ASM_PTR(
-            {
-                var url = (UTF8ToString($0));
-                if (typeof XMLHttpRequest === "undefined") {
-                    return 0;
-                }
-                const xhr = new XMLHttpRequest();
-		if (false && url.startsWith("http://")) {
-			url = "https://" + url.substr(7);
-		}
-                xhr.open(UTF8ToString($3), url, false);
-                xhr.responseType = "arraybuffer";
-
-                var i = 0;
-                var len = $1;
-                while (i < len*2) {
-                    var ptr1 = HEAP32[($2)/4 + i ];
-                    var ptr2 = HEAP32[($2)/4 + i + 1];
-
-                    try {
-			var z = encodeURI(UTF8ToString(ptr1));
-			if (z === "Host") z = "X-Host-Override";
-			if (z === "User-Agent") {}
-			else if (z.toLowerCase() === "authorization") {
-                        	xhr.setRequestHeader(z, UTF8ToString(ptr2));
-			} else {
-				
-                        	xhr.setRequestHeader(z, encodeURI(UTF8ToString(ptr2)));
-			}
-                    } catch (error) {
-                console.warn("Error while performing XMLHttpRequest.setRequestHeader()", error);
-                    }
-                    i += 2;
-                }
-
-//xhr.setRequestHeader("Content-Type", "application/octet-stream");
-//xhr.setRequestHeader("Content-Type", "text/json");
-                try {
-			var post_payload = new Uint8Array($5);
-
-			for (var iii = 0; iii < $5; iii++) {
-				post_payload[iii] = Module.HEAPU8[iii + $4];
-			}
-			xhr.send(post_payload);
-                } catch {
-                    return 0;
-                }
-                if (xhr.status === 0) return 0;
-                var uInt8Array = xhr.response;
-                if (!uInt8Array) uInt8Array = new ArrayBuffer(0);
-
-                var len = uInt8Array.byteLength;
-                var fileOnWasmHeap = _malloc(len + 8);
-
-                var properArray = new Uint8Array(uInt8Array);
-
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + fileOnWasmHeap + 8] = properArray[iii];
-                }
-                var LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap + 4);
-                var st123 = xhr.status;
-                var STAT123 = new Uint8Array(4);
-                STAT123[0] = st123 % 256; st123 -= STAT123[0]; st123 /= 256;
-                STAT123[1] = st123 % 256; st123 -= STAT123[1]; st123 /= 256;
-                STAT123[2] = st123 % 256; st123 -= STAT123[2]; st123 /= 256;
-                STAT123[3] = st123 % 256;
-                Module.HEAPU8.set(STAT123, fileOnWasmHeap + 0);
-                return fileOnWasmHeap;
-            },
-            path.c_str(), n, z, "POST", payload, buffer_length);
-        // clang-format on
-
-        free(payload);
-
-        i = 0;
-        for (auto h : headers) {
-            free(z[i]);
-            i++;
-            free(z[i]);
-            i++;
+        auto request = PrepareRequest("POST", info.url, info.headers, info.params);
+        request.body = std::string_view{reinterpret_cast<const char *>(info.buffer_in), info.buffer_in_len};
+        auto res = TransformResponse(transport->Send(request));
+        auto status_code = static_cast<int32_t>(res->status);
+        if (status_code >= 200 && status_code < 300) {
+            info.buffer_out += res->body;
         }
-        free(z);
-
-        if (!exe) {
-            res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
-            res->reason = "Please consult the browser console for details, might be potentially a CORS error";
-        } else {
-            res = duckdb::make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
-            int32_t status_code = 0;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[0]));
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[1])) << 8;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[2])) << 16;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[3])) << 24;
-            if (status_code != 0) {
-                res->status = HTTPUtil::ToStatusCode(status_code);
-                res->reason = HTTPUtil::GetStatusMessage(res->status);
-            }
-            uint64_t LEN = 0;
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[3 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[2 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[1 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[0 + 4];
-            res->body = string(exe + 8, LEN);
-
-            if (status_code >= 200 && status_code < 300) {
-                info.buffer_out += string(exe + 8, LEN);
-            }
-
-            free(exe);
-        }
-
         return res;
     }
     unique_ptr<HTTPResponse> Put(PutRequestInfo &info) override {
-        unique_ptr<HTTPResponse> res;
-
-        string path = info.url;
-        if (path[0] == '/') path = host_port + info.url;
-
-        if (!web::experimental_s3_tables_global_proxy.empty()) {
-            if (info.url.rfind(web::experimental_s3_tables_global_proxy, 0) != 0) {
-                auto id_table = path.find("--table-s3.s3.");
-                auto id_aws = path.find(".amazonaws.com/");
-                if (id_table != std::string::npos && id_aws != std::string::npos && id_table < id_aws) {
-                    path = web::experimental_s3_tables_global_proxy + path.substr(8);
-                }
-            }
+        auto request = PrepareRequest("PUT", info.url, info.headers, info.params);
+        request.body = std::string_view{reinterpret_cast<const char *>(info.buffer_in), info.buffer_in_len};
+
+        // s3fs signs "Content-Type: application/octet-stream" into the SigV4
+        // canonical request but omits it from the header map for that default
+        // value; XHR will not add a Content-Type for a Uint8Array body, so the
+        // signed header would never be sent -> SignatureDoesNotMatch. Re-add it
+        // when the request does not already send one (keeps signed == sent,
+        // and stays correct once httpfs emits the header itself).
+        if (!request.FindHeader("Content-Type")) {
+            request.headers.emplace_back("Content-Type", "application/octet-stream");
+        }
+        auto response = transport->Send(request);
+        auto etag = response.FindHeader("ETag");
+        auto res = TransformResponse(response);
+        auto status_code = static_cast<int32_t>(res->status);
+        if (status_code >= 200 && status_code < 300) {
+            res->headers.Insert("ETag", etag ? string{*etag} : string{});
+            res->body.clear();
         }
-        if ((path.rfind("https://", 0) != 0) && (path.rfind("http://", 0) != 0)) {
-            path = "https://" + path;
-        }
-
-        auto headers = TransformHeadersWasm(info.headers, info.params);
-        int n = 0;
-        for (auto h : headers) {
-            n++;
-        }
-
-        char **z = (char **)(void *)malloc(n * 4 * 2);
-
-        int i = 0;
-        for (auto h : headers) {
-            z[i] = (char *)malloc(h.first.size() * 4 + 1);
-            memset(z[i], 0, h.first.size() * 4 + 1);
-            memcpy(z[i], h.first.c_str(), h.first.size());
-            i++;
-            z[i] = (char *)malloc(h.second.size() * 4 + 1);
-            memset(z[i], 0, h.second.size() * 4 + 1);
-            memcpy(z[i], h.second.c_str(), h.second.size());
-            i++;
-        }
-
-        const int buffer_length = info.buffer_in_len;
-        char *payload = (char *)malloc(buffer_length);
-        memcpy(payload, info.buffer_in, buffer_length);
-
-        // clang-format off
-        char *exe = NULL;
-        exe = (char *)EM_ASM_PTR(
-            {
-                var url = (UTF8ToString($0));
-                if (typeof XMLHttpRequest === "undefined") {
-                    return 0;
-                }
-                const xhr = new XMLHttpRequest();
-		if (false && url.startsWith("http://")) {
-			url = "https://" + url.substr(7);
-		}
-                xhr.open(UTF8ToString($3), url, false);
-                xhr.responseType = "arraybuffer";
-
-                var i = 0;
-                var len = $1;
-                var hasContentType = false;
-                while (i < len*2) {
-                    var ptr1 = HEAP32[($2)/4 + i ];
-                    var ptr2 = HEAP32[($2)/4 + i + 1];
-
-                    try {
-			var z = encodeURI(UTF8ToString(ptr1));
-			if (z === "Host") z = "X-Host-Override";
-			if (z.toLowerCase() === "content-type") hasContentType = true;
-			if (z === "User-Agent") {}
-			else if (z.toLowerCase() === "authorization") {
-                        	xhr.setRequestHeader(z, UTF8ToString(ptr2));
-			} else {
-				
-                        	xhr.setRequestHeader(z, encodeURI(UTF8ToString(ptr2)));
-			}
-                    } catch (error) {
-                console.warn("Error while performing XMLHttpRequest.setRequestHeader()", error);
-                    }
-                    i += 2;
-                }
-
-                // s3fs signs "Content-Type: application/octet-stream" into the SigV4
-                // canonical request but omits it from the header map for that default
-                // value; XHR will not add a Content-Type for a Uint8Array body, so the
-                // signed header would never be sent -> SignatureDoesNotMatch. Re-add it
-                // when the loop above did not already send one (keeps signed == sent,
-                // and stays correct once httpfs emits the header itself).
-                if (!hasContentType) {
-                    try { xhr.setRequestHeader("Content-Type", "application/octet-stream"); } catch (error) {}
-                }
-                try {
-			var post_payload = new Uint8Array($5);
-
-			for (var iii = 0; iii < $5; iii++) {
-				post_payload[iii] = Module.HEAPU8[iii + $4];
-			}
-			xhr.send(post_payload);
-                } catch {
-                    return 0;
-                }
-                if (xhr.status === 0) return 0;
-		var uInt8Array;
-                if (xhr.status >= 400) {
-                    var errb = xhr.response;
-                    uInt8Array = errb ? new Uint8Array(errb) : new Uint8Array(0);
-                } else {
-                    var et = xhr.getResponseHeader("Etag");
-                    uInt8Array = et ? Uint8Array.from(Array.from(et).map(letter => letter.charCodeAt(0))) : new Uint8Array(0);
-                }
-
-                var len = uInt8Array.byteLength;
-                var fileOnWasmHeap = _malloc(len + 8);
-
-                var properArray = new Uint8Array(uInt8Array);
-
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + fileOnWasmHeap + 8] = properArray[iii];
-                }
-                var LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap + 4);
-                var st123 = xhr.status;
-                var STAT123 = new Uint8Array(4);
-                STAT123[0] = st123 % 256; st123 -= STAT123[0]; st123 /= 256;
-                STAT123[1] = st123 % 256; st123 -= STAT123[1]; st123 /= 256;
-                STAT123[2] = st123 % 256; st123 -= STAT123[2]; st123 /= 256;
-                STAT123[3] = st123 % 256;
-                Module.HEAPU8.set(STAT123, fileOnWasmHeap + 0);
-                return fileOnWasmHeap;
-            },
-            path.c_str(), n, z, "PUT", payload, buffer_length);
-        // clang-format on
-
-        free(payload);
-
-        i = 0;
-        for (auto h : headers) {
-            free(z[i]);
-            i++;
-            free(z[i]);
-            i++;
-        }
-        free(z);
-
-        if (!exe) {
-            res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
-            res->reason = "Please consult the browser console for details, might be potentially a CORS error";
-        } else {
-            res = duckdb::make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
-            int32_t status_code = 0;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[0]));
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[1])) << 8;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[2])) << 16;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[3])) << 24;
-            if (status_code != 0) {
-                res->status = HTTPUtil::ToStatusCode(status_code);
-                res->reason = HTTPUtil::GetStatusMessage(res->status);
-            }
-            uint64_t LEN = 0;
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[3 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[2 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[1 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[0 + 4];
-            if (status_code >= 200 && status_code < 300) {
-                res->headers.Insert("ETag", string(exe + 8, LEN));
-            } else {
-                res->body = string(exe + 8, LEN);
-            }
-
-            // info.buffer_out += string(exe + 4, LEN);
-
-            free(exe);
-        }
-
         return res;
     }
     unique_ptr<HTTPResponse> Delete(DeleteRequestInfo &info) override {
-        unique_ptr<HTTPResponse> res;
-
-        string path = info.url;
-        if (path[0] == '/') path = host_port + info.url;
-
-        if (!web::experimental_s3_tables_global_proxy.empty()) {
-            if (info.url.rfind(web::experimental_s3_tables_global_proxy, 0) != 0) {
-                auto id_table = path.find("--table-s3.s3.");
-                auto id_aws = path.find(".amazonaws.com/");
-                if (id_table != std::string::npos && id_aws != std::string::npos && id_table < id_aws) {
-                    path = web::experimental_s3_tables_global_proxy + path.substr(8);
-                }
-            }
-        }
-        if ((path.rfind("https://", 0) != 0) && (path.rfind("http://", 0) != 0)) {
-            path = "https://" + path;
-        }
-
-        auto headers = TransformHeadersWasm(info.headers, info.params);
-        int n = 0;
-        for (auto h : headers) {
-            n++;
-        }
-
-        char **z = (char **)(void *)malloc(n * 4 * 2);
-
-        int i = 0;
-        for (auto h : headers) {
-            z[i] = (char *)malloc(h.first.size() * 4 + 1);
-            memset(z[i], 0, h.first.size() * 4 + 1);
-            memcpy(z[i], h.first.c_str(), h.first.size());
-            i++;
-            z[i] = (char *)malloc(h.second.size() * 4 + 1);
-            memset(z[i], 0, h.second.size() * 4 + 1);
-            memcpy(z[i], h.second.c_str(), h.second.size());
-            i++;
-        }
-
-        // clang-format off
-        char *exe = NULL;
-        exe = (char *)EM_ASM_PTR(
-            {
-                var url = (UTF8ToString($0));
-                if (typeof XMLHttpRequest === "undefined") {
-                    return 0;
-                }
-                const xhr = new XMLHttpRequest();
-		if (false && url.startsWith("http://")) {
-			url = "https://" + url.substr(7);
-		}
-                xhr.open(UTF8ToString($3), url, false);
-                xhr.responseType = "arraybuffer";
-
-                var i = 0;
-                var len = $1;
-                while (i < len*2) {
-                    var ptr1 = HEAP32[($2)/4 + i ];
-                    var ptr2 = HEAP32[($2)/4 + i + 1];
-
-                    try {
-			var z = encodeURI(UTF8ToString(ptr1));
-			if (z === "Host") z = "X-Host-Override";
-			if (z === "User-Agent") {}
-			else if (z.toLowerCase() === "authorization") {
-                        	xhr.setRequestHeader(z, UTF8ToString(ptr2));
-			} else {
-				
-                        	xhr.setRequestHeader(z, encodeURI(UTF8ToString(ptr2)));
-			}
-                    } catch (error) {
-                console.warn("Error while performing XMLHttpRequest.setRequestHeader()", error);
-                    }
-                    i += 2;
-                }
-
-                try {
-                    xhr.send(null);
-                } catch {
-                    return 0;
-                }
-                if (xhr.status === 0) return 0;
-                var uInt8Array = xhr.response;
-                if (!uInt8Array) uInt8Array = new ArrayBuffer(0);
-
-                var len = uInt8Array.byteLength;
-                var fileOnWasmHeap = _malloc(len + 8);
-
-                var properArray = new Uint8Array(uInt8Array);
-
-                for (var iii = 0; iii < len; iii++) {
-                    Module.HEAPU8[iii + fileOnWasmHeap + 8] = properArray[iii];
-                }
-                var LEN123 = new Uint8Array(4);
-                LEN123[0] = len % 256;
-                len -= LEN123[0];
-                len /= 256;
-                LEN123[1] = len % 256;
-                len -= LEN123[1];
-                len /= 256;
-                LEN123[2] = len % 256;
-                len -= LEN123[2];
-                len /= 256;
-                LEN123[3] = len % 256;
-                len -= LEN123[3];
-                len /= 256;
-                Module.HEAPU8.set(LEN123, fileOnWasmHeap + 4);
-                var st123 = xhr.status;
-                var STAT123 = new Uint8Array(4);
-                STAT123[0] = st123 % 256; st123 -= STAT123[0]; st123 /= 256;
-                STAT123[1] = st123 % 256; st123 -= STAT123[1]; st123 /= 256;
-                STAT123[2] = st123 % 256; st123 -= STAT123[2]; st123 /= 256;
-                STAT123[3] = st123 % 256;
-                Module.HEAPU8.set(STAT123, fileOnWasmHeap + 0);
-                return fileOnWasmHeap;
-            },
-            path.c_str(), n, z, "DELETE");
-        // clang-format on
-
-        i = 0;
-        for (auto h : headers) {
-            free(z[i]);
-            i++;
-            free(z[i]);
-            i++;
-        }
-        free(z);
-
-        if (!exe) {
-            res = make_uniq<HTTPResponse>(HTTPStatusCode::NotFound_404);
-            res->reason = "Please consult the browser console for details, might be potentially a CORS error";
-        } else {
-            res = duckdb::make_uniq<HTTPResponse>(HTTPStatusCode::OK_200);
-            int32_t status_code = 0;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[0]));
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[1])) << 8;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[2])) << 16;
-            status_code |= static_cast<uint8_t>((((uint8_t *)exe)[3])) << 24;
-            if (status_code != 0) {
-                res->status = HTTPUtil::ToStatusCode(status_code);
-                res->reason = HTTPUtil::GetStatusMessage(res->status);
-            }
-            uint64_t LEN = 0;
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[3 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[2 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[1 + 4];
-            LEN *= 256;
-            LEN += ((uint8_t *)exe)[0 + 4];
-            res->body = string(exe + 8, LEN);
-            /*
-                        if (info.content_handler) {
-                            info.content_handler((const unsigned char *)exe + 4, LEN);
-                        }
-            */
-
-            free(exe);
-        }
-
-        return res;
+        auto request = PrepareRequest("DELETE", info.url, info.headers, info.params);
+        return TransformResponse(transport->Send(request));
     }
 
    private:
@@ -1096,7 +166,13 @@ res->headers.Insert(head, tail);
 };
 
 unique_ptr<HTTPClient> HTTPWasmUtil::InitializeClient(HTTPParams &http_params, const string &proto_host_port) {
-    auto client = make_uniq<HTTPWasmClient>(http_params.Cast<HTTPFSParams>(), proto_host_port);
+    auto transport = transport_;
+    if (!transport) {
+        auto *fs = web::io::WebFileSystem::Get();
+        transport = fs ? fs->GetHTTPTransport() : web::CreateDefaultHTTPTransport();
+    }
+    auto client = make_uniq<HTTPWasmClient>(http_params.Cast<HTTPFSParams>(), proto_host_port, std::move(transport),
+                                            hedging_);
     return std::move(client);
 }
 
@@ -1,5 +1,6 @@
 #include "duckdb/web/io/arrow_ifstream.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "arrow/buffer.h"
@@ -43,32 +44,71 @@ bool ArrowInputFileStream::closed() const { return !static_cast<bool>(file_); }
 /// Read at most nbytes bytes from the file
 arrow::Result<int64_t> ArrowInputFileStream::Read(int64_t nbytes, void* out) {
     tmp_page_.reset();
-    auto n = file_->Read(out, nbytes, file_position_);
+    ARROW_ASSIGN_OR_RAISE(auto n, ReadAt(file_position_, nbytes, out));
     file_position_ += n;
     return n;
 }
 
-/// Peek at most nbytes bytes from the file
-arrow::Result<ArrowInputFileStream::PageView> ArrowInputFileStream::PeekView(int64_t nbytes) {
+/// Peek at most nbytes bytes at a position within a single page
+arrow::Result<ArrowInputFileStream::PageView> ArrowInputFileStream::PeekView(int64_t position, int64_t nbytes) {
     // Determine page & offset
-    auto page_id = file_position_ >> file_page_buffer_->GetPageSizeShift();
-    auto skip_here = file_position_ - page_id * file_page_buffer_->GetPageSize();
+    auto page_id = static_cast<uint64_t>(position) >> file_page_buffer_->GetPageSizeShift();
+    auto skip_here = position - page_id * file_page_buffer_->GetPageSize();
     auto read_here = std::min<size_t>(nbytes, file_page_buffer_->GetPageSize() - skip_here);
 
     // Read page
     auto page = file_->FixPage(page_id, false);
-    assert(skip_here <= page.GetData().size());
-    auto data = page.GetData().subspan(skip_here);
-    return PageView{std::move(page), data};
+    auto data = page.GetData();
+    assert(skip_here <= data.size());
+    read_here = std::min<size_t>(read_here, data.size() - skip_here);
+    return PageView{std::move(page), data.subspan(skip_here, read_here)};
 }
 
 /// Read at most nbytes bytes from the file
 arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowInputFileStream::Read(int64_t nbytes) {
-    ARROW_ASSIGN_OR_RAISE(auto view, PeekView(nbytes));
+    tmp_page_.reset();
+    if (file_position_ >= file_->GetSize() || nbytes <= 0) {
+        return std::make_shared<arrow::Buffer>(nullptr, 0);
+    }
+    ARROW_ASSIGN_OR_RAISE(auto view, PeekView(file_position_, nbytes));
     file_position_ += view.size();
     return std::make_shared<ArrowInputFileStream::PageView>(std::move(view));
 }
 
+/// Get the file size
+arrow::Result<int64_t> ArrowInputFileStream::GetSize() { return file_->GetSize(); }
+
+/// Move the file position
+arrow::Status ArrowInputFileStream::Seek(int64_t position) {
+    tmp_page_.reset();
+    file_position_ = position;
+    return arrow::Status::OK();
+}
+
+/// Read at most nbytes bytes at a position
+arrow::Result<int64_t> ArrowInputFileStream::ReadAt(int64_t position, int64_t nbytes, void* out) {
+    // The page buffer reads at most a page at a time
+    int64_t total = 0;
+    while (total < nbytes) {
+        auto n = file_->Read(static_cast<char*>(out) + total, nbytes - total, position + total);
+        if (n == 0) break;
+        total += n;
+    }
+    return total;
+}
+
+/// Read at most nbytes bytes at a position
+arrow::Result<std::shared_ptr<arrow::Buffer>> ArrowInputFileStream::ReadAt(int64_t position, int64_t nbytes) {
+    auto file_size = static_cast<int64_t>(file_->GetSize());
+    nbytes = std::max<int64_t>(std::min<int64_t>(nbytes, file_size - position), 0);
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::ResizableBuffer> buffer, arrow::AllocateResizableBuffer(nbytes));
+    ARROW_ASSIGN_OR_RAISE(auto n, ReadAt(position, nbytes, buffer->mutable_data()));
+    if (n < nbytes) {
+        ARROW_RETURN_NOT_OK(buffer->Resize(n));
+    }
+    return buffer;
+}
+
 /// Advance the file position by nbytes bytes
 arrow::Status ArrowInputFileStream::Advance(int64_t nbytes) {
     tmp_page_.reset();
@@ -78,7 +118,11 @@ arrow::Status ArrowInputFileStream::Advance(int64_t nbytes) {
 
 /// Read at most nbytes bytes from the file without advancing the file position
 arrow::Result<std::string_view> ArrowInputFileStream::Peek(int64_t nbytes) {
-    ARROW_ASSIGN_OR_RAISE(auto view, PeekView(nbytes));
+    tmp_page_.reset();
+    if (file_position_ >= file_->GetSize() || nbytes <= 0) {
+        return std::string_view{};
+    }
+    ARROW_ASSIGN_OR_RAISE(auto view, PeekView(file_position_, nbytes));
     tmp_page_ = std::move(view);
     return std::string_view{*tmp_page_};
 }
@@ -0,0 +1,207 @@
+#include "duckdb/web/io/gzip_streambuf.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace duckdb {
+namespace web {
+namespace io {
+
+namespace {
+
+/// The gzip header flags
+constexpr unsigned char GZIP_FLAG_HCRC = 0x02;
+constexpr unsigned char GZIP_FLAG_EXTRA = 0x04;
+constexpr unsigned char GZIP_FLAG_NAME = 0x08;
+constexpr unsigned char GZIP_FLAG_COMMENT = 0x10;
+/// The size of the gzip header
+constexpr size_t GZIP_HEADER_SIZE = 10;
+/// The size of the gzip trailer (CRC32 and ISIZE)
+constexpr size_t GZIP_TRAILER_SIZE = 8;
+
+}  // namespace
+
+/// Constructor
+GzipInputStreamBuffer::GzipInputStreamBuffer(std::streambuf& source)
+    : source_(&source), input_(new char[INPUT_BUFFER_SIZE]), output_(new char[OUTPUT_BUFFER_SIZE]) {
+    Restart();
+}
+
+/// Constructor
+GzipInputStreamBuffer::GzipInputStreamBuffer(std::streambuf& source, const GzipInputStreamBuffer& other)
+    : source_(&source), input_(new char[INPUT_BUFFER_SIZE]), output_(new char[OUTPUT_BUFFER_SIZE]) {
+    Restart();
+    Skip(other.GetPosition());
+    slice_end_ = other.slice_end_;
+    TruncateWindow();
+}
+
+/// Destructor
+GzipInputStreamBuffer::~GzipInputStreamBuffer() { duckdb_miniz::mz_inflateEnd(&stream_); }
+
+/// Refill the compressed input
+bool GzipInputStreamBuffer::ReadInput() {
+    if (stream_.avail_in > 0) return true;
+    auto n = source_->sgetn(input_.get(), INPUT_BUFFER_SIZE);
+    stream_.next_in = reinterpret_cast<const unsigned char*>(input_.get());
+    stream_.avail_in = std::max<std::streamsize>(n, 0);
+    return stream_.avail_in > 0;
+}
+
+/// Consume compressed input bytes that are not passed to the inflater
+bool GzipInputStreamBuffer::SkipInput(size_t n, unsigned char* out) {
+    while (n > 0) {
+        if (!ReadInput()) return false;
+        auto m = std::min<size_t>(n, stream_.avail_in);
+        if (out) {
+            std::memcpy(out, stream_.next_in, m);
+            out += m;
+        }
+        stream_.next_in += m;
+        stream_.avail_in -= m;
+        n -= m;
+    }
+    return true;
+}
+
+/// Read the header of the next gzip member
+bool GzipInputStreamBuffer::ReadMemberHeader(bool first) {
+    // Trailing garbage after the first member is ignored, just like gzip does
+    if (!ReadInput()) return false;
+    if (!HasGzipMagic(reinterpret_cast<const char*>(stream_.next_in), stream_.avail_in) && !first) return false;
+
+    // Parse the fixed header
+    unsigned char header[GZIP_HEADER_SIZE];
+    if (!SkipInput(GZIP_HEADER_SIZE, header) || !HasGzipMagic(reinterpret_cast<char*>(header), GZIP_HEADER_SIZE)) {
+        throw std::runtime_error("invalid gzip header");
+    }
+    if (header[2] != 8) throw std::runtime_error("unsupported gzip compression method");
+
+    // Skip the optional fields
+    auto flags = header[3];
+    bool ok = true;
+    if (flags & GZIP_FLAG_EXTRA) {
+        unsigned char length[2];
+        ok = ok && SkipInput(2, length) && SkipInput(length[0] | (length[1] << 8));
+    }
+    for (auto flag : {GZIP_FLAG_NAME, GZIP_FLAG_COMMENT}) {
+        if (!(flags & flag)) continue;
+        unsigned char c = 1;
+        while (ok && c != 0) ok = SkipInput(1, &c);
+    }
+    if (flags & GZIP_FLAG_HCRC) {
+        ok = ok && SkipInput(2);
+    }
+    if (!ok) throw std::runtime_error("truncated gzip header");
+
+    // Start a raw inflater for the deflate stream of the member
+    duckdb_miniz::mz_inflateEnd(&stream_);
+    if (duckdb_miniz::mz_inflateInit2(&stream_, -MZ_DEFAULT_WINDOW_BITS) != duckdb_miniz::MZ_OK) {
+        throw std::runtime_error("failed to initialize the gzip inflater");
+    }
+    member_end_ = false;
+    return true;
+}
+
+/// Restart the inflater at the beginning of the source
+void GzipInputStreamBuffer::Restart() {
+    source_->pubseekpos(0);
+    stream_.next_in = reinterpret_cast<const unsigned char*>(input_.get());
+    stream_.avail_in = 0;
+    window_offset_ = 0;
+    setg(output_.get(), output_.get(), output_.get());
+    member_end_ = false;
+    stream_end_ = !ReadMemberHeader(true);
+}
+
+/// Truncate the output window at the end of the slice
+void GzipInputStreamBuffer::TruncateWindow() {
+    if (slice_end_ - window_offset_ < static_cast<uint64_t>(egptr() - eback())) {
+        setg(eback(), gptr(), eback() + (slice_end_ - window_offset_));
+    }
+}
+
+/// Skip uncompressed bytes
+void GzipInputStreamBuffer::Skip(uint64_t n) {
+    while (n > 0) {
+        if (gptr() == egptr() && underflow() == traits_type::eof()) break;
+        auto m = std::min<uint64_t>(egptr() - gptr(), n);
+        gbump(m);
+        n -= m;
+    }
+}
+
+/// Inflate the next window
+GzipInputStreamBuffer::int_type GzipInputStreamBuffer::underflow() {
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    window_offset_ += egptr() - eback();
+    setg(output_.get(), output_.get(), output_.get());
+
+    while (!stream_end_ && window_offset_ < slice_end_) {
+        // Continue with the next member
+        if (member_end_) {
+            if (!SkipInput(GZIP_TRAILER_SIZE)) throw std::runtime_error("truncated gzip trailer");
+            stream_end_ = !ReadMemberHeader(false);
+            continue;
+        }
+
+        // Inflate into the output window
+        stream_.next_out = reinterpret_cast<unsigned char*>(output_.get());
+        stream_.avail_out = OUTPUT_BUFFER_SIZE;
+        auto status = duckdb_miniz::mz_inflate(&stream_, duckdb_miniz::MZ_NO_FLUSH);
+        if (status == duckdb_miniz::MZ_STREAM_END) {
+            member_end_ = true;
+        } else if (status != duckdb_miniz::MZ_OK && status != duckdb_miniz::MZ_BUF_ERROR) {
+            throw std::runtime_error("invalid gzip stream");
+        }
+        auto n = std::min<uint64_t>(OUTPUT_BUFFER_SIZE - stream_.avail_out, slice_end_ - window_offset_);
+        if (n > 0) {
+            setg(output_.get(), output_.get(), output_.get() + n);
+            return traits_type::to_int_type(*gptr());
+        }
+
+        // No progress, we need more input
+        if (!member_end_ && stream_.avail_in == 0 && !ReadInput()) {
+            throw std::runtime_error("truncated gzip stream");
+        }
+    }
+    return traits_type::eof();
+}
+
+/// Set internal position pointer to relative position
+GzipInputStreamBuffer::pos_type GzipInputStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                               std::ios_base::openmode mode) {
+    if (dir == std::ios_base::beg) return seekpos(off, mode);
+    if (dir == std::ios_base::cur) return seekpos(GetPosition() + off, mode);
+    // The uncompressed size is unknown
+    return pos_type(off_type(-1));
+}
+
+/// Set internal position pointer to absolute position
+GzipInputStreamBuffer::pos_type GzipInputStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode) {
+    uint64_t target = pos;
+    if (target < window_offset_) {
+        Restart();
+        Skip(target);
+    } else if (target <= window_offset_ + (egptr() - eback())) {
+        setg(eback(), eback() + (target - window_offset_), egptr());
+    } else {
+        Skip(target - GetPosition());
+    }
+    return GetPosition();
+}
+
+/// Scan a slice of the uncompressed data
+void GzipInputStreamBuffer::Slice(uint64_t offset, uint64_t size) {
+    slice_end_ = std::numeric_limits<uint64_t>::max();
+    Restart();
+    Skip(offset);
+    if (size == 0) return;
+    slice_end_ = offset + size;
+    TruncateWindow();
+}
+
+}  // namespace io
+}  // namespace web
+}  // namespace duckdb
@@ -0,0 +1,143 @@
+#include "duckdb/web/io/range_prefetcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+namespace web {
+namespace io {
+
+/// Constructor
+RangePrefetcher::RangePrefetcher(uint64_t file_size, RangeReader reader, size_t range_size, size_t concurrency)
+    : file_size_(file_size),
+      range_size_(std::max<size_t>(range_size, 1)),
+      max_ranges_(2 * std::max<size_t>(concurrency, 1)),
+      reader_(std::move(reader)) {
+    for (size_t i = 0; i < std::max<size_t>(concurrency, 1); ++i) {
+        workers_.emplace_back([this]() { Work(); });
+    }
+}
+
+/// Destructor
+RangePrefetcher::~RangePrefetcher() { Stop(); }
+
+/// Fetch ranges until stopped
+void RangePrefetcher::Work() {
+    std::unique_lock<std::mutex> guard{mutex_};
+    while (true) {
+        changed_.wait(guard, [&]() { return stopped_ || (next_offset_ < file_size_ && ranges_.size() < max_ranges_); });
+        if (stopped_) return;
+
+        // Claim the next range.
+        // Ranges in flight are never dropped before the workers are joined.
+        auto offset = next_offset_;
+        auto size = static_cast<size_t>(std::min<uint64_t>(range_size_, file_size_ - offset));
+        next_offset_ += size;
+        auto& range = ranges_.try_emplace(offset, offset, size).first->second;
+        guard.unlock();
+
+        // Fetch the range
+        std::unique_ptr<char[]> data{new char[size]};
+        size_t fetched = 0;
+        bool failed = false;
+        try {
+            while (fetched < size) {
+                auto n = reader_(data.get() + fetched, size - fetched, offset + fetched);
+                if (n == 0) break;
+                fetched += n;
+            }
+        } catch (...) {
+            failed = true;
+        }
+        fetched_bytes_.fetch_add(fetched, std::memory_order_relaxed);
+
+        // Publish the range
+        guard.lock();
+        range.data = std::move(data);
+        range.done = true;
+        range.failed = failed || fetched < size;
+        changed_.notify_all();
+        // Drop the range right away if the reader skipped it
+        DropIfConsumed(ranges_.find(offset));
+    }
+}
+
+/// Drop a range if it was consumed
+void RangePrefetcher::DropIfConsumed(std::map<uint64_t, Range>::iterator iter) {
+    auto& range = iter->second;
+    if (range.done && range.readers == 0 && (range.failed || range.consumed >= range.size)) {
+        ranges_.erase(iter);
+        changed_.notify_all();
+    }
+}
+
+/// Read up to n bytes at an offset from the prefetched ranges
+std::optional<size_t> RangePrefetcher::Read(void* out, size_t n, duckdb::idx_t offset) {
+    if (n == 0 || offset >= file_size_) return std::nullopt;
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto range_offset = offset - offset % range_size_;
+    auto iter = ranges_.find(range_offset);
+    if (iter == ranges_.end()) {
+        // Did the reader skip ahead?
+        // Then continue prefetching behind the requested range and drop the ranges that were skipped.
+        if (range_offset >= next_offset_ && !stopped_) {
+            next_offset_ = range_offset + range_size_;
+            for (auto i = ranges_.begin(); i != ranges_.end();) {
+                auto current = i++;
+                current->second.consumed = current->second.size;
+                DropIfConsumed(current);
+            }
+            changed_.notify_all();
+        }
+        missed_reads_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    // Wait for the range
+    auto& range = iter->second;
+    ++range.readers;
+    changed_.wait(guard, [&]() { return range.done || stopped_; });
+    if (!range.done || range.failed) {
+        --range.readers;
+        DropIfConsumed(iter);
+        missed_reads_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    // Copy without holding the lock
+    auto skip = static_cast<size_t>(offset - range.offset);
+    auto here = std::min<size_t>(n, range.size - skip);
+    guard.unlock();
+    std::memcpy(out, range.data.get() + skip, here);
+    served_bytes_.fetch_add(here, std::memory_order_relaxed);
+    guard.lock();
+    --range.readers;
+    range.consumed = std::max(range.consumed, skip + here);
+    DropIfConsumed(iter);
+    return here;
+}
+
+/// Stop the workers and drop the ranges
+void RangePrefetcher::Stop() {
+    {
+        std::unique_lock<std::mutex> guard{mutex_};
+        if (stopped_ && workers_.empty()) return;
+        stopped_ = true;
+        changed_.notify_all();
+    }
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+
+    // Wait for readers that still copy from a range
+    std::unique_lock<std::mutex> guard{mutex_};
+    changed_.wait(guard, [&]() {
+        return std::all_of(ranges_.begin(), ranges_.end(), [](auto& entry) { return entry.second.readers == 0; });
+    });
+    ranges_.clear();
+}
+
+}  // namespace io
+}  // namespace web
+}  // namespace duckdb
@@ -1,6 +1,7 @@
 #include "duckdb/web/io/web_filesystem.h"
 
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <mutex>
 #include <regex>
@@ -90,6 +91,30 @@ static duckdb::FileHandle &GetOrOpen(size_t file_id) {
     }
     throw std::logic_error("unknown data protocol");
 }
+/// Is a remote file that the native runtime serves through the HTTP transport?
+static bool IsNativeHTTPFile(size_t file_id) {
+    auto file = WebFileSystem::Get()->GetFile(file_id);
+    return file && file->GetDataProtocol() == WebFileSystem::DataProtocol::HTTP;
+}
+/// Send a request for a remote file through the HTTP transport
+static HTTPTransportResponse SendNativeHTTPRequest(size_t file_id, std::string method, HTTPHeaderList headers) {
+    auto fs = WebFileSystem::Get();
+    auto file = fs->GetFile(file_id);
+    HTTPTransportRequest request;
+    request.method = std::move(method);
+    request.url = *file->GetDataURL();
+    request.headers = std::move(headers);
+    request.priority = HTTPRequestPriorityScope::Get();
+    auto response = fs->GetHTTPTransport()->Send(request);
+    if (response.status == 0) {
+        throw std::runtime_error("HTTP request failed: " + response.error);
+    }
+    if (response.status >= 400 && response.status != 416) {
+        throw std::runtime_error("HTTP request failed with status " + std::to_string(response.status) + ": " +
+                                 request.url);
+    }
+    return response;
+}
 #endif
 
 struct OpenedFile {
@@ -108,6 +133,15 @@ struct OpenedFile {
 #endif
 RT_FN(uint32_t duckdb_web_fs_get_default_data_protocol(), { return io::WebFileSystem::DataProtocol::NODE_FS; });
 RT_FN(void *duckdb_web_fs_file_open(size_t file_id, uint8_t flags), {
+    if (IsNativeHTTPFile(file_id)) {
+        auto response = SendNativeHTTPRequest(file_id, "HEAD", {});
+        auto length = response.FindHeader("Content-Length");
+        auto result = std::make_unique<OpenedFile>();
+        result->file_size = length ? std::strtod(std::string{*length}.c_str(), nullptr) : 0;
+        result->file_last_modification = 0;
+        result->file_buffer = 0;
+        return result.release();
+    }
     auto &file = GetOrOpen(file_id);
     auto result = std::make_unique<OpenedFile>();
     result->file_size = file.GetFileSize();
@@ -123,6 +157,7 @@ RT_FN(void duckdb_web_fs_file_close(size_t file_id), {
 RT_FN(void duckdb_web_fs_file_drop_file(const char *fileName, size_t pathLen), {});
 RT_FN(void duckdb_web_fs_file_truncate(size_t file_id, double new_size), { GetOrOpen(file_id).Truncate(new_size); });
 RT_FN(time_t duckdb_web_fs_file_get_last_modified_time(size_t file_id), {
+    if (IsNativeHTTPFile(file_id)) return 0;
     auto &file = GetOrOpen(file_id);
     return NATIVE_FS->GetLastModifiedTime(file);
 });
@@ -280,6 +315,9 @@ void WebFileSystem::WebFileHandle::Close() {
     }
     // Close the file in the runtime
     fs_guard.unlock();
+    if (auto prefetcher = std::move(file.range_prefetcher_)) {
+        prefetcher->Stop();
+    }
     duckdb_web_fs_file_close(file.file_id_);
     fs_guard.lock();
 
@@ -478,6 +516,17 @@ void WebFileSystem::DropDanglingFiles() {
     }
 }
 
+/// Get the data protocol of a file
+std::optional<WebFileSystem::DataProtocol> WebFileSystem::FindDataProtocol(std::string_view file_name) {
+    std::unique_lock<LightMutex> fs_guard{fs_mutex_};
+    auto iter = files_by_name_.find(std::string{file_name});
+    if (iter == files_by_name_.end()) return std::nullopt;
+    auto file = iter->second;
+    fs_guard.unlock();
+    std::shared_lock<SharedMutex> file_guard{file->file_mutex_};
+    return file->data_protocol_;
+}
+
 /// Try to drop a file
 bool WebFileSystem::TryDropFile(std::string_view file_name) {
     DEBUG_TRACE();
@@ -608,6 +657,47 @@ void WebFileSystem::CollectFileStatistics(std::string_view path, std::shared_ptr
     file_hdl.file_->file_stats_->Resize(file_hdl.file_->file_size_.value_or(0));
 }
 
+/// Prefetch the ranges of a remote file concurrently ahead of sequential reads
+std::shared_ptr<RangePrefetcher> WebFileSystem::PrefetchRanges(duckdb::FileHandle &handle, size_t range_size,
+                                                               size_t concurrency) {
+#ifndef WEBDB_THREADS
+    return nullptr;
+#else
+    auto &file_hdl = static_cast<WebFileHandle &>(handle);
+    assert(file_hdl.file_);
+    auto &file = *file_hdl.file_;
+    std::unique_lock<SharedMutex> file_guard{file.file_mutex_};
+    if (file.data_protocol_ != DataProtocol::HTTP && file.data_protocol_ != DataProtocol::S3) return nullptr;
+    if (file.range_prefetcher_) return file.range_prefetcher_;
+
+    // The prefetched ranges share requests with concurrent reads of the same ranges
+    // The workers are joined before the file is closed.
+    auto reader = [this, &file](void *out, size_t n, duckdb::idx_t ofs) -> size_t {
+        HTTPRequestPriorityScope priority{HTTPRequestPriority::PREFETCH};
+        return remote_reads_.Read(file.file_id_, out, n, ofs, [&](void *o, size_t m, duckdb::idx_t p) {
+            return ReadRemoteRange(file, o, m, p);
+        });
+    };
+    file.range_prefetcher_ =
+        std::make_shared<RangePrefetcher>(file.file_size_.value_or(0), std::move(reader), range_size, concurrency);
+    return file.range_prefetcher_;
+#endif
+}
+
+/// Stop prefetching the ranges of a file
+void WebFileSystem::StopRangePrefetch(duckdb::FileHandle &handle) {
+    auto &file_hdl = static_cast<WebFileHandle &>(handle);
+    assert(file_hdl.file_);
+    auto &file = *file_hdl.file_;
+    std::shared_ptr<RangePrefetcher> prefetcher;
+    {
+        std::unique_lock<SharedMutex> file_guard{file.file_mutex_};
+        prefetcher = std::move(file.range_prefetcher_);
+    }
+    // Join the workers without holding the file lock
+    if (prefetcher) prefetcher->Stop();
+}
+
 // Increment the Cache epoch, this allows detecting stale fileInfoCaches from JS
 void WebFileSystem::IncrementCacheEpoch() {
     DEBUG_TRACE();
@@ -737,6 +827,71 @@ duckdb::unique_ptr<duckdb::FileHandle> WebFileSystem::OpenFile(const string &url
     return handle;
 }
 
+/// Read a range of a remote file
+size_t WebFileSystem::ReadRemoteRange(const WebFile &file, void *out, size_t n, duckdb::idx_t offset) {
+    if (n == 0) return 0;
+    assert(file.data_url_);
+    auto priority = HTTPRequestPriorityScope::Get();
+
+    auto range = "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + n - 1);
+
+    // S3 requests are signed by the runtime.
+    // Browser HTTP reads go through the runtime unless the transport is needed for the range cache.
+    auto via_runtime = file.data_protocol_ == DataProtocol::S3;
+#ifdef EMSCRIPTEN
+    via_runtime |= default_http_transport_ && http_cache_->GetConfig().max_bytes == 0;
+#endif
+    if (via_runtime) {
+        auto slot = http_scheduler_->Acquire(*file.data_url_, priority);
+        HTTPRequestTrace trace{
+            .method = "GET",
+            .url = *file.data_url_,
+            .range = std::move(range),
+            .start_us = static_cast<uint64_t>(http_tracer_->Now().count()),
+        };
+        auto finish = [&](uint16_t status, size_t bytes) {
+            trace.status = status;
+            trace.bytes = bytes;
+            trace.duration_us = static_cast<uint64_t>(http_tracer_->Now().count()) - trace.start_us;
+            http_tracer_->Record(std::move(trace));
+        };
+        try {
+            auto here = duckdb_web_fs_file_read(file.file_id_, out, n, offset);
+            finish(206, here);
+            return here;
+        } catch (...) {
+            finish(0, 0);
+            throw;
+        }
+    }
+
+    HTTPTransportRequest request;
+    request.url = *file.data_url_;
+    request.headers = {{"Range", std::move(range)}};
+    request.priority = priority;
+    auto response = http_transport_->Send(request);
+    if (response.status == 416) return 0;
+    if (response.status == 0) {
+        throw std::runtime_error("HTTP request failed: " + response.error);
+    }
+    if (response.status >= 400) {
+        throw std::runtime_error("HTTP request failed with status " + std::to_string(response.status) + ": " +
+                                 request.url);
+    }
+    // Servers that ignore the range return the entire file
+    std::string_view body = response.body;
+    if (response.status == 200) {
+        if (offset >= body.size()) {
+            throw std::runtime_error("HTTP range request returned a full response of " + std::to_string(body.size()) +
+                                     " bytes that ends before offset " + std::to_string(offset) + ": " + request.url);
+        }
+        body = body.substr(offset);
+    }
+    auto here = std::min<size_t>(body.size(), n);
+    std::memcpy(out, body.data(), here);
+    return here;
+}
+
 void WebFileSystem::Read(duckdb::FileHandle &handle, void *buffer, int64_t nr_bytes, duckdb::idx_t location) {
     auto &file_hdl = static_cast<WebFileHandle &>(handle);
     auto file_size = file_hdl.file_->file_size_;
@@ -791,16 +946,32 @@ int64_t WebFileSystem::Read(duckdb::FileHandle &handle, void *buffer, int64_t nr
         // Try to read read with readahead
         case DataProtocol::HTTP:
         case DataProtocol::S3: {
+            // Concurrent reads of the same range share a single request
+            auto reader = [&](void *out, size_t n, duckdb::idx_t ofs) -> size_t {
+                // Fetching beyond the requested bytes is readahead
+                HTTPRequestPriorityScope priority{n > static_cast<size_t>(nr_bytes) ? HTTPRequestPriority::READAHEAD
+                                                                                    : HTTPRequestPriority::DEMAND};
+                return remote_reads_.Read(file.file_id_, out, n, ofs, [&](void *o, size_t m, duckdb::idx_t p) {
+                    return ReadRemoteRange(file, o, m, p);
+                });
+            };
+            // Serve sequential reads from the prefetched ranges first
+            if (file.range_prefetcher_) {
+                if (auto n = file.range_prefetcher_->Read(buffer, nr_bytes, file_hdl.position_)) {
+                    if (file.file_stats_) {
+                        file.file_stats_->RegisterFileReadCached(file_hdl.position_, *n);
+                    }
+                    file_hdl.position_ += *n;
+                    return *n;
+                }
+            }
             if (auto ra = file_hdl.ResolveReadAheadBuffer(file_guard)) {
-                auto reader = [&](auto *out, size_t n, duckdb::idx_t ofs) {
-                    return duckdb_web_fs_file_read(file.file_id_, out, n, ofs);
-                };
                 auto n = ra->Read(file.file_id_, file.file_size_.value_or(0), buffer, nr_bytes, file_hdl.position_,
                                   reader, file.file_stats_.get());
                 file_hdl.position_ += n;
                 return n;
             } else {
-                auto n = duckdb_web_fs_file_read(file.file_id_, buffer, nr_bytes, file_hdl.position_);
+                auto n = reader(buffer, nr_bytes, file_hdl.position_);
                 // Register read
                 if (file.file_stats_) {
                     file.file_stats_->RegisterFileReadCold(file_hdl.position_, n);
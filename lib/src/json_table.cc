@@ -1,6 +1,11 @@
+#include <algorithm>
 #include <memory>
 #include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "arrow/c/bridge.h"
 #include "arrow/record_batch.h"
@@ -209,21 +214,77 @@ std::shared_ptr<TableReader> RowArrayTableReader::CloneShared() const {
     return reader;
 }
 
+/// A stream buffer over bytes in memory
+struct MemoryStreamBuffer : public std::streambuf {
+    /// Constructor
+    explicit MemoryStreamBuffer(std::string_view data) {
+        auto begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+/// The uncompressed column arrays of a compressed file
+using DecodedColumns = std::unordered_map<std::string, std::string>;
+
+/// Inflate the column arrays of a compressed file in a single pass.
+/// The gzip stream can only be scanned forward, a slice per column would inflate the file once per column.
+arrow::Result<std::shared_ptr<const DecodedColumns>> DecodeColumns(io::InputFileStream& file, const TableType& type) {
+    std::vector<std::pair<FileRange, const std::string*>> ranges;
+    for (unsigned i = 0; i < type.type->num_fields(); ++i) {
+        auto& name = type.type->field(i)->name();
+        auto bound_iter = type.column_boundaries.find(name);
+        if (bound_iter != type.column_boundaries.end()) ranges.push_back({bound_iter->second, &name});
+    }
+    std::sort(ranges.begin(), ranges.end(), [](auto& l, auto& r) { return l.first.offset < r.first.offset; });
+
+    auto columns = std::make_shared<DecodedColumns>();
+    file.Rewind();
+    uint64_t position = 0;
+    for (auto& [range, name] : ranges) {
+        if (range.offset < position) {
+            file.Slice(range.offset);
+        } else if (range.offset > position) {
+            file.ignore(range.offset - position);
+        }
+        auto& column = (*columns)[*name];
+        column.resize(range.size);
+        file.read(column.data(), range.size);
+        if (static_cast<size_t>(file.gcount()) != range.size) {
+            return arrow::Status::Invalid("Unexpected end of compressed column: ", *name);
+        }
+        position = range.offset + range.size;
+    }
+    file.clear();
+    file.Rewind();
+    return columns;
+}
+
 struct ColumnObjectTableReader : public TableReader {
     /// A column parser
     struct ColumnReader {
+        /// The buffer over the decoded column (if any)
+        std::unique_ptr<MemoryStreamBuffer> decoded_buffer_;
         /// The column stream
-        io::InputFileStream stream_;
+        std::unique_ptr<std::istream> stream_;
         /// The column parser
         ArrayReader array_reader_;
 
         // Constructor
         ColumnReader(const io::InputFileStream& stream, std::shared_ptr<ArrayParser> parser)
-            : stream_(stream), array_reader_(stream_, std::move(parser)) {}
+            : decoded_buffer_(nullptr),
+              stream_(std::make_unique<io::InputFileStream>(stream)),
+              array_reader_(*stream_, std::move(parser)) {}
+        // Constructor for a decoded column
+        ColumnReader(std::string_view decoded, std::shared_ptr<ArrayParser> parser)
+            : decoded_buffer_(std::make_unique<MemoryStreamBuffer>(decoded)),
+              stream_(std::make_unique<std::istream>(decoded_buffer_.get())),
+              array_reader_(*stream_, std::move(parser)) {}
     };
 
     /// The column readers
     std::unordered_map<std::string, std::unique_ptr<ColumnReader>> column_readers_ = {};
+    /// The decoded columns of a compressed file, shared with clones
+    std::shared_ptr<const DecodedColumns> decoded_columns_ = nullptr;
 
     /// Constructor
     ColumnObjectTableReader(std::unique_ptr<io::InputFileStream> table, TableType type, size_t batch_size)
@@ -250,6 +311,7 @@ std::shared_ptr<TableReader> ColumnObjectTableReader::CloneShared() const {
     auto table_copy = std::make_unique<io::InputFileStream>(*table_file_);
     table_copy->Rewind();
     auto reader = std::make_shared<ColumnObjectTableReader>(std::move(table_copy), table_type_, batch_size_);
+    reader->decoded_columns_ = decoded_columns_;
     reader->Prepare().ok();
     return reader;
 }
@@ -265,6 +327,11 @@ arrow::Status ColumnObjectTableReader::Prepare() {
         ARROW_RETURN_NOT_OK(FindColumnBoundaries(stream, table_type_));
     }
 
+    // Inflate a compressed file once for all columns
+    if (table_file_->IsCompressed() && !decoded_columns_) {
+        ARROW_ASSIGN_OR_RAISE(decoded_columns_, DecodeColumns(*table_file_, table_type_));
+    }
+
     // Create the schema
     if (!schema_) {
         arrow::FieldVector schema_fields;
@@ -285,8 +352,13 @@ arrow::Status ColumnObjectTableReader::Prepare() {
             // XXX warning
             continue;
         }
-        table_file_->Slice(bound_iter->second.offset, bound_iter->second.size);
         ARROW_ASSIGN_OR_RAISE(auto parser, ArrayParser::Resolve(type));
+        if (decoded_columns_) {
+            auto& decoded = decoded_columns_->at(name);
+            column_readers_.insert({name, std::make_unique<ColumnReader>(decoded, std::move(parser))});
+            continue;
+        }
+        table_file_->Slice(bound_iter->second.offset, bound_iter->second.size);
         column_readers_.insert({name, std::make_unique<ColumnReader>(*table_file_, std::move(parser))});
     }
     return arrow::Status::OK();
@@ -0,0 +1,185 @@
+#include "duckdb/web/query_result_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#include "duckdb/common/constants.hpp"
+#include "duckdb/parser/statement/create_statement.hpp"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// Functions whose results change between executions.
+/// The normalized text is matched conservatively, identifiers that merely contain the names are not cached either.
+constexpr std::array<std::string_view, 10> VOLATILE_FUNCTIONS = {
+    "random", "uuid", "now(", "today(", "current_", "localtime", "transaction_timestamp", "nextval", "currval",
+    "setseed",
+};
+
+}  // namespace
+
+/// Erase an entry
+void QueryResultCache::Erase(std::list<Entry>::iterator entry) {
+    bytes_ -= entry->bytes;
+    entries_.erase(entry->key);
+    lru_.erase(entry);
+}
+
+/// Evict entries until the cache fits its budget
+void QueryResultCache::Evict() {
+    while (bytes_ > max_bytes_ && !lru_.empty()) {
+        Erase(std::prev(lru_.end()));
+        stats_.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/// Is the cache enabled?
+bool QueryResultCache::IsEnabled() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return max_bytes_ > 0;
+}
+
+/// Get the byte budget
+uint64_t QueryResultCache::GetMaxBytes() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return max_bytes_;
+}
+
+/// Update the byte budget and drop all results
+void QueryResultCache::Configure(uint64_t max_bytes) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    max_bytes_ = max_bytes;
+    ++version_;
+    lru_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+/// Get the accounted bytes
+size_t QueryResultCache::GetSize() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return bytes_;
+}
+
+/// Get the number of cached results
+size_t QueryResultCache::GetEntryCount() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return entries_.size();
+}
+
+/// Get the data version
+uint64_t QueryResultCache::GetVersion() const {
+    std::unique_lock<std::mutex> guard{mutex_};
+    return version_;
+}
+
+/// May a statement type write data or change the results of other statements?
+bool QueryResultCache::MayWrite(duckdb::StatementType type) {
+    switch (type) {
+        case duckdb::StatementType::SELECT_STATEMENT:
+        case duckdb::StatementType::EXPLAIN_STATEMENT:
+        case duckdb::StatementType::PREPARE_STATEMENT:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/// Does a statement change the session state of its connection?
+bool QueryResultCache::ChangesSessionState(const duckdb::SQLStatement& statement) {
+    switch (statement.type) {
+        // SET, RESET and USE
+        case duckdb::StatementType::SET_STATEMENT:
+        case duckdb::StatementType::PRAGMA_STATEMENT:
+            return true;
+        // Temporary objects shadow the objects of other connections
+        case duckdb::StatementType::CREATE_STATEMENT: {
+            auto& info = *statement.Cast<duckdb::CreateStatement>().info;
+            return info.temporary || info.catalog == duckdb::TEMP_CATALOG;
+        }
+        default:
+            return false;
+    }
+}
+
+/// Normalize a statement, returns nullopt if its results cannot be cached
+std::optional<std::string> QueryResultCache::Normalize(const duckdb::SQLStatement& statement) {
+    if (statement.type != duckdb::StatementType::SELECT_STATEMENT) return std::nullopt;
+    auto text = statement.ToString();
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    for (auto name : VOLATILE_FUNCTIONS) {
+        if (lower.find(name) != std::string::npos) return std::nullopt;
+    }
+    return text;
+}
+
+/// Build the key of a normalized statement
+std::string QueryResultCache::BuildKey(uint64_t session_epoch, std::string_view normalized, ResultFormat format,
+                                       std::string_view parameters) {
+    auto session = std::to_string(session_epoch);
+    std::string key;
+    key.reserve(session.size() + normalized.size() + parameters.size() + 3);
+    key.push_back(static_cast<char>('0' + static_cast<uint8_t>(format)));
+    key.append(session);
+    key.push_back(':');
+    key.append(normalized);
+    key.push_back('\n');
+    key.append(parameters);
+    return key;
+}
+
+/// Find a cached result
+std::shared_ptr<const QueryResultCache::Result> QueryResultCache::Find(const std::string& key) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    auto entry = entries_.find(key);
+    if (entry == entries_.end()) {
+        stats_.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, entry->second);
+    stats_.hits.fetch_add(1, std::memory_order_relaxed);
+    return entry->second->result;
+}
+
+/// Insert a result that was computed under a data version
+void QueryResultCache::Insert(const std::string& key, uint64_t version, std::shared_ptr<const Result> result) {
+    std::unique_lock<std::mutex> guard{mutex_};
+    // The data changed while the result was computed?
+    if (version != version_) return;
+    if (auto existing = entries_.find(key); existing != entries_.end()) {
+        Erase(existing->second);
+    }
+
+    // Account the entry
+    size_t bytes = key.size();
+    for (auto& buffer : result->buffers) {
+        bytes += buffer->size();
+    }
+    if (bytes > max_bytes_) return;
+
+    lru_.push_front(Entry{
+        .key = key,
+        .result = std::move(result),
+        .bytes = bytes,
+    });
+    entries_.insert({key, lru_.begin()});
+    bytes_ += bytes;
+    Evict();
+}
+
+/// Bump the data version and drop all results
+void QueryResultCache::Invalidate() {
+    std::unique_lock<std::mutex> guard{mutex_};
+    ++version_;
+    lru_.clear();
+    entries_.clear();
+    bytes_ = 0;
+    stats_.invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace web
+}  // namespace duckdb
@@ -0,0 +1,166 @@
+#include "duckdb/web/spilled_query_result.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+
+#include "arrow/io/memory.h"
+#include "arrow/ipc/message.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "duckdb/web/io/web_filesystem.h"
+
+namespace duckdb {
+namespace web {
+
+namespace {
+
+/// The next spill file id
+std::atomic<uint64_t> NEXT_SPILL_FILE = 0;
+/// The end-of-stream marker of the IPC stream format
+constexpr int32_t END_OF_STREAM[2] = {-1, 0};
+
+}  // namespace
+
+/// Constructor
+SpilledQueryResult::SpilledQueryResult(io::FilePageBuffer& file_page_buffer, std::string path)
+    : file_page_buffer_(file_page_buffer), path_(std::move(path)) {}
+
+/// Destructor, drops the spill file
+SpilledQueryResult::~SpilledQueryResult() {
+    if (!file_) return;
+    file_->Release(false);
+    file_.reset();
+    try {
+        file_page_buffer_.GetFileSystem()->RemoveFile(path_);
+    } catch (...) {
+    }
+    if (auto web_fs = io::WebFileSystem::Get()) {
+        if (web_fs->TryDropFile(path_)) web_fs->DropFile(path_);
+    }
+}
+
+/// Fetch all chunks of a query result and spill them as record batches of at least batch_rows rows
+arrow::Result<std::unique_ptr<SpilledQueryResult>> SpilledQueryResult::Create(io::FilePageBuffer& file_page_buffer,
+                                                                              std::string_view directory,
+                                                                              duckdb::QueryResult& result,
+                                                                              ArrowExportContext& export_context,
+                                                                              uint64_t batch_rows) {
+    // Open a new spill file.
+    // Native builds spill to the temp directory by default.
+    std::string path{directory};
+#ifndef EMSCRIPTEN
+    if (path.empty()) {
+        std::error_code error;
+        auto tmp = std::filesystem::temp_directory_path(error);
+        if (!error) path = tmp.string();
+    }
+#endif
+    if (!path.empty() && path.back() != '/') path += '/';
+    path += "duckdb_result_" + std::to_string(NEXT_SPILL_FILE.fetch_add(1)) + ".arrows";
+    auto spilled = std::make_unique<SpilledQueryResult>(file_page_buffer, std::move(path));
+    spilled->file_ = file_page_buffer.OpenFile(spilled->path_, duckdb::FileFlags::FILE_FLAGS_READ |
+                                                                   duckdb::FileFlags::FILE_FLAGS_WRITE |
+                                                                   duckdb::FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+    if (!spilled->file_) {
+        return arrow::Status::IOError("cannot open spill file: ", spilled->path_);
+    }
+    // A spill file that falls back to a wasm buffer would keep the result in memory
+    if (auto web_fs = io::WebFileSystem::Get();
+        web_fs && web_fs->FindDataProtocol(spilled->path_) == io::WebFileSystem::DataProtocol::BUFFER) {
+        return arrow::Status::Invalid("spill file ", spilled->path_,
+                                      " would be kept in wasm memory, set query.resultSpillDirectory to a location "
+                                      "outside of wasm memory such as opfs://tmp");
+    }
+    spilled->schema_ = export_context.GetSchema();
+    spilled->ipc_options_ = export_context.GetIPCOptions();
+    ARROW_ASSIGN_OR_RAISE(spilled->schema_message_, export_context.SerializeSchema());
+
+    // Encode and append the batches while fetching the chunks
+    std::vector<duckdb::unique_ptr<duckdb::DataChunk>> chunks;
+    uint64_t rows = 0;
+    auto flush = [&]() -> arrow::Status {
+        ARROW_ASSIGN_OR_RAISE(auto message, export_context.EncodeChunks(chunks));
+        spilled->Append(*message, rows);
+        chunks.clear();
+        rows = 0;
+        return arrow::Status::OK();
+    };
+    for (auto chunk = result.Fetch(); !!chunk && chunk->size() > 0; chunk = result.Fetch()) {
+        rows += chunk->size();
+        chunks.push_back(std::move(chunk));
+        if (rows >= batch_rows) ARROW_RETURN_NOT_OK(flush());
+    }
+    if (!chunks.empty()) ARROW_RETURN_NOT_OK(flush());
+    return spilled;
+}
+
+/// Append a record batch message to the spill file
+void SpilledQueryResult::Append(const arrow::Buffer& message, uint64_t rows) {
+    batches_.push_back(Batch{
+        .file_offset = file_->GetSize(),
+        .byte_length = static_cast<uint64_t>(message.size()),
+        .first_row = row_count_,
+        .row_count = rows,
+    });
+    file_->Append(const_cast<uint8_t*>(message.data()), message.size());
+    row_count_ += rows;
+}
+
+/// Read a record batch message from the spill file
+arrow::Result<std::shared_ptr<arrow::Buffer>> SpilledQueryResult::ReadMessage(const Batch& batch) {
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> buffer, arrow::AllocateBuffer(batch.byte_length));
+    auto* writer = buffer->mutable_data();
+    uint64_t done = 0;
+    while (done < batch.byte_length) {
+        auto n = file_->Read(writer + done, batch.byte_length - done, batch.file_offset + done);
+        if (n == 0) return arrow::Status::IOError("spill file is truncated: ", path_);
+        done += n;
+    }
+    return buffer;
+}
+
+/// Get the number of spilled bytes
+uint64_t SpilledQueryResult::GetSpilledBytes() const { return file_ ? file_->GetSize() : 0; }
+
+/// Fetch up to limit rows starting at offset as IPC stream
+arrow::Result<std::shared_ptr<arrow::Buffer>> SpilledQueryResult::FetchRange(uint64_t offset, uint64_t limit) {
+    offset = std::min(offset, row_count_);
+    auto end = offset + std::min(limit, row_count_ - offset);
+
+    ARROW_ASSIGN_OR_RAISE(auto out, arrow::io::BufferOutputStream::Create());
+    ARROW_RETURN_NOT_OK(out->Write(schema_message_));
+
+    // Find the batch that contains the offset
+    auto iter = std::upper_bound(batches_.begin(), batches_.end(), offset,
+                                 [](uint64_t row, const Batch& batch) { return row < batch.first_row; });
+    if (iter != batches_.begin()) --iter;
+
+    for (; iter != batches_.end() && iter->first_row < end; ++iter) {
+        auto batch_end = iter->first_row + iter->row_count;
+        if (batch_end <= offset) continue;
+        ARROW_ASSIGN_OR_RAISE(auto message, ReadMessage(*iter));
+
+        // Return covered batches as they were spilled
+        auto skip = offset > iter->first_row ? offset - iter->first_row : 0;
+        auto take = std::min(end, batch_end) - iter->first_row - skip;
+        if (skip == 0 && take == iter->row_count) {
+            ARROW_RETURN_NOT_OK(out->Write(message));
+            continue;
+        }
+
+        // Slice partially covered batches
+        arrow::io::BufferReader reader{message};
+        ARROW_ASSIGN_OR_RAISE(auto decoded, arrow::ipc::ReadMessage(&reader));
+        if (!decoded) return arrow::Status::IOError("invalid record batch in spill file: ", path_);
+        ARROW_ASSIGN_OR_RAISE(auto batch, arrow::ipc::ReadRecordBatch(*decoded, schema_, nullptr,
+                                                                      arrow::ipc::IpcReadOptions::Defaults()));
+        ARROW_ASSIGN_OR_RAISE(auto slice, arrow::ipc::SerializeRecordBatch(*batch->Slice(skip, take), ipc_options_));
+        ARROW_RETURN_NOT_OK(out->Write(slice));
+    }
+    ARROW_RETURN_NOT_OK(out->Write(END_OF_STREAM, sizeof(END_OF_STREAM)));
+    return out->Finish();
+}
+
+}  // namespace web
+}  // namespace duckdb
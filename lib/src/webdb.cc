@@ -4,9 +4,11 @@
 
 #include <emscripten/val.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -14,6 +16,7 @@
 #include <stdexcept>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 
 #include "../../third_party/mbedtls/include/mbedtls_wrapper.hpp"
 #include "arrow/array/array_dict.h"
@@ -40,13 +43,17 @@
 #include "duckdb/common/types/vector_buffer.hpp"
 #include "duckdb/common/virtual_file_system.hpp"
 #include "duckdb/function/table/arrow/arrow_duck_schema.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
 #include "duckdb/main/query_result.hpp"
 #include "duckdb/main/settings.hpp"
+#include "duckdb/main/stream_query_result.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
 #include "duckdb/parser/parser.hpp"
 #include "duckdb/web/arrow_bridge.h"
 #include "duckdb/web/arrow_casts.h"
+#include "duckdb/web/arrow_export_context.h"
 #include "duckdb/web/arrow_insert_options.h"
+#include "duckdb/web/arrow_ipc_file_reader.h"
 #include "duckdb/web/arrow_stream_buffer.h"
 #include "duckdb/web/arrow_type_mapping.h"
 #include "duckdb/web/config.h"
@@ -54,6 +61,7 @@
 #include "duckdb/web/environment.h"
 #include "duckdb/web/extensions/json_extension.h"
 #include "duckdb/web/extensions/parquet_extension.h"
+#include "duckdb/web/functions/http_requests.h"
 #include "duckdb/web/functions/table_function_relation.h"
 #include "duckdb/web/http_wasm.h"
 #include "duckdb/web/io/arrow_ifstream.h"
@@ -67,6 +75,7 @@
 #include "duckdb/web/json_table.h"
 #include "duckdb/web/udf.h"
 #include "duckdb/web/utils/debug.h"
+#include "duckdb/web/utils/scope_guard.h"
 #include "duckdb/web/utils/wasm_response.h"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
@@ -88,6 +97,27 @@ namespace web {
 
 static constexpr int64_t DEFAULT_QUERY_POLLING_INTERVAL = 100;
 
+/// Estimate the size of a data chunk in a record batch
+static uint64_t EstimateChunkBytes(duckdb::DataChunk& chunk) {
+    uint64_t bytes = 0;
+    for (auto& vector : chunk.data) {
+        auto& type = vector.GetType();
+        if (type.InternalType() == PhysicalType::VARCHAR) {
+            UnifiedVectorFormat format;
+            vector.ToUnifiedFormat(chunk.size(), format);
+            auto strings = UnifiedVectorFormat::GetData<string_t>(format);
+            for (idx_t i = 0; i < chunk.size(); ++i) {
+                bytes += sizeof(uint32_t) + strings[format.sel->get_index(i)].GetSize();
+            }
+        } else if (TypeIsConstantSize(type.InternalType())) {
+            bytes += GetTypeIdSize(type.InternalType()) * chunk.size();
+        } else {
+            bytes += sizeof(uint64_t) * chunk.size();
+        }
+    }
+    return bytes;
+}
+
 /// Create the default webdb database
 duckdb::unique_ptr<WebDB> WebDB::Create() {
     if constexpr (ENVIRONMENT == Environment::WEB) {
@@ -114,70 +144,257 @@ WebDB::Connection::~Connection() = default;
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::MaterializeQueryResult(
     duckdb::unique_ptr<duckdb::QueryResult> result) {
-    current_query_result_.reset();
-    current_schema_.reset();
-    current_schema_patched_.reset();
-
-    // Configure the output writer
-    ArrowSchema raw_schema;
-    bool lossless_conversion = webdb_.config_->arrow_lossless_conversion;
-    ClientProperties options("UTC", ArrowOffsetSize::REGULAR, false, false, lossless_conversion,
-                             ArrowFormatVersion::V1_0, connection_.context);
-    auto extension_type_cast = ArrowTypeExtensionData::GetExtensionTypes(*connection_.context, result->types);
-    options.arrow_offset_size = ArrowOffsetSize::REGULAR;
-    ArrowConverter::ToArrowSchema(&raw_schema, result->types, result->names, options);
-    ARROW_ASSIGN_OR_RAISE(auto schema, arrow::ImportSchema(&raw_schema));
-
-    // Patch the schema (if necessary)
-    std::shared_ptr<arrow::Schema> patched_schema = patchSchema(schema, webdb_.config_->query);
-    // Create the file writer
-    ARROW_ASSIGN_OR_RAISE(auto out, arrow::io::BufferOutputStream::Create());
-    ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(out, patched_schema));
-
-    // Write chunk stream
-    for (auto chunk = result->Fetch(); !!chunk && chunk->size() > 0; chunk = result->Fetch()) {
-        // Import the data chunk as record batch
-        ArrowArray array;
-        ArrowConverter::ToArrowArray(*chunk, &array, options, extension_type_cast);
-        // Import the record batch
-        ARROW_ASSIGN_OR_RAISE(auto batch, arrow::ImportRecordBatch(&array, schema));
-        // Patch the record batch
-        ARROW_ASSIGN_OR_RAISE(batch, patchRecordBatch(batch, patched_schema, webdb_.config_->query));
-        // Write the record batch
-        ARROW_RETURN_NOT_OK(writer->WriteRecordBatch(*batch));
-    }
-    ARROW_RETURN_NOT_OK(writer->Close());
-    return out->Finish();
+    ResetQueryResult(current_query_);
+
+    // Write the chunks as IPC file
+    ARROW_ASSIGN_OR_RAISE(auto export_context, ArrowExportContext::Create(*connection_.context, result->types,
+                                                                          result->names, *webdb_.config_));
+    return export_context->WriteFile(*result);
 }
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::StreamQueryResult(
-    duckdb::unique_ptr<duckdb::QueryResult> result) {
-    current_query_result_ = std::move(result);
-    current_schema_.reset();
-    current_schema_patched_.reset();
+    QueryHandle& query, duckdb::unique_ptr<duckdb::QueryResult> result) {
+    query.query_result = std::move(result);
+    query.export_context.reset();
+    query.cached_result.reset();
+    // Streamed results hold the client context until they are fetched
+    if (query.query_result->type == QueryResultType::STREAM_RESULT) {
+        active_query_ = &query;
+    } else if (active_query_ == &query) {
+        active_query_ = nullptr;
+    }
 
-    // Import the schema
-    ArrowSchema raw_schema;
-    bool lossless_conversion = webdb_.config_->arrow_lossless_conversion;
-    ClientProperties options("UTC", ArrowOffsetSize::REGULAR, false, false, lossless_conversion,
-                             ArrowFormatVersion::V1_0, connection_.context);
-    options.arrow_offset_size = ArrowOffsetSize::REGULAR;
-    ArrowConverter::ToArrowSchema(&raw_schema, current_query_result_->types, current_query_result_->names, options);
-    ARROW_ASSIGN_OR_RAISE(current_schema_, arrow::ImportSchema(&raw_schema));
-    current_schema_patched_ = patchSchema(current_schema_, webdb_.config_->query);
+    // Set up the export of all chunks and serialize the schema
+    ARROW_ASSIGN_OR_RAISE(query.export_context,
+                          ArrowExportContext::Create(*connection_.context, query.query_result->types,
+                                                     query.query_result->names, *webdb_.config_));
+    ARROW_ASSIGN_OR_RAISE(auto schema, query.export_context->SerializeSchema());
+
+    // Return the first rows together with the schema to save a fetch round trip
+    auto first_batch_rows = webdb_.config_->query.first_batch_rows.value_or(0);
+    if (first_batch_rows > 0) {
+        ARROW_ASSIGN_OR_RAISE(auto first_batch, FetchFirstBatch(query, first_batch_rows));
+        if (first_batch) {
+            ARROW_ASSIGN_OR_RAISE(schema, arrow::ConcatenateBuffers({schema, first_batch}));
+        }
+    }
+    RecordResultBuffer(query, schema);
+    return schema;
+}
 
-    // Serialize the schema
-    return arrow::ipc::SerializeSchema(*current_schema_patched_);
+/// Fetch and encode at least the first rows of a streamed result, returns nullptr for empty results
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::FetchFirstBatch(QueryHandle& query, uint64_t rows) {
+    auto& result = *query.query_result;
+    std::vector<duckdb::unique_ptr<duckdb::DataChunk>> chunks;
+    uint64_t fetched = 0;
+    while (fetched < rows) {
+        // Wait for the first chunk only, later chunks are appended if they are ready
+        if (!chunks.empty() && result.type == QueryResultType::STREAM_RESULT) {
+            auto state = result.Cast<duckdb::StreamQueryResult>().ExecuteTask();
+            if (state != StreamExecutionResult::CHUNK_READY && state != StreamExecutionResult::EXECUTION_FINISHED) {
+                break;
+            }
+        }
+        auto chunk = result.Fetch();
+        if (result.HasError()) {
+            return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result.GetError())};
+        }
+        if (!chunk || chunk->size() == 0) break;
+        fetched += chunk->size();
+        chunks.push_back(std::move(chunk));
+    }
+    if (chunks.empty()) return nullptr;
+    return query.export_context->EncodeChunks(chunks);
+}
+
+/// Export a query result as Arrow C stream
+arrow::Status WebDB::Connection::ExportQueryResult(duckdb::unique_ptr<duckdb::QueryResult> result,
+                                                   ArrowArrayStream* out) {
+    // Materialize streaming results, the stream may outlive the next query on this connection
+    if (result->type == duckdb::QueryResultType::STREAM_RESULT) {
+        result = static_cast<duckdb::StreamQueryResult&>(*result).Materialize();
+        if (result->HasError()) {
+            return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
+        }
+    }
+    ARROW_ASSIGN_OR_RAISE(auto export_context, ArrowExportContext::Create(*connection_.context, result->types,
+                                                                          result->names, *webdb_.config_));
+    auto reader = std::make_shared<ArrowQueryResultReader>(std::move(result), std::move(export_context));
+    return arrow::ExportRecordBatchReader(std::move(reader), out);
+}
+
+/// Reset the query result of a query
+void WebDB::Connection::ResetQueryResult(QueryHandle& query) {
+    query.query_result.reset();
+    query.export_context.reset();
+    query.cached_result.reset();
+    query.cached_result_index = 0;
+    query.cache_recording.reset();
+    if (active_query_ == &query && !query.pending_query_result) active_query_ = nullptr;
+}
+
+/// Finish the query that owns the client context before another query runs
+arrow::Status WebDB::Connection::SuspendActiveQuery() {
+    // Other statements must not run inside the transaction of a pending arrow ipc stream insert
+    if (arrow_ipc_stream_) {
+        return arrow::Status::Invalid(
+            "an arrow ipc stream insert is pending on this connection, finish the stream or abort it first");
+    }
+    auto* query = std::exchange(active_query_, nullptr);
+    // Queries without handle are invalidated by the next query
+    if (query == nullptr || query == &current_query_) return arrow::Status::OK();
+    try {
+        // Execute the remaining statements
+        while (query->pending_query_result) {
+            auto result = query->pending_query_result->Execute();
+            if (result->HasError()) {
+                if (query->pending_may_write) webdb_.result_cache_.Invalidate();
+                query->pending_query_result.reset();
+                query->pending_statements.clear();
+                query->suspended_error = arrow::Status{arrow::StatusCode::ExecutionError, result->GetError()};
+                break;
+            }
+            auto schema = FinishPendingStatement(*query, std::move(result));
+            if (!schema.ok()) {
+                query->suspended_error = schema.status();
+                break;
+            }
+            if (*schema) query->ready_schema = std::move(*schema);
+        }
+        // Materialize the streamed result
+        if (query->query_result && query->query_result->type == QueryResultType::STREAM_RESULT) {
+            auto materialized = query->query_result->Cast<duckdb::StreamQueryResult>().Materialize();
+            if (materialized->HasError()) {
+                query->suspended_error = arrow::Status{arrow::StatusCode::ExecutionError, materialized->GetError()};
+            }
+            query->query_result = std::move(materialized);
+        }
+    } catch (std::exception& e) {
+        query->suspended_error = arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
+    }
+    active_query_ = nullptr;
+    return arrow::Status::OK();
+}
+
+/// Find a query handle
+arrow::Result<std::reference_wrapper<WebDB::Connection::QueryHandle>> WebDB::Connection::FindQueryHandle(
+    size_t query_id) {
+    auto it = query_handles_.find(query_id);
+    if (it == query_handles_.end()) {
+        return arrow::Status{arrow::StatusCode::KeyError, "No query found with ID"};
+    }
+    return std::ref(*it->second);
+}
+
+/// Move the connection to a session epoch of its own if a statement changes its session state
+void WebDB::Connection::TrackSessionState(const duckdb::SQLStatement& statement) {
+    if (QueryResultCache::ChangesSessionState(statement)) session_epoch_ = webdb_.result_cache_.NextSessionEpoch();
+}
+
+/// Look up a single statement in the result cache, returns the cache key on a miss if the result is cacheable
+std::optional<std::string> WebDB::Connection::LookupCachedResult(const duckdb::SQLStatement& statement,
+                                                                 QueryResultCache::ResultFormat format,
+                                                                 std::shared_ptr<const QueryResultCache::Result>& hit,
+                                                                 std::string_view parameters) {
+    auto& cache = webdb_.result_cache_;
+    // Results in open transactions may contain uncommitted changes
+    if (!cache.IsEnabled() || !connection_.IsAutoCommit()) return std::nullopt;
+    auto normalized = QueryResultCache::Normalize(statement);
+    if (!normalized) return std::nullopt;
+    auto key = QueryResultCache::BuildKey(session_epoch_, *normalized, format, parameters);
+    hit = cache.Find(key);
+    return key;
+}
+
+/// Look up a prepared statement in the result cache, returns the cache key on a miss if the result is cacheable
+std::optional<std::string> WebDB::Connection::LookupCachedPreparedResult(
+    size_t statement_id, std::string_view args_json, QueryResultCache::ResultFormat format,
+    std::shared_ptr<const QueryResultCache::Result>& hit) {
+    if (!webdb_.result_cache_.IsEnabled()) return std::nullopt;
+    auto stmt = prepared_statements_.find(statement_id);
+    if (stmt == prepared_statements_.end() || !stmt->second->data || !stmt->second->data->unbound_statement) {
+        return std::nullopt;
+    }
+    // Serialize the arguments canonically
+    rapidjson::Document args_doc;
+    rapidjson::ParseResult ok = args_doc.Parse(args_json.data(), args_json.size());
+    if (!ok || !args_doc.IsArray()) return std::nullopt;
+    rapidjson::StringBuffer args_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> args_writer{args_buffer};
+    args_doc.Accept(args_writer);
+    return LookupCachedResult(*stmt->second->data->unbound_statement, format, hit,
+                              std::string_view{args_buffer.GetString(), args_buffer.GetSize()});
+}
+
+/// Serve a cached streamed result and return its schema
+std::shared_ptr<arrow::Buffer> WebDB::Connection::StreamCachedResult(
+    QueryHandle& query, std::shared_ptr<const QueryResultCache::Result> result) {
+    ResetQueryResult(query);
+    query.cached_result = std::move(result);
+    query.cached_result_index = 1;
+    return query.cached_result->buffers.front();
+}
+
+/// Record a buffer of a streamed result for the result cache
+void WebDB::Connection::RecordResultBuffer(QueryHandle& query, const std::shared_ptr<arrow::Buffer>& buffer) {
+    if (!query.cache_recording) return;
+    auto& recording = *query.cache_recording;
+    recording.bytes += buffer->size();
+    // Stop recording results that exceed the budget
+    if (recording.bytes > webdb_.result_cache_.GetMaxBytes()) {
+        query.cache_recording.reset();
+        return;
+    }
+    recording.result->buffers.push_back(buffer);
+}
+
+/// Insert the recorded streamed result into the result cache
+void WebDB::Connection::FinishResultRecording(QueryHandle& query) {
+    if (!query.cache_recording) return;
+    auto& recording = *query.cache_recording;
+    webdb_.result_cache_.Insert(recording.key, recording.version, std::move(recording.result));
+    query.cache_recording.reset();
 }
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::RunQuery(std::string_view text) {
     try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+
+        // Serve cached results of read-only queries
+        auto& cache = webdb_.result_cache_;
+        std::optional<std::string> cache_key;
+        uint64_t cache_version = 0;
+        bool may_write = false;
+        if (cache.IsEnabled()) {
+            auto statements = connection_.ExtractStatements(std::string{text});
+            for (auto& statement : statements) {
+                may_write |= QueryResultCache::MayWrite(statement->type);
+                TrackSessionState(*statement);
+            }
+            if (statements.size() == 1) {
+                std::shared_ptr<const QueryResultCache::Result> hit;
+                cache_key = LookupCachedResult(*statements[0], QueryResultCache::ResultFormat::IPC_FILE, hit);
+                if (hit) {
+                    ResetQueryResult(current_query_);
+                    return hit->buffers.front();
+                }
+                cache_version = cache.GetVersion();
+            }
+        }
+
         // Send the query
         auto result = connection_.SendQuery(std::string{text});
         if (result->HasError()) {
+            if (may_write) cache.Invalidate();
             return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
         }
-        return MaterializeQueryResult(std::move(result));
+        auto buffer = MaterializeQueryResult(std::move(result));
+        if (may_write) cache.Invalidate();
+        if (buffer.ok() && cache_key) {
+            cache.Insert(*cache_key, cache_version,
+                         std::make_shared<QueryResultCache::Result>(QueryResultCache::Result{{*buffer}}));
+        }
+        return buffer;
     } catch (std::exception& e) {
         return arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
     } catch (...) {
@@ -187,28 +404,57 @@ arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::RunQuery(std::s
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PendingQuery(std::string_view text,
                                                                               bool allow_stream_result) {
+    return PendingQuery(current_query_, text, allow_stream_result);
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PendingQuery(QueryHandle& query,
+                                                                              std::string_view text,
+                                                                              bool allow_stream_result) {
     try {
         auto statements = connection_.ExtractStatements(std::string{text});
         if (statements.size() == 0) {
             return arrow::Status{arrow::StatusCode::ExecutionError, "no statements"};
         }
-        current_pending_statements_ = std::move(statements);
-        current_pending_statement_index_ = 0;
-        current_allow_stream_result_ = allow_stream_result;
+
+        // Serve cached results of read-only queries
+        auto& cache = webdb_.result_cache_;
+        std::optional<ResultCacheRecording> recording;
+        query.pending_may_write = false;
+        if (cache.IsEnabled()) {
+            for (auto& statement : statements) {
+                query.pending_may_write |= QueryResultCache::MayWrite(statement->type);
+                TrackSessionState(*statement);
+            }
+            if (statements.size() == 1) {
+                std::shared_ptr<const QueryResultCache::Result> hit;
+                auto key = LookupCachedResult(*statements[0], QueryResultCache::ResultFormat::IPC_STREAM, hit);
+                if (hit) {
+                    query.pending_query_result.reset();
+                    query.pending_statements.clear();
+                    return StreamCachedResult(query, std::move(hit));
+                }
+                if (key) recording = ResultCacheRecording{.key = std::move(*key), .version = cache.GetVersion()};
+            }
+        }
+
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+        query.pending_statements = std::move(statements);
+        query.pending_statement_index = 0;
+        query.allow_stream_result = allow_stream_result;
         // Send the first query
-        auto result = connection_.PendingQuery(std::move(current_pending_statements_[current_pending_statement_index_]),
-                                               current_allow_stream_result_);
+        auto result = connection_.PendingQuery(std::move(query.pending_statements[query.pending_statement_index]),
+                                               query.allow_stream_result);
         if (result->HasError()) {
-            current_pending_statements_.clear();
+            query.pending_statements.clear();
             return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
         }
-        current_pending_query_result_ = std::move(result);
-        current_pending_query_was_canceled_ = false;
-        current_query_result_.reset();
-        current_schema_.reset();
-        current_schema_patched_.reset();
+        query.pending_query_result = std::move(result);
+        query.pending_query_was_canceled = false;
+        ResetQueryResult(query);
+        active_query_ = &query;
+        query.cache_recording = std::move(recording);
         if (webdb_.config_->query.query_polling_interval.value_or(DEFAULT_QUERY_POLLING_INTERVAL) > 0) {
-            return PollPendingQuery();
+            return PollPendingQuery(query);
         } else {
             return nullptr;
         }
@@ -220,34 +466,31 @@ arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PendingQuery(st
 }
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PollPendingQuery() {
-    if (current_pending_query_was_canceled_) {
+    return PollPendingQuery(current_query_);
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PollPendingQuery(QueryHandle& query) {
+    // The query finished or failed while it was suspended?
+    if (query.ready_schema) {
+        return std::move(query.ready_schema);
+    } else if (!query.suspended_error.ok()) {
+        return query.suspended_error;
+    }
+    if (query.pending_query_was_canceled) {
         return arrow::Status{arrow::StatusCode::ExecutionError, "query was canceled"};
-    } else if (current_pending_query_result_ == nullptr) {
+    } else if (query.pending_query_result == nullptr) {
         return arrow::Status{arrow::StatusCode::ExecutionError, "no active pending query"};
     }
     auto before = std::chrono::steady_clock::now();
     uint64_t elapsed;
     auto polling_interval = webdb_.config_->query.query_polling_interval.value_or(DEFAULT_QUERY_POLLING_INTERVAL);
     do {
-        switch (current_pending_query_result_->ExecuteTask()) {
+        switch (query.pending_query_result->ExecuteTask()) {
             case PendingExecutionResult::EXECUTION_FINISHED:
             case PendingExecutionResult::RESULT_READY: {
-                auto result = current_pending_query_result_->Execute();
-                current_pending_statement_index_++;
-                // If this was the last statement, then return the result
-                if (current_pending_statement_index_ == current_pending_statements_.size()) {
-                    return StreamQueryResult(std::move(result));
-                }
-                // Otherwise, start the next statement
-                auto pending_result =
-                    connection_.PendingQuery(std::move(current_pending_statements_[current_pending_statement_index_]),
-                                             current_allow_stream_result_);
-                if (pending_result->HasError()) {
-                    current_pending_query_result_.reset();
-                    current_pending_statements_.clear();
-                    return arrow::Status{arrow::StatusCode::ExecutionError, std::move(pending_result->GetError())};
-                }
-                current_pending_query_result_ = std::move(pending_result);
+                auto schema = FinishPendingStatement(query, query.pending_query_result->Execute());
+                // Return the result after the last statement
+                if (!schema.ok() || *schema != nullptr) return schema;
                 break;
             }
             case PendingExecutionResult::BLOCKED:
@@ -256,9 +499,11 @@ arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PollPendingQuer
             case PendingExecutionResult::RESULT_NOT_READY:
                 break;
             case PendingExecutionResult::EXECUTION_ERROR: {
-                auto err = current_pending_query_result_->GetError();
-                current_pending_query_result_.reset();
-                current_pending_statements_.clear();
+                auto err = query.pending_query_result->GetError();
+                if (query.pending_may_write) webdb_.result_cache_.Invalidate();
+                query.pending_query_result.reset();
+                query.pending_statements.clear();
+                if (active_query_ == &query) active_query_ = nullptr;
                 return arrow::Status{arrow::StatusCode::ExecutionError, err};
             }
         }
@@ -268,28 +513,73 @@ arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PollPendingQuer
     return nullptr;
 }
 
-bool WebDB::Connection::CancelPendingQuery() {
+/// Continue a pending query with a finished statement, returns the schema after the last statement
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::FinishPendingStatement(
+    QueryHandle& query, duckdb::unique_ptr<duckdb::QueryResult> result) {
+    query.pending_statement_index++;
+    // If this was the last statement, then return the result
+    if (query.pending_statement_index == query.pending_statements.size()) {
+        if (query.pending_may_write) webdb_.result_cache_.Invalidate();
+        query.pending_query_result.reset();
+        query.pending_statements.clear();
+        return StreamQueryResult(query, std::move(result));
+    }
+    // Otherwise, start the next statement
+    auto pending_result = connection_.PendingQuery(std::move(query.pending_statements[query.pending_statement_index]),
+                                                   query.allow_stream_result);
+    if (pending_result->HasError()) {
+        if (query.pending_may_write) webdb_.result_cache_.Invalidate();
+        query.pending_query_result.reset();
+        query.pending_statements.clear();
+        if (active_query_ == &query) active_query_ = nullptr;
+        return arrow::Status{arrow::StatusCode::ExecutionError, std::move(pending_result->GetError())};
+    }
+    query.pending_query_result = std::move(pending_result);
+    return nullptr;
+}
+
+bool WebDB::Connection::CancelPendingQuery() { return CancelPendingQuery(current_query_); }
+
+bool WebDB::Connection::CancelPendingQuery(QueryHandle& query) {
     // Only reset the pending query if it hasn't completed yet
-    if (current_pending_query_result_ != nullptr && current_query_result_ == nullptr) {
-        current_pending_query_was_canceled_ = true;
-        current_pending_query_result_.reset();
-        current_pending_statements_.clear();
+    if (query.pending_query_result != nullptr && query.query_result == nullptr) {
+        query.pending_query_was_canceled = true;
+        query.pending_query_result.reset();
+        query.pending_statements.clear();
+        if (active_query_ == &query) active_query_ = nullptr;
         return true;
     } else {
         return false;
     }
 }
 
-DuckDBWasmResultsWrapper WebDB::Connection::FetchQueryResults() {
+DuckDBWasmResultsWrapper WebDB::Connection::FetchQueryResults() { return FetchQueryResults(current_query_); }
+
+DuckDBWasmResultsWrapper WebDB::Connection::FetchQueryResults(QueryHandle& query) {
     try {
+        // The query failed while it was suspended?
+        if (!query.suspended_error.ok()) {
+            return query.suspended_error;
+        }
+
+        // Serve a cached result
+        if (query.cached_result) {
+            if (query.cached_result_index < query.cached_result->buffers.size()) {
+                return query.cached_result->buffers[query.cached_result_index++];
+            }
+            ResetQueryResult(query);
+            return DuckDBWasmResultsWrapper{nullptr};
+        }
+
         // Fetch data if a query is active
         duckdb::unique_ptr<duckdb::DataChunk> chunk;
-        if (current_query_result_ == nullptr) {
+        if (query.query_result == nullptr) {
             return DuckDBWasmResultsWrapper{nullptr};
         }
+        auto& result = *query.query_result;
 
-        if (current_query_result_->type == QueryResultType::STREAM_RESULT) {
-            auto& stream_result = current_query_result_->Cast<duckdb::StreamQueryResult>();
+        if (result.type == QueryResultType::STREAM_RESULT) {
+            auto& stream_result = result.Cast<duckdb::StreamQueryResult>();
 
             auto before = std::chrono::steady_clock::now();
             uint64_t elapsed;
@@ -299,8 +589,7 @@ DuckDBWasmResultsWrapper WebDB::Connection::FetchQueryResults() {
             do {
                 switch (stream_result.ExecuteTask()) {
                     case StreamExecutionResult::EXECUTION_ERROR:
-                        return arrow::Status{arrow::StatusCode::ExecutionError,
-                                             std::move(current_query_result_->GetError())};
+                        return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result.GetError())};
                     case StreamExecutionResult::EXECUTION_CANCELLED:
                         return arrow::Status{arrow::StatusCode::ExecutionError,
                                              "The execution of the query was cancelled before it could finish, likely "
@@ -328,40 +617,126 @@ DuckDBWasmResultsWrapper WebDB::Connection::FetchQueryResults() {
         }
 
         // Fetch next result chunk
-        chunk = current_query_result_->Fetch();
-        if (current_query_result_->HasError()) {
-            return arrow::Status{arrow::StatusCode::ExecutionError, std::move(current_query_result_->GetError())};
+        chunk = result.Fetch();
+        if (result.HasError()) {
+            return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result.GetError())};
         }
         // Reached end?
         if (!chunk) {
-            current_query_result_.reset();
-            current_schema_.reset();
-            current_schema_patched_.reset();
+            FinishResultRecording(query);
+            ResetQueryResult(query);
             return DuckDBWasmResultsWrapper{nullptr};
         }
 
-        // Serialize the record batch
-        ArrowArray array;
-        bool lossless_conversion = webdb_.config_->arrow_lossless_conversion;
-        ClientProperties arrow_options("UTC", ArrowOffsetSize::REGULAR, false, false, lossless_conversion,
-                                       ArrowFormatVersion::V1_0, connection_.context);
-        auto extension_type_cast = ArrowTypeExtensionData::GetExtensionTypes(*connection_.context, chunk->GetTypes());
-        arrow_options.arrow_offset_size = ArrowOffsetSize::REGULAR;
-        ArrowConverter::ToArrowArray(*chunk, &array, arrow_options, extension_type_cast);
-        ARROW_ASSIGN_OR_RAISE(auto batch, arrow::ImportRecordBatch(&array, current_schema_));
-        // Patch the record batch
-        ARROW_ASSIGN_OR_RAISE(batch, patchRecordBatch(batch, current_schema_patched_, webdb_.config_->query));
-        // Serialize the record batch
-        auto options = arrow::ipc::IpcWriteOptions::Defaults();
-        options.use_threads = false;
-        return arrow::ipc::SerializeRecordBatch(*batch, options);
+        // Coalesce more chunks into the record batch?
+        std::vector<duckdb::unique_ptr<duckdb::DataChunk>> chunks;
+        chunks.push_back(std::move(chunk));
+        bool reached_end = false;
+        auto& query_config = webdb_.config_->query;
+        if (query_config.hasResultBatchTarget()) {
+            auto target_rows = query_config.result_batch_rows.value_or(0);
+            auto target_bytes = query_config.result_batch_bytes.value_or(0);
+            auto polling_interval = query_config.query_polling_interval.value_or(DEFAULT_QUERY_POLLING_INTERVAL);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{polling_interval};
+            uint64_t rows = chunks.back()->size();
+            uint64_t bytes = EstimateChunkBytes(*chunks.back());
+            while ((target_rows == 0 || rows < target_rows) && (target_bytes == 0 || bytes < target_bytes) &&
+                   std::chrono::steady_clock::now() < deadline) {
+
+                // Only fetch chunks that are ready, errors are reported by the next call
+                if (result.type == QueryResultType::STREAM_RESULT) {
+                    auto& stream_result = result.Cast<duckdb::StreamQueryResult>();
+                    auto state = stream_result.ExecuteTask();
+                    if (state == StreamExecutionResult::CHUNK_NOT_READY) continue;
+                    if (state != StreamExecutionResult::CHUNK_READY &&
+                        state != StreamExecutionResult::EXECUTION_FINISHED) {
+                        break;
+                    }
+                }
+                auto next = result.Fetch();
+                if (result.HasError()) {
+                    return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result.GetError())};
+                }
+                if (!next || next->size() == 0) {
+                    reached_end = true;
+                    break;
+                }
+                rows += next->size();
+                bytes += EstimateChunkBytes(*next);
+                chunks.push_back(std::move(next));
+            }
+        }
+
+        // Encode the chunks
+        auto buffer = query.export_context->EncodeChunks(chunks);
+        if (buffer.ok()) {
+            RecordResultBuffer(query, *buffer);
+        } else {
+            query.cache_recording.reset();
+        }
+        if (reached_end) {
+            FinishResultRecording(query);
+            ResetQueryResult(query);
+        }
+        return buffer;
     } catch (std::exception& e) {
         return arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
     }
 }
+
+arrow::Result<size_t> WebDB::Connection::StartPendingQuery(std::string_view text, bool allow_stream_result) {
+    auto query = std::make_unique<QueryHandle>();
+    auto schema = PendingQuery(*query, text, allow_stream_result);
+    if (!schema.ok()) {
+        if (active_query_ == query.get()) active_query_ = nullptr;
+        return schema.status();
+    }
+    query->ready_schema = std::move(*schema);
+    auto query_id = next_query_handle_id_++;
+    query_handles_.insert({query_id, std::move(query)});
+    return query_id;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::PollPendingQuery(size_t query_id) {
+    ARROW_ASSIGN_OR_RAISE(auto query, FindQueryHandle(query_id));
+    auto schema = PollPendingQuery(query.get());
+    if (!schema.ok()) CloseQueryHandle(query_id);
+    return schema;
+}
+
+bool WebDB::Connection::CancelPendingQuery(size_t query_id) {
+    auto query = FindQueryHandle(query_id);
+    if (!query.ok()) return false;
+    auto canceled = CancelPendingQuery(query->get());
+    if (canceled) CloseQueryHandle(query_id);
+    return canceled;
+}
+
+DuckDBWasmResultsWrapper WebDB::Connection::FetchQueryResults(size_t query_id) {
+    auto query = FindQueryHandle(query_id);
+    if (!query.ok()) return query.status();
+    auto results = FetchQueryResults(query->get());
+    // Close the handle at the end of the result and on errors
+    if (results.status == DuckDBWasmResultsWrapper::ResponseStatus::ARROW_BUFFER &&
+        (!results.arrow_buffer.ok() || *results.arrow_buffer == nullptr)) {
+        CloseQueryHandle(query_id);
+    }
+    return results;
+}
+
+arrow::Status WebDB::Connection::CloseQueryHandle(size_t query_id) {
+    // Handles are closed implicitly at the end of their result, closing them again is a no-op
+    auto it = query_handles_.find(query_id);
+    if (it == query_handles_.end()) return arrow::Status::OK();
+    if (active_query_ == it->second.get()) active_query_ = nullptr;
+    query_handles_.erase(it);
+    return arrow::Status::OK();
+}
+
 /// Fetch table names
 arrow::Result<std::string> WebDB::Connection::GetTableNames(std::string_view text) {
     try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
         rapidjson::Document doc;
         auto table_name_set = connection_.GetTableNames(std::string{text});
         std::vector<std::string> table_names{table_name_set.begin(), table_name_set.end()};
@@ -382,6 +757,7 @@ arrow::Result<std::string> WebDB::Connection::GetTableNames(std::string_view tex
 
 arrow::Result<size_t> WebDB::Connection::CreatePreparedStatement(std::string_view text) {
     try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
         auto prep = connection_.Prepare(std::string{text});
         if (prep->HasError()) return arrow::Status{arrow::StatusCode::ExecutionError, prep->GetError()};
         auto id = next_prepared_statement_id_++;
@@ -399,9 +775,13 @@ arrow::Result<size_t> WebDB::Connection::CreatePreparedStatement(std::string_vie
 arrow::Result<duckdb::unique_ptr<duckdb::QueryResult>> WebDB::Connection::ExecutePreparedStatement(
     size_t statement_id, std::string_view args_json) {
     try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
         auto stmt = prepared_statements_.find(statement_id);
         if (stmt == prepared_statements_.end())
             return arrow::Status{arrow::StatusCode::KeyError, "No prepared statement found with ID"};
+        if (stmt->second->data && stmt->second->data->unbound_statement) {
+            TrackSessionState(*stmt->second->data->unbound_statement);
+        }
 
         rapidjson::Document args_doc;
         rapidjson::ParseResult ok = args_doc.Parse(args_json.data(), args_json.size());
@@ -427,6 +807,7 @@ arrow::Result<duckdb::unique_ptr<duckdb::QueryResult>> WebDB::Connection::Execut
         }
 
         auto result = stmt->second->Execute(values);
+        if (QueryResultCache::MayWrite(stmt->second->GetStatementType())) webdb_.result_cache_.Invalidate();
         if (result->HasError()) return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
         return result;
     } catch (std::exception& e) {
@@ -436,16 +817,127 @@ arrow::Result<duckdb::unique_ptr<duckdb::QueryResult>> WebDB::Connection::Execut
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::RunPreparedStatement(size_t statement_id,
                                                                                       std::string_view args_json) {
+    // Serve cached results of read-only statements
+    auto& cache = webdb_.result_cache_;
+    std::shared_ptr<const QueryResultCache::Result> hit;
+    auto cache_key =
+        LookupCachedPreparedResult(statement_id, args_json, QueryResultCache::ResultFormat::IPC_FILE, hit);
+    if (hit) {
+        ResetQueryResult(current_query_);
+        return hit->buffers.front();
+    }
+    auto cache_version = cache.GetVersion();
+
     auto result = ExecutePreparedStatement(statement_id, args_json);
     if (!result.ok()) return result.status();
-    return MaterializeQueryResult(std::move(*result));
+    auto buffer = MaterializeQueryResult(std::move(*result));
+    if (buffer.ok() && cache_key) {
+        cache.Insert(*cache_key, cache_version,
+                     std::make_shared<QueryResultCache::Result>(QueryResultCache::Result{{*buffer}}));
+    }
+    return buffer;
 }
 
 arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::SendPreparedStatement(size_t statement_id,
                                                                                        std::string_view args_json) {
+    // Serve cached results of read-only statements
+    auto& cache = webdb_.result_cache_;
+    std::shared_ptr<const QueryResultCache::Result> hit;
+    auto cache_key =
+        LookupCachedPreparedResult(statement_id, args_json, QueryResultCache::ResultFormat::IPC_STREAM, hit);
+    if (hit) return StreamCachedResult(current_query_, std::move(hit));
+    std::optional<ResultCacheRecording> recording;
+    if (cache_key) recording = ResultCacheRecording{.key = std::move(*cache_key), .version = cache.GetVersion()};
+
     auto result = ExecutePreparedStatement(statement_id, args_json);
     if (!result.ok()) return result.status();
-    return StreamQueryResult(std::move(*result));
+    current_query_.cache_recording = std::move(recording);
+    return StreamQueryResult(current_query_, std::move(*result));
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::RunPreparedStatementBatch(
+    size_t statement_id, nonstd::span<const uint8_t> params) {
+    try {
+        auto stmt = prepared_statements_.find(statement_id);
+        if (stmt == prepared_statements_.end())
+            return arrow::Status{arrow::StatusCode::KeyError, "No prepared statement found with ID"};
+        auto& prepared = *stmt->second;
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+        if (prepared.data && prepared.data->unbound_statement) TrackSessionState(*prepared.data->unbound_statement);
+
+        // Read the parameter sets
+        arrow::io::BufferReader reader{std::make_shared<arrow::Buffer>(params.data(), params.size())};
+        ARROW_ASSIGN_OR_RAISE(auto batch_reader, arrow::ipc::RecordBatchStreamReader::Open(&reader));
+        ARROW_ASSIGN_OR_RAISE(auto batches, batch_reader->ToRecordBatches());
+
+        // Execute the statement once per parameter set.
+        // The parameters are converted column-wise with their Arrow types, the results are materialized since the
+        // next execution would invalidate a streaming result.
+        bool may_write = QueryResultCache::MayWrite(prepared.GetStatementType());
+        std::vector<duckdb::unique_ptr<duckdb::QueryResult>> results;
+        for (auto& batch : batches) {
+            std::vector<duckdb::vector<duckdb::Value>> columns;
+            columns.reserve(batch->num_columns());
+            for (auto& column : batch->columns()) {
+                ARROW_ASSIGN_OR_RAISE(auto values, convertArrowArrayToDuckDBValues(*column));
+                columns.push_back(std::move(values));
+            }
+            duckdb::vector<duckdb::Value> values(columns.size());
+            for (int64_t row = 0; row < batch->num_rows(); ++row) {
+                for (size_t col = 0; col < columns.size(); ++col) {
+                    values[col] = std::move(columns[col][row]);
+                }
+                auto result = prepared.Execute(values, false);
+                if (result->HasError()) {
+                    if (may_write) webdb_.result_cache_.Invalidate();
+                    return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
+                }
+                results.push_back(std::move(result));
+            }
+        }
+        if (may_write) webdb_.result_cache_.Invalidate();
+
+        // Write all results as a single IPC file
+        ResetQueryResult(current_query_);
+        std::vector<duckdb::QueryResult*> result_ptrs;
+        for (auto& result : results) result_ptrs.push_back(result.get());
+        ARROW_ASSIGN_OR_RAISE(auto export_context, ArrowExportContext::Create(*connection_.context, prepared.GetTypes(),
+                                                                              prepared.GetNames(), *webdb_.config_));
+        return export_context->WriteFile(result_ptrs);
+    } catch (std::exception& e) {
+        return arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
+    }
+}
+
+arrow::Status WebDB::Connection::ExportQuery(std::string_view text, ArrowArrayStream* out) {
+    try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+        if (webdb_.result_cache_.IsEnabled()) {
+            for (auto& statement : connection_.ExtractStatements(std::string{text})) TrackSessionState(*statement);
+        }
+        auto result = connection_.Query(std::string{text});
+        bool may_write = false;
+        for (auto* r = result.get(); r != nullptr; r = r->next.get()) {
+            may_write |= QueryResultCache::MayWrite(r->statement_type);
+        }
+        if (may_write) webdb_.result_cache_.Invalidate();
+        if (result->HasError()) {
+            return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
+        }
+        return ExportQueryResult(std::move(result), out);
+    } catch (std::exception& e) {
+        return arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
+    }
+}
+
+arrow::Status WebDB::Connection::ExportPreparedStatement(size_t statement_id, std::string_view args_json,
+                                                         ArrowArrayStream* out) {
+    try {
+        ARROW_ASSIGN_OR_RAISE(auto result, ExecutePreparedStatement(statement_id, args_json));
+        return ExportQueryResult(std::move(result), out);
+    } catch (std::exception& e) {
+        return arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
+    }
 }
 
 arrow::Status WebDB::Connection::ClosePreparedStatement(size_t statement_id) {
@@ -456,6 +948,74 @@ arrow::Status WebDB::Connection::ClosePreparedStatement(size_t statement_id) {
     return arrow::Status::OK();
 }
 
+arrow::Result<size_t> WebDB::Connection::SpillQuery(std::string_view text) {
+    try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+        auto& cache = webdb_.result_cache_;
+        bool may_write = false;
+        if (cache.IsEnabled()) {
+            for (auto& statement : connection_.ExtractStatements(std::string{text})) {
+                may_write |= QueryResultCache::MayWrite(statement->type);
+                TrackSessionState(*statement);
+            }
+        }
+
+        // Send the query
+        auto result = connection_.SendQuery(std::string{text});
+        if (result->HasError()) {
+            if (may_write) cache.Invalidate();
+            return arrow::Status{arrow::StatusCode::ExecutionError, std::move(result->GetError())};
+        }
+
+        // Spill plain record batches, dictionary deltas would break the random access
+        auto config = *webdb_.config_;
+        config.query.dictionary_encode_strings = false;
+        ARROW_ASSIGN_OR_RAISE(auto export_context,
+                              ArrowExportContext::Create(*connection_.context, result->types, result->names, config));
+        auto spilled = SpilledQueryResult::Create(*webdb_.file_page_buffer_,
+                                                  config.query.result_spill_directory.value_or(""), *result,
+                                                  *export_context, config.query.result_batch_rows.value_or(0));
+        if (may_write) cache.Invalidate();
+        if (!spilled.ok()) return spilled.status();
+
+        auto result_id = next_spilled_result_id_++;
+        spilled_results_.insert({result_id, std::move(*spilled)});
+        return result_id;
+    } catch (std::exception& e) {
+        return arrow::Status{arrow::StatusCode::ExecutionError, e.what()};
+    } catch (...) {
+        return arrow::Status{arrow::StatusCode::ExecutionError, "unknown exception"};
+    }
+}
+
+arrow::Result<uint64_t> WebDB::Connection::GetSpilledResultRowCount(size_t result_id) {
+    auto it = spilled_results_.find(result_id);
+    if (it == spilled_results_.end())
+        return arrow::Status{arrow::StatusCode::KeyError, "No spilled result found with ID"};
+    return it->second->GetRowCount();
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> WebDB::Connection::FetchSpilledResultRange(size_t result_id,
+                                                                                         uint64_t offset,
+                                                                                         uint64_t limit) {
+    auto it = spilled_results_.find(result_id);
+    if (it == spilled_results_.end())
+        return arrow::Status{arrow::StatusCode::KeyError, "No spilled result found with ID"};
+    try {
+        return it->second->FetchRange(offset, limit);
+    } catch (std::exception& e) {
+        return arrow::Status{arrow::StatusCode::IOError, e.what()};
+    }
+}
+
+arrow::Status WebDB::Connection::CloseSpilledResult(size_t result_id) {
+    auto it = spilled_results_.find(result_id);
+    if (it == spilled_results_.end())
+        return arrow::Status{arrow::StatusCode::KeyError, "No spilled result found with ID"};
+    spilled_results_.erase(it);
+    return arrow::Status::OK();
+}
+
 arrow::Status WebDB::Connection::CreateScalarFunction(std::string_view def_json) {
     // Read the function definiton
     rapidjson::Document def_doc;
@@ -466,6 +1026,7 @@ arrow::Status WebDB::Connection::CreateScalarFunction(std::string_view def_json)
     // Read return type
     auto name = def->name;
     ARROW_ASSIGN_OR_RAISE(auto ret_type, mapArrowTypeToDuckDB(*def->return_type));
+    ARROW_RETURN_NOT_OK(SuspendActiveQuery());
 
     // UDF lambda
     auto udf = [&, udf = std::move(def)](DataChunk& chunk, ExpressionState& state, Vector& vec) {
@@ -477,6 +1038,7 @@ arrow::Status WebDB::Connection::CreateScalarFunction(std::string_view def_json)
 
     // Register the vectorized function
     connection_.CreateVectorizedFunction(name, vector<LogicalType>{}, ret_type, udf, LogicalType::ANY);
+    webdb_.result_cache_.Invalidate();
     return arrow::Status::OK();
 }
 
@@ -498,6 +1060,16 @@ class SharedVectorBuffer : public VectorBuffer {
         : VectorBuffer(VectorBufferType::STANDARD_BUFFER), data(std::move(data)) {}
 };
 
+/// An arrow buffer that owns its memory
+class OwningArrowBuffer : public arrow::Buffer {
+   protected:
+    std::unique_ptr<char[]> owned_data;
+
+   public:
+    OwningArrowBuffer(std::unique_ptr<char[]> data, size_t size)
+        : arrow::Buffer(reinterpret_cast<const uint8_t*>(data.get()), size), owned_data(std::move(data)) {}
+};
+
 }  // namespace
 
 typedef vector<unique_ptr<data_t[]>> additional_buffers_t;
@@ -591,9 +1163,27 @@ arrow::Status WebDB::Connection::CallScalarUDFFunction(UDFFunctionDeclaration& f
 /// Insert a record batch
 arrow::Status WebDB::Connection::InsertArrowFromIPCStream(nonstd::span<const uint8_t> stream,
                                                           std::string_view options_json) {
+    // The span is only valid during this call, decoded batches and partial messages need their own copy
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> buffer, arrow::AllocateBuffer(stream.size()));
+    if (!stream.empty()) std::memcpy(buffer->mutable_data(), stream.data(), stream.size());
+    return ConsumeArrowIPCBuffer(std::move(buffer), options_json);
+}
+
+/// Insert a record batch from an owned buffer
+arrow::Status WebDB::Connection::InsertArrowFromIPCBuffer(std::unique_ptr<char[]> buffer, size_t buffer_length,
+                                                          std::string_view options_json) {
+    return ConsumeArrowIPCBuffer(std::make_shared<OwningArrowBuffer>(std::move(buffer), buffer_length),
+                                 options_json);
+}
+
+/// Consume a buffer of an arrow ipc stream and insert the decoded batches
+arrow::Status WebDB::Connection::ConsumeArrowIPCBuffer(std::shared_ptr<arrow::Buffer> data,
+                                                       std::string_view options_json) {
     try {
         // First call?
         if (!arrow_ipc_stream_) {
+            // Finish other queries first, later statements on the connection are rejected until the stream ends
+            ARROW_RETURN_NOT_OK(SuspendActiveQuery());
             arrow_insert_options_.reset();
 
             /// Read table options.
@@ -610,40 +1200,118 @@ arrow::Status WebDB::Connection::InsertArrowFromIPCStream(nonstd::span<const uin
         }
 
         /// Consume stream bytes
-        ARROW_RETURN_NOT_OK(arrow_ipc_stream_->Consume(stream.data(), stream.size()));
-        if (!arrow_ipc_stream_->buffer()->is_eos()) {
-            return arrow::Status::OK();
+        // Batches are decoded as slices of the buffer
+        auto status = arrow_ipc_stream_->Consume(std::move(data));
+        if (!status.ok()) {
+            AbortArrowIPCStream();
+            return status;
         }
+        auto& buffer = arrow_ipc_stream_->buffer();
         assert(arrow_insert_options_);
 
+        // Append the batches of this call right away, the table is created with the first batches.
+        // An empty stream only creates the table.
+        if (!buffer->batches().empty() || (buffer->is_eos() && arrow_insert_options_->create_new)) {
+            // All batches of a stream are inserted in one transaction
+            if (!arrow_insert_transaction_ && connection_.IsAutoCommit()) {
+                connection_.BeginTransaction();
+                arrow_insert_transaction_ = true;
+            }
+
+            /// Execute the arrow scan
+            vector<Value> params;
+            params.push_back(duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&buffer)));
+            params.push_back(
+                duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ArrowIPCStreamBufferReader::CreateStream)));
+            params.push_back(
+                duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ArrowIPCStreamBufferReader::GetSchema)));
+            auto func = connection_.TableFunction("arrow_scan", params);
+
+            /// Create or insert
+            if (arrow_insert_options_->create_new) {
+                func->Create(arrow_insert_options_->schema_name, arrow_insert_options_->table_name);
+                // Later batches are appended to the new table
+                arrow_insert_options_->create_new = false;
+            } else {
+                func->Insert(arrow_insert_options_->schema_name, arrow_insert_options_->table_name);
+            }
+            webdb_.result_cache_.Invalidate();
+
+            // Release the inserted batches
+            buffer->ClearBatches();
+        }
+        if (!buffer->is_eos()) {
+            return arrow::Status::OK();
+        }
+
+        // Commit the batches and reset the ipc stream
+        if (std::exchange(arrow_insert_transaction_, false)) {
+            connection_.Commit();
+        }
+        arrow_insert_options_.reset();
+        arrow_ipc_stream_.reset();
+    } catch (const std::exception& e) {
+        AbortArrowIPCStream();
+        return arrow::Status::UnknownError(e.what());
+    }
+    return arrow::Status::OK();
+}
+
+/// Abort a pending arrow ipc stream insert
+arrow::Status WebDB::Connection::AbortArrowIPCStream() {
+    arrow_insert_options_.reset();
+    arrow_ipc_stream_.reset();
+    try {
+        if (std::exchange(arrow_insert_transaction_, false) && connection_.HasActiveTransaction()) {
+            connection_.Rollback();
+        }
+    } catch (const std::exception& e) {
+        return arrow::Status::UnknownError(e.what());
+    }
+    return arrow::Status::OK();
+}
+/// Import an arrow ipc file
+arrow::Status WebDB::Connection::InsertArrowFromIPCFile(std::string_view path, std::string_view options_json) {
+    try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+
+        /// Read table options
+        rapidjson::Document options_doc;
+        options_doc.Parse(options_json.data(), options_json.size());
+        ArrowInsertOptions options;
+        ARROW_RETURN_NOT_OK(options.ReadFrom(options_doc));
+
+        // Open the ipc file, all state is local to this call
+        auto decode_threads = static_cast<int>(webdb_.config_->maximum_threads);
+        ARROW_ASSIGN_OR_RAISE(auto file_reader,
+                              ArrowIPCFileReader::Open(webdb_.file_page_buffer_, path, decode_threads));
+
         /// Execute the arrow scan
         vector<Value> params;
-        params.push_back(duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&arrow_ipc_stream_->buffer())));
-        params.push_back(
-            duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ArrowIPCStreamBufferReader::CreateStream)));
-        params.push_back(duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ArrowIPCStreamBufferReader::GetSchema)));
+        params.push_back(duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&file_reader)));
+        params.push_back(duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ArrowIPCFileReader::CreateStream)));
+        params.push_back(duckdb::Value::POINTER(reinterpret_cast<uintptr_t>(&ArrowIPCFileReader::GetSchema)));
         auto func = connection_.TableFunction("arrow_scan", params);
 
         /// Create or insert
-        if (arrow_insert_options_->create_new) {
-            func->Create(arrow_insert_options_->schema_name, arrow_insert_options_->table_name);
+        if (options.create_new) {
+            func->Create(options.schema_name, options.table_name);
         } else {
-            func->Insert(arrow_insert_options_->schema_name, arrow_insert_options_->table_name);
+            func->Insert(options.schema_name, options.table_name);
         }
+        webdb_.result_cache_.Invalidate();
 
-        // Reset the ipc stream
-        arrow_insert_options_.reset();
-        arrow_ipc_stream_.reset();
     } catch (const std::exception& e) {
-        arrow_insert_options_.reset();
-        arrow_ipc_stream_.reset();
         return arrow::Status::UnknownError(e.what());
     }
     return arrow::Status::OK();
 }
+
 /// Import a csv file
 arrow::Status WebDB::Connection::InsertCSVFromPath(std::string_view path, std::string_view options_json) {
     try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+
         /// Read table options
         rapidjson::Document options_doc;
         options_doc.Parse(options_json.data(), options_json.size());
@@ -692,6 +1360,33 @@ arrow::Status WebDB::Connection::InsertCSVFromPath(std::string_view path, std::s
         }
         named_params.insert({"auto_detect", Value::BOOLEAN(options.auto_detect.value_or(true))});
 
+        // Prefetch the ranges of remote files concurrently while the scan parses in parallel.
+        // The sniffer and the scan read sequentially through the web filesystem and are served from the ranges.
+        // Registered files and remote urls are read through the web filesystem unless an extension like httpfs
+        // handles the urls, these reads would not be served from the ranges.
+        duckdb::unique_ptr<duckdb::FileHandle> prefetch_hdl = nullptr;
+        auto web_fs = io::WebFileSystem::Get();
+        auto is_url = [&](std::string_view prefix) { return path.substr(0, prefix.size()) == prefix; };
+        auto prefetch =
+            is_url("http://") || is_url("https://") || is_url("s3://") || webdb_.pinned_web_files_.count(path);
+        if (web_fs && options.prefetch_concurrency.value_or(1) > 0 && prefetch) {
+            // Open the file through the filesystem of the database to find the filesystem that handles the path.
+            // Direct I/O bypasses the page buffer and returns the handle of the web filesystem.
+            auto& db_fs = duckdb::FileSystem::GetFileSystem(*connection_.context);
+            prefetch_hdl = db_fs.OpenFile(std::string{path},
+                                          duckdb::FileFlags::FILE_FLAGS_READ | duckdb::FileFlags::FILE_FLAGS_DIRECT_IO);
+            if (prefetch_hdl && &prefetch_hdl->file_system == web_fs) {
+                web_fs->PrefetchRanges(
+                    *prefetch_hdl, options.prefetch_range_size.value_or(io::RangePrefetcher::DEFAULT_RANGE_SIZE),
+                    options.prefetch_concurrency.value_or(io::RangePrefetcher::DEFAULT_CONCURRENCY));
+            } else {
+                prefetch_hdl.reset();
+            }
+        }
+        auto stop_prefetch = sg::make_scope_guard([&]() {
+            if (prefetch_hdl) web_fs->StopRangePrefetch(*prefetch_hdl);
+        });
+
         /// Execute the csv scan
         auto func = duckdb::make_shared_ptr<TableFunctionRelation>(connection_.context, "read_csv",
                                                                    std::move(unnamed_params), named_params);
@@ -702,6 +1397,7 @@ arrow::Status WebDB::Connection::InsertCSVFromPath(std::string_view path, std::s
         } else {
             func->Insert(options.schema_name, options.table_name);
         }
+        webdb_.result_cache_.Invalidate();
 
     } catch (const std::exception& e) {
         return arrow::Status::UnknownError(e.what());
@@ -712,6 +1408,8 @@ arrow::Status WebDB::Connection::InsertCSVFromPath(std::string_view path, std::s
 /// Import a json file
 arrow::Status WebDB::Connection::InsertJSONFromPath(std::string_view path, std::string_view options_json) {
     try {
+        ARROW_RETURN_NOT_OK(SuspendActiveQuery());
+
         /// Read table options
         rapidjson::Document options_doc;
         options_doc.Parse(options_json.data(), options_json.size());
@@ -751,6 +1449,7 @@ arrow::Status WebDB::Connection::InsertJSONFromPath(std::string_view path, std::
         } else {
             func->Insert(schema_name, options.table_name);
         }
+        webdb_.result_cache_.Invalidate();
 
     } catch (const std::exception& e) {
         return arrow::Status::UnknownError(e.what());
@@ -800,6 +1499,14 @@ void WebDB::RegisterCustomExtensionOptions(shared_ptr<duckdb::DuckDB> database)
             webfs->Config()->duckdb_config_options.reliable_head_requests = BooleanValue::Get(parameter);
             webfs->IncrementCacheEpoch();
         };
+        auto callback_http_request_trace_size = [](ClientContext& context, SetScope scope, Value& parameter) {
+            auto webfs = io::WebFileSystem::Get();
+            webfs->GetHTTPTracer().SetCapacity(UBigIntValue::Get(parameter));
+        };
+        auto callback_http_max_connections_per_host = [](ClientContext& context, SetScope scope, Value& parameter) {
+            auto webfs = io::WebFileSystem::Get();
+            webfs->GetHTTPScheduler().SetMaxConnectionsPerHost(UBigIntValue::Get(parameter));
+        };
         auto callback_experimental_s3_tables_global_proxy = [](ClientContext& context, SetScope scope,
                                                                Value& parameter) {
             experimental_s3_tables_global_proxy = StringValue::Get(parameter);
@@ -821,6 +1528,23 @@ void WebDB::RegisterCustomExtensionOptions(shared_ptr<duckdb::DuckDB> database)
         config.AddExtensionOption("experimental_s3_tables_global_proxy",
                                   "Experimental - Global proxy to interact with S3 Tables", LogicalType::VARCHAR,
                                   Value(""), callback_experimental_s3_tables_global_proxy);
+        config.AddExtensionOption("http_hedged_requests",
+                                  "Issue a duplicate range request if the original one misses the hedging deadline",
+                                  LogicalType::BOOLEAN, Value(false));
+        config.AddExtensionOption("http_hedge_percentile",
+                                  "The percentile of observed request latencies that is used as hedging deadline",
+                                  LogicalType::DOUBLE, Value::DOUBLE(0.95));
+        config.AddExtensionOption("http_hedge_min_delay_ms", "The minimum hedging deadline in milliseconds",
+                                  LogicalType::UBIGINT, Value::UBIGINT(10));
+        config.AddExtensionOption("http_request_trace_size",
+                                  "The number of HTTP requests that are retained for http_requests() (0 disables)",
+                                  LogicalType::UBIGINT, Value::UBIGINT(HTTPRequestTracer::DEFAULT_CAPACITY),
+                                  callback_http_request_trace_size);
+        config.AddExtensionOption("http_max_connections_per_host",
+                                  "The number of concurrent HTTP requests per host (0 disables the limit)",
+                                  LogicalType::UBIGINT,
+                                  Value::UBIGINT(HTTPRequestScheduler::DEFAULT_MAX_CONNECTIONS_PER_HOST),
+                                  callback_http_max_connections_per_host);
 
         webfs->IncrementCacheEpoch();
     }
@@ -943,6 +1667,12 @@ void WebDB::Disconnect(Connection* session) { connections_.erase(session); }
 
 /// Flush all file buffers
 void WebDB::FlushFiles() { file_page_buffer_->FlushFiles(); }
+/// Clear the HTTP range cache
+void WebDB::ClearHTTPCache() {
+    if (auto web_fs = io::WebFileSystem::Get()) web_fs->GetHTTPCache().Clear();
+}
+/// Clear the query result cache
+void WebDB::ClearResultCache() { result_cache_.Invalidate(); }
 /// Flush file by path
 void WebDB::FlushFile(std::string_view path) { file_page_buffer_->FlushFile(path); }
 
@@ -957,6 +1687,14 @@ arrow::Status WebDB::Open(std::string_view args_json) {
     DEBUG_TRACE();
     assert(config_ != nullptr);
     *config_ = WebDBConfig::ReadFrom(args_json);
+    if (auto web_fs = io::WebFileSystem::Get()) {
+        HTTPCacheConfig cache_config;
+        cache_config.max_bytes = config_->filesystem.http_cache_bytes.value_or(cache_config.max_bytes);
+        cache_config.max_age =
+            std::chrono::milliseconds{config_->filesystem.http_cache_max_age_ms.value_or(cache_config.max_age.count())};
+        web_fs->GetHTTPCache().Configure(cache_config);
+    }
+    result_cache_.Configure(config_->query.result_cache_bytes.value_or(0));
     bool in_memory = config_->path == ":memory:" || config_->path == "";
     AccessMode access_mode = in_memory ? AccessMode::AUTOMATIC : AccessMode::READ_ONLY;
     if (config_->access_mode.has_value()) {
@@ -986,6 +1724,7 @@ arrow::Status WebDB::Open(std::string_view args_json) {
 #endif
 #endif  // WASM_LOADABLE_EXTENSIONS
         RegisterCustomExtensionOptions(db);
+        RegisterHTTPRequestsFunction(*db->instance);
 
         auto& config = duckdb::DBConfig::GetConfig(*db->instance);
         if (!config.http_util || config.http_util->GetName() != string("WasmHTTPUtils")) {
@@ -1037,6 +1776,7 @@ arrow::Status WebDB::RegisterFileURL(std::string_view file_name, std::string_vie
         .force_direct_io = direct_io,
     };
     buffered_filesystem_->RegisterFile(file_name, file_config);
+    result_cache_.Invalidate();
     return arrow::Status::OK();
 }
 /// Register a file URL
@@ -1065,10 +1805,12 @@ arrow::Status WebDB::RegisterFileBuffer(std::string_view file_name, std::unique_
     buffered_filesystem_->RegisterFile(file_name, file_config);
     // Pin the file handle to keep the file alive
     pinned_web_files_.insert({file_hdl->GetName(), std::move(file_hdl)});
+    result_cache_.Invalidate();
     return arrow::Status::OK();
 }
 /// Drop all files
 arrow::Status WebDB::DropFiles() {
+    result_cache_.Invalidate();
     file_page_buffer_->DropDanglingFiles();
     std::vector<std::string> files_to_drop;
     for (const auto& [key, handle] : pinned_web_files_) {
@@ -1087,6 +1829,7 @@ arrow::Status WebDB::DropFiles() {
 }
 /// Drop a file
 arrow::Status WebDB::DropFile(std::string_view fileName) {
+    result_cache_.Invalidate();
     file_page_buffer_->TryDropFile(fileName);
     pinned_web_files_.erase(fileName);
     if (auto fs = io::WebFileSystem::Get()) {
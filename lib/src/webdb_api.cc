@@ -65,6 +65,16 @@ void duckdb_web_flush_files() {
     GET_WEBDB_OR_RETURN();
     webdb.FlushFiles();
 }
+/// Clear the HTTP range cache
+void duckdb_web_clear_http_cache() {
+    GET_WEBDB_OR_RETURN();
+    webdb.ClearHTTPCache();
+}
+/// Clear the query result cache
+void duckdb_web_clear_result_cache() {
+    GET_WEBDB_OR_RETURN();
+    webdb.ClearResultCache();
+}
 /// Flush file buffer by path
 void duckdb_web_flush_file(const char* path) {
     GET_WEBDB_OR_RETURN();
@@ -213,6 +223,13 @@ void duckdb_web_prepared_send(WASMResponse* packed, ConnectionHdl connHdl, size_
     auto r = c->SendPreparedStatement(statement_id, args_json);
     WASMResponseBuffer::Get().Store(*packed, std::move(r));
 }
+/// Execute a prepared statement once per row of an Arrow IPC stream and fully materialize the result
+void duckdb_web_prepared_run_batch(WASMResponse* packed, ConnectionHdl connHdl, size_t statement_id,
+                                   const uint8_t* buffer, size_t buffer_length) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->RunPreparedStatementBatch(statement_id, nonstd::span{buffer, buffer_length});
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
 /// Run a query
 void duckdb_web_query_run(WASMResponse* packed, ConnectionHdl connHdl, const char* script) {
     auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
@@ -260,6 +277,116 @@ void duckdb_web_query_fetch_results(WASMResponse* packed, ConnectionHdl connHdl)
     auto r = c->FetchQueryResults();
     WASMResponseBuffer::Get().Store(*packed, r);
 }
+/// Start a pending query with its own query handle, stores the handle identifier
+void duckdb_web_query_handle_start(WASMResponse* packed, ConnectionHdl connHdl, const uint8_t* buffer,
+                                   size_t buffer_length, bool allow_stream_result) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    std::string_view S(reinterpret_cast<const char*>(buffer), buffer_length);
+    auto r = c->StartPendingQuery(S, allow_stream_result);
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Poll the pending query of a query handle
+void duckdb_web_query_handle_poll(WASMResponse* packed, ConnectionHdl connHdl, size_t query_id) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->PollPendingQuery(query_id);
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Cancel the pending query of a query handle
+bool duckdb_web_query_handle_cancel(ConnectionHdl connHdl, size_t query_id) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    return c->CancelPendingQuery(query_id);
+}
+/// Fetch query results of a query handle
+void duckdb_web_query_handle_fetch_results(WASMResponse* packed, ConnectionHdl connHdl, size_t query_id) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->FetchQueryResults(query_id);
+    WASMResponseBuffer::Get().Store(*packed, r);
+}
+/// Close a query handle
+void duckdb_web_query_handle_close(WASMResponse* packed, ConnectionHdl connHdl, size_t query_id) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->CloseQueryHandle(query_id);
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Run a query and export the result as Arrow C stream, stores the address of the stream
+void duckdb_web_query_export(WASMResponse* packed, ConnectionHdl connHdl, const char* script) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto stream = std::make_unique<ArrowArrayStream>();
+    stream->release = nullptr;
+    auto status = c->ExportQuery(script, stream.get());
+    if (!status.ok()) {
+        WASMResponseBuffer::Get().Store(*packed, std::move(status));
+        return;
+    }
+    WASMResponseBuffer::Get().Store(*packed, arrow::Result<size_t>{reinterpret_cast<size_t>(stream.release())});
+}
+/// Run a query and spill the materialized result, stores the result identifier
+void duckdb_web_spilled_result_create(WASMResponse* packed, ConnectionHdl connHdl, const char* script) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->SpillQuery(script);
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Get the number of rows of a spilled result
+void duckdb_web_spilled_result_row_count(WASMResponse* packed, ConnectionHdl connHdl, size_t result_id) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->GetSpilledResultRowCount(result_id);
+    if (!r.ok()) {
+        WASMResponseBuffer::Get().Store(*packed, r.status());
+        return;
+    }
+    WASMResponseBuffer::Get().Store(*packed, arrow::Result<double>{static_cast<double>(*r)});
+}
+/// Fetch a row range of a spilled result
+void duckdb_web_spilled_result_fetch(WASMResponse* packed, ConnectionHdl connHdl, size_t result_id, double offset,
+                                     double limit) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->FetchSpilledResultRange(result_id, offset, limit);
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Close a spilled result
+void duckdb_web_spilled_result_close(WASMResponse* packed, ConnectionHdl connHdl, size_t result_id) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->CloseSpilledResult(result_id);
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Get the schema of an exported Arrow C stream, stores the address of the schema
+void duckdb_web_arrow_stream_schema(WASMResponse* packed, ArrowArrayStream* stream) {
+    auto schema = std::make_unique<ArrowSchema>();
+    schema->release = nullptr;
+    if (stream->get_schema(stream, schema.get()) != 0) {
+        auto error = stream->get_last_error(stream);
+        WASMResponseBuffer::Get().Store(*packed, arrow::Status::ExecutionError(error ? error : "get_schema failed"));
+        return;
+    }
+    WASMResponseBuffer::Get().Store(*packed, arrow::Result<size_t>{reinterpret_cast<size_t>(schema.release())});
+}
+/// Get the next array of an exported Arrow C stream, stores the address of the array or 0 at the end
+void duckdb_web_arrow_stream_next(WASMResponse* packed, ArrowArrayStream* stream) {
+    auto array = std::make_unique<ArrowArray>();
+    array->release = nullptr;
+    if (stream->get_next(stream, array.get()) != 0) {
+        auto error = stream->get_last_error(stream);
+        WASMResponseBuffer::Get().Store(*packed, arrow::Status::ExecutionError(error ? error : "get_next failed"));
+        return;
+    }
+    size_t address = array->release ? reinterpret_cast<size_t>(array.release()) : 0;
+    WASMResponseBuffer::Get().Store(*packed, arrow::Result<size_t>{address});
+}
+/// Release an exported Arrow C stream
+void duckdb_web_arrow_stream_release(ArrowArrayStream* stream) {
+    if (stream->release) stream->release(stream);
+    delete stream;
+}
+/// Release an exported Arrow schema
+void duckdb_web_arrow_schema_release(ArrowSchema* schema) {
+    if (schema->release) schema->release(schema);
+    delete schema;
+}
+/// Release an exported Arrow array
+void duckdb_web_arrow_array_release(ArrowArray* array) {
+    if (array->release) array->release(array);
+    delete array;
+}
 /// Get table names
 void duckdb_web_get_tablenames(WASMResponse* packed, ConnectionHdl connHdl, const char* query) {
     auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
@@ -281,6 +408,27 @@ void duckdb_web_insert_arrow_from_ipc_stream(WASMResponse* packed, ConnectionHdl
     auto r = c->InsertArrowFromIPCStream(nonstd::span{buffer, buffer_length}, std::string_view{options});
     WASMResponseBuffer::Get().Store(*packed, std::move(r));
 }
+/// Insert arrow from an ipc stream buffer, takes ownership of the buffer
+void duckdb_web_insert_arrow_from_ipc_buffer(WASMResponse* packed, ConnectionHdl connHdl, uint8_t* buffer,
+                                             size_t buffer_length, const char* options) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto buffer_ptr = std::unique_ptr<char[]>(reinterpret_cast<char*>(buffer));
+    auto r = c->InsertArrowFromIPCBuffer(std::move(buffer_ptr), buffer_length, std::string_view{options});
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Abort a pending arrow ipc stream insert
+void duckdb_web_abort_arrow_ipc_stream(WASMResponse* packed, ConnectionHdl connHdl) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->AbortArrowIPCStream();
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
+/// Insert arrow from an ipc file
+void duckdb_web_insert_arrow_from_ipc_file(WASMResponse* packed, ConnectionHdl connHdl, const char* path,
+                                           const char* options) {
+    auto c = reinterpret_cast<WebDB::Connection*>(connHdl);
+    auto r = c->InsertArrowFromIPCFile(std::string_view{path}, std::string_view{options});
+    WASMResponseBuffer::Get().Store(*packed, std::move(r));
+}
 /// Insert csv from a file
 void duckdb_web_insert_csv_from_path(WASMResponse* packed, ConnectionHdl connHdl, const char* path,
                                      const char* options) {
@@ -0,0 +1,104 @@
+#include "duckdb/web/arrow_cast_kernels.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+
+namespace {
+
+/// Values around the word boundaries and the double precision limits
+std::vector<int64_t> GetEdgeValues() {
+    std::vector<int64_t> values{0,
+                                1,
+                                -1,
+                                42,
+                                -42,
+                                0xFFFFFFFFll,
+                                0x100000000ll,
+                                -0x100000000ll,
+                                (1ll << 53) - 1,
+                                (1ll << 53) + 1,
+                                -(1ll << 53) - 1,
+                                (1ll << 62) + 12345,
+                                std::numeric_limits<int64_t>::max(),
+                                std::numeric_limits<int64_t>::max() - 511,
+                                std::numeric_limits<int64_t>::min(),
+                                std::numeric_limits<int64_t>::min() + 1};
+    // Odd lengths cover the scalar tail of the vectorized loops
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < 1001; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values.push_back(static_cast<int64_t>(state) >> (i % 64));
+    }
+    return values;
+}
+
+TEST(ArrowCastKernels, Int64ToDouble) {
+    auto values = GetEdgeValues();
+    std::vector<double> out(values.size());
+    kernels::CastInt64ToDouble(values.data(), out.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(out[i], static_cast<double>(values[i])) << values[i];
+    }
+}
+
+TEST(ArrowCastKernels, UInt64ToDouble) {
+    auto signed_values = GetEdgeValues();
+    std::vector<uint64_t> values{signed_values.begin(), signed_values.end()};
+    values.push_back(std::numeric_limits<uint64_t>::max());
+    std::vector<double> out(values.size());
+    kernels::CastUInt64ToDouble(values.data(), out.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(out[i], static_cast<double>(values[i])) << values[i];
+    }
+}
+
+TEST(ArrowCastKernels, ScaleInt64) {
+    std::vector<int64_t> values{0, 1, -1, 999, -999, 1000, -1000, 1999999, -1999999, 1234567890123};
+    std::vector<int64_t> out(values.size());
+    for (auto [multiplier, divisor] : std::vector<std::pair<int64_t, int64_t>>{
+             {1, 1}, {1, 1000}, {1, 1000 * 1000}, {1, 7}, {1000, 1}, {86400000, 1}, {1000, 3}}) {
+        kernels::ScaleInt64(values.data(), out.data(), values.size(), multiplier, divisor);
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_EQ(out[i], values[i] * multiplier / divisor) << multiplier << "/" << divisor;
+        }
+    }
+}
+
+TEST(ArrowCastKernels, DecimalToDouble) {
+    std::vector<int16_t> d16{0, 15, -15, 9999, -9999};
+    std::vector<int32_t> d32{0, 15, -15, 999999999, -999999999};
+    std::vector<int64_t> d64{0, 15, -15, 999999999999999999ll, -999999999999999999ll};
+    std::vector<double> out16(d16.size()), out32(d32.size()), out64(d64.size());
+    kernels::CastDecimalToDouble(d16.data(), out16.data(), d16.size(), 1);
+    kernels::CastDecimalToDouble(d32.data(), out32.data(), d32.size(), 1);
+    kernels::CastDecimalToDouble(d64.data(), out64.data(), d64.size(), 1);
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(out16[i], out32[i]);
+        ASSERT_EQ(out16[i], out64[i]);
+    }
+    ASSERT_EQ(out16[1], 1.5);
+    ASSERT_EQ(out64[4], -99999999999999999.9);
+
+    // 128 bit values that fit into 64 bits convert like the narrower decimals
+    std::vector<uint64_t> d128;
+    for (auto v : d64) {
+        d128.push_back(static_cast<uint64_t>(v));
+        d128.push_back(v < 0 ? ~0ull : 0);
+    }
+    // 2^64 and -2^64
+    d128.insert(d128.end(), {0, 1, 0, ~0ull});
+    std::vector<double> out128(d128.size() / 2);
+    kernels::CastDecimal128ToDouble(d128.data(), out128.data(), out128.size(), 1);
+    for (size_t i = 0; i < d64.size(); ++i) {
+        ASSERT_EQ(out128[i], out64[i]);
+    }
+    ASSERT_EQ(out128[5], 18446744073709551616.0 / 10);
+    ASSERT_EQ(out128[6], -18446744073709551616.0 / 10);
+}
+
+}  // namespace
@@ -2,7 +2,10 @@
 
 #include <duckdb/common/types.hpp>
 
+#include "arrow/array/builder_decimal.h"
+#include "arrow/array/builder_primitive.h"
 #include "arrow/c/bridge.h"
+#include "arrow/util/decimal.h"
 #include "arrow/status.h"
 #include "duckdb/common/arrow/arrow_converter.hpp"
 #include "duckdb/web/io/file_page_buffer.h"
@@ -105,4 +108,48 @@ TEST(ArrowCasts, PatchTimestamp) {
     ASSERT_EQ(patched->column(0)->type_id(), arrow::Type::DATE64);
 }
 
+TEST(ArrowCasts, PlanRecordBatchCasts) {
+    QueryConfig config;
+    config.cast_bigint_to_double = true;
+    config.cast_timestamp_to_date = true;
+    auto schema = arrow::schema({arrow::field("a", arrow::int32()), arrow::field("b", arrow::int64()),
+                                 arrow::field("c", arrow::timestamp(arrow::TimeUnit::NANO)),
+                                 arrow::field("d", arrow::decimal128(18, 3))});
+    auto patched_schema = patchSchema(schema, config);
+    auto casts = planRecordBatchCasts(*schema, patched_schema, config);
+    ASSERT_TRUE(casts.any);
+    ASSERT_EQ(casts.schema, patched_schema);
+    ASSERT_EQ(casts.columns.size(), 4);
+    ASSERT_EQ(casts.columns[0].kind, ColumnCast::Kind::NONE);
+    ASSERT_EQ(casts.columns[1].kind, ColumnCast::Kind::INT64_TO_DOUBLE);
+    ASSERT_EQ(casts.columns[2].kind, ColumnCast::Kind::SCALE_INT64);
+    ASSERT_EQ(casts.columns[2].divisor, 1000 * 1000);
+    ASSERT_EQ(casts.columns[3].kind, ColumnCast::Kind::NONE);
+
+    // Sliced batches keep their offsets
+    arrow::Int32Builder a;
+    ASSERT_TRUE(a.AppendValues({1, 2, 3}).ok());
+    arrow::Int64Builder b;
+    ASSERT_TRUE(b.AppendValues({-1, 1ll << 60, 42}).ok());
+    arrow::TimestampBuilder c{arrow::timestamp(arrow::TimeUnit::NANO), arrow::default_memory_pool()};
+    ASSERT_TRUE(c.AppendValues({0, 86400000000000ll, 2 * 86400000000000ll}).ok());
+    arrow::Decimal128Builder d{arrow::decimal128(18, 3)};
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(d.Append(arrow::Decimal128(i)).ok());
+    auto batch = arrow::RecordBatch::Make(schema, 3,
+                                          {a.Finish().ValueOrDie(), b.Finish().ValueOrDie(), c.Finish().ValueOrDie(),
+                                           d.Finish().ValueOrDie()})
+                     ->Slice(1);
+    auto patched = patchRecordBatch(batch, casts).ValueOrDie();
+    ASSERT_TRUE(patched->ValidateFull().ok());
+    ASSERT_EQ(std::static_pointer_cast<arrow::DoubleArray>(patched->column(1))->Value(0),
+              static_cast<double>(1ll << 60));
+    ASSERT_EQ(std::static_pointer_cast<arrow::Date64Array>(patched->column(2))->Value(1), 2 * 86400000ll);
+    ASSERT_EQ(patched->column(3), batch->column(3));
+
+    // Results without casts are passed through
+    auto no_casts = planRecordBatchCasts(*schema, schema, QueryConfig{});
+    ASSERT_FALSE(no_casts.any);
+    ASSERT_EQ(patchRecordBatch(batch, no_casts).ValueOrDie(), batch);
+}
+
 }  // namespace
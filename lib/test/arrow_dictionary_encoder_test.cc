@@ -0,0 +1,165 @@
+#include "duckdb/web/arrow_dictionary_encoder.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array/array_dict.h"
+#include "arrow/array/builder_binary.h"
+#include "arrow/c/bridge.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/table.h"
+#include "duckdb/common/arrow/arrow_converter.hpp"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+
+namespace {
+
+/// A query with low-cardinality, null, constant and high-cardinality strings
+constexpr const char* QUERY = R"SQL(
+    SELECT v,
+           (['red', 'green', 'blue'])[v % 3 + 1] AS color,
+           CASE WHEN v % 7 = 0 THEN NULL ELSE 'status ' || (v % 5) END AS status,
+           'constant' AS c,
+           'row ' || v AS id
+    FROM range(10000) t(v)
+)SQL";
+
+/// Open a database that dictionary-encodes strings
+std::shared_ptr<WebDB> OpenDictionaryDB() {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    auto status = db->Open(R"JSON({"query": {"dictionaryEncodeStrings": true}})JSON");
+    EXPECT_TRUE(status.ok()) << status.message();
+    return db;
+}
+
+/// Stream a query and collect the concatenated IPC stream and the buffer sizes
+std::shared_ptr<arrow::Buffer> StreamQuery(WebDB::Connection& conn, const std::string& query,
+                                           std::vector<int64_t>& buffer_sizes) {
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto schema_buffer = conn.PendingQuery(query, true);
+    EXPECT_TRUE(schema_buffer.ok()) << schema_buffer.status().message();
+    while (*schema_buffer == nullptr) schema_buffer = conn.PollPendingQuery();
+    EXPECT_TRUE(out->Write(*schema_buffer).ok());
+    while (true) {
+        auto chunk = conn.FetchQueryResults();
+        if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+        EXPECT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+        if (!chunk.arrow_buffer.ok() || *chunk.arrow_buffer == nullptr) break;
+        buffer_sizes.push_back((*chunk.arrow_buffer)->size());
+        EXPECT_TRUE(out->Write(*chunk.arrow_buffer).ok());
+    }
+    return out->Finish().ValueOrDie();
+}
+
+/// Decode the dictionary columns of a table
+std::shared_ptr<arrow::Table> DecodeDictionaries(const std::shared_ptr<arrow::Table>& table) {
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (int i = 0; i < table->num_columns(); ++i) {
+        auto column = table->column(i);
+        auto field = table->schema()->field(i);
+        if (field->type()->id() == arrow::Type::DICTIONARY) {
+            arrow::ArrayVector chunks;
+            for (auto& chunk : column->chunks()) {
+                auto dictionary = std::static_pointer_cast<arrow::DictionaryArray>(chunk);
+                arrow::StringBuilder builder;
+                auto values = std::static_pointer_cast<arrow::StringArray>(dictionary->dictionary());
+                for (int64_t j = 0; j < dictionary->length(); ++j) {
+                    if (dictionary->IsNull(j)) {
+                        EXPECT_TRUE(builder.AppendNull().ok());
+                    } else {
+                        EXPECT_TRUE(builder.Append(values->GetView(dictionary->GetValueIndex(j))).ok());
+                    }
+                }
+                chunks.push_back(builder.Finish().ValueOrDie());
+            }
+            column = std::make_shared<arrow::ChunkedArray>(chunks, arrow::utf8());
+            field = field->WithType(arrow::utf8());
+        }
+        columns.push_back(column);
+        fields.push_back(field);
+    }
+    return arrow::Table::Make(arrow::schema(fields), columns);
+}
+
+/// Read an IPC stream
+std::shared_ptr<arrow::Table> ReadStream(const std::shared_ptr<arrow::Buffer>& buffer) {
+    arrow::io::BufferReader reader{buffer};
+    auto stream = arrow::ipc::RecordBatchStreamReader::Open(&reader).ValueOrDie();
+    return stream->ToTable().ValueOrDie();
+}
+
+/// Read an IPC file
+std::shared_ptr<arrow::Table> ReadFile(const std::shared_ptr<arrow::Buffer>& buffer) {
+    arrow::io::BufferReader reader{buffer};
+    auto file = arrow::ipc::RecordBatchFileReader::Open(&reader).ValueOrDie();
+    arrow::RecordBatchVector batches;
+    for (int i = 0; i < file->num_record_batches(); ++i) {
+        batches.push_back(file->ReadRecordBatch(i).ValueOrDie());
+    }
+    return arrow::Table::FromRecordBatches(file->schema(), batches).ValueOrDie();
+}
+
+TEST(ArrowDictionaryEncoderTest, StreamedResults) {
+    auto plain_db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection plain_conn{*plain_db};
+    std::vector<int64_t> plain_sizes;
+    auto expected = ReadStream(StreamQuery(plain_conn, QUERY, plain_sizes));
+
+    auto db = OpenDictionaryDB();
+    WebDB::Connection conn{*db};
+    std::vector<int64_t> sizes;
+    auto table = ReadStream(StreamQuery(conn, QUERY, sizes));
+    ASSERT_TRUE(table->ValidateFull().ok());
+    for (auto* name : {"color", "status", "c", "id"}) {
+        ASSERT_EQ(table->schema()->GetFieldByName(name)->type()->id(), arrow::Type::DICTIONARY) << name;
+    }
+
+    // The dictionary grows with deltas and keeps the low-cardinality values once
+    auto colors = std::static_pointer_cast<arrow::DictionaryArray>(table->GetColumnByName("color")->chunks().back());
+    ASSERT_EQ(colors->dictionary()->length(), 3);
+    // The distinct ids fall back to a dictionary per batch
+    auto ids = std::static_pointer_cast<arrow::DictionaryArray>(table->GetColumnByName("id")->chunks().back());
+    ASSERT_EQ(ids->dictionary()->length(), ids->length());
+    ASSERT_GT(sizes.size(), 1);
+    ASSERT_LT(sizes.back(), sizes.front());
+
+    auto decoded = DecodeDictionaries(table);
+    ASSERT_TRUE(decoded->Equals(*expected)) << decoded->ToString() << "\n" << expected->ToString();
+}
+
+TEST(ArrowDictionaryEncoderTest, MaterializedResults) {
+    auto plain_db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection plain_conn{*plain_db};
+    auto expected = ReadFile(plain_conn.RunQuery(QUERY).ValueOrDie());
+
+    auto db = OpenDictionaryDB();
+    WebDB::Connection conn{*db};
+    auto buffer = conn.RunQuery(QUERY);
+    ASSERT_TRUE(buffer.ok()) << buffer.status().message();
+    auto table = ReadFile(*buffer);
+    ASSERT_TRUE(table->ValidateFull().ok());
+    ASSERT_EQ(table->schema()->GetFieldByName("color")->type()->id(), arrow::Type::DICTIONARY);
+    // The distinct ids are written as plain strings
+    ASSERT_EQ(table->schema()->GetFieldByName("id")->type()->id(), arrow::Type::STRING);
+
+    auto decoded = DecodeDictionaries(table);
+    ASSERT_TRUE(decoded->Equals(*expected)) << decoded->ToString() << "\n" << expected->ToString();
+}
+
+TEST(ArrowDictionaryEncoderTest, NoStringColumns) {
+    auto db = OpenDictionaryDB();
+    WebDB::Connection conn{*db};
+    auto result = conn.connection().Query("SELECT 1::INTEGER AS a, [('x')] AS l");
+    ArrowSchema raw_schema;
+    duckdb::ClientProperties options;
+    duckdb::ArrowConverter::ToArrowSchema(&raw_schema, result->types, result->names, options);
+    auto schema = arrow::ImportSchema(&raw_schema).ValueOrDie();
+    ASSERT_EQ(ArrowDictionaryEncoder::Create(result->types, *schema), nullptr);
+}
+
+}  // namespace
@@ -0,0 +1,200 @@
+#include "duckdb/web/arrow_ipc_encoder.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/c/bridge.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/record_batch.h"
+#include "duckdb/common/arrow/arrow_converter.hpp"
+#include "duckdb/web/arrow_casts.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+
+namespace {
+
+/// A query that covers all supported column types, nulls and non-flat vectors
+constexpr const char* QUERY = R"SQL(
+    SELECT v % 2 = 0 AS b,
+           (v % 100)::TINYINT AS i8,
+           (v * 7)::SMALLINT AS i16,
+           CASE WHEN v % 5 = 0 THEN NULL ELSE v::INTEGER END AS i32,
+           v::BIGINT * 1000 AS i64,
+           (v % 200)::UTINYINT AS u8,
+           v::UBIGINT AS u64,
+           v::FLOAT / 4 AS f32,
+           v::DOUBLE / 3 AS f64,
+           DATE '2020-01-01' + v::INTEGER AS d,
+           TIME '10:00:00' + v * INTERVAL 1 SECOND AS t,
+           TIMESTAMP '2020-01-01' + v * INTERVAL 1 SECOND AS ts,
+           CASE WHEN v % 3 = 0 THEN NULL ELSE 'row ' || v END AS s,
+           'constant' AS c,
+           ('blob' || v)::BLOB AS bl
+    FROM range(3000) t(v)
+)SQL";
+
+/// Export a chunk with the generic Arrow export
+std::shared_ptr<arrow::RecordBatch> ExportGeneric(duckdb::DataChunk& chunk, const std::shared_ptr<arrow::Schema>& schema,
+                                                  const std::shared_ptr<arrow::Schema>& patched_schema,
+                                                  const QueryConfig& config, duckdb::ClientProperties& options) {
+    ArrowArray array;
+    duckdb::ArrowConverter::ToArrowArray(chunk, &array, options);
+    auto batch = arrow::ImportRecordBatch(&array, schema).ValueOrDie();
+    return patchRecordBatch(batch, patched_schema, config).ValueOrDie();
+}
+
+/// Export all chunks of a query with both exports and compare them
+void CompareExports(const std::string& query, const QueryConfig& config) {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    auto result = conn.connection().Query(query);
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+
+    ArrowSchema raw_schema;
+    duckdb::ClientProperties options;
+    options.arrow_offset_size = duckdb::ArrowOffsetSize::REGULAR;
+    duckdb::ArrowConverter::ToArrowSchema(&raw_schema, result->types, result->names, options);
+    auto schema = arrow::ImportSchema(&raw_schema).ValueOrDie();
+    auto patched_schema = patchSchema(schema, config);
+    auto encoder = ArrowIPCEncoder::Create(result->types, *patched_schema);
+    ASSERT_NE(encoder, nullptr) << patched_schema->ToString();
+
+    size_t chunks = 0;
+    for (auto chunk = result->Fetch(); !!chunk && chunk->size() > 0; chunk = result->Fetch(), ++chunks) {
+        auto message = encoder->Encode(*chunk);
+        ASSERT_TRUE(message.ok()) << message.status().message();
+        arrow::io::BufferReader reader{message->GetMessage()};
+        auto ipc_message = arrow::ipc::ReadMessage(&reader).ValueOrDie();
+        arrow::ipc::DictionaryMemo memo;
+        auto encoded = arrow::ipc::ReadRecordBatch(*ipc_message, patched_schema, &memo,
+                                                   arrow::ipc::IpcReadOptions::Defaults())
+                           .ValueOrDie();
+        ASSERT_TRUE(encoded->Validate().ok());
+
+        auto expected = ExportGeneric(*chunk, schema, patched_schema, config, options);
+        ASSERT_TRUE(encoded->Equals(*expected)) << "encoded:\n"
+                                                << encoded->ToString() << "\nexpected:\n"
+                                                << expected->ToString();
+    }
+    ASSERT_GT(chunks, 1);
+}
+
+TEST(ArrowIPCEncoderTest, MatchesGenericExport) {
+    QueryConfig config;
+    CompareExports(QUERY, config);
+}
+
+TEST(ArrowIPCEncoderTest, MatchesGenericExportWithCasts) {
+    QueryConfig config;
+    config.cast_bigint_to_double = true;
+    config.cast_timestamp_to_date = true;
+    CompareExports(QUERY, config);
+    CompareExports("SELECT range::TIMESTAMP_S AS s, range::TIMESTAMP_MS AS ms, range::TIMESTAMP_NS AS ns "
+                   "FROM (SELECT TIMESTAMP '2020-01-01' + range * INTERVAL 1 HOUR AS range FROM range(5000))",
+                   config);
+    config.cast_decimal_to_double = true;
+    CompareExports("SELECT (v - 1500)::DECIMAL(4,1) / 10 AS d16, (v * 7)::DECIMAL(9,3) / 7 AS d32, "
+                   "CASE WHEN v % 4 = 0 THEN NULL ELSE (v * 1001)::DECIMAL(18,6) END AS d64, "
+                   "(v::HUGEINT * 1000000000000000000)::DECIMAL(38,10) AS d128 FROM range(3000) t(v)",
+                   config);
+}
+
+TEST(ArrowIPCEncoderTest, UnsupportedTypes) {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    for (auto query : {"SELECT 1.5::DECIMAL(4,1)", "SELECT [1, 2]", "SELECT {'a': 1}", "SELECT INTERVAL 1 DAY"}) {
+        auto result = conn.connection().Query(query);
+        ArrowSchema raw_schema;
+        duckdb::ClientProperties options;
+        duckdb::ArrowConverter::ToArrowSchema(&raw_schema, result->types, result->names, options);
+        auto schema = arrow::ImportSchema(&raw_schema).ValueOrDie();
+        ASSERT_EQ(ArrowIPCEncoder::Create(result->types, *schema), nullptr) << query;
+    }
+}
+
+TEST(ArrowIPCEncoderTest, QueryResults) {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+
+    // Materialized results are written as IPC file
+    auto buffer = conn.RunQuery(QUERY);
+    ASSERT_TRUE(buffer.ok()) << buffer.status().message();
+    arrow::io::BufferReader file{*buffer};
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(&file).ValueOrDie();
+    int64_t rows = 0;
+    for (int i = 0; i < reader->num_record_batches(); ++i) {
+        auto batch = reader->ReadRecordBatch(i).ValueOrDie();
+        ASSERT_TRUE(batch->ValidateFull().ok());
+        rows += batch->num_rows();
+    }
+    ASSERT_EQ(rows, 3000);
+
+    // Streamed results are written as IPC messages
+    auto schema_buffer = conn.PendingQuery(QUERY, true);
+    ASSERT_TRUE(schema_buffer.ok()) << schema_buffer.status().message();
+    while (*schema_buffer == nullptr) schema_buffer = conn.PollPendingQuery();
+    arrow::io::BufferReader schema_reader{*schema_buffer};
+    arrow::ipc::DictionaryMemo memo;
+    auto schema = arrow::ipc::ReadSchema(&schema_reader, &memo).ValueOrDie();
+    rows = 0;
+    while (true) {
+        auto chunk = conn.FetchQueryResults();
+        if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+        ASSERT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+        if (*chunk.arrow_buffer == nullptr) break;
+        arrow::io::BufferReader message_reader{*chunk.arrow_buffer};
+        auto message = arrow::ipc::ReadMessage(&message_reader).ValueOrDie();
+        auto batch =
+            arrow::ipc::ReadRecordBatch(*message, schema, &memo, arrow::ipc::IpcReadOptions::Defaults()).ValueOrDie();
+        ASSERT_TRUE(batch->ValidateFull().ok());
+        rows += batch->num_rows();
+    }
+    ASSERT_EQ(rows, 3000);
+}
+
+/// Stream a query and return the sizes of the record batches
+std::vector<int64_t> StreamBatchSizes(WebDB::Connection& conn, const std::string& query) {
+    std::vector<int64_t> sizes;
+    auto schema_buffer = conn.PendingQuery(query, true);
+    EXPECT_TRUE(schema_buffer.ok()) << schema_buffer.status().message();
+    while (*schema_buffer == nullptr) schema_buffer = conn.PollPendingQuery();
+    arrow::io::BufferReader schema_reader{*schema_buffer};
+    arrow::ipc::DictionaryMemo memo;
+    auto schema = arrow::ipc::ReadSchema(&schema_reader, &memo).ValueOrDie();
+    while (true) {
+        auto chunk = conn.FetchQueryResults();
+        if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+        EXPECT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+        if (!chunk.arrow_buffer.ok() || *chunk.arrow_buffer == nullptr) break;
+        arrow::io::BufferReader message_reader{*chunk.arrow_buffer};
+        auto message = arrow::ipc::ReadMessage(&message_reader).ValueOrDie();
+        auto batch =
+            arrow::ipc::ReadRecordBatch(*message, schema, &memo, arrow::ipc::IpcReadOptions::Defaults()).ValueOrDie();
+        EXPECT_TRUE(batch->ValidateFull().ok());
+        sizes.push_back(batch->num_rows());
+    }
+    return sizes;
+}
+
+TEST(ArrowIPCEncoderTest, CoalesceResultBatches) {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(R"JSON({"query": {"resultBatchRows": 10000, "queryPollingInterval": 60000}})JSON").ok());
+    WebDB::Connection conn{*db};
+
+    // Encoded and generic results are coalesced up to the target
+    for (auto query : {"SELECT v, 'row ' || v AS s FROM range(30000) t(v)",
+                       "SELECT v::DECIMAL(18,2) AS d, [v] AS l FROM range(30000) t(v)"}) {
+        auto sizes = StreamBatchSizes(conn, query);
+        int64_t rows = 0;
+        for (auto size : sizes) rows += size;
+        ASSERT_EQ(rows, 30000) << query;
+        ASSERT_GT(*std::max_element(sizes.begin(), sizes.end()), STANDARD_VECTOR_SIZE) << query;
+    }
+}
+
+}  // namespace
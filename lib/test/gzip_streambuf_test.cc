@@ -0,0 +1,164 @@
+#include "duckdb/web/io/gzip_streambuf.h"
+
+#include <istream>
+#include <sstream>
+#include <string>
+
+#include "duckdb/web/io/memory_filesystem.h"
+#include "duckdb/web/test/config.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace duckdb::web::test;
+
+namespace {
+
+/// Compress a buffer as a single gzip member
+std::string Gzip(std::string_view data) {
+    duckdb_miniz::mz_stream stream = {};
+    duckdb_miniz::mz_deflateInit2(&stream, duckdb_miniz::MZ_DEFAULT_COMPRESSION, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS,
+                                  9, duckdb_miniz::MZ_DEFAULT_STRATEGY);
+    std::string out{"\x1f\x8b\x08\x08\0\0\0\0\0\xff", 10};
+    out += "data.json";
+    out.push_back('\0');
+    std::string body(duckdb_miniz::mz_deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<const unsigned char*>(data.data());
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<unsigned char*>(body.data());
+    stream.avail_out = body.size();
+    duckdb_miniz::mz_deflate(&stream, duckdb_miniz::MZ_FINISH);
+    out.append(body.data(), body.size() - stream.avail_out);
+    duckdb_miniz::mz_deflateEnd(&stream);
+
+    auto crc = duckdb_miniz::mz_crc32(0, reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    for (auto value : {static_cast<uint32_t>(crc), static_cast<uint32_t>(data.size())}) {
+        for (unsigned i = 0; i < 4; ++i) out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+    return out;
+}
+
+/// Generate json rows
+std::string GenerateRows(size_t n) {
+    std::stringstream out;
+    out << "[";
+    for (size_t i = 0; i < n; ++i) {
+        out << (i == 0 ? "" : ",") << "\n{\"a\":" << i << ",\"b\":\"row " << i << "\"}";
+    }
+    out << "\n]";
+    return out.str();
+}
+
+/// Read the remaining data of a stream
+std::string ReadAll(std::streambuf& buffer) {
+    std::istream in{&buffer};
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+TEST(GzipInputStreamBuffer, Inflate) {
+    auto data = GenerateRows(10000);
+    ASSERT_GT(data.size(), 4 * io::GzipInputStreamBuffer::OUTPUT_BUFFER_SIZE);
+    std::stringbuf compressed{Gzip(data)};
+    io::GzipInputStreamBuffer buffer{compressed};
+    ASSERT_EQ(ReadAll(buffer), data);
+}
+
+TEST(GzipInputStreamBuffer, MultipleMembers) {
+    auto a = GenerateRows(100);
+    auto b = GenerateRows(5000);
+    // Trailing zeros are ignored just like gzip does
+    std::stringbuf compressed{Gzip(a) + Gzip("") + Gzip(b) + std::string(16, '\0')};
+    io::GzipInputStreamBuffer buffer{compressed};
+    ASSERT_EQ(ReadAll(buffer), a + b);
+}
+
+TEST(GzipInputStreamBuffer, SliceAndCopy) {
+    auto data = GenerateRows(10000);
+    std::stringbuf compressed{Gzip(data)};
+    io::GzipInputStreamBuffer buffer{compressed};
+
+    // Slices refer to uncompressed offsets
+    uint64_t offset = 3 * io::GzipInputStreamBuffer::OUTPUT_BUFFER_SIZE - 10;
+    buffer.Slice(offset, 100);
+    ASSERT_EQ(ReadAll(buffer), data.substr(offset, 100));
+    buffer.Slice(42, 0);
+    std::istream in{&buffer};
+    ASSERT_EQ(in.tellg(), 42);
+    std::string prefix(1000, '\0');
+    in.read(prefix.data(), prefix.size());
+    ASSERT_EQ(prefix, data.substr(42, 1000));
+
+    // A copy continues at the same position over its own source
+    std::stringbuf compressed_copy{compressed.str()};
+    io::GzipInputStreamBuffer copy{compressed_copy, buffer};
+    ASSERT_EQ(ReadAll(copy), data.substr(1042));
+    ASSERT_EQ(ReadAll(buffer), data.substr(1042));
+
+    // Seeking backwards restarts the inflater
+    in.clear();
+    in.seekg(7);
+    ASSERT_EQ(ReadAll(buffer), data.substr(7));
+}
+
+TEST(GzipInputStreamBuffer, Truncated) {
+    auto compressed_data = Gzip(GenerateRows(1000));
+    std::stringbuf compressed{compressed_data.substr(0, compressed_data.size() / 2)};
+    io::GzipInputStreamBuffer buffer{compressed};
+    std::string out(1 << 20, '\0');
+    ASSERT_THROW(buffer.sgetn(out.data(), out.size()), std::runtime_error);
+}
+
+TEST(GzipInputStreamBuffer, InsertJSON) {
+    auto rows = GenerateRows(10000);
+    auto columns = R"JSON({"a": [1, 2, 3], "b": ["x", "y", "z"]})JSON";
+    auto memory_filesystem = std::make_unique<io::MemoryFileSystem>();
+    for (auto& [name, data] : {std::pair{"rows.json.gz", Gzip(rows)}, std::pair{"columns.json.gz", Gzip(columns)}}) {
+        ASSERT_TRUE(memory_filesystem->RegisterFileBuffer(name, std::vector<char>{data.begin(), data.end()}).ok());
+    }
+    auto db = std::make_shared<WebDB>(NATIVE, std::move(memory_filesystem));
+    WebDB::Connection conn{*db};
+
+    auto status = conn.InsertJSONFromPath("rows.json.gz", R"JSON({"name": "rows"})JSON");
+    ASSERT_TRUE(status.ok()) << status.message();
+    auto result = conn.connection().Query("SELECT count(*), sum(a), max(b) FROM rows");
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {10000}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {49995000}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 2, {"row 9999"}));
+
+    status = conn.InsertJSONFromPath("columns.json.gz", R"JSON({"name": "columns"})JSON");
+    ASSERT_TRUE(status.ok()) << status.message();
+    result = conn.connection().Query("SELECT a, b FROM columns ORDER BY a");
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {1, 2, 3}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {"x", "y", "z"}));
+}
+
+TEST(GzipInputStreamBuffer, InsertColumnsJSON) {
+    // Every column spans several output windows
+    constexpr size_t NUM_COLUMNS = 8;
+    constexpr size_t NUM_ROWS = 20000;
+    std::stringstream columns;
+    columns << "{";
+    for (size_t c = 0; c < NUM_COLUMNS; ++c) {
+        columns << (c == 0 ? "" : ",") << "\n\"c" << c << "\": [";
+        for (size_t i = 0; i < NUM_ROWS; ++i) columns << (i == 0 ? "" : ",") << (i * NUM_COLUMNS + c);
+        columns << "]";
+    }
+    columns << "\n}";
+    auto data = Gzip(columns.str());
+    auto memory_filesystem = std::make_unique<io::MemoryFileSystem>();
+    auto status = memory_filesystem->RegisterFileBuffer("wide.json.gz", std::vector<char>{data.begin(), data.end()});
+    ASSERT_TRUE(status.ok());
+    auto db = std::make_shared<WebDB>(NATIVE, std::move(memory_filesystem));
+    WebDB::Connection conn{*db};
+
+    status = conn.InsertJSONFromPath("wide.json.gz", R"JSON({"name": "wide"})JSON");
+    ASSERT_TRUE(status.ok()) << status.message();
+    auto result = conn.connection().Query("SELECT count(*), sum(c0), min(c7 - c0), max(c7 - c0), max(c3) FROM wide");
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {static_cast<int64_t>(NUM_ROWS)}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {static_cast<int64_t>(NUM_COLUMNS * NUM_ROWS * (NUM_ROWS - 1) / 2)}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 2, {7}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 3, {7}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 4, {static_cast<int64_t>((NUM_ROWS - 1) * NUM_COLUMNS + 3)}));
+}
+
+}  // namespace
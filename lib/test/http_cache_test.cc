@@ -0,0 +1,189 @@
+#include "duckdb/web/http_cache.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "duckdb/web/extensions/parquet_extension.h"
+#include "duckdb/web/http_transport.h"
+#include "duckdb/web/io/web_filesystem.h"
+#include "duckdb/web/test/config.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace duckdb::web::test;
+using namespace std;
+
+namespace {
+
+constexpr const char* URL = "http://mock/data";
+
+/// Build a request
+HTTPTransportRequest MakeRequest(std::string method, std::string range = "") {
+    HTTPTransportRequest request;
+    request.method = std::move(method);
+    request.url = URL;
+    if (!range.empty()) request.headers.emplace_back("Range", std::move(range));
+    return request;
+}
+
+/// A mock transport behind a cache
+struct CachedMock {
+    std::shared_ptr<MockHTTPTransport> mock = std::make_shared<MockHTTPTransport>();
+    std::shared_ptr<HTTPRangeCache> cache = std::make_shared<HTTPRangeCache>();
+    CachingHTTPTransport transport{mock, cache};
+
+    CachedMock(HTTPCacheConfig config) {
+        cache->Configure(config);
+        mock->AddResource(URL, "0123456789");
+    }
+    /// Open the file and read two ranges
+    void ReadFile() {
+        ASSERT_EQ(transport.Send(MakeRequest("HEAD")).FindHeader("Content-Length"), "10");
+        ASSERT_EQ(transport.Send(MakeRequest("GET", "bytes=0-3")).body, "0123");
+        ASSERT_EQ(transport.Send(MakeRequest("GET", "bytes=4-9")).body, "456789");
+    }
+};
+
+TEST(HTTPRangeCacheTest, FreshResponses) {
+    CachedMock m{{.max_bytes = 1 << 20, .max_age = std::chrono::minutes{1}}};
+    m.ReadFile();
+    ASSERT_EQ(m.mock->GetRequestCount(), 3);
+    m.ReadFile();
+    ASSERT_EQ(m.mock->GetRequestCount(), 3);
+    ASSERT_EQ(m.cache->GetStatistics().hits, 3);
+    ASSERT_EQ(m.cache->GetEntryCount(), 3);
+}
+
+TEST(HTTPRangeCacheTest, Revalidation) {
+    CachedMock m{{.max_bytes = 1 << 20, .max_age = std::chrono::milliseconds{0}}};
+    m.ReadFile();
+    auto bytes = m.mock->GetBytesSent();
+    m.ReadFile();
+
+    // Every response was revalidated with a 304 Not Modified
+    ASSERT_EQ(m.mock->GetRequestCount(), 6);
+    ASSERT_EQ(m.mock->GetBytesSent(), bytes);
+    ASSERT_EQ(m.cache->GetStatistics().revalidations, 3);
+    ASSERT_EQ(m.cache->GetStatistics().hits, 0);
+}
+
+TEST(HTTPRangeCacheTest, ChangedObject) {
+    CachedMock m{{.max_bytes = 1 << 20, .max_age = std::chrono::milliseconds{0}}};
+    m.ReadFile();
+    m.mock->AddResource(URL, "abcdefghij");
+    ASSERT_EQ(m.transport.Send(MakeRequest("GET", "bytes=0-3")).body, "abcd");
+
+    // The responses of the old version are gone
+    ASSERT_EQ(m.cache->GetEntryCount(), 1);
+    ASSERT_EQ(m.transport.Send(MakeRequest("GET", "bytes=0-3")).body, "abcd");
+    ASSERT_EQ(m.cache->GetStatistics().revalidations, 1);
+}
+
+TEST(HTTPRangeCacheTest, Eviction) {
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource(URL, std::string(1000, 'x'));
+    auto cache = std::make_shared<HTTPRangeCache>();
+    cache->Configure({.max_bytes = 800, .max_age = std::chrono::minutes{1}});
+    CachingHTTPTransport transport{mock, cache};
+
+    transport.Send(MakeRequest("GET", "bytes=0-199"));
+    transport.Send(MakeRequest("GET", "bytes=200-399"));
+    transport.Send(MakeRequest("GET", "bytes=0-199"));
+    transport.Send(MakeRequest("GET", "bytes=400-599"));
+    ASSERT_LE(cache->GetSize(), 800);
+    ASSERT_EQ(cache->GetStatistics().evictions, 1);
+
+    // The least recently used range was evicted
+    auto requests = mock->GetRequestCount();
+    transport.Send(MakeRequest("GET", "bytes=0-199"));
+    ASSERT_EQ(mock->GetRequestCount(), requests);
+    transport.Send(MakeRequest("GET", "bytes=200-399"));
+    ASSERT_EQ(mock->GetRequestCount(), requests + 1);
+
+    // Responses that exceed the budget are not cached
+    transport.Send(MakeRequest("GET"));
+    ASSERT_LE(cache->GetSize(), 800);
+}
+
+TEST(HTTPRangeCacheTest, ClearAndWrites) {
+    CachedMock m{{.max_bytes = 1 << 20, .max_age = std::chrono::minutes{1}}};
+    m.ReadFile();
+    m.cache->Clear();
+    ASSERT_EQ(m.cache->GetSize(), 0);
+    m.ReadFile();
+    ASSERT_EQ(m.mock->GetRequestCount(), 6);
+
+    // Writes invalidate the url
+    m.transport.Send(MakeRequest("PUT"));
+    ASSERT_EQ(m.cache->GetEntryCount(), 0);
+
+    // Disabled cache forwards everything
+    m.cache->Configure({.max_bytes = 0, .max_age = std::chrono::minutes{1}});
+    m.ReadFile();
+    m.ReadFile();
+    ASSERT_EQ(m.mock->GetRequestCount(), 13);
+}
+
+TEST(HTTPRangeCacheTest, DisabledByDefault) {
+    HTTPRangeCache cache;
+    ASSERT_EQ(cache.GetConfig().max_bytes, 0);
+}
+
+TEST(HTTPRangeCacheTest, CredentialsBypassCache) {
+    CachedMock m{{.max_bytes = 1 << 20, .max_age = std::chrono::minutes{1}}};
+    for (auto header : {"Authorization", "Cookie", "x-amz-security-token"}) {
+        auto request = MakeRequest("GET", "bytes=0-3");
+        request.headers.emplace_back(header, "secret");
+        ASSERT_EQ(m.transport.Send(request).body, "0123");
+        ASSERT_EQ(m.transport.Send(request).body, "0123");
+    }
+    ASSERT_EQ(m.mock->GetRequestCount(), 6);
+    ASSERT_EQ(m.cache->GetEntryCount(), 0);
+
+    // A cached response is not served to a request with credentials
+    m.ReadFile();
+    auto request = MakeRequest("GET", "bytes=0-3");
+    request.headers.emplace_back("Authorization", "secret");
+    m.transport.Send(request);
+    ASSERT_EQ(m.mock->GetRequestCount(), 10);
+}
+
+TEST(HTTPRangeCacheTest, ReopenRemoteParquet) {
+    auto path = test::SOURCE_DIR / ".." / "data" / "uni" / "studenten.parquet";
+    std::ifstream in{path, std::ios::binary};
+    std::string data{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource("http://mock/studenten.parquet", data);
+
+    auto db = std::make_shared<WebDB>(WEB);
+    ASSERT_TRUE(db->Open(R"JSON({"filesystem": {"httpCacheBytes": 33554432, "httpCacheMaxAgeMs": 60000}})JSON").ok());
+    duckdb_web_parquet_init(&db->database());
+    io::WebFileSystem::Get()->SetHTTPTransport(mock);
+    WebDB::Connection conn{*db};
+
+    auto scan = [&]() {
+        ASSERT_TRUE(db->RegisterFileURL("studenten.parquet", "http://mock/studenten.parquet",
+                                        io::WebFileSystem::DataProtocol::HTTP, false)
+                        .ok());
+        auto result = conn.connection().Query("SELECT * FROM parquet_scan('studenten.parquet');");
+        ASSERT_TRUE(CHECK_COLUMN(*result, 0, {24002, 25403, 26120, 26830, 27550, 28106, 29120, 29555}));
+        result.reset();
+        ASSERT_TRUE(db->DropFile("studenten.parquet").ok());
+    };
+    scan();
+    auto requests = mock->GetRequestCount();
+    ASSERT_GT(requests, 0);
+    scan();
+    ASSERT_EQ(mock->GetRequestCount(), requests);
+
+    // Clearing the cache goes back to the network
+    db->ClearHTTPCache();
+    scan();
+    ASSERT_GT(mock->GetRequestCount(), requests);
+}
+
+}  // namespace
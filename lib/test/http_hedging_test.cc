@@ -0,0 +1,201 @@
+#include "duckdb/web/http_hedging.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "duckdb/web/test/config.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace duckdb::web::test;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Sleep until the delay passed or the request was cancelled
+static bool SleepUnlessCancelled(std::chrono::milliseconds delay, const std::atomic<bool>& cancelled) {
+    auto until = std::chrono::steady_clock::now() + delay;
+    while (std::chrono::steady_clock::now() < until) {
+        if (cancelled) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+static HTTPHedgingConfig EnabledConfig(uint64_t default_delay_ms) {
+    HTTPHedgingConfig config;
+    config.enabled = true;
+    config.min_delay_ms = 1;
+    config.default_delay_ms = default_delay_ms;
+    return config;
+}
+
+TEST(HTTPHedgingTest, LatencyPercentile) {
+    HTTPLatencyTracker tracker;
+    ASSERT_FALSE(tracker.ComputePercentile(0.5).has_value());
+    for (size_t i = 1; i <= 100; ++i) {
+        tracker.Record(std::chrono::microseconds{i});
+    }
+    ASSERT_EQ(tracker.GetSampleCount(), 100);
+    ASSERT_EQ(tracker.ComputePercentile(0.5)->count(), 50);
+    ASSERT_EQ(tracker.ComputePercentile(0.95)->count(), 95);
+    ASSERT_EQ(tracker.ComputePercentile(1.0)->count(), 100);
+
+    // Older latencies are forgotten
+    for (size_t i = 0; i < HTTPLatencyTracker::CAPACITY; ++i) {
+        tracker.Record(std::chrono::microseconds{1000});
+    }
+    ASSERT_EQ(tracker.GetSampleCount(), HTTPLatencyTracker::CAPACITY);
+    ASSERT_EQ(tracker.ComputePercentile(0.5)->count(), 1000);
+}
+
+TEST(HTTPHedgingTest, DeadlineFromLatencies) {
+    HTTPHedging hedging;
+    auto config = EnabledConfig(500);
+    ASSERT_EQ(hedging.ComputeDeadline(config), 500ms);
+    for (size_t i = 0; i < HTTPLatencyTracker::MIN_SAMPLES; ++i) {
+        hedging.GetLatencies().Record(20ms);
+    }
+    ASSERT_EQ(hedging.ComputeDeadline(config), 20ms);
+    config.min_delay_ms = 100;
+    ASSERT_EQ(hedging.ComputeDeadline(config), 100ms);
+}
+
+TEST(HTTPHedgingTest, Disabled) {
+    HTTPHedging hedging;
+    HTTPHedgingConfig config;
+    std::atomic<size_t> attempts = 0;
+    auto result = hedging.Run<int>(config, [&](const std::atomic<bool>&) {
+        ++attempts;
+        return 42;
+    });
+    ASSERT_EQ(result, 42);
+    ASSERT_EQ(attempts, 1);
+    ASSERT_EQ(hedging.GetStatistics().hedges_issued, 0);
+    ASSERT_EQ(hedging.GetLatencies().GetSampleCount(), 1);
+}
+
+TEST(HTTPHedgingTest, FastRequestIsNotHedged) {
+    HTTPHedging hedging;
+    auto attempts = std::make_shared<std::atomic<size_t>>(0);
+    auto result = hedging.Run<int>(EnabledConfig(1000), [attempts](const std::atomic<bool>&) {
+        ++*attempts;
+        return 1;
+    });
+    ASSERT_EQ(result, 1);
+    ASSERT_EQ(*attempts, 1);
+    ASSERT_EQ(hedging.GetStatistics().requests, 1);
+    ASSERT_EQ(hedging.GetStatistics().hedges_issued, 0);
+}
+
+TEST(HTTPHedgingTest, StalledRequestIsHedged) {
+    HTTPHedging hedging;
+    auto attempts = std::make_shared<std::atomic<size_t>>(0);
+    auto cancelled = std::make_shared<std::atomic<size_t>>(0);
+    auto result = hedging.Run<int>(EnabledConfig(20), [attempts, cancelled](const std::atomic<bool>& c) {
+        // The first attempt stalls, the hedge responds immediately
+        auto attempt = (*attempts)++;
+        if (attempt == 0) {
+            if (!SleepUnlessCancelled(5000ms, c)) ++*cancelled;
+            return 0;
+        }
+        return 2;
+    });
+    ASSERT_EQ(result, 2);
+    ASSERT_EQ(hedging.GetStatistics().hedges_issued, 1);
+    ASSERT_EQ(hedging.GetStatistics().hedges_won, 1);
+    ASSERT_EQ(hedging.GetStatistics().requests_cancelled, 1);
+
+    // The loser observes the cancellation
+    auto until = std::chrono::steady_clock::now() + 1s;
+    while (*cancelled == 0 && std::chrono::steady_clock::now() < until) std::this_thread::sleep_for(1ms);
+    ASSERT_EQ(*cancelled, 1);
+}
+
+TEST(HTTPHedgingTest, FailedRequestWaitsForHedge) {
+    HTTPHedging hedging;
+    auto attempts = std::make_shared<std::atomic<size_t>>(0);
+    auto result = hedging.Run<int>(EnabledConfig(10), [attempts](const std::atomic<bool>& c) {
+        auto attempt = (*attempts)++;
+        if (attempt == 0) {
+            std::this_thread::sleep_for(50ms);
+            throw std::runtime_error("stalled request failed");
+        }
+        std::this_thread::sleep_for(100ms);
+        return 3;
+    });
+    ASSERT_EQ(result, 3);
+    ASSERT_EQ(hedging.GetStatistics().hedges_won, 1);
+}
+
+TEST(HTTPHedgingTest, AllAttemptsFail) {
+    HTTPHedging hedging;
+    ASSERT_THROW(hedging.Run<int>(EnabledConfig(1000),
+                                  [](const std::atomic<bool>&) -> int { throw std::runtime_error("failed"); }),
+                 std::runtime_error);
+    ASSERT_EQ(hedging.GetStatistics().hedges_issued, 0);
+}
+
+TEST(HTTPHedgingTest, UncancellableOriginal) {
+    HTTPHedging hedging;
+    auto attempts = std::make_shared<std::atomic<size_t>>(0);
+    auto start = std::chrono::steady_clock::now();
+    auto result = hedging.Run<int>(EnabledConfig(20), [attempts](const std::atomic<bool>&) {
+        // The original ignores the cancellation like a synchronous XMLHttpRequest
+        if ((*attempts)++ == 0) {
+            std::this_thread::sleep_for(1000ms);
+            return 0;
+        }
+        return 4;
+    });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(result, 4);
+    ASSERT_EQ(hedging.GetStatistics().hedges_won, 1);
+    // The call returns at the hedge latency, not when the stalled original finishes
+    ASSERT_LT(elapsed, 500ms);
+}
+
+TEST(HTTPHedgingTest, BoundedHedgeWorkers) {
+    HTTPHedging hedging{2};
+    auto started = std::make_shared<std::atomic<size_t>>(0);
+    auto request = [started](const std::atomic<bool>& c) {
+        ++*started;
+        SleepUnlessCancelled(200ms, c);
+        return 5;
+    };
+
+    // The first request occupies both workers with the original and the hedge.
+    // The second request finds no idle worker and runs unhedged on the calling thread.
+    std::thread first{[&]() { ASSERT_EQ(hedging.Run<int>(EnabledConfig(20), request), 5); }};
+    while (*started < 2) std::this_thread::yield();
+    auto caller = std::this_thread::get_id();
+    std::thread::id unhedged;
+    ASSERT_EQ(hedging.Run<int>(EnabledConfig(20),
+                               [&](const std::atomic<bool>&) {
+                                   unhedged = std::this_thread::get_id();
+                                   return 6;
+                               }),
+              6);
+    first.join();
+    ASSERT_EQ(unhedged, caller);
+    ASSERT_EQ(hedging.GetStatistics().requests, 2);
+    ASSERT_EQ(hedging.GetStatistics().hedges_skipped, 1);
+    ASSERT_EQ(hedging.GetStatistics().hedges_issued, 1);
+    ASSERT_EQ(hedging.GetWorkers().GetThreadCount(), 2);
+}
+
+TEST(HTTPHedgingTest, SQLStatistics) {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    auto result = conn.connection().Query(
+        "SELECT requests, hedges_issued, hedges_won, hedges_skipped, requests_cancelled FROM http_hedging()");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    for (uint32_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(CHECK_COLUMN(*result, i, {0}));
+    }
+}
+
+}  // namespace
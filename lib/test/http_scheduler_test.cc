@@ -0,0 +1,136 @@
+#include "duckdb/web/http_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "duckdb/web/http_transport.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace std;
+
+namespace {
+
+constexpr const char* URL = "http://mock:8080/data";
+
+/// Wait until a number of requests are queued
+void WaitForQueued(HTTPRequestScheduler& scheduler, size_t n) {
+    while (scheduler.GetQueuedCount(URL) < n) std::this_thread::sleep_for(std::chrono::milliseconds{1});
+}
+
+TEST(HTTPRequestSchedulerTest, Host) {
+    ASSERT_EQ(HTTPRequestScheduler::GetHost("https://a.b:443/c/d?e"), "https://a.b:443");
+    ASSERT_EQ(HTTPRequestScheduler::GetHost("http://a.b?c"), "http://a.b");
+    ASSERT_EQ(HTTPRequestScheduler::GetHost("http://a.b"), "http://a.b");
+}
+
+TEST(HTTPRequestSchedulerTest, LimitsConnectionsPerHost) {
+    HTTPRequestScheduler scheduler;
+    scheduler.SetMaxConnectionsPerHost(2);
+    auto a = scheduler.Acquire(URL, HTTPRequestPriority::DEMAND);
+    auto b = scheduler.Acquire(URL, HTTPRequestPriority::DEMAND);
+    ASSERT_EQ(scheduler.GetActiveCount(URL), 2);
+
+    // Other hosts are not affected
+    ASSERT_TRUE(scheduler.Acquire("http://other/data", HTTPRequestPriority::DEMAND));
+
+    std::atomic<bool> started = false;
+    std::thread waiter{[&]() {
+        auto c = scheduler.Acquire(URL, HTTPRequestPriority::DEMAND);
+        started = true;
+    }};
+    WaitForQueued(scheduler, 1);
+    ASSERT_FALSE(started);
+    a.reset();
+    waiter.join();
+    ASSERT_TRUE(started);
+    ASSERT_EQ(scheduler.GetActiveCount(URL), 1);
+    ASSERT_EQ(scheduler.GetStatistics().queued, 1);
+}
+
+TEST(HTTPRequestSchedulerTest, DemandPreemptsSpeculativeRequests) {
+    HTTPRequestScheduler scheduler;
+    scheduler.SetMaxConnectionsPerHost(2);
+    auto demand = scheduler.Acquire(URL, HTTPRequestPriority::DEMAND);
+    auto prefetch = scheduler.Acquire(URL, HTTPRequestPriority::PREFETCH);
+    ASSERT_EQ(scheduler.GetActiveCount(URL), 2);
+
+    // Queue speculative requests before a demand request
+    std::mutex order_mutex;
+    std::vector<HTTPRequestPriority> order;
+    std::vector<std::thread> threads;
+    for (auto priority :
+         {HTTPRequestPriority::PREFETCH, HTTPRequestPriority::READAHEAD, HTTPRequestPriority::DEMAND}) {
+        auto queued = scheduler.GetQueuedCount(URL);
+        threads.emplace_back([&, priority]() {
+            auto slot = scheduler.Acquire(URL, priority);
+            std::unique_lock<std::mutex> guard{order_mutex};
+            order.push_back(priority);
+        });
+        WaitForQueued(scheduler, queued + 1);
+    }
+
+    // The demand request goes first.
+    // The speculative requests never take the last connection and have to wait for the prefetch.
+    demand.reset();
+    threads[2].join();
+    ASSERT_EQ(scheduler.GetQueuedCount(URL), 2);
+    prefetch.reset();
+    threads[0].join();
+    threads[1].join();
+    ASSERT_EQ(order, (std::vector<HTTPRequestPriority>{HTTPRequestPriority::DEMAND, HTTPRequestPriority::READAHEAD,
+                                                       HTTPRequestPriority::PREFETCH}));
+    ASSERT_EQ(scheduler.GetActiveCount(URL), 0);
+}
+
+TEST(HTTPRequestSchedulerTest, CancelWhileWaiting) {
+    HTTPRequestScheduler scheduler;
+    scheduler.SetMaxConnectionsPerHost(1);
+    auto slot = scheduler.Acquire(URL, HTTPRequestPriority::DEMAND);
+    std::atomic<bool> cancelled = false;
+    std::thread waiter{[&]() { ASSERT_FALSE(scheduler.Acquire(URL, HTTPRequestPriority::DEMAND, &cancelled)); }};
+    WaitForQueued(scheduler, 1);
+    cancelled = true;
+    waiter.join();
+    ASSERT_EQ(scheduler.GetQueuedCount(URL), 0);
+    ASSERT_EQ(scheduler.GetStatistics().cancelled, 1);
+}
+
+TEST(HTTPRequestSchedulerTest, Transport) {
+    auto mock = std::make_shared<MockHTTPTransport>();
+    std::atomic<size_t> active = 0;
+    std::atomic<size_t> max_active = 0;
+    mock->SetHandler([&](const HTTPTransportRequest& request) {
+        auto now = ++active;
+        for (auto seen = max_active.load(); now > seen && !max_active.compare_exchange_weak(seen, now);) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        --active;
+        HTTPTransportResponse response;
+        response.status = 200;
+        return response;
+    });
+    auto scheduler = std::make_shared<HTTPRequestScheduler>();
+    scheduler->SetMaxConnectionsPerHost(3);
+    SchedulingHTTPTransport transport{mock, scheduler};
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < 8; ++i) {
+        threads.emplace_back([&]() {
+            HTTPTransportRequest request;
+            request.url = URL;
+            for (unsigned j = 0; j < 10; ++j) ASSERT_EQ(transport.Send(request).status, 200);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    ASSERT_EQ(mock->GetRequestCount(), 80);
+    ASSERT_LE(max_active, 3);
+    ASSERT_EQ(scheduler->GetActiveCount(URL), 0);
+}
+
+}  // namespace
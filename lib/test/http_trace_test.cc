@@ -0,0 +1,148 @@
+#include "duckdb/web/http_trace.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "duckdb/web/extensions/parquet_extension.h"
+#include "duckdb/web/http_transport.h"
+#include "duckdb/web/io/web_filesystem.h"
+#include "duckdb/web/test/config.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace duckdb::web::test;
+using namespace std;
+
+namespace {
+
+constexpr const char* URL = "http://mock/data";
+
+/// Build a range request
+HTTPTransportRequest MakeRequest(std::string range) {
+    HTTPTransportRequest request;
+    request.method = "GET";
+    request.url = URL;
+    request.headers.emplace_back("Range", std::move(range));
+    return request;
+}
+
+TEST(HTTPRequestTracerTest, RecordsRequests) {
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource(URL, "0123456789");
+    auto tracer = std::make_shared<HTTPRequestTracer>();
+    TracingHTTPTransport transport{mock, tracer};
+
+    transport.Send(MakeRequest("bytes=0-3"));
+    transport.Send(MakeRequest("bytes=4-9"));
+    auto traces = tracer->Collect();
+    ASSERT_EQ(traces.size(), 2);
+    ASSERT_EQ(traces[0].id, 0);
+    ASSERT_EQ(traces[0].method, "GET");
+    ASSERT_EQ(traces[0].url, URL);
+    ASSERT_EQ(traces[0].range, "bytes=0-3");
+    ASSERT_EQ(traces[0].status, 206);
+    ASSERT_EQ(traces[0].bytes, 4);
+    ASSERT_EQ(traces[1].range, "bytes=4-9");
+    ASSERT_EQ(traces[1].bytes, 6);
+    ASSERT_LE(traces[0].start_us, traces[1].start_us);
+
+    // Collecting with reset scopes the traces
+    ASSERT_EQ(tracer->Collect(true).size(), 2);
+    ASSERT_EQ(tracer->Collect().size(), 0);
+}
+
+TEST(HTTPRequestTracerTest, CountsRetries) {
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource(URL, "0123456789");
+    auto tracer = std::make_shared<HTTPRequestTracer>();
+    TracingHTTPTransport transport{mock, tracer};
+
+    mock->FailNextRequests(2);
+    for (unsigned i = 0; i < 3; ++i) transport.Send(MakeRequest("bytes=0-3"));
+    transport.Send(MakeRequest("bytes=0-3"));
+    auto traces = tracer->Collect();
+    ASSERT_EQ(traces.size(), 4);
+    ASSERT_EQ(traces[0].status, 503);
+    ASSERT_EQ(traces[0].retries, 0);
+    ASSERT_EQ(traces[1].retries, 1);
+    ASSERT_EQ(traces[2].status, 206);
+    ASSERT_EQ(traces[2].retries, 2);
+    ASSERT_EQ(traces[3].retries, 0);
+
+    // Cancelled requests are no failures
+    std::atomic<bool> cancelled{true};
+    transport.Send(MakeRequest("bytes=0-3"), &cancelled);
+    transport.Send(MakeRequest("bytes=0-3"));
+    traces = tracer->Collect();
+    ASSERT_TRUE(traces[4].cancelled);
+    ASSERT_EQ(traces[5].retries, 0);
+}
+
+TEST(HTTPRequestTracerTest, RecordsRuntimeRequests) {
+    // Requests that the runtime sends are recorded without a transport
+    HTTPRequestTracer tracer;
+    tracer.Record(HTTPRequestTrace{.method = "GET", .url = URL, .range = "bytes=0-3", .status = 0});
+    tracer.Record(HTTPRequestTrace{.method = "GET", .url = URL, .range = "bytes=0-3", .status = 206, .bytes = 4});
+    auto traces = tracer.Collect();
+    ASSERT_EQ(traces.size(), 2);
+    ASSERT_EQ(traces[0].id, 0);
+    ASSERT_EQ(traces[1].id, 1);
+    ASSERT_EQ(traces[1].bytes, 4);
+    ASSERT_EQ(traces[1].retries, 1);
+}
+
+TEST(HTTPRequestTracerTest, RingBuffer) {
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource(URL, "0123456789");
+    auto tracer = std::make_shared<HTTPRequestTracer>();
+    tracer->SetCapacity(4);
+    TracingHTTPTransport transport{mock, tracer};
+
+    for (unsigned i = 0; i < 10; ++i) transport.Send(MakeRequest("bytes=" + std::to_string(i) + "-9"));
+    auto traces = tracer->Collect();
+    ASSERT_EQ(traces.size(), 4);
+    for (unsigned i = 0; i < 4; ++i) ASSERT_EQ(traces[i].id, 6 + i);
+
+    // A disabled tracer records nothing
+    tracer->SetCapacity(0);
+    transport.Send(MakeRequest("bytes=0-9"));
+    ASSERT_EQ(tracer->Collect().size(), 0);
+}
+
+TEST(HTTPRequestTracerTest, QueryRequests) {
+    auto path = test::SOURCE_DIR / ".." / "data" / "uni" / "studenten.parquet";
+    std::ifstream in{path, std::ios::binary};
+    std::string data{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource("http://mock/studenten.parquet", data);
+
+    auto db = std::make_shared<WebDB>(WEB);
+    duckdb_web_parquet_init(&db->database());
+    io::WebFileSystem::Get()->SetHTTPTransport(mock);
+    WebDB::Connection conn{*db};
+    ASSERT_TRUE(db->RegisterFileURL("studenten.parquet", "http://mock/studenten.parquet",
+                                    io::WebFileSystem::DataProtocol::HTTP, false)
+                    .ok());
+    conn.connection().Query("SELECT * FROM http_requests(reset := true)");
+    auto requests = mock->GetRequestCount();
+    auto result = conn.connection().Query("SELECT count(*) FROM parquet_scan('studenten.parquet');");
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {8}));
+
+    // The requests of the scan are listed
+    result = conn.connection().Query(
+        "SELECT count(*) = " + std::to_string(mock->GetRequestCount() - requests) +
+        ", sum(bytes) > 0, bool_and(url = 'http://mock/studenten.parquet') FROM http_requests(reset := true)");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {true}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {true}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 2, {true}));
+    result = conn.connection().Query("SELECT count(*) FROM http_requests()");
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {0}));
+    ASSERT_TRUE(db->DropFile("studenten.parquet").ok());
+}
+
+}  // namespace
@@ -0,0 +1,401 @@
+#include "duckdb/web/http_transport.h"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "duckdb/web/extensions/parquet_extension.h"
+#include "duckdb/web/io/web_filesystem.h"
+#include "duckdb/web/test/config.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace duckdb::web::test;
+using namespace std;
+
+namespace {
+
+/// A minimal HTTP/1.1 server on the loopback interface that serves static resources
+class TestHTTPServer {
+   protected:
+    /// The listening socket
+    int listen_fd_ = -1;
+    /// The port
+    uint16_t port_ = 0;
+    /// The accept thread
+    std::thread acceptor_ = {};
+    /// The connection threads
+    std::vector<std::thread> connections_ = {};
+    /// The mutex
+    std::mutex mutex_ = {};
+    /// The condition variable that is notified when the server stops
+    std::condition_variable stopped_cv_ = {};
+    /// The server stopped?
+    bool stopped_ = false;
+    /// The resources by path
+    std::unordered_map<std::string, std::string> resources_ = {};
+    /// The response delay
+    std::chrono::milliseconds delay_ = std::chrono::milliseconds{0};
+    /// The number of requests
+    std::atomic<size_t> request_count_ = 0;
+
+    /// Serve a connection
+    void Serve(int fd) {
+        std::string buffer;
+        char chunk[4096];
+        while (buffer.find("\r\n\r\n") == std::string::npos) {
+            auto n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                ::close(fd);
+                return;
+            }
+            buffer.append(chunk, n);
+        }
+        ++request_count_;
+
+        // Parse the request
+        HTTPTransportRequest request;
+        std::string_view head{buffer.data(), buffer.find("\r\n\r\n")};
+        auto request_line = head.substr(0, head.find("\r\n"));
+        auto sp1 = request_line.find(' ');
+        auto sp2 = request_line.find(' ', sp1 + 1);
+        request.method = std::string{request_line.substr(0, sp1)};
+        auto path = std::string{request_line.substr(sp1 + 1, sp2 - sp1 - 1)};
+        std::string_view lines = head.substr(std::min(head.size(), request_line.size() + 2));
+        while (!lines.empty()) {
+            auto eol = lines.find("\r\n");
+            auto line = lines.substr(0, eol);
+            lines = eol == std::string_view::npos ? std::string_view{} : lines.substr(eol + 2);
+            auto colon = line.find(':');
+            if (colon == std::string_view::npos) continue;
+            auto value = line.substr(colon + 1);
+            while (!value.empty() && value[0] == ' ') value.remove_prefix(1);
+            request.headers.emplace_back(std::string{line.substr(0, colon)}, std::string{value});
+        }
+
+        // Delay the response
+        std::unique_lock<std::mutex> guard{mutex_};
+        stopped_cv_.wait_for(guard, delay_, [&]() { return stopped_; });
+        HTTPTransportResponse response;
+        if (auto iter = resources_.find(path); iter != resources_.end()) {
+            response = MockHTTPTransport::ServeResource(request, iter->second);
+        } else {
+            response.status = 404;
+        }
+        guard.unlock();
+
+        // Write the response
+        std::stringstream out;
+        out << "HTTP/1.1 " << response.status << " Status\r\n";
+        for (auto& [key, value] : response.headers) {
+            if (key == "Content-Length") continue;
+            out << key << ": " << value << "\r\n";
+        }
+        auto content_length = response.body.size();
+        if (auto length = response.FindHeader("Content-Length"); length && request.method == "HEAD") {
+            content_length = std::stoull(std::string{*length});
+        }
+        out << "Content-Length: " << content_length << "\r\n";
+        out << "Connection: close\r\n\r\n";
+        if (request.method != "HEAD") out << response.body;
+        auto text = out.str();
+        ::send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+        ::close(fd);
+    }
+
+   public:
+    /// Constructor
+    TestHTTPServer() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listen_fd_, 64);
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+
+        acceptor_ = std::thread([this]() {
+            while (true) {
+                pollfd pfd{.fd = listen_fd_, .events = POLLIN, .revents = 0};
+                if (::poll(&pfd, 1, 10) <= 0) {
+                    std::unique_lock<std::mutex> guard{mutex_};
+                    if (stopped_) return;
+                    continue;
+                }
+                auto fd = ::accept(listen_fd_, nullptr, nullptr);
+                if (fd < 0) continue;
+                std::unique_lock<std::mutex> guard{mutex_};
+                connections_.emplace_back([this, fd]() { Serve(fd); });
+            }
+        });
+    }
+    /// Destructor
+    ~TestHTTPServer() {
+        {
+            std::unique_lock<std::mutex> guard{mutex_};
+            stopped_ = true;
+        }
+        stopped_cv_.notify_all();
+        acceptor_.join();
+        for (auto& connection : connections_) connection.join();
+        ::close(listen_fd_);
+    }
+
+    /// Add a resource
+    void AddResource(std::string path, std::string data) {
+        std::unique_lock<std::mutex> guard{mutex_};
+        resources_[std::move(path)] = std::move(data);
+    }
+    /// Delay all responses
+    void SetDelay(std::chrono::milliseconds delay) {
+        std::unique_lock<std::mutex> guard{mutex_};
+        delay_ = delay;
+    }
+    /// Get the url of a path
+    std::string GetURL(std::string_view path) const {
+        return "http://127.0.0.1:" + std::to_string(port_) + std::string{path};
+    }
+    /// Get the number of requests
+    size_t GetRequestCount() const { return request_count_.load(); }
+};
+
+/// Read a test file
+std::string ReadTestFile(const std::filesystem::path& path) {
+    std::ifstream in{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+/// Build a request
+HTTPTransportRequest MakeRequest(std::string method, std::string url, HTTPHeaderList headers = {}) {
+    HTTPTransportRequest request;
+    request.method = std::move(method);
+    request.url = std::move(url);
+    request.headers = std::move(headers);
+    return request;
+}
+
+TEST(MockHTTPTransportTest, ServeRanges) {
+    MockHTTPTransport transport;
+    transport.AddResource("http://mock/data", "0123456789");
+
+    auto head = transport.Send(MakeRequest("HEAD", "http://mock/data"));
+    ASSERT_EQ(head.status, 200);
+    ASSERT_EQ(head.FindHeader("content-length"), "10");
+    ASSERT_TRUE(head.body.empty());
+
+    auto range = transport.Send(MakeRequest("GET", "http://mock/data", {{"Range", "bytes=2-5"}}));
+    ASSERT_EQ(range.status, 206);
+    ASSERT_EQ(range.body, "2345");
+    ASSERT_EQ(range.FindHeader("Content-Range"), "bytes 2-5/10");
+
+    auto suffix = transport.Send(MakeRequest("GET", "http://mock/data", {{"Range", "bytes=-3"}}));
+    ASSERT_EQ(suffix.status, 206);
+    ASSERT_EQ(suffix.body, "789");
+
+    auto open_end = transport.Send(MakeRequest("GET", "http://mock/data", {{"Range", "bytes=8-100"}}));
+    ASSERT_EQ(open_end.status, 206);
+    ASSERT_EQ(open_end.body, "89");
+
+    auto unsatisfiable = transport.Send(MakeRequest("GET", "http://mock/data", {{"Range", "bytes=10-20"}}));
+    ASSERT_EQ(unsatisfiable.status, 416);
+
+    auto full = transport.Send(MakeRequest("GET", "http://mock/data"));
+    ASSERT_EQ(full.status, 200);
+    ASSERT_EQ(full.body, "0123456789");
+
+    auto missing = transport.Send(MakeRequest("GET", "http://mock/missing"));
+    ASSERT_EQ(missing.status, 404);
+    ASSERT_EQ(transport.GetRequestCount(), 7);
+    ASSERT_EQ(transport.GetBytesSent(), 19);
+}
+
+TEST(MockHTTPTransportTest, InjectErrors) {
+    MockHTTPTransport transport;
+    transport.AddResource("http://mock/data", "0123456789");
+
+    transport.FailNextRequests(2, 503);
+    ASSERT_EQ(transport.Send(MakeRequest("GET", "http://mock/data")).status, 503);
+    ASSERT_EQ(transport.Send(MakeRequest("GET", "http://mock/data")).status, 503);
+    ASSERT_EQ(transport.Send(MakeRequest("GET", "http://mock/data")).status, 200);
+
+    transport.FailNextRequests(1, 0);
+    auto failed = transport.Send(MakeRequest("GET", "http://mock/data"));
+    ASSERT_EQ(failed.status, 0);
+    ASSERT_FALSE(failed.error.empty());
+
+    transport.SetErrorRate(1.0);
+    ASSERT_EQ(transport.Send(MakeRequest("GET", "http://mock/data")).status, 503);
+    transport.SetErrorRate(0.0);
+    ASSERT_EQ(transport.Send(MakeRequest("GET", "http://mock/data")).status, 200);
+}
+
+TEST(MockHTTPTransportTest, LatencyAndBandwidth) {
+    MockHTTPTransport transport;
+    transport.AddResource("http://mock/data", std::string(10000, 'x'));
+    transport.SetLatency(std::chrono::milliseconds{20});
+    transport.SetBandwidth(100000);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(transport.Send(MakeRequest("GET", "http://mock/data")).status, 200);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_GE(elapsed, std::chrono::milliseconds{120});
+
+    // A cancelled request returns early
+    std::atomic<bool> cancelled{false};
+    transport.SetLatency(std::chrono::seconds{10});
+    std::thread canceller{[&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        cancelled = true;
+    }};
+    start = std::chrono::steady_clock::now();
+    auto response = transport.Send(MakeRequest("GET", "http://mock/data"), &cancelled);
+    canceller.join();
+    ASSERT_EQ(response.status, 0);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+}
+
+TEST(HTTPTransportTest, RawHeaders) {
+    HTTPTransportResponse response;
+    response.status = 206;
+    response.raw_headers = "content-length: 4\r\nETag:  \"v1\" \r\ninvalid\r\nContent-Type: text/plain\r\n"
+                           "x-amz-version-id: 3sL4kqtJ\r\n";
+    response.body = "abcd";
+
+    // Raw header lines are scanned on access
+    ASSERT_TRUE(response.headers.empty());
+    ASSERT_EQ(response.FindHeader("Content-Length"), "4");
+    ASSERT_EQ(response.FindHeader("etag"), "\"v1\"");
+    ASSERT_EQ(response.FindHeader("Content-Type"), "text/plain");
+    ASSERT_EQ(response.FindHeader("X-Amz-Version-Id"), "3sL4kqtJ");
+    ASSERT_FALSE(response.FindHeader("invalid"));
+
+    // Parsed headers take precedence over the raw header lines
+    response.headers.emplace_back("ETag", "\"v2\"");
+    ASSERT_EQ(response.FindHeader("ETag"), "\"v2\"");
+    std::vector<std::string> keys;
+    response.ForEachHeader([&](std::string_view key, std::string_view value) { keys.emplace_back(key); });
+    ASSERT_EQ(keys, (std::vector<std::string>{"ETag", "content-length", "ETag", "Content-Type", "x-amz-version-id"}));
+}
+
+TEST(SocketHTTPTransportTest, RangeRequests) {
+    TestHTTPServer server;
+    server.AddResource("/data", "0123456789");
+    SocketHTTPTransport transport;
+
+    auto head = transport.Send(MakeRequest("HEAD", server.GetURL("/data")));
+    ASSERT_EQ(head.status, 200);
+    ASSERT_EQ(head.FindHeader("Content-Length"), "10");
+    ASSERT_TRUE(head.body.empty());
+
+    auto range = transport.Send(MakeRequest("GET", server.GetURL("/data"), {{"Range", "bytes=3-6"}}));
+    ASSERT_EQ(range.status, 206);
+    ASSERT_EQ(range.body, "3456");
+
+    auto full = transport.Send(MakeRequest("GET", server.GetURL("/data")));
+    ASSERT_EQ(full.status, 200);
+    ASSERT_EQ(full.body, "0123456789");
+
+    auto missing = transport.Send(MakeRequest("GET", server.GetURL("/missing")));
+    ASSERT_EQ(missing.status, 404);
+    ASSERT_EQ(server.GetRequestCount(), 4);
+}
+
+TEST(SocketHTTPTransportTest, Errors) {
+    SocketHTTPTransport transport;
+    auto https = transport.Send(MakeRequest("GET", "https://127.0.0.1/data"));
+    ASSERT_EQ(https.status, 0);
+    ASSERT_FALSE(https.error.empty());
+
+    // A cancelled request returns while the server is still waiting
+    TestHTTPServer server;
+    server.AddResource("/data", "0123456789");
+    server.SetDelay(std::chrono::seconds{10});
+    std::atomic<bool> cancelled{false};
+    std::thread canceller{[&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        cancelled = true;
+    }};
+    auto start = std::chrono::steady_clock::now();
+    auto response = transport.Send(MakeRequest("GET", server.GetURL("/data")), &cancelled);
+    canceller.join();
+    ASSERT_EQ(response.status, 0);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+}
+
+TEST(HTTPTransportTest, RemoteParquetScan) {
+    auto data = ReadTestFile(test::SOURCE_DIR / ".." / "data" / "uni" / "studenten.parquet");
+    TestHTTPServer server;
+    server.AddResource("/studenten.parquet", data);
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource("http://mock/studenten.parquet", data);
+
+    for (auto& [transport, url] : std::vector<std::pair<std::shared_ptr<HTTPTransport>, std::string>>{
+             {std::make_shared<SocketHTTPTransport>(), server.GetURL("/studenten.parquet")},
+             {mock, "http://mock/studenten.parquet"}}) {
+        auto db = std::make_shared<WebDB>(WEB);
+        duckdb_web_parquet_init(&db->database());
+        io::WebFileSystem::Get()->SetHTTPTransport(transport);
+        ASSERT_TRUE(db->RegisterFileURL("studenten.parquet", url, io::WebFileSystem::DataProtocol::HTTP, false).ok());
+
+        WebDB::Connection conn{*db};
+        auto result = conn.connection().Query("SELECT * FROM parquet_scan('studenten.parquet');");
+        ASSERT_TRUE(CHECK_COLUMN(*result, 0, {24002, 25403, 26120, 26830, 27550, 28106, 29120, 29555}));
+        ASSERT_TRUE(CHECK_COLUMN(*result, 2, {18, 12, 10, 8, 6, 3, 2, 2}));
+    }
+    ASSERT_GT(server.GetRequestCount(), 0);
+    ASSERT_GT(mock->GetRequestCount(), 0);
+}
+
+TEST(HTTPTransportTest, FullResponseToRangeRequest) {
+    auto data = ReadTestFile(test::SOURCE_DIR / ".." / "data" / "uni" / "studenten.parquet");
+    auto mock = std::make_shared<MockHTTPTransport>();
+    // The server ignores the range and returns the entire file, the truncated file ends after 16 bytes
+    mock->SetHandler([data](const HTTPTransportRequest& request) {
+        HTTPTransportResponse response;
+        response.status = 200;
+        response.headers = {{"Content-Length", std::to_string(data.size())}};
+        if (request.method == "GET") {
+            response.body = request.url == "http://mock/truncated.parquet" ? data.substr(0, 16) : data;
+        }
+        return response;
+    });
+    auto db = std::make_shared<WebDB>(WEB);
+    duckdb_web_parquet_init(&db->database());
+    io::WebFileSystem::Get()->SetHTTPTransport(mock);
+    for (auto name : {"studenten.parquet", "truncated.parquet"}) {
+        ASSERT_TRUE(db->RegisterFileURL(name, std::string{"http://mock/"} + name,
+                                        io::WebFileSystem::DataProtocol::HTTP, false)
+                        .ok());
+    }
+    WebDB::Connection conn{*db};
+
+    // The requested ranges are sliced out of the full response
+    auto result = conn.connection().Query("SELECT * FROM parquet_scan('studenten.parquet');");
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {24002, 25403, 26120, 26830, 27550, 28106, 29120, 29555}));
+
+    // A full response that ends before the requested range is rejected
+    auto failed = conn.connection().Query("SELECT * FROM parquet_scan('truncated.parquet');");
+    ASSERT_TRUE(failed->HasError());
+    ASSERT_NE(failed->GetError().find("full response"), std::string::npos) << failed->GetError();
+}
+
+}  // namespace
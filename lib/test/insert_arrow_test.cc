@@ -1,10 +1,14 @@
 #include <arrow/memory_pool.h>
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include <thread>
 
+#include "arrow/array/array_dict.h"
+#include "arrow/array/builder_primitive.h"
 #include "arrow/io/memory.h"
 #include "arrow/ipc/options.h"
 #include "arrow/ipc/writer.h"
@@ -231,4 +235,247 @@ static std::vector<ArrowInsertTest> ARROW_IMPORT_TEST = {
 INSTANTIATE_TEST_SUITE_P(ArrowInsertTest, ArrowInsertTestSuite, testing::ValuesIn(ARROW_IMPORT_TEST),
                          ArrowInsertTest::TestPrinter());
 
+/// Count the rows of a table, returns -1 if the table is not visible
+int64_t CountRows(duckdb::Connection& conn, std::string_view table) {
+    auto result = conn.Query("SELECT count(*)::BIGINT FROM " + std::string{table});
+    if (result->HasError()) return -1;
+    return result->GetValue(0, 0).GetValue<int64_t>();
+}
+
+TEST(ArrowInsert, IncrementalBatches) {
+    // Write a stream with several batches and remember where the messages end
+    auto schema = arrow::schema({arrow::field("v", arrow::int32())});
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto writer = arrow::ipc::MakeStreamWriter(out, schema).ValueOrDie();
+    std::vector<int64_t> ends;
+    for (int i = 0; i < 3; ++i) {
+        auto values = json::ArrayFromJSON(arrow::int32(), "[1, 2, 3, 4]").ValueOrDie();
+        ASSERT_TRUE(writer->WriteRecordBatch(*arrow::RecordBatch::Make(schema, 4, {values})).ok());
+        ends.push_back(out->Tell().ValueOrDie());
+    }
+    ASSERT_TRUE(writer->Close().ok());
+    auto buffer = out->Finish().ValueOrDie();
+
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    duckdb::Connection other{db->database()};
+    constexpr std::string_view OPTIONS = R"JSON({"schema": "main", "name": "foo"})JSON";
+
+    // Every completed batch is appended before the end of the stream, other connections see the whole stream only
+    int64_t ofs = 0;
+    for (size_t i = 0; i < ends.size(); ++i) {
+        nonstd::span<const uint8_t> chunk{buffer->data() + ofs, static_cast<size_t>(ends[i] - ofs)};
+        ASSERT_TRUE(conn.InsertArrowFromIPCStream(chunk, i == 0 ? OPTIONS : "").ok());
+        ofs = ends[i];
+        ASSERT_EQ(CountRows(conn.connection(), "main.foo"), static_cast<int64_t>(4 * (i + 1)));
+        ASSERT_EQ(CountRows(other, "main.foo"), -1);
+    }
+    nonstd::span<const uint8_t> eos{buffer->data() + ofs, static_cast<size_t>(buffer->size() - ofs)};
+    ASSERT_TRUE(conn.InsertArrowFromIPCStream(eos, "").ok());
+    ASSERT_EQ(CountRows(other, "main.foo"), 12);
+}
+
+TEST(ArrowInsert, OwnedBuffers) {
+    auto schema = arrow::schema({arrow::field("v", arrow::int32()), arrow::field("s", arrow::utf8())});
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto writer = arrow::ipc::MakeStreamWriter(out, schema).ValueOrDie();
+    for (int i = 0; i < 2; ++i) {
+        auto v = json::ArrayFromJSON(arrow::int32(), "[1, 2, 3]").ValueOrDie();
+        auto s = json::ArrayFromJSON(arrow::utf8(), R"(["a", "b", "c"])").ValueOrDie();
+        ASSERT_TRUE(writer->WriteRecordBatch(*arrow::RecordBatch::Make(schema, 3, {v, s})).ok());
+    }
+    ASSERT_TRUE(writer->Close().ok());
+    auto buffer = out->Finish().ValueOrDie();
+
+    // Hand over the stream in two owned buffers that split a message
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    size_t split = buffer->size() / 2;
+    std::vector<size_t> bounds{0, split, static_cast<size_t>(buffer->size())};
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        auto len = bounds[i + 1] - bounds[i];
+        std::unique_ptr<char[]> owned{new char[len]};
+        std::memcpy(owned.get(), buffer->data() + bounds[i], len);
+        auto status = conn.InsertArrowFromIPCBuffer(std::move(owned), len,
+                                                    i == 0 ? R"JSON({"schema": "main", "name": "foo"})JSON" : "");
+        ASSERT_TRUE(status.ok()) << status.message();
+    }
+    auto result = conn.connection().Query("SELECT v, s FROM main.foo");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {1, 2, 3, 1, 2, 3}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {"a", "b", "c", "a", "b", "c"}));
+}
+
+TEST(ArrowInsert, ParallelScan) {
+    // Write a large table as a single record batch
+    constexpr int64_t ROWS = 10'000'000;
+    arrow::Int64Builder builder;
+    ASSERT_TRUE(builder.Reserve(ROWS).ok());
+    for (int64_t i = 0; i < ROWS; ++i) builder.UnsafeAppend(i * 7 % 1000003);
+    auto schema = arrow::schema({arrow::field("v", arrow::int64())});
+    auto batch = arrow::RecordBatch::Make(schema, ROWS, {builder.Finish().ValueOrDie()});
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    ASSERT_TRUE(arrow::ipc::WriteRecordBatchStream({batch}, arrow::ipc::IpcWriteOptions::Defaults(), out.get()).ok());
+    auto buffer = out->Finish().ValueOrDie();
+    nonstd::span<const uint8_t> stream{buffer->data(), static_cast<size_t>(buffer->size())};
+
+    // The partitions of the batch are inserted on multiple threads, the result matches the serial insert
+    constexpr std::string_view QUERY = "SELECT count(*)::BIGINT, sum(v)::BIGINT, "
+                                       "count(*) FILTER (WHERE v <> rowid * 7 % 1000003)::BIGINT FROM foo";
+    std::vector<std::vector<int64_t>> results;
+    for (auto threads : {1, 4}) {
+        auto db = std::make_shared<WebDB>(NATIVE);
+        ASSERT_TRUE(db->Open(R"JSON({"maximumThreads": )JSON" + std::to_string(threads) + "}").ok());
+        WebDB::Connection conn{*db};
+        ASSERT_TRUE(conn.InsertArrowFromIPCStream(stream, R"JSON({"schema": "main", "name": "foo"})JSON").ok());
+        auto result = conn.connection().Query(std::string{QUERY});
+        ASSERT_FALSE(result->HasError()) << result->GetError();
+        results.push_back({result->GetValue(0, 0).GetValue<int64_t>(), result->GetValue(1, 0).GetValue<int64_t>(),
+                           result->GetValue(2, 0).GetValue<int64_t>()});
+    }
+    ASSERT_EQ(results[0][0], ROWS);
+    ASSERT_EQ(results[0][2], 0);
+    ASSERT_EQ(results[0], results[1]);
+}
+
+TEST(ArrowInsert, IPCFiles) {
+    // Write two ipc files with several batches, the strings are dictionary encoded
+    auto write_file = [](std::shared_ptr<arrow::Schema> schema, auto make_batch, int batches) {
+        auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+        auto writer = arrow::ipc::MakeFileWriter(out, schema).ValueOrDie();
+        for (int i = 0; i < batches; ++i) {
+            EXPECT_TRUE(writer->WriteRecordBatch(*make_batch(i)).ok());
+        }
+        EXPECT_TRUE(writer->Close().ok());
+        auto buffer = out->Finish().ValueOrDie();
+        return std::vector<char>(buffer->data(), buffer->data() + buffer->size());
+    };
+    constexpr int64_t BATCH_ROWS = 50000;
+    auto ints_schema = arrow::schema({arrow::field("v", arrow::int64())});
+    auto ints = write_file(
+        ints_schema,
+        [&](int i) {
+            arrow::Int64Builder builder;
+            for (int64_t j = 0; j < BATCH_ROWS; ++j) EXPECT_TRUE(builder.Append(i * BATCH_ROWS + j).ok());
+            return arrow::RecordBatch::Make(ints_schema, BATCH_ROWS, {builder.Finish().ValueOrDie()});
+        },
+        8);
+    auto dict_type = arrow::dictionary(arrow::int32(), arrow::utf8());
+    auto strings_schema = arrow::schema({arrow::field("s", dict_type)});
+    auto dictionary = json::ArrayFromJSON(arrow::utf8(), R"(["a", "b", "c"])").ValueOrDie();
+    auto strings_batch = [&](int i) {
+        auto indices = json::ArrayFromJSON(arrow::int32(), "[0, 1, 2, 2]").ValueOrDie();
+        auto array = arrow::DictionaryArray::FromArrays(dict_type, indices, dictionary).ValueOrDie();
+        return arrow::RecordBatch::Make(strings_schema, 4, {array});
+    };
+    auto strings = write_file(strings_schema, strings_batch, 3);
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto options = arrow::ipc::IpcWriteOptions::Defaults();
+    ASSERT_TRUE(arrow::ipc::WriteRecordBatchStream({strings_batch(0)}, options, out.get()).ok());
+    auto stream = out->Finish().ValueOrDie();
+
+    auto memory_filesystem = std::make_unique<io::MemoryFileSystem>();
+    ASSERT_TRUE(memory_filesystem->RegisterFileBuffer("ints.arrow", std::move(ints)).ok());
+    std::vector<char> stream_buffer(stream->data(), stream->data() + stream->size());
+    ASSERT_TRUE(memory_filesystem->RegisterFileBuffer("stream.arrow", std::move(stream_buffer)).ok());
+    ASSERT_TRUE(memory_filesystem->RegisterFileBuffer("strings.arrow", std::move(strings)).ok());
+    auto db = std::make_shared<WebDB>(NATIVE, std::move(memory_filesystem));
+
+    // Insert both files concurrently on different connections
+    WebDB::Connection ints_conn{*db};
+    WebDB::Connection strings_conn{*db};
+    arrow::Status ints_status, strings_status;
+    std::thread ints_thread{[&]() {
+        ints_status = ints_conn.InsertArrowFromIPCFile("ints.arrow", R"JSON({"schema": "main", "name": "ints"})JSON");
+    }};
+    std::thread strings_thread{[&]() {
+        strings_status =
+            strings_conn.InsertArrowFromIPCFile("strings.arrow", R"JSON({"schema": "main", "name": "strings"})JSON");
+    }};
+    ints_thread.join();
+    strings_thread.join();
+    ASSERT_TRUE(ints_status.ok()) << ints_status.message();
+    ASSERT_TRUE(strings_status.ok()) << strings_status.message();
+
+    auto result = ints_conn.connection().Query(
+        "SELECT count(*)::BIGINT, count(*) FILTER (WHERE v <> rowid)::BIGINT FROM ints");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {400000}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {0}));
+    result = ints_conn.connection().Query("SELECT s, count(*)::BIGINT FROM strings GROUP BY s ORDER BY s");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {"a", "b", "c"}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {3, 3, 6}));
+
+    // Streams are not ipc files
+    auto status = ints_conn.InsertArrowFromIPCFile("stream.arrow", R"JSON({"schema": "main", "name": "stream"})JSON");
+    ASSERT_FALSE(status.ok());
+}
+
+TEST(ArrowInsert, RollbackOnError) {
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    ASSERT_TRUE(conn.RunQuery("CREATE TABLE foo (v INTEGER)").ok());
+
+    // Write a stream with a batch that cannot be appended
+    auto schema = arrow::schema({arrow::field("v", arrow::utf8())});
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto writer = arrow::ipc::MakeStreamWriter(out, schema).ValueOrDie();
+    std::vector<int64_t> ends;
+    for (auto* values : {R"(["1", "2"])", R"(["3", "not a number"])"}) {
+        auto array = json::ArrayFromJSON(arrow::utf8(), values).ValueOrDie();
+        ASSERT_TRUE(writer->WriteRecordBatch(*arrow::RecordBatch::Make(schema, 2, {array})).ok());
+        ends.push_back(out->Tell().ValueOrDie());
+    }
+    ASSERT_TRUE(writer->Close().ok());
+    auto buffer = out->Finish().ValueOrDie();
+
+    // The batches that were appended before the error are rolled back
+    nonstd::span<const uint8_t> first{buffer->data(), static_cast<size_t>(ends[0])};
+    ASSERT_TRUE(conn.InsertArrowFromIPCStream(first, R"JSON({"schema": "main", "name": "foo", "create": false})JSON").ok());
+    nonstd::span<const uint8_t> rest{buffer->data() + ends[0], static_cast<size_t>(buffer->size() - ends[0])};
+    ASSERT_FALSE(conn.InsertArrowFromIPCStream(rest, "").ok());
+    ASSERT_EQ(CountRows(conn.connection(), "foo"), 0);
+}
+
+TEST(ArrowInsert, AbortStream) {
+    auto schema = arrow::schema({arrow::field("v", arrow::int32())});
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto writer = arrow::ipc::MakeStreamWriter(out, schema).ValueOrDie();
+    auto values = json::ArrayFromJSON(arrow::int32(), "[1, 2, 3]").ValueOrDie();
+    ASSERT_TRUE(writer->WriteRecordBatch(*arrow::RecordBatch::Make(schema, 3, {values})).ok());
+    auto first_end = out->Tell().ValueOrDie();
+    ASSERT_TRUE(writer->Close().ok());
+    auto buffer = out->Finish().ValueOrDie();
+    nonstd::span<const uint8_t> first{buffer->data(), static_cast<size_t>(first_end)};
+    nonstd::span<const uint8_t> rest{buffer->data() + first_end, static_cast<size_t>(buffer->size() - first_end)};
+    constexpr std::string_view OPTIONS = R"JSON({"schema": "main", "name": "foo"})JSON";
+
+    auto db = std::make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+
+    // An explicit abort rolls back the created table
+    ASSERT_TRUE(conn.InsertArrowFromIPCStream(first, OPTIONS).ok());
+    ASSERT_EQ(CountRows(conn.connection(), "main.foo"), 3);
+    ASSERT_TRUE(conn.AbortArrowIPCStream().ok());
+    ASSERT_EQ(CountRows(conn.connection(), "main.foo"), -1);
+    ASSERT_TRUE(conn.connection().IsAutoCommit());
+
+    // Other statements fail while the insert is pending and the insert is not aborted
+    ASSERT_TRUE(conn.InsertArrowFromIPCStream(first, OPTIONS).ok());
+    auto interleaved = conn.RunQuery("CREATE TABLE bar AS SELECT 42 AS v");
+    ASSERT_FALSE(interleaved.ok());
+    ASSERT_NE(interleaved.status().message().find("arrow ipc stream insert is pending"), std::string::npos)
+        << interleaved.status().message();
+    ASSERT_FALSE(conn.SpillQuery("SELECT 1").ok());
+    ASSERT_FALSE(conn.CreatePreparedStatement("SELECT 1").ok());
+    ASSERT_TRUE(conn.InsertArrowFromIPCStream(rest, "").ok());
+    ASSERT_EQ(CountRows(conn.connection(), "main.foo"), 3);
+    ASSERT_TRUE(conn.connection().IsAutoCommit());
+
+    // Statements run again once the stream ended
+    ASSERT_TRUE(conn.RunQuery("CREATE TABLE bar AS SELECT 42 AS v").ok());
+    ASSERT_EQ(CountRows(conn.connection(), "main.bar"), 1);
+}
+
 }  // namespace
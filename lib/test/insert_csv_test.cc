@@ -1,11 +1,14 @@
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 
 #include "duckdb/common/types/date.hpp"
 #include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/web/http_transport.h"
 #include "duckdb/web/io/ifstream.h"
 #include "duckdb/web/io/memory_filesystem.h"
+#include "duckdb/web/io/web_filesystem.h"
 #include "duckdb/web/test/config.h"
 #include "duckdb/web/webdb.h"
 #include "gtest/gtest.h"
@@ -338,4 +341,70 @@ TEST(CSVExportTest, TestExport) {
     ASSERT_TRUE(CHECK_COLUMN(*result, 2, {3, 6, 9}));
 }
 
+TEST(CSVInsertTest, RemotePrefetch) {
+    constexpr size_t ROWS = 50000;
+    std::stringstream csv;
+    csv << "id,value,name\n";
+    for (size_t i = 0; i < ROWS; ++i) {
+        csv << i << "," << (i * 7) % 1000 << ",\"name " << i << "\"\n";
+    }
+    auto mock = std::make_shared<MockHTTPTransport>();
+    mock->AddResource("http://mock/data.csv", csv.str());
+
+    auto db = std::make_shared<WebDB>(WEB);
+    io::WebFileSystem::Get()->SetHTTPTransport(mock);
+    WebDB::Connection conn{*db};
+    ASSERT_TRUE(
+        db->RegisterFileURL("data.csv", "http://mock/data.csv", io::WebFileSystem::DataProtocol::HTTP, false).ok());
+
+    // Insert with prefetching in small ranges and without prefetching
+    auto maybe_ok = conn.InsertCSVFromPath("data.csv", R"JSON({
+        "name": "prefetched",
+        "prefetchRangeSize": 16384,
+        "prefetchConcurrency": 4
+    })JSON");
+    ASSERT_TRUE(maybe_ok.ok()) << maybe_ok.message();
+    maybe_ok = conn.InsertCSVFromPath("data.csv", R"JSON({
+        "name": "direct",
+        "prefetchConcurrency": 0
+    })JSON");
+    ASSERT_TRUE(maybe_ok.ok()) << maybe_ok.message();
+
+    auto result = conn.connection().Query(
+        "SELECT (SELECT count(*) FROM prefetched), (SELECT sum(value) FROM prefetched), "
+        "(SELECT count(*) FROM (SELECT * FROM prefetched EXCEPT SELECT * FROM direct))");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    int64_t sum = 0;
+    for (size_t i = 0; i < ROWS; ++i) sum += (i * 7) % 1000;
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {Value::BIGINT(ROWS)}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 1, {Value::BIGINT(sum)}));
+    ASSERT_TRUE(CHECK_COLUMN(*result, 2, {0}));
+
+    // Urls that are not registered are prefetched as well
+    std::atomic<size_t> prefetch_requests = 0;
+    auto data = csv.str();
+    mock->SetHandler([&](const HTTPTransportRequest& request) {
+        if (request.priority == HTTPRequestPriority::PREFETCH) ++prefetch_requests;
+        return MockHTTPTransport::ServeResource(request, data);
+    });
+    maybe_ok = conn.InsertCSVFromPath("http://mock/unregistered.csv", R"JSON({
+        "name": "unregistered",
+        "prefetchRangeSize": 16384,
+        "prefetchConcurrency": 4
+    })JSON");
+    ASSERT_TRUE(maybe_ok.ok()) << maybe_ok.message();
+    ASSERT_GT(prefetch_requests, 0);
+    result = conn.connection().Query("SELECT count(*) FROM (SELECT * FROM unregistered EXCEPT SELECT * FROM direct)");
+    ASSERT_FALSE(result->HasError()) << result->GetError();
+    ASSERT_TRUE(CHECK_COLUMN(*result, 0, {0}));
+
+    // Invalid range sizes are rejected
+    maybe_ok = conn.InsertCSVFromPath("data.csv", R"JSON({
+        "name": "invalid",
+        "prefetchRangeSize": 0
+    })JSON");
+    ASSERT_FALSE(maybe_ok.ok());
+    ASSERT_TRUE(db->DropFile("data.csv").ok());
+}
+
 }  // namespace
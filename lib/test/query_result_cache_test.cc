@@ -0,0 +1,224 @@
+#include "duckdb/web/query_result_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace std;
+
+namespace {
+
+constexpr const char* CACHE_CONFIG = R"JSON({"query": {"resultCacheBytes": 1048576}})JSON";
+
+/// Build a cached result of a given size
+std::shared_ptr<QueryResultCache::Result> MakeResult(size_t bytes) {
+    std::shared_ptr<arrow::Buffer> buffer = arrow::Buffer::FromString(std::string(bytes, 'x'));
+    return std::make_shared<QueryResultCache::Result>(QueryResultCache::Result{{buffer}});
+}
+
+/// Stream a query and collect all buffers
+std::vector<std::shared_ptr<arrow::Buffer>> StreamQuery(WebDB::Connection& conn, std::string_view text) {
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+    auto schema = conn.PendingQuery(text, true);
+    EXPECT_TRUE(schema.ok()) << schema.status().message();
+    while (schema.ok() && *schema == nullptr) schema = conn.PollPendingQuery();
+    buffers.push_back(*schema);
+    while (true) {
+        auto chunk = conn.FetchQueryResults();
+        if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+        EXPECT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+        if (!chunk.arrow_buffer.ok() || *chunk.arrow_buffer == nullptr) break;
+        buffers.push_back(*chunk.arrow_buffer);
+    }
+    return buffers;
+}
+
+TEST(QueryResultCache, Disabled) {
+    auto db = make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    ASSERT_TRUE(conn.RunQuery("SELECT 42").ok());
+    ASSERT_TRUE(conn.RunQuery("SELECT 42").ok());
+    ASSERT_EQ(db->result_cache().GetStatistics().hits, 0);
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 0);
+}
+
+TEST(QueryResultCache, RunQuery) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection conn{*db};
+    auto& stats = db->result_cache().GetStatistics();
+
+    auto first = conn.RunQuery("SELECT v FROM generate_series(0, 2000) AS t(v)");
+    ASSERT_TRUE(first.ok()) << first.status().message();
+    ASSERT_EQ(stats.misses, 1);
+    // Whitespace and keyword case are normalized
+    auto second = conn.RunQuery("select   v\nfrom generate_series(0, 2000) as t(v)");
+    ASSERT_TRUE(second.ok()) << second.status().message();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(second->get(), first->get());
+}
+
+TEST(QueryResultCache, PendingQuery) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection conn{*db};
+    auto& stats = db->result_cache().GetStatistics();
+
+    auto first = StreamQuery(conn, "SELECT v FROM generate_series(0, 10000) AS t(v)");
+    ASSERT_EQ(stats.misses, 1);
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 1);
+    auto second = StreamQuery(conn, "SELECT v FROM generate_series(0, 10000) AS t(v)");
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        ASSERT_TRUE(first[i]->Equals(*second[i]));
+    }
+    // Materialized and streamed results are cached separately
+    ASSERT_TRUE(conn.RunQuery("SELECT v FROM generate_series(0, 10000) AS t(v)").ok());
+    ASSERT_EQ(stats.misses, 2);
+}
+
+TEST(QueryResultCache, PreparedStatement) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection conn{*db};
+    auto& stats = db->result_cache().GetStatistics();
+
+    auto stmt = conn.CreatePreparedStatement("SELECT ? + 5");
+    ASSERT_TRUE(stmt.ok()) << stmt.status().message();
+    ASSERT_TRUE(conn.RunPreparedStatement(*stmt, "[4]").ok());
+    ASSERT_TRUE(conn.RunPreparedStatement(*stmt, "[ 4 ]").ok());
+    ASSERT_EQ(stats.hits, 1);
+    // Different parameters miss
+    ASSERT_TRUE(conn.RunPreparedStatement(*stmt, "[5]").ok());
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.misses, 2);
+}
+
+TEST(QueryResultCache, InvalidateOnWrite) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection conn{*db};
+    auto& stats = db->result_cache().GetStatistics();
+
+    ASSERT_TRUE(conn.RunQuery("CREATE TABLE foo (v INTEGER)").ok());
+    auto before = conn.RunQuery("SELECT count(*) FROM foo");
+    ASSERT_TRUE(before.ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 1);
+    ASSERT_TRUE(conn.RunQuery("INSERT INTO foo VALUES (1), (2)").ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 0);
+    auto after = conn.RunQuery("SELECT count(*) FROM foo");
+    ASSERT_TRUE(after.ok());
+    ASSERT_EQ(stats.hits, 0);
+    ASSERT_FALSE((*before)->Equals(**after));
+
+    // Open transactions bypass the cache
+    ASSERT_TRUE(conn.RunQuery("BEGIN TRANSACTION").ok());
+    ASSERT_TRUE(conn.RunQuery("SELECT count(*) FROM foo").ok());
+    ASSERT_TRUE(conn.RunQuery("SELECT count(*) FROM foo").ok());
+    ASSERT_EQ(stats.hits, 0);
+    ASSERT_TRUE(conn.RunQuery("COMMIT").ok());
+}
+
+TEST(QueryResultCache, InvalidateOnFiles) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection conn{*db};
+
+    ASSERT_TRUE(conn.RunQuery("SELECT 1").ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 1);
+    ASSERT_TRUE(db->DropFile("foo.csv").ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 0);
+
+    ASSERT_TRUE(conn.RunQuery("SELECT 1").ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 1);
+    ASSERT_TRUE(db->DropFiles().ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 0);
+
+    ASSERT_TRUE(conn.RunQuery("SELECT 1").ok());
+    db->ClearResultCache();
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 0);
+}
+
+TEST(QueryResultCache, SessionState) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection a{*db};
+    WebDB::Connection b{*db};
+    WebDB::Connection c{*db};
+    auto& stats = db->result_cache().GetStatistics();
+
+    // The temporary table of a shadows the table of b
+    ASSERT_TRUE(b.RunQuery("CREATE TABLE t AS SELECT 'main' AS v").ok());
+    ASSERT_TRUE(a.RunQuery("CREATE TEMP TABLE t AS SELECT 'temp' AS v").ok());
+    auto temp = a.RunQuery("SELECT v FROM t");
+    ASSERT_TRUE(temp.ok()) << temp.status().message();
+    auto main = b.RunQuery("SELECT v FROM t");
+    ASSERT_TRUE(main.ok()) << main.status().message();
+    ASSERT_EQ(stats.hits, 0);
+    ASSERT_FALSE((*temp)->Equals(**main));
+
+    // Connections without session state share their results
+    auto shared = c.RunQuery("SELECT v FROM t");
+    ASSERT_TRUE(shared.ok()) << shared.status().message();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(shared->get(), main->get());
+    auto again = a.RunQuery("SELECT v FROM t");
+    ASSERT_TRUE(again.ok()) << again.status().message();
+    ASSERT_EQ(stats.hits, 2);
+    ASSERT_EQ(again->get(), temp->get());
+
+    // Settings scope the results as well
+    ASSERT_TRUE(c.RunQuery("SET threads = 1").ok());
+    ASSERT_TRUE(c.RunQuery("SELECT v FROM t").ok());
+    ASSERT_TRUE(b.RunQuery("SELECT v FROM t").ok());
+    ASSERT_EQ(stats.hits, 2);
+}
+
+TEST(QueryResultCache, VolatileQueries) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(CACHE_CONFIG).ok());
+    WebDB::Connection conn{*db};
+    ASSERT_TRUE(conn.RunQuery("SELECT random()").ok());
+    ASSERT_TRUE(conn.RunQuery("SELECT now()").ok());
+    ASSERT_TRUE(conn.RunQuery("SELECT gen_random_uuid()").ok());
+    ASSERT_EQ(db->result_cache().GetEntryCount(), 0);
+}
+
+TEST(QueryResultCache, Eviction) {
+    QueryResultCache cache;
+    cache.Configure(1000);
+    auto version = cache.GetVersion();
+    cache.Insert("a", version, MakeResult(400));
+    cache.Insert("b", version, MakeResult(400));
+    // Touch a, b is least recently used
+    ASSERT_NE(cache.Find("a"), nullptr);
+    cache.Insert("c", version, MakeResult(400));
+    ASSERT_EQ(cache.GetEntryCount(), 2);
+    ASSERT_EQ(cache.Find("b"), nullptr);
+    ASSERT_NE(cache.Find("a"), nullptr);
+    ASSERT_NE(cache.Find("c"), nullptr);
+    ASSERT_EQ(cache.GetStatistics().evictions, 1);
+    ASSERT_LE(cache.GetSize(), 1000);
+    // Results over the budget are not cached
+    cache.Insert("d", version, MakeResult(2000));
+    ASSERT_EQ(cache.Find("d"), nullptr);
+}
+
+TEST(QueryResultCache, StaleVersion) {
+    QueryResultCache cache;
+    cache.Configure(1000);
+    auto version = cache.GetVersion();
+    cache.Invalidate();
+    cache.Insert("a", version, MakeResult(10));
+    ASSERT_EQ(cache.GetEntryCount(), 0);
+    cache.Insert("a", cache.GetVersion(), MakeResult(10));
+    ASSERT_EQ(cache.GetEntryCount(), 1);
+}
+
+}  // namespace
@@ -0,0 +1,142 @@
+#include "duckdb/web/io/range_prefetcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace duckdb::web::io;
+using namespace std;
+
+namespace {
+
+/// A remote file that counts the concurrent reads
+struct RemoteFile {
+    std::vector<char> data;
+    std::atomic<size_t> reads = 0;
+    std::atomic<size_t> active = 0;
+    std::atomic<size_t> max_active = 0;
+    duckdb::idx_t fail_at = std::numeric_limits<duckdb::idx_t>::max();
+
+    RemoteFile(size_t size) : data(size) { std::iota(data.begin(), data.end(), 0); }
+
+    size_t Read(void* out, size_t n, duckdb::idx_t ofs) {
+        ++reads;
+        auto now = ++active;
+        auto prev = max_active.load();
+        while (prev < now && !max_active.compare_exchange_weak(prev, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --active;
+        if (ofs <= fail_at && fail_at < ofs + n) throw std::runtime_error("request failed");
+        auto here = std::min<size_t>(n, data.size() - std::min<size_t>(ofs, data.size()));
+        std::memcpy(out, data.data() + ofs, here);
+        return here;
+    }
+};
+
+/// Read a file sequentially through the prefetcher, falling back to the file
+std::vector<char> ReadAll(RangePrefetcher& prefetcher, RemoteFile& file, size_t chunk) {
+    std::vector<char> out(file.data.size());
+    size_t ofs = 0;
+    while (ofs < out.size()) {
+        auto n = std::min(chunk, out.size() - ofs);
+        auto here = prefetcher.Read(out.data() + ofs, n, ofs);
+        ofs += here ? *here : file.Read(out.data() + ofs, n, ofs);
+    }
+    return out;
+}
+
+TEST(RangePrefetcherTest, SequentialReads) {
+    RemoteFile file{10000};
+    RangePrefetcher prefetcher{file.data.size(),
+                               [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); }, 1024,
+                               4};
+    auto out = ReadAll(prefetcher, file, 300);
+    ASSERT_EQ(out, file.data);
+    ASSERT_EQ(prefetcher.GetMissedReads(), 0);
+    ASSERT_EQ(prefetcher.GetServedBytes(), file.data.size());
+    ASSERT_EQ(prefetcher.GetFetchedBytes(), file.data.size());
+    ASSERT_EQ(file.reads, 10);
+    ASSERT_GT(file.max_active, 1);
+    ASSERT_LE(file.max_active, 4);
+}
+
+TEST(RangePrefetcherTest, ConcurrentReaders) {
+    constexpr size_t READERS = 4;
+    constexpr size_t RANGE_SIZE = 512;
+    RemoteFile file{RANGE_SIZE * 32};
+    RangePrefetcher prefetcher{file.data.size(),
+                               [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); },
+                               RANGE_SIZE, 2};
+
+    // Every reader takes every READERS-th range, the ranges are consumed out of order
+    std::vector<char> out(file.data.size());
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < READERS; ++r) {
+        readers.emplace_back([&, r]() {
+            for (size_t ofs = r * RANGE_SIZE; ofs < out.size(); ofs += READERS * RANGE_SIZE) {
+                for (size_t pos = ofs; pos < ofs + RANGE_SIZE;) {
+                    auto n = ofs + RANGE_SIZE - pos;
+                    auto here = prefetcher.Read(out.data() + pos, n, pos);
+                    pos += here ? *here : file.Read(out.data() + pos, n, pos);
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) reader.join();
+    ASSERT_EQ(out, file.data);
+    ASSERT_GT(prefetcher.GetServedBytes(), 0);
+}
+
+TEST(RangePrefetcherTest, SkipAhead) {
+    RemoteFile file{16 * 1024};
+    RangePrefetcher prefetcher{file.data.size(),
+                               [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); }, 1024,
+                               1};
+
+    // Skip the first half of the file, the read misses and moves the prefetching forward
+    std::vector<char> out(100);
+    size_t ofs = 8 * 1024 + 10;
+    while (!prefetcher.Read(out.data(), out.size(), ofs)) {
+        ASSERT_EQ(file.Read(out.data(), out.size(), ofs), out.size());
+        ofs += 1024;
+    }
+    ASSERT_TRUE(std::equal(out.begin(), out.end(), file.data.begin() + ofs));
+    ASSERT_LT(prefetcher.GetFetchedBytes(), file.data.size());
+}
+
+TEST(RangePrefetcherTest, FailedRange) {
+    RemoteFile file{4096};
+    file.fail_at = 1500;
+    RangePrefetcher prefetcher{file.data.size(),
+                               [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); }, 1024,
+                               2};
+
+    // The failed range is read from the file again
+    std::vector<char> out(1024);
+    ASSERT_EQ(prefetcher.Read(out.data(), out.size(), 0), 1024);
+    ASSERT_FALSE(prefetcher.Read(out.data(), out.size(), 1024).has_value());
+    ASSERT_EQ(prefetcher.GetMissedReads(), 1);
+    ASSERT_EQ(prefetcher.Read(out.data(), out.size(), 2048), 1024);
+    ASSERT_TRUE(std::equal(out.begin(), out.end(), file.data.begin() + 2048));
+}
+
+TEST(RangePrefetcherTest, StopWhileFetching) {
+    RemoteFile file{1 << 20};
+    RangePrefetcher prefetcher{file.data.size(),
+                               [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); }, 1024,
+                               4};
+    std::vector<char> out(100);
+    ASSERT_TRUE(prefetcher.Read(out.data(), out.size(), 0).has_value());
+    prefetcher.Stop();
+    ASSERT_FALSE(prefetcher.Read(out.data(), out.size(), 100).has_value());
+    ASSERT_LT(file.reads, 16);
+}
+
+}  // namespace
@@ -0,0 +1,230 @@
+#include "duckdb/web/io/single_flight.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace duckdb::web::io;
+using namespace std;
+
+namespace {
+
+struct TestableSingleFlightReader : public SingleFlightReader {
+    /// Count the readers that wait for an in-flight read of a file
+    size_t CountWaiters(uint32_t file_id) {
+        std::unique_lock<std::mutex> guard{mutex_};
+        auto iter = flights_.find(file_id);
+        if (iter == flights_.end()) return 0;
+        size_t n = 0;
+        for (auto& flight : iter->second) n += flight->waiters;
+        return n;
+    }
+};
+
+/// A remote file that blocks the first read until it is released
+struct BlockingFile {
+    std::vector<char> data;
+    std::atomic<size_t> reads = 0;
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    bool fail = false;
+    bool fail_retries = false;
+
+    BlockingFile(size_t size) : data(size) { std::iota(data.begin(), data.end(), 0); }
+
+    size_t Read(void* out, size_t n, duckdb::idx_t ofs) {
+        if (reads++ == 0) {
+            started = true;
+            while (!released) std::this_thread::yield();
+            if (fail) throw std::runtime_error("request failed");
+        } else if (fail_retries) {
+            throw std::runtime_error("request failed");
+        }
+        auto here = std::min<size_t>(n, data.size() - std::min<size_t>(ofs, data.size()));
+        std::memcpy(out, data.data() + ofs, here);
+        return here;
+    }
+};
+
+TEST(SingleFlightReaderTest, IdenticalRanges) {
+    constexpr size_t FILE_ID = 1;
+    constexpr size_t READERS = 4;
+    TestableSingleFlightReader reader;
+    BlockingFile file{1024};
+    auto read_fn = [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); };
+
+    std::vector<std::vector<char>> out(READERS, std::vector<char>(256));
+    std::vector<size_t> bytes_read(READERS);
+    std::vector<std::thread> threads;
+    threads.emplace_back([&]() { bytes_read[0] = reader.Read(FILE_ID, out[0].data(), 256, 128, read_fn); });
+    while (!file.started) std::this_thread::yield();
+    for (size_t i = 1; i < READERS; ++i) {
+        threads.emplace_back([&, i]() { bytes_read[i] = reader.Read(FILE_ID, out[i].data(), 256, 128, read_fn); });
+    }
+    while (reader.CountWaiters(FILE_ID) < (READERS - 1)) std::this_thread::yield();
+    file.released = true;
+    for (auto& t : threads) t.join();
+
+    std::vector<char> expected{file.data.begin() + 128, file.data.begin() + 384};
+    for (size_t i = 0; i < READERS; ++i) {
+        ASSERT_EQ(bytes_read[i], 256);
+        ASSERT_EQ(out[i], expected);
+    }
+    ASSERT_EQ(file.reads, 1);
+    ASSERT_EQ(reader.GetIssuedReads(), 1);
+    ASSERT_EQ(reader.GetSharedReads(), READERS - 1);
+    ASSERT_EQ(reader.CountWaiters(FILE_ID), 0);
+}
+
+TEST(SingleFlightReaderTest, OverlappingRanges) {
+    constexpr size_t FILE_ID = 1;
+    TestableSingleFlightReader reader;
+    BlockingFile file{1024};
+    auto read_fn = [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); };
+
+    std::vector<char> leader_out(512);
+    std::vector<char> contained_out(128);
+    std::vector<char> overlapping_out(512);
+    size_t contained_bytes = 0;
+    size_t overlapping_bytes = 0;
+
+    std::thread leader{[&]() { reader.Read(FILE_ID, leader_out.data(), 512, 0, read_fn); }};
+    while (!file.started) std::this_thread::yield();
+    std::thread contained{[&]() { contained_bytes = reader.Read(FILE_ID, contained_out.data(), 128, 64, read_fn); }};
+    std::thread overlapping{
+        [&]() { overlapping_bytes = reader.Read(FILE_ID, overlapping_out.data(), 512, 384, read_fn); }};
+    while (reader.CountWaiters(FILE_ID) < 2) std::this_thread::yield();
+    file.released = true;
+    leader.join();
+    contained.join();
+    overlapping.join();
+
+    // The contained range is served entirely, the overlapping range receives a short read
+    ASSERT_EQ(contained_bytes, 128);
+    ASSERT_EQ(overlapping_bytes, 128);
+    ASSERT_EQ(contained_out, (std::vector<char>{file.data.begin() + 64, file.data.begin() + 192}));
+    ASSERT_TRUE(std::equal(overlapping_out.begin(), overlapping_out.begin() + 128, file.data.begin() + 384));
+    ASSERT_EQ(file.reads, 1);
+}
+
+TEST(SingleFlightReaderTest, DisjointRanges) {
+    constexpr size_t FILE_ID = 1;
+    TestableSingleFlightReader reader;
+    BlockingFile file{1024};
+    file.released = true;
+    auto read_fn = [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); };
+
+    std::vector<char> out(256);
+    ASSERT_EQ(reader.Read(FILE_ID, out.data(), 256, 0, read_fn), 256);
+    ASSERT_EQ(reader.Read(FILE_ID, out.data(), 256, 0, read_fn), 256);
+    ASSERT_EQ(reader.Read(FILE_ID + 1, out.data(), 256, 0, read_fn), 256);
+    ASSERT_EQ(file.reads, 3);
+    ASSERT_EQ(reader.GetSharedReads(), 0);
+}
+
+TEST(SingleFlightReaderTest, LeaderFailure) {
+    constexpr size_t FILE_ID = 1;
+    TestableSingleFlightReader reader;
+    BlockingFile file{1024};
+    file.fail = true;
+    auto read_fn = [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); };
+
+    std::vector<char> leader_out(256);
+    std::vector<char> follower_out(256);
+    bool leader_failed = false;
+    size_t follower_bytes = 0;
+    std::thread leader{[&]() {
+        try {
+            reader.Read(FILE_ID, leader_out.data(), 256, 0, read_fn);
+        } catch (const std::runtime_error&) {
+            leader_failed = true;
+        }
+    }};
+    while (!file.started) std::this_thread::yield();
+    std::thread follower{[&]() { follower_bytes = reader.Read(FILE_ID, follower_out.data(), 256, 0, read_fn); }};
+    while (reader.CountWaiters(FILE_ID) < 1) std::this_thread::yield();
+    file.released = true;
+    leader.join();
+    follower.join();
+
+    // The follower retries the read
+    ASSERT_TRUE(leader_failed);
+    ASSERT_EQ(follower_bytes, 256);
+    ASSERT_EQ(follower_out, (std::vector<char>{file.data.begin(), file.data.begin() + 256}));
+    ASSERT_EQ(file.reads, 2);
+}
+
+TEST(SingleFlightReaderTest, LeaderFailureSingleRetry) {
+    constexpr size_t FILE_ID = 1;
+    constexpr size_t FOLLOWERS = 4;
+    TestableSingleFlightReader reader;
+    BlockingFile file{1024};
+    file.fail = true;
+    auto read_fn = [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); };
+
+    std::vector<char> leader_out(512);
+    std::thread leader{
+        [&]() { ASSERT_THROW(reader.Read(FILE_ID, leader_out.data(), 512, 0, read_fn), std::runtime_error); }};
+    while (!file.started) std::this_thread::yield();
+    std::vector<std::vector<char>> out(FOLLOWERS, std::vector<char>(128));
+    std::vector<size_t> bytes_read(FOLLOWERS);
+    std::vector<std::thread> followers;
+    for (size_t i = 0; i < FOLLOWERS; ++i) {
+        followers.emplace_back(
+            [&, i]() { bytes_read[i] = reader.Read(FILE_ID, out[i].data(), 128, i * 100, read_fn); });
+    }
+    while (reader.CountWaiters(FILE_ID) < FOLLOWERS) std::this_thread::yield();
+    file.released = true;
+    leader.join();
+    for (auto& follower : followers) follower.join();
+
+    // One follower retries the range of the failed read, the others share the retry
+    ASSERT_EQ(file.reads, 2);
+    for (size_t i = 0; i < FOLLOWERS; ++i) {
+        ASSERT_EQ(bytes_read[i], 128);
+        ASSERT_TRUE(std::equal(out[i].begin(), out[i].end(), file.data.begin() + i * 100));
+    }
+}
+
+TEST(SingleFlightReaderTest, RetryFailure) {
+    constexpr size_t FILE_ID = 1;
+    constexpr size_t FOLLOWERS = 3;
+    TestableSingleFlightReader reader;
+    BlockingFile file{1024};
+    file.fail = true;
+    file.fail_retries = true;
+    auto read_fn = [&](void* out, size_t n, duckdb::idx_t ofs) { return file.Read(out, n, ofs); };
+
+    std::vector<char> leader_out(256);
+    std::thread leader{
+        [&]() { ASSERT_THROW(reader.Read(FILE_ID, leader_out.data(), 256, 0, read_fn), std::runtime_error); }};
+    while (!file.started) std::this_thread::yield();
+    std::vector<std::vector<char>> out(FOLLOWERS, std::vector<char>(256));
+    std::atomic<size_t> failures = 0;
+    std::vector<std::thread> followers;
+    for (size_t i = 0; i < FOLLOWERS; ++i) {
+        followers.emplace_back([&, i]() {
+            try {
+                reader.Read(FILE_ID, out[i].data(), 256, 0, read_fn);
+            } catch (const std::runtime_error&) {
+                ++failures;
+            }
+        });
+    }
+    while (reader.CountWaiters(FILE_ID) < FOLLOWERS) std::this_thread::yield();
+    file.released = true;
+    leader.join();
+    for (auto& follower : followers) follower.join();
+
+    // The failed retry fails all followers without further requests
+    ASSERT_EQ(failures, FOLLOWERS);
+    ASSERT_EQ(file.reads, 2);
+}
+
+}  // namespace
@@ -0,0 +1,168 @@
+#include "duckdb/web/spilled_query_result.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "arrow/array/array_primitive.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/table.h"
+#include "duckdb/web/webdb.h"
+#include "gtest/gtest.h"
+
+using namespace duckdb::web;
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Create an empty spill directory
+fs::path CreateSpillDirectory() {
+    static uint64_t NEXT_SPILL_DIR = 0;
+
+    auto cwd = fs::current_path();
+    auto tmp = cwd / ".tmp";
+    auto dir = tmp / (std::string("test_spill_") + std::to_string(NEXT_SPILL_DIR++));
+    if (!fs::is_directory(tmp) || !fs::exists(tmp)) fs::create_directory(tmp);
+    if (fs::exists(dir)) fs::remove_all(dir);
+    fs::create_directory(dir);
+    return dir;
+}
+
+/// Open a database that spills results to a directory
+std::shared_ptr<WebDB> OpenSpillingDB(const fs::path& dir, std::string_view query_options = "") {
+    auto db = make_shared<WebDB>(NATIVE);
+    auto config = std::string{R"JSON({"query": {"resultSpillDirectory": ")JSON"} + dir.string() + "\"" +
+                  std::string{query_options} + "}}";
+    auto status = db->Open(config);
+    EXPECT_TRUE(status.ok()) << status.message();
+    return db;
+}
+
+/// Read an IPC stream as table
+std::shared_ptr<arrow::Table> ReadIPCStream(const std::shared_ptr<arrow::Buffer>& buffer) {
+    auto input = std::make_shared<arrow::io::BufferReader>(buffer);
+    auto reader = arrow::ipc::RecordBatchStreamReader::Open(input).ValueOrDie();
+    return reader->ToTable().ValueOrDie();
+}
+
+/// Get the integer value of a column at a row
+int64_t GetValue(const arrow::Table& table, int column, int64_t row) {
+    auto chunks = table.column(column);
+    for (auto& chunk : chunks->chunks()) {
+        if (row < chunk->length()) return static_cast<const arrow::Int64Array&>(*chunk).Value(row);
+        row -= chunk->length();
+    }
+    return -1;
+}
+
+TEST(SpilledQueryResult, FetchRange) {
+    auto dir = CreateSpillDirectory();
+    auto db = OpenSpillingDB(dir, R"JSON(, "resultBatchRows": 1000)JSON");
+    WebDB::Connection conn{*db};
+
+    auto result = conn.SpillQuery("SELECT v, v::VARCHAR AS s FROM generate_series(0, 9999) AS t(v)");
+    ASSERT_TRUE(result.ok()) << result.status().message();
+    auto rows = conn.GetSpilledResultRowCount(*result);
+    ASSERT_TRUE(rows.ok());
+    ASSERT_EQ(*rows, 10000);
+
+    // A range inside a single batch
+    auto range = conn.FetchSpilledResultRange(*result, 2500, 100);
+    ASSERT_TRUE(range.ok()) << range.status().message();
+    auto table = ReadIPCStream(*range);
+    ASSERT_EQ(table->num_rows(), 100);
+    ASSERT_EQ(table->num_columns(), 2);
+    ASSERT_EQ(GetValue(*table, 0, 0), 2500);
+    ASSERT_EQ(GetValue(*table, 0, 99), 2599);
+
+    // A range across batches
+    range = conn.FetchSpilledResultRange(*result, 1500, 3000);
+    ASSERT_TRUE(range.ok()) << range.status().message();
+    table = ReadIPCStream(*range);
+    ASSERT_EQ(table->num_rows(), 3000);
+    for (int64_t i = 0; i < table->num_rows(); ++i) {
+        ASSERT_EQ(GetValue(*table, 0, i), 1500 + i);
+    }
+
+    // Ranges at the end
+    table = ReadIPCStream(*conn.FetchSpilledResultRange(*result, 9990, 100));
+    ASSERT_EQ(table->num_rows(), 10);
+    ASSERT_EQ(GetValue(*table, 0, 9), 9999);
+    table = ReadIPCStream(*conn.FetchSpilledResultRange(*result, 20000, 100));
+    ASSERT_EQ(table->num_rows(), 0);
+    ASSERT_EQ(table->num_columns(), 2);
+}
+
+TEST(SpilledQueryResult, EmptyResult) {
+    auto dir = CreateSpillDirectory();
+    auto db = OpenSpillingDB(dir);
+    WebDB::Connection conn{*db};
+
+    auto result = conn.SpillQuery("SELECT v FROM generate_series(0, 10) AS t(v) WHERE v < 0");
+    ASSERT_TRUE(result.ok()) << result.status().message();
+    ASSERT_EQ(*conn.GetSpilledResultRowCount(*result), 0);
+    auto table = ReadIPCStream(*conn.FetchSpilledResultRange(*result, 0, 10));
+    ASSERT_EQ(table->num_rows(), 0);
+}
+
+TEST(SpilledQueryResult, DictionaryEncodedStrings) {
+    auto dir = CreateSpillDirectory();
+    auto db = OpenSpillingDB(dir, R"JSON(, "dictionaryEncodeStrings": true)JSON");
+    WebDB::Connection conn{*db};
+
+    // Spilled batches are plain, ranges do not depend on earlier dictionary deltas
+    auto result = conn.SpillQuery("SELECT v, (v % 10)::VARCHAR AS s FROM generate_series(0, 9999) AS t(v)");
+    ASSERT_TRUE(result.ok()) << result.status().message();
+    auto range = conn.FetchSpilledResultRange(*result, 5000, 10);
+    ASSERT_TRUE(range.ok()) << range.status().message();
+    auto table = ReadIPCStream(*range);
+    ASSERT_EQ(table->num_rows(), 10);
+    ASSERT_EQ(GetValue(*table, 0, 0), 5000);
+}
+
+TEST(SpilledQueryResult, Close) {
+    auto dir = CreateSpillDirectory();
+    auto db = OpenSpillingDB(dir);
+    WebDB::Connection conn{*db};
+
+    auto result = conn.SpillQuery("SELECT v FROM generate_series(0, 9999) AS t(v)");
+    ASSERT_TRUE(result.ok()) << result.status().message();
+    ASSERT_FALSE(fs::is_empty(dir));
+    ASSERT_TRUE(conn.CloseSpilledResult(*result).ok());
+    ASSERT_TRUE(fs::is_empty(dir));
+    ASSERT_FALSE(conn.FetchSpilledResultRange(*result, 0, 10).ok());
+    ASSERT_FALSE(conn.CloseSpilledResult(*result).ok());
+}
+
+TEST(SpilledQueryResult, DefaultDirectory) {
+    auto count_spill_files = []() {
+        size_t count = 0;
+        for (auto& entry : fs::directory_iterator{fs::temp_directory_path()}) {
+            count += entry.path().filename().string().rfind("duckdb_result_", 0) == 0;
+        }
+        return count;
+    };
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open().ok());
+    WebDB::Connection conn{*db};
+
+    // Native builds spill to the temp directory
+    auto before = count_spill_files();
+    auto result = conn.SpillQuery("SELECT v FROM generate_series(0, 9999) AS t(v)");
+    ASSERT_TRUE(result.ok()) << result.status().message();
+    ASSERT_EQ(count_spill_files(), before + 1);
+    ASSERT_TRUE(conn.CloseSpilledResult(*result).ok());
+    ASSERT_EQ(count_spill_files(), before);
+}
+
+TEST(SpilledQueryResult, InvalidQuery) {
+    auto dir = CreateSpillDirectory();
+    auto db = OpenSpillingDB(dir);
+    WebDB::Connection conn{*db};
+    ASSERT_FALSE(conn.SpillQuery("SELECT * FROM missing_table").ok());
+    ASSERT_TRUE(fs::is_empty(dir));
+}
+
+}  // namespace
@@ -1,7 +1,16 @@
 #include "duckdb/web/webdb.h"
 
 #include <filesystem>
+#include <utility>
+#include <vector>
 
+#include "arrow/array/builder_binary.h"
+#include "arrow/array/builder_primitive.h"
+#include "arrow/c/bridge.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/util/compression.h"
 #include "duckdb/web/config.h"
 #include "duckdb/web/io/web_filesystem.h"
 #include "gtest/gtest.h"
@@ -156,4 +165,278 @@ TEST(WebDB, GlobalFileInfo) {
     auto current_epoch = doc["cacheEpoch"].GetInt();
     ASSERT_STREQ(db->GetGlobalFileInfo(current_epoch).ValueOrDie().c_str(), "");
 }
+
+TEST(WebDB, ResultCompression) {
+    constexpr const char* QUERY =
+        "SELECT v, 'a rather long and repetitive string ' || (v % 10) AS s FROM range(10000) t(v)";
+    auto plain_db = make_shared<WebDB>(NATIVE);
+    WebDB::Connection plain_conn{*plain_db};
+    auto plain = plain_conn.RunQuery(QUERY);
+    ASSERT_TRUE(plain.ok()) << plain.status().message();
+
+    std::vector<std::pair<std::string, arrow::Compression::type>> compressions{
+        {"lz4", arrow::Compression::LZ4_FRAME}, {"zstd", arrow::Compression::ZSTD}};
+    for (auto& [name, compression] : compressions) {
+        auto db = make_shared<WebDB>(NATIVE);
+        ASSERT_TRUE(db->Open(R"JSON({"query": {"resultCompression": ")JSON" + name + R"JSON("}})JSON").ok());
+        WebDB::Connection conn{*db};
+        auto buffer = conn.RunQuery(QUERY);
+        if (!arrow::util::Codec::IsAvailable(compression)) {
+            ASSERT_EQ(buffer.status().code(), arrow::StatusCode::NotImplemented) << name;
+            continue;
+        }
+        ASSERT_TRUE(buffer.ok()) << buffer.status().message();
+        ASSERT_LT((*buffer)->size(), (*plain)->size()) << name;
+
+        // Materialized and streamed results can be read back
+        arrow::io::BufferReader file{*buffer};
+        auto reader = arrow::ipc::RecordBatchFileReader::Open(&file).ValueOrDie();
+        int64_t rows = 0;
+        for (int i = 0; i < reader->num_record_batches(); ++i) {
+            rows += reader->ReadRecordBatch(i).ValueOrDie()->num_rows();
+        }
+        ASSERT_EQ(rows, 10000);
+        auto schema_buffer = conn.PendingQuery(QUERY, true);
+        ASSERT_TRUE(schema_buffer.ok()) << schema_buffer.status().message();
+        while (*schema_buffer == nullptr) schema_buffer = conn.PollPendingQuery();
+        arrow::io::BufferReader schema_reader{*schema_buffer};
+        arrow::ipc::DictionaryMemo memo;
+        auto schema = arrow::ipc::ReadSchema(&schema_reader, &memo).ValueOrDie();
+        rows = 0;
+        while (true) {
+            auto chunk = conn.FetchQueryResults();
+            if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+            ASSERT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+            if (*chunk.arrow_buffer == nullptr) break;
+            arrow::io::BufferReader message_reader{*chunk.arrow_buffer};
+            auto message = arrow::ipc::ReadMessage(&message_reader).ValueOrDie();
+            auto batch = arrow::ipc::ReadRecordBatch(*message, schema, &memo, arrow::ipc::IpcReadOptions::Defaults())
+                             .ValueOrDie();
+            rows += batch->num_rows();
+        }
+        ASSERT_EQ(rows, 10000);
+    }
+}
+
+/// Serialize record batches as IPC stream
+std::shared_ptr<arrow::Buffer> WriteIPCStream(const std::shared_ptr<arrow::RecordBatch>& batch) {
+    auto out = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto writer = arrow::ipc::MakeStreamWriter(out, batch->schema()).ValueOrDie();
+    EXPECT_TRUE(writer->WriteRecordBatch(*batch).ok());
+    EXPECT_TRUE(writer->Close().ok());
+    return out->Finish().ValueOrDie();
+}
+
+/// Read all record batches of an IPC file
+std::vector<std::shared_ptr<arrow::RecordBatch>> ReadIPCFile(const std::shared_ptr<arrow::Buffer>& buffer) {
+    arrow::io::BufferReader file{buffer};
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(&file).ValueOrDie();
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int i = 0; i < reader->num_record_batches(); ++i) {
+        batches.push_back(reader->ReadRecordBatch(i).ValueOrDie());
+    }
+    return batches;
+}
+
+TEST(WebDB, PreparedStatementBatch) {
+    auto db = make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    auto stmt = conn.CreatePreparedStatement("SELECT ? + 5 AS v, upper(?) AS s");
+    ASSERT_TRUE(stmt.ok()) << stmt.status().message();
+
+    // One parameter set per row, typed by the Arrow columns
+    arrow::Int64Builder ints;
+    ASSERT_TRUE(ints.AppendValues({1, 2, 3}).ok());
+    ASSERT_TRUE(ints.AppendNull().ok());
+    arrow::StringBuilder strings;
+    ASSERT_TRUE(strings.AppendValues({"a", "b", "c", "d"}).ok());
+    auto schema = arrow::schema({arrow::field("a", arrow::int64()), arrow::field("b", arrow::utf8())});
+    auto params = arrow::RecordBatch::Make(schema, 4, {ints.Finish().ValueOrDie(), strings.Finish().ValueOrDie()});
+    auto stream = WriteIPCStream(params);
+    nonstd::span<const uint8_t> stream_data{stream->data(), static_cast<size_t>(stream->size())};
+    auto buffer = conn.RunPreparedStatementBatch(*stmt, stream_data);
+    ASSERT_TRUE(buffer.ok()) << buffer.status().message();
+
+    std::vector<std::string> values;
+    for (auto& batch : ReadIPCFile(*buffer)) {
+        for (int64_t i = 0; i < batch->num_rows(); ++i) {
+            values.push_back(batch->column(0)->GetScalar(i).ValueOrDie()->ToString() + "," +
+                             batch->column(1)->GetScalar(i).ValueOrDie()->ToString());
+        }
+    }
+    ASSERT_EQ(values, (std::vector<std::string>{"6,A", "7,B", "8,C", "null,D"}));
+
+    // Writes are executed per row
+    ASSERT_TRUE(conn.RunQuery("CREATE TABLE foo (a BIGINT, b VARCHAR)").ok());
+    auto insert = conn.CreatePreparedStatement("INSERT INTO foo VALUES (?, ?)");
+    ASSERT_TRUE(insert.ok()) << insert.status().message();
+    ASSERT_TRUE(conn.RunPreparedStatementBatch(*insert, stream_data).ok());
+    auto count = conn.RunQuery("SELECT count(*)::INTEGER FROM foo WHERE a IS NOT NULL");
+    ASSERT_TRUE(count.ok()) << count.status().message();
+    auto count_batches = ReadIPCFile(*count);
+    ASSERT_EQ(count_batches[0]->column(0)->GetScalar(0).ValueOrDie()->ToString(), "3");
+
+    // Unknown statements and mismatching parameters fail
+    ASSERT_EQ(conn.RunPreparedStatementBatch(42, stream_data).status().code(), arrow::StatusCode::KeyError);
+    auto single = conn.CreatePreparedStatement("SELECT ? + 1");
+    ASSERT_TRUE(single.ok());
+    ASSERT_FALSE(conn.RunPreparedStatementBatch(*single, stream_data).ok());
+}
+
+TEST(WebDB, FirstBatchWithSchema) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(R"JSON({"query": {"firstBatchRows": 100}})JSON").ok());
+    WebDB::Connection conn{*db};
+    for (auto* query : {"SELECT v FROM generate_series(0, 9999) AS t(v)", "SELECT 1 AS v WHERE false"}) {
+        auto header = conn.PendingQuery(query, true);
+        ASSERT_TRUE(header.ok()) << header.status().message();
+        while (*header == nullptr) header = conn.PollPendingQuery();
+
+        // The header holds the schema followed by the first record batch
+        arrow::io::BufferReader header_reader{*header};
+        arrow::ipc::DictionaryMemo memo;
+        auto schema = arrow::ipc::ReadSchema(&header_reader, &memo).ValueOrDie();
+        int64_t rows = 0;
+        auto read_batches = [&](arrow::io::BufferReader& reader) {
+            for (auto message = arrow::ipc::ReadMessage(&reader).ValueOrDie(); message;
+                 message = arrow::ipc::ReadMessage(&reader).ValueOrDie()) {
+                auto batch = arrow::ipc::ReadRecordBatch(*message, schema, &memo, arrow::ipc::IpcReadOptions::Defaults())
+                                 .ValueOrDie();
+                rows += batch->num_rows();
+            }
+        };
+        read_batches(header_reader);
+        auto first_rows = rows;
+        while (true) {
+            auto chunk = conn.FetchQueryResults();
+            if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+            ASSERT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+            if (*chunk.arrow_buffer == nullptr) break;
+            arrow::io::BufferReader chunk_reader{*chunk.arrow_buffer};
+            read_batches(chunk_reader);
+        }
+        if (rows > 0) {
+            ASSERT_GE(first_rows, 100);
+            ASSERT_EQ(rows, 10000);
+        } else {
+            ASSERT_EQ(first_rows, 0);
+        }
+    }
+}
+
+/// Wait for the schema of a query handle
+std::shared_ptr<arrow::Schema> PollQueryHandle(WebDB::Connection& conn, size_t query_id) {
+    auto header = conn.PollPendingQuery(query_id);
+    while (header.ok() && *header == nullptr) header = conn.PollPendingQuery(query_id);
+    EXPECT_TRUE(header.ok()) << header.status().message();
+    arrow::io::BufferReader header_reader{*header};
+    arrow::ipc::DictionaryMemo memo;
+    return arrow::ipc::ReadSchema(&header_reader, &memo).ValueOrDie();
+}
+
+/// Fetch the next record batch of a query handle, returns nullptr at the end
+std::shared_ptr<arrow::RecordBatch> FetchQueryHandle(WebDB::Connection& conn, size_t query_id,
+                                                     const std::shared_ptr<arrow::Schema>& schema) {
+    while (true) {
+        auto chunk = conn.FetchQueryResults(query_id);
+        if (chunk.status == DuckDBWasmResultsWrapper::ResponseStatus::DUCKDB_WASM_RETRY) continue;
+        EXPECT_TRUE(chunk.arrow_buffer.ok()) << chunk.arrow_buffer.status().message();
+        if (!chunk.arrow_buffer.ok() || *chunk.arrow_buffer == nullptr) return nullptr;
+        arrow::io::BufferReader message_reader{*chunk.arrow_buffer};
+        auto message = arrow::ipc::ReadMessage(&message_reader).ValueOrDie();
+        return arrow::ipc::ReadRecordBatch(*message, schema, nullptr, arrow::ipc::IpcReadOptions::Defaults())
+            .ValueOrDie();
+    }
+}
+
+TEST(WebDB, QueryHandles) {
+    auto db = make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    auto a = conn.StartPendingQuery("SELECT v FROM generate_series(0, 99999) AS t(v)", true);
+    ASSERT_TRUE(a.ok()) << a.status().message();
+    auto a_schema = PollQueryHandle(conn, *a);
+    auto a_batch = FetchQueryHandle(conn, *a, a_schema);
+    ASSERT_NE(a_batch, nullptr);
+    int64_t a_rows = a_batch->num_rows();
+
+    // Starting another query keeps the result of the first one
+    auto b = conn.StartPendingQuery("SELECT v * 2 AS w FROM generate_series(0, 9999) AS t(v)", true);
+    ASSERT_TRUE(b.ok()) << b.status().message();
+    auto b_schema = PollQueryHandle(conn, *b);
+    int64_t b_rows = 0;
+    bool a_done = false, b_done = false;
+    while (!a_done || !b_done) {
+        if (!b_done) {
+            auto batch = FetchQueryHandle(conn, *b, b_schema);
+            b_done = batch == nullptr;
+            if (batch) b_rows += batch->num_rows();
+        }
+        if (!a_done) {
+            auto batch = FetchQueryHandle(conn, *a, a_schema);
+            a_done = batch == nullptr;
+            if (batch) a_rows += batch->num_rows();
+        }
+    }
+    ASSERT_EQ(a_rows, 100000);
+    ASSERT_EQ(b_rows, 10000);
+
+    // Handles are closed at the end of their result
+    ASSERT_EQ(conn.PollPendingQuery(*a).status().code(), arrow::StatusCode::KeyError);
+    ASSERT_TRUE(conn.CloseQueryHandle(*b).ok());
+    ASSERT_TRUE(conn.RunQuery("SELECT 1").ok());
+}
+
+TEST(WebDB, QueryHandleErrors) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(R"JSON({"query": {"queryPollingInterval": 0}})JSON").ok());
+    WebDB::Connection conn{*db};
+    ASSERT_FALSE(conn.StartPendingQuery("SELECT * FROM missing_table", true).ok());
+
+    // A query that fails while it is suspended reports the error when it is polled
+    auto a = conn.StartPendingQuery("SELECT 1; SELECT * FROM missing_table", true);
+    ASSERT_TRUE(a.ok()) << a.status().message();
+    auto b = conn.StartPendingQuery("SELECT 42 AS v", true);
+    ASSERT_TRUE(b.ok()) << b.status().message();
+    auto b_schema = PollQueryHandle(conn, *b);
+    auto b_batch = FetchQueryHandle(conn, *b, b_schema);
+    ASSERT_NE(b_batch, nullptr);
+    ASSERT_EQ(b_batch->num_rows(), 1);
+    ASSERT_FALSE(conn.PollPendingQuery(*a).ok());
+    ASSERT_EQ(conn.PollPendingQuery(*a).status().code(), arrow::StatusCode::KeyError);
+    ASSERT_FALSE(conn.CancelPendingQuery(*a));
+}
+
+TEST(WebDB, ExportQuery) {
+    auto db = make_shared<WebDB>(NATIVE);
+    WebDB::Connection conn{*db};
+    ArrowArrayStream stream;
+    ASSERT_TRUE(conn.ExportQuery("SELECT v, v::VARCHAR AS s FROM generate_series(0, 9999) AS t(v)", &stream).ok());
+    // The stream stays valid while the connection runs other queries
+    ASSERT_TRUE(conn.RunQuery("SELECT 1").ok());
+    auto reader = arrow::ImportRecordBatchReader(&stream).ValueOrDie();
+    ASSERT_EQ(reader->schema()->num_fields(), 2);
+    int64_t rows = 0;
+    for (auto batch = reader->Next().ValueOrDie(); batch; batch = reader->Next().ValueOrDie()) {
+        ASSERT_TRUE(batch->ValidateFull().ok());
+        ASSERT_EQ(batch->column(0)->GetScalar(0).ValueOrDie()->ToString(), std::to_string(rows));
+        rows += batch->num_rows();
+    }
+    ASSERT_EQ(rows, 10000);
+
+    // Prepared statements and errors
+    auto stmt = conn.CreatePreparedStatement("SELECT ? + 5 AS v");
+    ASSERT_TRUE(stmt.ok()) << stmt.status().message();
+    ASSERT_TRUE(conn.ExportPreparedStatement(*stmt, "[4]", &stream).ok());
+    auto table = arrow::ImportRecordBatchReader(&stream).ValueOrDie()->ToTable().ValueOrDie();
+    ASSERT_EQ(table->num_rows(), 1);
+    ASSERT_EQ(table->column(0)->GetScalar(0).ValueOrDie()->ToString(), "9");
+    ASSERT_FALSE(conn.ExportQuery("INVALID SQL", &stream).ok());
+}
+
+TEST(WebDB, InvalidResultCompression) {
+    auto db = make_shared<WebDB>(NATIVE);
+    ASSERT_TRUE(db->Open(R"JSON({"query": {"resultCompression": "brotli"}})JSON").ok());
+    WebDB::Connection conn{*db};
+    ASSERT_EQ(conn.RunQuery("SELECT 1").status().code(), arrow::StatusCode::Invalid);
+}
 }  // namespace
@@ -260,6 +260,158 @@ export abstract class DuckDBBindingsBase implements DuckDBBindings {
         dropResponseBuffers(this.mod);
         return res;
     }
+    /** Start a pending query with its own query handle and return the handle identifier */
+    public startQueryHandle(conn: number, text: string, allowStreamResult: boolean = false): number {
+        const BUF = TEXT_ENCODER.encode(text);
+        const bufferPtr = this.mod._malloc(BUF.length);
+        const bufferOfs = this.mod.HEAPU8.subarray(bufferPtr, bufferPtr + BUF.length);
+        bufferOfs.set(BUF);
+        const [s, d, n] = callSRet(
+            this.mod,
+            'duckdb_web_query_handle_start',
+            ['number', 'number', 'number', 'boolean'],
+            [conn, bufferPtr, BUF.length, allowStreamResult],
+        );
+        this.mod._free(bufferPtr);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+        return d;
+    }
+    /** Poll the pending query of a query handle */
+    public pollQueryHandle(conn: number, query: number): Uint8Array | null {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_query_handle_poll', ['number', 'number'], [conn, query]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        if (d == 0) {
+            return null;
+        }
+        const res = copyBuffer(this.mod, d, n);
+        dropResponseBuffers(this.mod);
+        return res;
+    }
+    /** Cancel the pending query of a query handle */
+    public cancelQueryHandle(conn: number, query: number): boolean {
+        return this.mod.ccall('duckdb_web_query_handle_cancel', 'boolean', ['number', 'number'], [conn, query]);
+    }
+    /** Fetch query results of a query handle */
+    public fetchQueryHandleResults(conn: number, query: number): Uint8Array | null {
+        const [s, d, n] = callSRet(
+            this.mod,
+            'duckdb_web_query_handle_fetch_results',
+            ['number', 'number'],
+            [conn, query],
+        );
+        if (IsDuckDBWasmRetry(s)) {
+            dropResponseBuffers(this.mod);
+            return null; // Retry
+        }
+        if (!IsArrowBuffer(s)) {
+            throw new Error(
+                'Unexpected StatusCode from duckdb_web_query_handle_fetch_results (' +
+                    s +
+                    ') and with self reported error as' +
+                    readString(this.mod, d, n),
+            );
+        }
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        const res = copyBuffer(this.mod, d, n);
+        dropResponseBuffers(this.mod);
+        return res;
+    }
+    /** Close a query handle */
+    public closeQueryHandle(conn: number, query: number): void {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_query_handle_close', ['number', 'number'], [conn, query]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+    }
+    /**
+     * Run a query and export the result as arrow c stream.
+     * Returns the address of the ArrowArrayStream in the wasm memory, the buffers of the arrays can be viewed
+     * through HEAPU8 until they are released.
+     */
+    public exportQuery(conn: number, text: string): number {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_query_export', ['number', 'string'], [conn, text]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+        return d;
+    }
+    /** Run a query, spill the materialized result and return its identifier and row count */
+    public spillQuery(conn: number, text: string): [number, number] {
+        let [s, d, n] = callSRet(this.mod, 'duckdb_web_spilled_result_create', ['number', 'string'], [conn, text]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+        const result = d;
+        [s, d, n] = callSRet(this.mod, 'duckdb_web_spilled_result_row_count', ['number', 'number'], [conn, result]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+        return [result, d];
+    }
+    /** Fetch a row range of a spilled result as arrow ipc stream */
+    public fetchSpilledRange(conn: number, result: number, offset: number, limit: number): Uint8Array {
+        const [s, d, n] = callSRet(
+            this.mod,
+            'duckdb_web_spilled_result_fetch',
+            ['number', 'number', 'number', 'number'],
+            [conn, result, offset, limit],
+        );
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        const res = copyBuffer(this.mod, d, n);
+        dropResponseBuffers(this.mod);
+        return res;
+    }
+    /** Close a spilled result */
+    public closeSpilled(conn: number, result: number): void {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_spilled_result_close', ['number', 'number'], [conn, result]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+    }
+    /** Get the schema of an exported arrow c stream and return the address of the ArrowSchema */
+    public getArrowStreamSchema(stream: number): number {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_arrow_stream_schema', ['number'], [stream]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+        return d;
+    }
+    /** Get the next array of an exported arrow c stream and return the address of the ArrowArray, 0 at the end */
+    public getArrowStreamNext(stream: number): number {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_arrow_stream_next', ['number'], [stream]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+        return d;
+    }
+    /** Release an exported arrow c stream */
+    public releaseArrowStream(stream: number): void {
+        this.mod.ccall('duckdb_web_arrow_stream_release', null, ['number'], [stream]);
+    }
+    /** Release an exported arrow schema */
+    public releaseArrowSchema(schema: number): void {
+        this.mod.ccall('duckdb_web_arrow_schema_release', null, ['number'], [schema]);
+    }
+    /** Release an exported arrow array */
+    public releaseArrowArray(array: number): void {
+        this.mod.ccall('duckdb_web_arrow_array_release', null, ['number'], [array]);
+    }
     /** Get table names */
     public getTableNames(conn: number, text: string): string[] {
         const BUF = TEXT_ENCODER.encode(text);
@@ -370,6 +522,29 @@ export abstract class DuckDBBindingsBase implements DuckDBBindings {
         return res;
     }
 
+    /** Execute a prepared statement once per row of an arrow ipc stream and return the full result */
+    public runPreparedBatch(conn: number, statement: number, params: Uint8Array): Uint8Array {
+        // Store buffer
+        const bufferPtr = this.mod._malloc(params.length);
+        const bufferOfs = this.mod.HEAPU8.subarray(bufferPtr, bufferPtr + params.length);
+        bufferOfs.set(params);
+
+        // Call wasm function
+        const [s, d, n] = callSRet(
+            this.mod,
+            'duckdb_web_prepared_run_batch',
+            ['number', 'number', 'number', 'number'],
+            [conn, statement, bufferPtr, params.length],
+        );
+        this.mod._free(bufferPtr);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        const res = copyBuffer(this.mod, d, n);
+        dropResponseBuffers(this.mod);
+        return res;
+    }
+
     /** Execute a prepared statement and stream the result */
     public sendPrepared(conn: number, statement: number, params: any[]): Uint8Array {
         const [s, d, n] = callSRet(
@@ -395,16 +570,37 @@ export abstract class DuckDBBindingsBase implements DuckDBBindings {
         bufferOfs.set(buffer);
         const optJSON = options ? JSON.stringify(options) : '';
 
-        // Call wasm function
+        // Call wasm function, the buffer is owned and released by the connection
         const [s, d, n] = callSRet(
             this.mod,
-            'duckdb_web_insert_arrow_from_ipc_stream',
+            'duckdb_web_insert_arrow_from_ipc_buffer',
             ['number', 'number', 'number', 'string'],
             [conn, bufferPtr, buffer.length, optJSON],
         );
 
-        this.mod._free(bufferPtr);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+    }
 
+    /** Abort a pending arrow ipc stream insert and roll back the inserted batches */
+    public abortArrowIPCStream(conn: number): void {
+        const [s, d, n] = callSRet(this.mod, 'duckdb_web_abort_arrow_ipc_stream', ['number'], [conn]);
+        if (s !== StatusCode.SUCCESS) {
+            throw new Error(readString(this.mod, d, n));
+        }
+        dropResponseBuffers(this.mod);
+    }
+
+    /** Insert record batches from an arrow ipc file */
+    public insertArrowFromIPCFile(conn: number, path: string, options?: ArrowInsertOptions): void {
+        const optJSON = options ? JSON.stringify(options) : '';
+        const [s, d, n] = callSRet(
+            this.mod,
+            'duckdb_web_insert_arrow_from_ipc_file',
+            ['number', 'string', 'string'],
+            [conn, path, optJSON],
+        );
         if (s !== StatusCode.SUCCESS) {
             throw new Error(readString(this.mod, d, n));
         }
@@ -676,6 +872,14 @@ export abstract class DuckDBBindingsBase implements DuckDBBindings {
     public flushFiles(): void {
         this.mod.ccall('duckdb_web_flush_files', null, [], []);
     }
+    /** Clear the HTTP range cache */
+    public clearHTTPCache(): void {
+        this.mod.ccall('duckdb_web_clear_http_cache', null, [], []);
+    }
+    /** Clear the query result cache */
+    public clearResultCache(): void {
+        this.mod.ccall('duckdb_web_clear_result_cache', null, [], []);
+    }
     /** Write a file to a path */
     public copyFileToPath(name: string, path: string): void {
         const [s, d, n] = callSRet(this.mod, 'duckdb_web_copy_file_to_path', ['string', 'string'], [name, path]);
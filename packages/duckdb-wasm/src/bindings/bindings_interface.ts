@@ -20,16 +20,33 @@ export interface DuckDBBindings {
     pollPendingQuery(conn: number): Uint8Array | null;
     cancelPendingQuery(conn: number): boolean;
     fetchQueryResults(conn: number): Uint8Array | null;
+    startQueryHandle(conn: number, text: string, allowStreamResult: boolean): number;
+    pollQueryHandle(conn: number, query: number): Uint8Array | null;
+    cancelQueryHandle(conn: number, query: number): boolean;
+    fetchQueryHandleResults(conn: number, query: number): Uint8Array | null;
+    closeQueryHandle(conn: number, query: number): void;
     getTableNames(conn: number, text: string): string[];
+    exportQuery(conn: number, text: string): number;
+    getArrowStreamSchema(stream: number): number;
+    getArrowStreamNext(stream: number): number;
+    releaseArrowStream(stream: number): void;
+    releaseArrowSchema(schema: number): void;
+    releaseArrowArray(array: number): void;
+    spillQuery(conn: number, text: string): [number, number];
+    fetchSpilledRange(conn: number, result: number, offset: number, limit: number): Uint8Array;
+    closeSpilled(conn: number, result: number): void;
 
     createPrepared(conn: number, text: string): number;
     closePrepared(conn: number, statement: number): void;
     runPrepared(conn: number, statement: number, params: any[]): Uint8Array;
+    runPreparedBatch(conn: number, statement: number, params: Uint8Array): Uint8Array;
     sendPrepared(conn: number, statement: number, params: any[]): Uint8Array;
 
     createScalarFunction(conn: number, name: string, returns: arrow.DataType, func: (...args: any[]) => void): void;
 
     insertArrowFromIPCStream(conn: number, buffer: Uint8Array, options?: ArrowInsertOptions): void;
+    abortArrowIPCStream(conn: number): void;
+    insertArrowFromIPCFile(conn: number, path: string, options?: ArrowInsertOptions): void;
     insertCSVFromPath(conn: number, path: string, options: CSVInsertOptions): void;
     insertJSONFromPath(conn: number, path: string, options: JSONInsertOptions): void;
 
@@ -60,6 +77,8 @@ export interface DuckDBBindings {
     dropFile(name: string): void;
     dropFiles(names?: string[]): void;
     flushFiles(): void;
+    clearHTTPCache(): void;
+    clearResultCache(): void;
     copyFileToPath(name: string, path: string): void;
     copyFileToBuffer(name: string): Uint8Array;
     registerOPFSFileName(file: string): Promise<void>;
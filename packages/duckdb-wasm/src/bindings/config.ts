@@ -19,6 +19,46 @@ export interface DuckDBQueryConfig {
      * Cast Decimal to Double?
      */
     castDecimalToDouble?: boolean;
+    /**
+     * The number of rows that a streamed record batch should reach.
+     * Result chunks are combined until the target or the polling interval is reached.
+     */
+    resultBatchRows?: number;
+    /**
+     * The number of bytes that a streamed record batch should reach.
+     * Result chunks are combined until the target or the polling interval is reached.
+     */
+    resultBatchBytes?: number;
+    /**
+     * Compress the bodies of Arrow IPC results?
+     * Only for native builds and for clients that forward the raw IPC bytes to another Arrow reader.
+     * The published WebAssembly bundles are built without IPC codecs and reject this option, and apache-arrow 17
+     * cannot decompress record batches, so query results that are read in JavaScript must stay uncompressed.
+     */
+    resultCompression?: 'none' | 'lz4' | 'zstd';
+    /**
+     * Export VARCHAR columns as dictionary vectors?
+     * The dictionaries persist across the record batches of a result and grow through dictionary deltas.
+     */
+    dictionaryEncodeStrings?: boolean;
+    /**
+     * The byte budget of the query result cache (0 disables the cache).
+     * Results of repeated read-only queries are served without executing them until a statement writes data or files
+     * are registered or dropped.
+     */
+    resultCacheBytes?: number;
+    /**
+     * The number of rows that are returned together with the schema of a streamed result.
+     * The first chunks are appended to the schema message until the rows are reached, saving one fetch round trip
+     * before the first rows can be shown.
+     */
+    firstBatchRows?: number;
+    /**
+     * The directory of the files that spilled results are written to.
+     * Spilled results keep their record batches in the file page buffer instead of one IPC buffer, a directory such
+     * as "opfs://tmp" moves them out of wasm memory. Spilling fails if the spill file would be kept in wasm memory.
+     */
+    resultSpillDirectory?: string;
 }
 
 export interface DuckDBFilesystemConfig {
@@ -31,6 +71,16 @@ export interface DuckDBFilesystemConfig {
      * Force use of full HTTP reads, suppressing range requests.
      */
     forceFullHTTPReads?: boolean;
+    /**
+     * The byte budget of the HTTP range cache (default 0 disables the cache).
+     * Cached responses are revalidated with If-None-Match, which adds a CORS preflight for cross-origin urls.
+     * Requests with credentials are never cached.
+     */
+    httpCacheBytes?: number;
+    /**
+     * The time in milliseconds in which cached HTTP responses are served without revalidation.
+     */
+    httpCacheMaxAgeMs?: number;
 }
 
 export interface DuckDBOPFSConfig {
@@ -68,11 +68,30 @@ export class DuckDBConnection {
         return this._bindings.cancelPendingQuery(this._conn);
     }
 
+    /**
+     * Start a query with its own query handle.
+     * Several query handles can be read interleaved on one connection, a running query is finished and its result
+     * is buffered when another query starts.
+     */
+    public startQuery<T extends { [key: string]: arrow.DataType } = any>(
+        text: string,
+        allowStreamResult: boolean = false,
+    ): QueryHandle<T> {
+        const query = this._bindings.startQueryHandle(this._conn, text, allowStreamResult);
+        return new QueryHandle<T>(this._bindings, this._conn, query);
+    }
+
     /** Get table names */
     public getTableNames(query: string): string[] {
         return this._bindings.getTableNames(this._conn, query);
     }
 
+    /** Run a query and spill the materialized result for random access */
+    public spill<T extends { [key: string]: arrow.DataType } = any>(text: string): SpilledResult<T> {
+        const [result, rowCount] = this._bindings.spillQuery(this._conn, text);
+        return new SpilledResult<T>(this._bindings, this._conn, result, rowCount);
+    }
+
     /** Create a prepared statement */
     public prepare<T extends { [key: string]: arrow.DataType } = any>(text: string): PreparedStatement {
         const stmt = this._bindings.createPrepared(this._conn, text);
@@ -93,6 +112,14 @@ export class DuckDBConnection {
     public insertArrowFromIPCStream(buffer: Uint8Array, options: ArrowInsertOptions): void {
         this._bindings.insertArrowFromIPCStream(this._conn, buffer, options);
     }
+    /** Abort a pending arrow ipc stream insert, other statements on the connection fail until the stream ends */
+    public abortArrowIPCStream(): void {
+        this._bindings.abortArrowIPCStream(this._conn);
+    }
+    /** Insert an arrow ipc file from path */
+    public insertArrowFromIPCFile(path: string, options: ArrowInsertOptions): void {
+        this._bindings.insertArrowFromIPCFile(this._conn, path, options);
+    }
 
     /** Inesrt csv file from path */
     public insertCSVFromPath(path: string, options: CSVInsertOptions): void {
@@ -115,6 +142,7 @@ export class ResultStreamIterator implements Iterable<Uint8Array> {
         protected bindings: DuckDBBindings,
         protected conn: number,
         protected header: Uint8Array,
+        protected queryId: number | null = null,
     ) {
         this._first = true;
         this._depleted = false;
@@ -130,7 +158,10 @@ export class ResultStreamIterator implements Iterable<Uint8Array> {
         }
         let bufferI8 = null;
         do {
-            bufferI8 = this.bindings.fetchQueryResults(this.conn);
+            bufferI8 =
+                this.queryId == null
+                    ? this.bindings.fetchQueryResults(this.conn)
+                    : this.bindings.fetchQueryHandleResults(this.conn, this.queryId);
         } while (bufferI8 == null);
         this._depleted = bufferI8.length == 0;
         return {
@@ -144,6 +175,52 @@ export class ResultStreamIterator implements Iterable<Uint8Array> {
     }
 }
 
+/** A thin helper to bind the query handle id */
+export class QueryHandle<T extends { [key: string]: arrow.DataType } = any> {
+    /** The bindings */
+    protected readonly bindings: DuckDBBindings;
+    /** The connection id */
+    protected readonly connectionId: number;
+    /** The query id */
+    public readonly queryId: number;
+
+    /** Constructor */
+    constructor(bindings: DuckDBBindings, connectionId: number, queryId: number) {
+        this.bindings = bindings;
+        this.connectionId = connectionId;
+        this.queryId = queryId;
+    }
+
+    /** Wait for the query and stream the result */
+    public async read(): Promise<arrow.RecordBatchStreamReader<T>> {
+        let header = this.bindings.pollQueryHandle(this.connectionId, this.queryId);
+        while (header == null) {
+            header = await new Promise((resolve, reject) => {
+                try {
+                    resolve(this.bindings.pollQueryHandle(this.connectionId, this.queryId));
+                } catch (e: any) {
+                    reject(e);
+                }
+            });
+        }
+        const iter = new ResultStreamIterator(this.bindings, this.connectionId, header, this.queryId);
+        const reader = arrow.RecordBatchReader.from<T>(iter);
+        console.assert(reader.isSync());
+        console.assert(reader.isStream());
+        return reader;
+    }
+
+    /** Cancel the query */
+    public cancel(): boolean {
+        return this.bindings.cancelQueryHandle(this.connectionId, this.queryId);
+    }
+
+    /** Close the query handle and drop its result */
+    public close() {
+        this.bindings.closeQueryHandle(this.connectionId, this.queryId);
+    }
+}
+
 /** A thin helper to bind the prepared statement id*/
 export class PreparedStatement<T extends { [key: string]: arrow.DataType } = any> {
     /** The bindings */
@@ -174,6 +251,19 @@ export class PreparedStatement<T extends { [key: string]: arrow.DataType } = any
         return new arrow.Table(reader as arrow.RecordBatchFileReader);
     }
 
+    /** Run a prepared statement once per row of a parameter table and return the concatenated result */
+    public queryBatch(params: arrow.Table): arrow.Table<T> {
+        const buffer = this.bindings.runPreparedBatch(
+            this.connectionId,
+            this.statementId,
+            arrow.tableToIPC(params, 'stream'),
+        );
+        const reader = arrow.RecordBatchReader.from<T>(buffer);
+        console.assert(reader.isSync());
+        console.assert(reader.isFile());
+        return new arrow.Table(reader as arrow.RecordBatchFileReader);
+    }
+
     /** Send a prepared statement */
     public send(...params: any[]): arrow.RecordBatchStreamReader<T> {
         const header = this.bindings.sendPrepared(this.connectionId, this.statementId, params);
@@ -184,3 +274,37 @@ export class PreparedStatement<T extends { [key: string]: arrow.DataType } = any
         return reader as arrow.RecordBatchStreamReader;
     }
 }
+
+/** A thin helper to bind the spilled result id */
+export class SpilledResult<T extends { [key: string]: arrow.DataType } = any> {
+    /** The bindings */
+    protected readonly bindings: DuckDBBindings;
+    /** The connection id */
+    protected readonly connectionId: number;
+    /** The result id */
+    protected readonly resultId: number;
+    /** The number of rows */
+    public readonly rowCount: number;
+
+    /** Constructor */
+    constructor(bindings: DuckDBBindings, connectionId: number, resultId: number, rowCount: number) {
+        this.bindings = bindings;
+        this.connectionId = connectionId;
+        this.resultId = resultId;
+        this.rowCount = rowCount;
+    }
+
+    /** Close the result and drop its spill file */
+    public close() {
+        this.bindings.closeSpilled(this.connectionId, this.resultId);
+    }
+
+    /** Fetch up to limit rows starting at offset */
+    public fetch(offset: number, limit: number): arrow.Table<T> {
+        const buffer = this.bindings.fetchSpilledRange(this.connectionId, this.resultId, offset, limit);
+        const reader = arrow.RecordBatchReader.from<T>(buffer);
+        console.assert(reader.isSync());
+        console.assert(reader.isStream());
+        return new arrow.Table(reader as arrow.RecordBatchStreamReader);
+    }
+}
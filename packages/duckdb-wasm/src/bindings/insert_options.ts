@@ -33,6 +33,15 @@ export interface CSVInsertOptions {
         [key: string]: arrow.DataType;
     };
     columnsFlat?: SQLField[];
+    /**
+     * The size of the byte ranges that are prefetched concurrently from remote files.
+     * Registered files and http(s):// or s3:// paths are prefetched when they are read through the DuckDB-Wasm
+     * filesystem, not when an extension like httpfs handles the url.
+     * Prefetching requires a build with threads.
+     */
+    prefetchRangeSize?: number;
+    /** The number of concurrent range requests for remote files, 0 disables prefetching */
+    prefetchConcurrency?: number;
 }
 
 export interface ArrowInsertOptions {
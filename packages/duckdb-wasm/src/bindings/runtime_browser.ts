@@ -644,6 +644,11 @@ export const BROWSER_RUNTIME: DuckDBRuntime & {
                             console.warn(
                                 `Range request for ${file.dataUrl} did not return a partial response: ${xhr.status} "${xhr.statusText}"`,
                             );
+                            if (location >= xhr.response.byteLength) {
+                                throw new Error(
+                                    `Range request for ${file.dataUrl} returned a full response of ${xhr.response.byteLength} bytes that ends before offset ${location}`,
+                                );
+                            }
                             const src = new Uint8Array(
                                 xhr.response,
                                 location,
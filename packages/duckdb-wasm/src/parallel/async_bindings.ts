@@ -176,7 +176,10 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
 
         // Otherwise differentiate between the tasks first
         switch (task.type) {
+            case WorkerRequestType.ABORT_ARROW_IPC_STREAM:
             case WorkerRequestType.CLOSE_PREPARED:
+            case WorkerRequestType.CLOSE_QUERY_HANDLE:
+            case WorkerRequestType.CLOSE_SPILLED_RESULT:
             case WorkerRequestType.COLLECT_FILE_STATISTICS:
             case WorkerRequestType.REGISTER_OPFS_FILE_NAME:
             case WorkerRequestType.COPY_FILE_TO_PATH:
@@ -184,6 +187,9 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
             case WorkerRequestType.DROP_FILE:
             case WorkerRequestType.DROP_FILES:
             case WorkerRequestType.FLUSH_FILES:
+            case WorkerRequestType.CLEAR_HTTP_CACHE:
+            case WorkerRequestType.CLEAR_RESULT_CACHE:
+            case WorkerRequestType.INSERT_ARROW_FROM_IPC_FILE:
             case WorkerRequestType.INSERT_ARROW_FROM_IPC_STREAM:
             case WorkerRequestType.INSERT_CSV_FROM_PATH:
             case WorkerRequestType.INSERT_JSON_FROM_PATH:
@@ -253,7 +259,9 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
                     return;
                 }
                 break;
+            case WorkerRequestType.FETCH_SPILLED_RANGE:
             case WorkerRequestType.RUN_PREPARED:
+            case WorkerRequestType.RUN_PREPARED_BATCH:
             case WorkerRequestType.RUN_QUERY:
                 if (response.type == WorkerResponseType.QUERY_RESULT) {
                     task.promiseResolver(response.data);
@@ -285,6 +293,25 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
                     return;
                 }
                 break;
+            case WorkerRequestType.START_QUERY_HANDLE:
+                if (response.type == WorkerResponseType.QUERY_HANDLE_ID) {
+                    task.promiseResolver(response.data);
+                    return;
+                }
+                break;
+            case WorkerRequestType.POLL_QUERY_HANDLE:
+                if (response.type == WorkerResponseType.QUERY_RESULT_HEADER_OR_NULL) {
+                    task.promiseResolver(response.data);
+                    return;
+                }
+                break;
+            case WorkerRequestType.CANCEL_QUERY_HANDLE:
+                if (response.type == WorkerResponseType.SUCCESS) {
+                    task.promiseResolver(response.data);
+                    return;
+                }
+                break;
+            case WorkerRequestType.FETCH_QUERY_HANDLE_RESULTS:
             case WorkerRequestType.FETCH_QUERY_RESULTS:
                 if (response.type == WorkerResponseType.QUERY_RESULT_CHUNK) {
                     task.promiseResolver(response.data);
@@ -297,6 +324,12 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
                     return;
                 }
                 break;
+            case WorkerRequestType.SPILL_QUERY:
+                if (response.type == WorkerResponseType.SPILLED_RESULT_INFO) {
+                    task.promiseResolver(response.data);
+                    return;
+                }
+                break;
         }
         task.promiseRejecter(new Error(`unexpected response type: ${response.type.toString()}`));
     }
@@ -349,6 +382,22 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
         const task = new WorkerTask<WorkerRequestType.FLUSH_FILES, null, null>(WorkerRequestType.FLUSH_FILES, null);
         return await this.postTask(task);
     }
+    /** Clear the HTTP range cache */
+    public async clearHTTPCache(): Promise<null> {
+        const task = new WorkerTask<WorkerRequestType.CLEAR_HTTP_CACHE, null, null>(
+            WorkerRequestType.CLEAR_HTTP_CACHE,
+            null,
+        );
+        return await this.postTask(task);
+    }
+    /** Clear the query result cache */
+    public async clearResultCache(): Promise<null> {
+        const task = new WorkerTask<WorkerRequestType.CLEAR_RESULT_CACHE, null, null>(
+            WorkerRequestType.CLEAR_RESULT_CACHE,
+            null,
+        );
+        return await this.postTask(task);
+    }
 
     /** Open the database */
     public async instantiate(
@@ -499,6 +548,52 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
         return await this.postTask(task);
     }
 
+    /** Start a pending query with its own query handle and return the handle identifier */
+    public async startQueryHandle(
+        conn: ConnectionID,
+        text: string,
+        allowStreamResult: boolean = false,
+    ): Promise<number> {
+        const task = new WorkerTask<WorkerRequestType.START_QUERY_HANDLE, [ConnectionID, string, boolean], number>(
+            WorkerRequestType.START_QUERY_HANDLE,
+            [conn, text, allowStreamResult],
+        );
+        return await this.postTask(task);
+    }
+    /** Poll the pending query of a query handle */
+    public async pollQueryHandle(conn: ConnectionID, query: number): Promise<Uint8Array | null> {
+        const task = new WorkerTask<WorkerRequestType.POLL_QUERY_HANDLE, [ConnectionID, number], Uint8Array | null>(
+            WorkerRequestType.POLL_QUERY_HANDLE,
+            [conn, query],
+        );
+        return await this.postTask(task);
+    }
+    /** Cancel the pending query of a query handle */
+    public async cancelQueryHandle(conn: ConnectionID, query: number): Promise<boolean> {
+        const task = new WorkerTask<WorkerRequestType.CANCEL_QUERY_HANDLE, [ConnectionID, number], boolean>(
+            WorkerRequestType.CANCEL_QUERY_HANDLE,
+            [conn, query],
+        );
+        return await this.postTask(task);
+    }
+    /** Fetch query results of a query handle */
+    public async fetchQueryHandleResults(conn: ConnectionID, query: number): Promise<Uint8Array | null> {
+        const task = new WorkerTask<
+            WorkerRequestType.FETCH_QUERY_HANDLE_RESULTS,
+            [ConnectionID, number],
+            Uint8Array | null
+        >(WorkerRequestType.FETCH_QUERY_HANDLE_RESULTS, [conn, query]);
+        return await this.postTask(task);
+    }
+    /** Close a query handle */
+    public async closeQueryHandle(conn: ConnectionID, query: number): Promise<void> {
+        const task = new WorkerTask<WorkerRequestType.CLOSE_QUERY_HANDLE, [ConnectionID, number], null>(
+            WorkerRequestType.CLOSE_QUERY_HANDLE,
+            [conn, query],
+        );
+        await this.postTask(task);
+    }
+
     /** Get table names */
     public async getTableNames(conn: number, text: string): Promise<string[]> {
         const task = new WorkerTask<WorkerRequestType.GET_TABLE_NAMES, [number, string], string[]>(
@@ -532,6 +627,15 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
         );
         return await this.postTask(task);
     }
+    /** Execute a prepared statement once per row of an arrow ipc stream and return the full result */
+    public async runPreparedBatch(conn: number, statement: number, params: Uint8Array): Promise<Uint8Array> {
+        const task = new WorkerTask<
+            WorkerRequestType.RUN_PREPARED_BATCH,
+            [ConnectionID, number, Uint8Array],
+            Uint8Array
+        >(WorkerRequestType.RUN_PREPARED_BATCH, [conn, statement, params]);
+        return await this.postTask(task, [params.buffer]);
+    }
     /** Execute a prepared statement and stream the result */
     public async sendPrepared(conn: number, statement: number, params: any[]): Promise<Uint8Array> {
         const task = new WorkerTask<WorkerRequestType.SEND_PREPARED, [ConnectionID, number, any[]], Uint8Array>(
@@ -540,6 +644,31 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
         );
         return await this.postTask(task);
     }
+    /** Run a query, spill the materialized result and return its identifier and row count */
+    public async spillQuery(conn: number, text: string): Promise<[number, number]> {
+        const task = new WorkerTask<WorkerRequestType.SPILL_QUERY, [ConnectionID, string], [number, number]>(
+            WorkerRequestType.SPILL_QUERY,
+            [conn, text],
+        );
+        return await this.postTask(task);
+    }
+    /** Fetch a row range of a spilled result as arrow ipc stream */
+    public async fetchSpilledRange(conn: number, result: number, offset: number, limit: number): Promise<Uint8Array> {
+        const task = new WorkerTask<
+            WorkerRequestType.FETCH_SPILLED_RANGE,
+            [ConnectionID, number, number, number],
+            Uint8Array
+        >(WorkerRequestType.FETCH_SPILLED_RANGE, [conn, result, offset, limit]);
+        return await this.postTask(task);
+    }
+    /** Close a spilled result */
+    public async closeSpilled(conn: number, result: number): Promise<void> {
+        const task = new WorkerTask<WorkerRequestType.CLOSE_SPILLED_RESULT, [ConnectionID, number], null>(
+            WorkerRequestType.CLOSE_SPILLED_RESULT,
+            [conn, result],
+        );
+        await this.postTask(task);
+    }
     /** Glob file infos */
     public async globFiles(path: string): Promise<WebFile[]> {
         const task = new WorkerTask<WorkerRequestType.GLOB_FILE_INFOS, string, WebFile[]>(
@@ -666,6 +795,23 @@ export class AsyncDuckDB implements AsyncDuckDBBindings {
         >(WorkerRequestType.INSERT_ARROW_FROM_IPC_STREAM, [conn, buffer, options]);
         await this.postTask(task, [buffer.buffer]);
     }
+    /** Abort a pending arrow ipc stream insert */
+    public async abortArrowIPCStream(conn: ConnectionID): Promise<void> {
+        const task = new WorkerTask<WorkerRequestType.ABORT_ARROW_IPC_STREAM, ConnectionID, null>(
+            WorkerRequestType.ABORT_ARROW_IPC_STREAM,
+            conn,
+        );
+        await this.postTask(task);
+    }
+    /** Insert an arrow ipc file */
+    public async insertArrowFromIPCFile(conn: ConnectionID, path: string, options?: ArrowInsertOptions): Promise<void> {
+        const task = new WorkerTask<
+            WorkerRequestType.INSERT_ARROW_FROM_IPC_FILE,
+            [number, string, ArrowInsertOptions | undefined],
+            null
+        >(WorkerRequestType.INSERT_ARROW_FROM_IPC_FILE, [conn, path, options]);
+        await this.postTask(task);
+    }
     /** Insert a csv file */
     public async insertCSVFromPath(conn: ConnectionID, path: string, options: CSVInsertOptions): Promise<void> {
         // Flatten the table options
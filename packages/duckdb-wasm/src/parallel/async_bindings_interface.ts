@@ -1,5 +1,5 @@
 import { Logger } from '../log';
-import { CSVInsertOptions, JSONInsertOptions } from '../bindings/insert_options';
+import { ArrowInsertOptions, CSVInsertOptions, JSONInsertOptions } from '../bindings/insert_options';
 import { DuckDBDataProtocol } from '../bindings';
 
 /** An interface for the async DuckDB bindings */
@@ -23,13 +23,24 @@ export interface AsyncDuckDBBindings {
     pollPendingQuery(conn: number): Promise<Uint8Array | null>;
     cancelPendingQuery(conn: number): Promise<boolean>;
     fetchQueryResults(conn: number): Promise<Uint8Array | null>;
+    startQueryHandle(conn: number, text: string, allowStreamResult: boolean): Promise<number>;
+    pollQueryHandle(conn: number, query: number): Promise<Uint8Array | null>;
+    cancelQueryHandle(conn: number, query: number): Promise<boolean>;
+    fetchQueryHandleResults(conn: number, query: number): Promise<Uint8Array | null>;
+    closeQueryHandle(conn: number, query: number): Promise<void>;
+    spillQuery(conn: number, text: string): Promise<[number, number]>;
+    fetchSpilledRange(conn: number, result: number, offset: number, limit: number): Promise<Uint8Array>;
+    closeSpilled(conn: number, result: number): Promise<void>;
 
     createPrepared(conn: number, text: string): Promise<number>;
     closePrepared(conn: number, statement: number): Promise<void>;
     runPrepared(conn: number, statement: number, params: any[]): Promise<Uint8Array>;
+    runPreparedBatch(conn: number, statement: number, params: Uint8Array): Promise<Uint8Array>;
     sendPrepared(conn: number, statement: number, params: any[]): Promise<Uint8Array>;
 
     insertArrowFromIPCStream(conn: number, buffer: Uint8Array, options?: CSVInsertOptions): Promise<void>;
+    abortArrowIPCStream(conn: number): Promise<void>;
+    insertArrowFromIPCFile(conn: number, path: string, options?: ArrowInsertOptions): Promise<void>;
     insertCSVFromPath(conn: number, path: string, options: CSVInsertOptions): Promise<void>;
     insertJSONFromPath(conn: number, path: string, options: JSONInsertOptions): Promise<void>;
 
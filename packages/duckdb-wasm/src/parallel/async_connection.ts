@@ -81,11 +81,40 @@ export class AsyncDuckDBConnection {
         return await this._bindings.cancelPendingQuery(this._conn);
     }
 
+    /**
+     * Start a query with its own query handle.
+     * Several query handles can be read interleaved on one connection, a running query is finished and its result
+     * is buffered when another query starts.
+     */
+    public async startQuery<T extends { [key: string]: arrow.DataType } = any>(
+        text: string,
+        allowStreamResult: boolean = false,
+    ): Promise<AsyncQueryHandle<T>> {
+        this._bindings.logger.log({
+            timestamp: new Date(),
+            level: LogLevel.INFO,
+            origin: LogOrigin.ASYNC_DUCKDB,
+            topic: LogTopic.QUERY,
+            event: LogEvent.RUN,
+            value: text,
+        });
+        const query = await this._bindings.startQueryHandle(this._conn, text, allowStreamResult);
+        return new AsyncQueryHandle<T>(this._bindings, this._conn, query);
+    }
+
     /** Get table names */
     public async getTableNames(query: string): Promise<string[]> {
         return await this._bindings.getTableNames(this._conn, query);
     }
 
+    /** Run a query and spill the materialized result for random access */
+    public async spill<T extends { [key: string]: arrow.DataType } = any>(
+        text: string,
+    ): Promise<AsyncSpilledResult<T>> {
+        const [result, rowCount] = await this._bindings.spillQuery(this._conn, text);
+        return new AsyncSpilledResult<T>(this._bindings, this._conn, result, rowCount);
+    }
+
     /** Create a prepared statement */
     public async prepare<T extends { [key: string]: arrow.DataType } = any>(
         text: string,
@@ -103,6 +132,14 @@ export class AsyncDuckDBConnection {
     public async insertArrowFromIPCStream(buffer: Uint8Array, options: ArrowInsertOptions): Promise<void> {
         await this._bindings.insertArrowFromIPCStream(this._conn, buffer, options);
     }
+    /** Abort a pending arrow ipc stream insert, other statements on the connection fail until the stream ends */
+    public async abortArrowIPCStream(): Promise<void> {
+        await this._bindings.abortArrowIPCStream(this._conn);
+    }
+    /** Insert an arrow ipc file from path */
+    public async insertArrowFromIPCFile(path: string, options: ArrowInsertOptions): Promise<void> {
+        await this._bindings.insertArrowFromIPCFile(this._conn, path, options);
+    }
     /** Insert csv file from path */
     public async insertCSVFromPath(text: string, options: CSVInsertOptions): Promise<void> {
         await this._bindings.insertCSVFromPath(this._conn, text, options);
@@ -126,6 +163,7 @@ export class AsyncResultStreamIterator implements AsyncIterable<Uint8Array> {
         protected readonly db: AsyncDuckDB,
         protected readonly conn: number,
         protected readonly header: Uint8Array,
+        protected readonly queryId: number | null = null,
     ) {
         this._first = true;
         this._depleted = false;
@@ -147,12 +185,12 @@ export class AsyncResultStreamIterator implements AsyncIterable<Uint8Array> {
         }
 
         while (buffer == null) {
-            buffer = await this.db.fetchQueryResults(this.conn);
+            buffer = await this.fetch();
         }
 
         this._depleted = buffer.length == 0;
         if (!this._depleted) {
-            this._inFlight = this.db.fetchQueryResults(this.conn);
+            this._inFlight = this.fetch();
         }
 
         return {
@@ -161,11 +199,64 @@ export class AsyncResultStreamIterator implements AsyncIterable<Uint8Array> {
         };
     }
 
+    /** Fetch the next results of the connection or the query handle */
+    protected fetch(): Promise<Uint8Array | null> {
+        if (this.queryId == null) {
+            return this.db.fetchQueryResults(this.conn);
+        }
+        return this.db.fetchQueryHandleResults(this.conn, this.queryId);
+    }
+
     [Symbol.asyncIterator]() {
         return this;
     }
 }
 
+/** A thin helper to bind the query handle id */
+export class AsyncQueryHandle<T extends { [key: string]: arrow.DataType } = any> {
+    /** The bindings */
+    protected readonly bindings: AsyncDuckDB;
+    /** The connection id */
+    protected readonly connectionId: number;
+    /** The query id */
+    public readonly queryId: number;
+
+    /** Constructor */
+    constructor(bindings: AsyncDuckDB, connectionId: number, queryId: number) {
+        this.bindings = bindings;
+        this.connectionId = connectionId;
+        this.queryId = queryId;
+    }
+
+    /** Wait for the query and stream the result */
+    public async read(): Promise<arrow.AsyncRecordBatchStreamReader<T>> {
+        let header: Uint8Array | null = null;
+        while (header == null) {
+            // Avoid infinite loop on detached state
+            if (this.bindings.isDetached()) {
+                console.error('cannot send a message since the worker is not set!');
+                return undefined as any;
+            }
+            header = await this.bindings.pollQueryHandle(this.connectionId, this.queryId);
+        }
+        const iter = new AsyncResultStreamIterator(this.bindings, this.connectionId, header, this.queryId);
+        const reader = await arrow.RecordBatchReader.from<T>(iter);
+        console.assert(reader.isAsync());
+        console.assert(reader.isStream());
+        return reader as unknown as arrow.AsyncRecordBatchStreamReader<T>; // XXX
+    }
+
+    /** Cancel the query */
+    public async cancel(): Promise<boolean> {
+        return await this.bindings.cancelQueryHandle(this.connectionId, this.queryId);
+    }
+
+    /** Close the query handle and drop its result */
+    public async close() {
+        await this.bindings.closeQueryHandle(this.connectionId, this.queryId);
+    }
+}
+
 /** A thin helper to bind the prepared statement id */
 export class AsyncPreparedStatement<T extends { [key: string]: arrow.DataType } = any> {
     /** The bindings */
@@ -196,6 +287,19 @@ export class AsyncPreparedStatement<T extends { [key: string]: arrow.DataType }
         return new arrow.Table(reader as arrow.RecordBatchFileReader);
     }
 
+    /** Run a prepared statement once per row of a parameter table and return the concatenated result */
+    public async queryBatch(params: arrow.Table): Promise<arrow.Table<T>> {
+        const buffer = await this.bindings.runPreparedBatch(
+            this.connectionId,
+            this.statementId,
+            arrow.tableToIPC(params, 'stream'),
+        );
+        const reader = arrow.RecordBatchReader.from<T>(buffer);
+        console.assert(reader.isSync());
+        console.assert(reader.isFile());
+        return new arrow.Table(reader as arrow.RecordBatchFileReader);
+    }
+
     /** Send a prepared statement */
     public async send(...params: any[]): Promise<arrow.AsyncRecordBatchStreamReader<T>> {
         const header = await this.bindings.sendPrepared(this.connectionId, this.statementId, params);
@@ -206,3 +310,37 @@ export class AsyncPreparedStatement<T extends { [key: string]: arrow.DataType }
         return reader as unknown as arrow.AsyncRecordBatchStreamReader<T>; // XXX
     }
 }
+
+/** A thin helper to bind the spilled result id */
+export class AsyncSpilledResult<T extends { [key: string]: arrow.DataType } = any> {
+    /** The bindings */
+    protected readonly bindings: AsyncDuckDB;
+    /** The connection id */
+    protected readonly connectionId: number;
+    /** The result id */
+    protected readonly resultId: number;
+    /** The number of rows */
+    public readonly rowCount: number;
+
+    /** Constructor */
+    constructor(bindings: AsyncDuckDB, connectionId: number, resultId: number, rowCount: number) {
+        this.bindings = bindings;
+        this.connectionId = connectionId;
+        this.resultId = resultId;
+        this.rowCount = rowCount;
+    }
+
+    /** Close the result and drop its spill file */
+    public async close() {
+        await this.bindings.closeSpilled(this.connectionId, this.resultId);
+    }
+
+    /** Fetch up to limit rows starting at offset */
+    public async fetch(offset: number, limit: number): Promise<arrow.Table<T>> {
+        const buffer = await this.bindings.fetchSpilledRange(this.connectionId, this.resultId, offset, limit);
+        const reader = arrow.RecordBatchReader.from<T>(buffer);
+        console.assert(reader.isSync());
+        console.assert(reader.isStream());
+        return new arrow.Table(reader as arrow.RecordBatchStreamReader);
+    }
+}
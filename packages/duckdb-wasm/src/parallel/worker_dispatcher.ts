@@ -156,6 +156,14 @@ export abstract class AsyncDuckDBDispatcher implements Logger {
                     this._bindings.flushFiles();
                     this.sendOK(request);
                     break;
+                case WorkerRequestType.CLEAR_HTTP_CACHE:
+                    this._bindings.clearHTTPCache();
+                    this.sendOK(request);
+                    break;
+                case WorkerRequestType.CLEAR_RESULT_CACHE:
+                    this._bindings.clearResultCache();
+                    this.sendOK(request);
+                    break;
                 case WorkerRequestType.CONNECT: {
                     const conn = this._bindings.connect();
                     this.postMessage(
@@ -204,6 +212,55 @@ export abstract class AsyncDuckDBDispatcher implements Logger {
                     );
                     break;
                 }
+                case WorkerRequestType.RUN_PREPARED_BATCH: {
+                    const result = this._bindings.runPreparedBatch(request.data[0], request.data[1], request.data[2]);
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.QUERY_RESULT,
+                            data: result,
+                        },
+                        [result.buffer],
+                    );
+                    break;
+                }
+                case WorkerRequestType.SPILL_QUERY: {
+                    const result = this._bindings.spillQuery(request.data[0], request.data[1]);
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.SPILLED_RESULT_INFO,
+                            data: result,
+                        },
+                        [],
+                    );
+                    break;
+                }
+                case WorkerRequestType.FETCH_SPILLED_RANGE: {
+                    const result = this._bindings.fetchSpilledRange(
+                        request.data[0],
+                        request.data[1],
+                        request.data[2],
+                        request.data[3],
+                    );
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.QUERY_RESULT,
+                            data: result,
+                        },
+                        [result.buffer],
+                    );
+                    break;
+                }
+                case WorkerRequestType.CLOSE_SPILLED_RESULT: {
+                    this._bindings.closeSpilled(request.data[0], request.data[1]);
+                    this.sendOK(request);
+                    break;
+                }
                 case WorkerRequestType.RUN_QUERY: {
                     const result = this._bindings.runQuery(request.data[0], request.data[1]);
                     this.postMessage(
@@ -291,6 +348,65 @@ export abstract class AsyncDuckDBDispatcher implements Logger {
                     );
                     break;
                 }
+                case WorkerRequestType.START_QUERY_HANDLE: {
+                    const result = this._bindings.startQueryHandle(request.data[0], request.data[1], request.data[2]);
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.QUERY_HANDLE_ID,
+                            data: result,
+                        },
+                        [],
+                    );
+                    break;
+                }
+                case WorkerRequestType.POLL_QUERY_HANDLE: {
+                    const result = this._bindings.pollQueryHandle(request.data[0], request.data[1]);
+                    const transfer = result ? [result.buffer] : [];
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.QUERY_RESULT_HEADER_OR_NULL,
+                            data: result,
+                        },
+                        transfer,
+                    );
+                    break;
+                }
+                case WorkerRequestType.CANCEL_QUERY_HANDLE: {
+                    const result = this._bindings.cancelQueryHandle(request.data[0], request.data[1]);
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.SUCCESS,
+                            data: result,
+                        },
+                        [],
+                    );
+                    break;
+                }
+                case WorkerRequestType.FETCH_QUERY_HANDLE_RESULTS: {
+                    const result = this._bindings.fetchQueryHandleResults(request.data[0], request.data[1]);
+                    const transfer = result ? [result.buffer] : [];
+                    this.postMessage(
+                        {
+                            messageId: this._nextMessageId++,
+                            requestId: request.messageId,
+                            type: WorkerResponseType.QUERY_RESULT_CHUNK,
+                            data: result,
+                        },
+                        transfer,
+                    );
+                    break;
+                }
+                case WorkerRequestType.CLOSE_QUERY_HANDLE: {
+                    this._bindings.closeQueryHandle(request.data[0], request.data[1]);
+                    this.sendOK(request);
+                    break;
+                }
                 case WorkerRequestType.GET_TABLE_NAMES: {
                     const result = this._bindings.getTableNames(request.data[0], request.data[1]);
                     this.postMessage(
@@ -378,11 +494,21 @@ export abstract class AsyncDuckDBDispatcher implements Logger {
                     );
                     break;
                 }
+                case WorkerRequestType.INSERT_ARROW_FROM_IPC_FILE: {
+                    this._bindings.insertArrowFromIPCFile(request.data[0], request.data[1], request.data[2]);
+                    this.sendOK(request);
+                    break;
+                }
                 case WorkerRequestType.INSERT_ARROW_FROM_IPC_STREAM: {
                     this._bindings.insertArrowFromIPCStream(request.data[0], request.data[1], request.data[2]);
                     this.sendOK(request);
                     break;
                 }
+                case WorkerRequestType.ABORT_ARROW_IPC_STREAM: {
+                    this._bindings.abortArrowIPCStream(request.data);
+                    this.sendOK(request);
+                    break;
+                }
                 case WorkerRequestType.INSERT_CSV_FROM_PATH: {
                     this._bindings.insertCSVFromPath(request.data[0], request.data[1], request.data[2]);
                     this.sendOK(request);
@@ -11,8 +11,14 @@ export type ConnectionID = number;
 export type StatementID = number;
 
 export enum WorkerRequestType {
+    ABORT_ARROW_IPC_STREAM = 'ABORT_ARROW_IPC_STREAM',
     CANCEL_PENDING_QUERY = 'CANCEL_PENDING_QUERY',
+    CANCEL_QUERY_HANDLE = 'CANCEL_QUERY_HANDLE',
+    CLEAR_HTTP_CACHE = 'CLEAR_HTTP_CACHE',
+    CLEAR_RESULT_CACHE = 'CLEAR_RESULT_CACHE',
     CLOSE_PREPARED = 'CLOSE_PREPARED',
+    CLOSE_QUERY_HANDLE = 'CLOSE_QUERY_HANDLE',
+    CLOSE_SPILLED_RESULT = 'CLOSE_SPILLED_RESULT',
     COLLECT_FILE_STATISTICS = 'COLLECT_FILE_STATISTICS',
     REGISTER_OPFS_FILE_NAME = 'REGISTER_OPFS_FILE_NAME',
     CONNECT = 'CONNECT',
@@ -23,12 +29,15 @@ export enum WorkerRequestType {
     DROP_FILE = 'DROP_FILE',
     DROP_FILES = 'DROP_FILES',
     EXPORT_FILE_STATISTICS = 'EXPORT_FILE_STATISTICS',
+    FETCH_QUERY_HANDLE_RESULTS = 'FETCH_QUERY_HANDLE_RESULTS',
     FETCH_QUERY_RESULTS = 'FETCH_QUERY_RESULTS',
+    FETCH_SPILLED_RANGE = 'FETCH_SPILLED_RANGE',
     FLUSH_FILES = 'FLUSH_FILES',
     GET_FEATURE_FLAGS = 'GET_FEATURE_FLAGS',
     GET_TABLE_NAMES = 'GET_TABLE_NAMES',
     GET_VERSION = 'GET_VERSION',
     GLOB_FILE_INFOS = 'GLOB_FILE_INFOS',
+    INSERT_ARROW_FROM_IPC_FILE = 'INSERT_ARROW_FROM_IPC_FILE',
     INSERT_ARROW_FROM_IPC_STREAM = 'INSERT_ARROW_FROM_IPC_STREAM',
     INSERT_CSV_FROM_PATH = 'IMPORT_CSV_FROM_PATH',
     INSERT_JSON_FROM_PATH = 'IMPORT_JSON_FROM_PATH',
@@ -36,14 +45,18 @@ export enum WorkerRequestType {
     OPEN = 'OPEN',
     PING = 'PING',
     POLL_PENDING_QUERY = 'POLL_PENDING_QUERY',
+    POLL_QUERY_HANDLE = 'POLL_QUERY_HANDLE',
     REGISTER_FILE_BUFFER = 'REGISTER_FILE_BUFFER',
     REGISTER_FILE_HANDLE = 'REGISTER_FILE_HANDLE',
     REGISTER_FILE_URL = 'REGISTER_FILE_URL',
     RESET = 'RESET',
     RUN_PREPARED = 'RUN_PREPARED',
+    RUN_PREPARED_BATCH = 'RUN_PREPARED_BATCH',
     RUN_QUERY = 'RUN_QUERY',
     SEND_PREPARED = 'SEND_PREPARED',
+    SPILL_QUERY = 'SPILL_QUERY',
     START_PENDING_QUERY = 'START_PENDING_QUERY',
+    START_QUERY_HANDLE = 'START_QUERY_HANDLE',
     TOKENIZE = 'TOKENIZE',
 }
 
@@ -60,6 +73,7 @@ export enum WorkerResponseType {
     PROGRESS_UPDATE = 'PROGRESS_UPDATE',
     OK = 'OK',
     PREPARED_STATEMENT_ID = 'PREPARED_STATEMENT_ID',
+    QUERY_HANDLE_ID = 'QUERY_HANDLE_ID',
     QUERY_PLAN = 'QUERY_PLAN',
     QUERY_RESULT = 'QUERY_RESULT',
     QUERY_RESULT_CHUNK = 'QUERY_RESULT_CHUNK',
@@ -67,6 +81,7 @@ export enum WorkerResponseType {
     QUERY_RESULT_HEADER_OR_NULL = 'QUERY_RESULT_HEADER_OR_NULL',
     REGISTERED_FILE = 'REGISTERED_FILE',
     SCRIPT_TOKENS = 'SCRIPT_TOKENS',
+    SPILLED_RESULT_INFO = 'SPILLED_RESULT_INFO',
     SUCCESS = 'SUCCESS',
     TABLE_NAMES = 'TABLE_NAMES',
     VERSION_STRING = 'VERSION_STRING',
@@ -109,6 +124,8 @@ export class WorkerTask<T, D, P> {
 export type WorkerRequestVariant =
     | WorkerRequest<WorkerRequestType.CLOSE_PREPARED, [ConnectionID, StatementID]>
     | WorkerRequest<WorkerRequestType.CANCEL_PENDING_QUERY, number>
+    | WorkerRequest<WorkerRequestType.CANCEL_QUERY_HANDLE, [number, number]>
+    | WorkerRequest<WorkerRequestType.CLOSE_QUERY_HANDLE, [number, number]>
     | WorkerRequest<WorkerRequestType.COLLECT_FILE_STATISTICS, [string, boolean]>
     | WorkerRequest<WorkerRequestType.REGISTER_OPFS_FILE_NAME, [string]>
     | WorkerRequest<WorkerRequestType.CONNECT, null>
@@ -119,12 +136,19 @@ export type WorkerRequestVariant =
     | WorkerRequest<WorkerRequestType.DROP_FILE, string>
     | WorkerRequest<WorkerRequestType.DROP_FILES, string[] | undefined>
     | WorkerRequest<WorkerRequestType.EXPORT_FILE_STATISTICS, string>
+    | WorkerRequest<WorkerRequestType.FETCH_QUERY_HANDLE_RESULTS, [number, number]>
     | WorkerRequest<WorkerRequestType.FETCH_QUERY_RESULTS, number>
+    | WorkerRequest<WorkerRequestType.FETCH_SPILLED_RANGE, [number, number, number, number]>
+    | WorkerRequest<WorkerRequestType.CLOSE_SPILLED_RESULT, [number, number]>
     | WorkerRequest<WorkerRequestType.FLUSH_FILES, null>
+    | WorkerRequest<WorkerRequestType.CLEAR_HTTP_CACHE, null>
+    | WorkerRequest<WorkerRequestType.CLEAR_RESULT_CACHE, null>
     | WorkerRequest<WorkerRequestType.GET_FEATURE_FLAGS, null>
     | WorkerRequest<WorkerRequestType.GET_TABLE_NAMES, [number, string]>
     | WorkerRequest<WorkerRequestType.GET_VERSION, null>
     | WorkerRequest<WorkerRequestType.GLOB_FILE_INFOS, string>
+    | WorkerRequest<WorkerRequestType.ABORT_ARROW_IPC_STREAM, ConnectionID>
+    | WorkerRequest<WorkerRequestType.INSERT_ARROW_FROM_IPC_FILE, [number, string, ArrowInsertOptions | undefined]>
     | WorkerRequest<
           WorkerRequestType.INSERT_ARROW_FROM_IPC_STREAM,
           [number, Uint8Array, ArrowInsertOptions | undefined]
@@ -135,14 +159,18 @@ export type WorkerRequestVariant =
     | WorkerRequest<WorkerRequestType.OPEN, DuckDBConfig>
     | WorkerRequest<WorkerRequestType.PING, null>
     | WorkerRequest<WorkerRequestType.POLL_PENDING_QUERY, number>
+    | WorkerRequest<WorkerRequestType.POLL_QUERY_HANDLE, [number, number]>
     | WorkerRequest<WorkerRequestType.REGISTER_FILE_BUFFER, [string, Uint8Array]>
     | WorkerRequest<WorkerRequestType.REGISTER_FILE_HANDLE, [string, any, DuckDBDataProtocol, boolean]>
     | WorkerRequest<WorkerRequestType.REGISTER_FILE_URL, [string, string, DuckDBDataProtocol, boolean]>
     | WorkerRequest<WorkerRequestType.RESET, null>
     | WorkerRequest<WorkerRequestType.RUN_PREPARED, [number, number, any[]]>
+    | WorkerRequest<WorkerRequestType.RUN_PREPARED_BATCH, [number, number, Uint8Array]>
     | WorkerRequest<WorkerRequestType.RUN_QUERY, [number, string]>
     | WorkerRequest<WorkerRequestType.SEND_PREPARED, [number, number, any[]]>
+    | WorkerRequest<WorkerRequestType.SPILL_QUERY, [number, string]>
     | WorkerRequest<WorkerRequestType.START_PENDING_QUERY, [number, string, boolean]>
+    | WorkerRequest<WorkerRequestType.START_QUERY_HANDLE, [number, string, boolean]>
     | WorkerRequest<WorkerRequestType.TOKENIZE, string>;
 
 export type WorkerResponseVariant =
@@ -158,12 +186,14 @@ export type WorkerResponseVariant =
     | WorkerResponse<WorkerResponseType.PROGRESS_UPDATE, ProgressEntry>
     | WorkerResponse<WorkerResponseType.OK, null>
     | WorkerResponse<WorkerResponseType.PREPARED_STATEMENT_ID, number>
+    | WorkerResponse<WorkerResponseType.QUERY_HANDLE_ID, number>
     | WorkerResponse<WorkerResponseType.QUERY_PLAN, Uint8Array>
     | WorkerResponse<WorkerResponseType.QUERY_RESULT, Uint8Array>
     | WorkerResponse<WorkerResponseType.QUERY_RESULT_CHUNK, Uint8Array | null>
     | WorkerResponse<WorkerResponseType.QUERY_RESULT_HEADER, Uint8Array>
     | WorkerResponse<WorkerResponseType.QUERY_RESULT_HEADER_OR_NULL, Uint8Array | null>
     | WorkerResponse<WorkerResponseType.SCRIPT_TOKENS, ScriptTokens>
+    | WorkerResponse<WorkerResponseType.SPILLED_RESULT_INFO, [number, number]>
     | WorkerResponse<WorkerResponseType.SUCCESS, boolean>
     | WorkerResponse<WorkerResponseType.TABLE_NAMES, string[]>
     | WorkerResponse<WorkerResponseType.VERSION_STRING, string>;
@@ -181,10 +211,16 @@ export type WorkerTaskVariant =
     | WorkerTask<WorkerRequestType.DROP_FILES, string[] | undefined, null>
     | WorkerTask<WorkerRequestType.EXPORT_FILE_STATISTICS, string, FileStatistics>
     | WorkerTask<WorkerRequestType.FETCH_QUERY_RESULTS, ConnectionID, Uint8Array | null>
+    | WorkerTask<WorkerRequestType.FETCH_SPILLED_RANGE, [ConnectionID, number, number, number], Uint8Array>
+    | WorkerTask<WorkerRequestType.CLOSE_SPILLED_RESULT, [ConnectionID, number], null>
     | WorkerTask<WorkerRequestType.FLUSH_FILES, null, null>
+    | WorkerTask<WorkerRequestType.CLEAR_HTTP_CACHE, null, null>
+    | WorkerTask<WorkerRequestType.CLEAR_RESULT_CACHE, null, null>
     | WorkerTask<WorkerRequestType.GET_FEATURE_FLAGS, null, number>
     | WorkerTask<WorkerRequestType.GET_TABLE_NAMES, [number, string], string[]>
     | WorkerTask<WorkerRequestType.GET_VERSION, null, string>
+    | WorkerTask<WorkerRequestType.ABORT_ARROW_IPC_STREAM, ConnectionID, null>
+    | WorkerTask<WorkerRequestType.INSERT_ARROW_FROM_IPC_FILE, [number, string, ArrowInsertOptions | undefined], null>
     | WorkerTask<
           WorkerRequestType.INSERT_ARROW_FROM_IPC_STREAM,
           [number, Uint8Array, ArrowInsertOptions | undefined],
@@ -201,9 +237,16 @@ export type WorkerTaskVariant =
     | WorkerTask<WorkerRequestType.GLOB_FILE_INFOS, string, WebFile[]>
     | WorkerTask<WorkerRequestType.RESET, null, null>
     | WorkerTask<WorkerRequestType.RUN_PREPARED, [number, number, any[]], Uint8Array>
+    | WorkerTask<WorkerRequestType.RUN_PREPARED_BATCH, [number, number, Uint8Array], Uint8Array>
     | WorkerTask<WorkerRequestType.RUN_QUERY, [ConnectionID, string], Uint8Array>
     | WorkerTask<WorkerRequestType.SEND_PREPARED, [number, number, any[]], Uint8Array>
+    | WorkerTask<WorkerRequestType.SPILL_QUERY, [ConnectionID, string], [number, number]>
     | WorkerTask<WorkerRequestType.START_PENDING_QUERY, [ConnectionID, string, boolean], Uint8Array | null>
     | WorkerTask<WorkerRequestType.POLL_PENDING_QUERY, ConnectionID, Uint8Array | null>
     | WorkerTask<WorkerRequestType.CANCEL_PENDING_QUERY, ConnectionID, boolean>
+    | WorkerTask<WorkerRequestType.START_QUERY_HANDLE, [ConnectionID, string, boolean], number>
+    | WorkerTask<WorkerRequestType.POLL_QUERY_HANDLE, [ConnectionID, number], Uint8Array | null>
+    | WorkerTask<WorkerRequestType.CANCEL_QUERY_HANDLE, [ConnectionID, number], boolean>
+    | WorkerTask<WorkerRequestType.FETCH_QUERY_HANDLE_RESULTS, [ConnectionID, number], Uint8Array | null>
+    | WorkerTask<WorkerRequestType.CLOSE_QUERY_HANDLE, [ConnectionID, number], null>
     | WorkerTask<WorkerRequestType.TOKENIZE, string, ScriptTokens>;